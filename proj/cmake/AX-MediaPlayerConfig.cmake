@@ -11,7 +11,8 @@ if( NOT TARGET AX-MediaPlayer )
 		error ( "Unsupported platform" )
 	endif()
 
-	list( APPEND AXMP_SOURCE_FILES "${AXMP_SOURCE_PATH}/AX-MediaPlayer.h" "${AXMP_SOURCE_PATH}/AX-MediaPlayer.cxx" )
+	file ( GLOB AXMP_PORTABLE_SOURCE_FILES "${AXMP_SOURCE_PATH}/*.h" "${AXMP_SOURCE_PATH}/*.cxx" )
+	list( APPEND AXMP_SOURCE_FILES ${AXMP_PORTABLE_SOURCE_FILES} )
 
 	add_library( AX-MediaPlayer ${AXMP_SOURCE_FILES} )
 
@@ -24,6 +25,10 @@ if( NOT TARGET AX-MediaPlayer )
 	endif()
 
 	target_link_libraries( AX-MediaPlayer PRIVATE cinder )
+
+	if ( APPLE )
+		target_link_libraries( AX-MediaPlayer PRIVATE "-framework MediaToolbox" )
+	endif()
 	
 endif()
 
@@ -0,0 +1,210 @@
+//
+//  BundleBenchmarkApp.cxx
+//  BundleBenchmarkApp
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive
+//
+
+#include "cinder/app/RendererGl.h"
+#include "cinder/app/App.h"
+#include "cinder/gl/gl.h"
+#include "cinder/Timer.h"
+#include "AX-MediaPlayer.h"
+#include "AX-MediaPlayerBundle.h"
+
+#include <deque>
+#include <algorithm>
+#include <numeric>
+
+using namespace ci;
+using namespace ci::app;
+
+// Drop a folder of clips onto the window. It's packed into a bundle next to the
+// folder, then every clip is opened one at a time both loose and via bundle://
+// and the time from MediaPlayer::Create ( ) to OnReady is reported for each.
+
+class BundleBenchmarkApp : public app::App
+{
+public:
+    void setup ( ) override;
+    void update ( ) override;
+    void draw ( ) override;
+    void fileDrop ( FileDropEvent event ) override;
+
+protected:
+
+    struct Job
+    {
+        std::string name;
+        fs::path    path;
+        bool        fromBundle{ false };
+    };
+
+    struct Results
+    {
+        std::vector<double> create;
+        std::vector<double> ready;
+    };
+
+    void startBenchmark ( const fs::path & folder );
+    void startNextJob ( );
+    void report ( const std::string & label, const Results & results );
+
+    AX::Video::MediaBundleRef   _bundle;
+    AX::Video::MediaPlayerRef   _player;
+    std::deque<Job>             _jobs;
+    Job                         _current;
+    Timer                       _timer;
+    double                      _createTime{ 0.0 };
+    Results                     _loose;
+    Results                     _bundled;
+    std::string                 _status{ "Drop a folder of clips to benchmark" };
+
+    static constexpr double     kTimeout = 5.0;
+    static constexpr int        kRounds = 3;
+};
+
+void BundleBenchmarkApp::setup ( )
+{
+    AX::Video::MediaPlayer::StaticInitialize ( );
+
+    auto & args = getCommandLineArgs ( );
+    if ( args.size ( ) > 1 && fs::is_directory ( args[1] ) )
+    {
+        startBenchmark ( args[1] );
+    }
+}
+
+void BundleBenchmarkApp::fileDrop ( FileDropEvent event )
+{
+    if ( fs::is_directory ( event.getFile ( 0 ) ) )
+    {
+        startBenchmark ( event.getFile ( 0 ) );
+    }
+}
+
+void BundleBenchmarkApp::startBenchmark ( const fs::path & folder )
+{
+    std::vector<AX::Video::MediaBundle::PackInput> inputs;
+    for ( auto & item : fs::directory_iterator ( folder ) )
+    {
+        if ( item.is_regular_file ( ) ) inputs.push_back ( { item.path ( ), item.path ( ).filename ( ).string ( ) } );
+    }
+
+    auto bundlePath = folder.parent_path ( ) / ( folder.filename ( ).string ( ) + ".axb" );
+
+    std::string error;
+    if ( !AX::Video::MediaBundle::Pack ( bundlePath, inputs, AX::Video::MediaBundle::kDefaultAlignment, &error ) )
+    {
+        _status = "Packing failed: " + error;
+        return;
+    }
+
+    Timer openTimer{ true };
+    if ( _bundle ) AX::Video::MediaBundle::Unmount ( _bundle );
+    _bundle = AX::Video::MediaBundle::Open ( bundlePath );
+    AX::Video::MediaBundle::Mount ( _bundle );
+    console ( ) << "Bundle open + index: " << openTimer.getSeconds ( ) * 1000.0 << "ms for " << inputs.size ( ) << " entries" << std::endl;
+
+    _loose = { };
+    _bundled = { };
+    _jobs.clear ( );
+
+    // Interleave the two so neither side gets a consistently warmer file cache
+    for ( int round = 0; round < kRounds; round++ )
+    {
+        for ( auto & input : inputs )
+        {
+            _jobs.push_back ( { input.name, input.file, false } );
+            _jobs.push_back ( { input.name, input.file, true } );
+        }
+    }
+
+    startNextJob ( );
+}
+
+void BundleBenchmarkApp::startNextJob ( )
+{
+    _player = nullptr;
+
+    if ( _jobs.empty ( ) )
+    {
+        report ( "Loose files", _loose );
+        report ( "Bundle", _bundled );
+        _status = "Done, see console";
+        return;
+    }
+
+    _current = _jobs.front ( );
+    _jobs.pop_front ( );
+
+    auto fmt = AX::Video::MediaPlayer::Format ( ).Audio ( false ).AutoInitialize ( false );
+
+    _timer.start ( );
+    _player = _current.fromBundle
+        ? AX::Video::MediaPlayer::Create ( std::string ( AX::Video::MediaBundle::kUrlScheme ) + _current.name, fmt )
+        : AX::Video::MediaPlayer::Create ( _current.path, fmt );
+    _createTime = _timer.getSeconds ( );
+
+    if ( !_player )
+    {
+        startNextJob ( );
+        return;
+    }
+
+    _player->OnReady.connect ( [=]
+    {
+        auto & results = _current.fromBundle ? _bundled : _loose;
+        results.create.push_back ( _createTime * 1000.0 );
+        results.ready.push_back ( _timer.getSeconds ( ) * 1000.0 );
+
+        // Don't tear down from inside the player's own signal
+        dispatchAsync ( [=] { startNextJob ( ); } );
+    } );
+
+    _status = ( _current.fromBundle ? "bundle://" : "" ) + _current.name + " (" + std::to_string ( _jobs.size ( ) ) + " remaining)";
+}
+
+void BundleBenchmarkApp::report ( const std::string & label, const Results & results )
+{
+    auto summarise = [] ( std::vector<double> values )
+    {
+        if ( values.empty ( ) ) return std::string ( "n/a" );
+
+        std::sort ( values.begin ( ), values.end ( ) );
+        double mean = std::accumulate ( values.begin ( ), values.end ( ), 0.0 ) / values.size ( );
+        double median = values[values.size ( ) / 2];
+        double p95 = values[std::min ( values.size ( ) - 1, static_cast<size_t> ( values.size ( ) * 0.95 ) )];
+
+        return "mean " + std::to_string ( mean ) + "ms, median " + std::to_string ( median ) + "ms, p95 " + std::to_string ( p95 ) + "ms";
+    };
+
+    console ( ) << label << " (" << results.ready.size ( ) << " opens)" << std::endl;
+    console ( ) << "    Create  : " << summarise ( results.create ) << std::endl;
+    console ( ) << "    OnReady : " << summarise ( results.ready ) << std::endl;
+}
+
+void BundleBenchmarkApp::update ( )
+{
+    if ( _player && _timer.getSeconds ( ) > kTimeout )
+    {
+        console ( ) << "Timed out waiting for " << _current.name << std::endl;
+        startNextJob ( );
+    }
+}
+
+void BundleBenchmarkApp::draw ( )
+{
+    gl::clear ( Colorf::black ( ) );
+    gl::drawString ( _status, vec2 ( 20.0f, 20.0f ) );
+}
+
+void Init ( App::Settings * settings )
+{
+#ifdef CINDER_MSW
+    settings->setConsoleWindowEnabled ( );
+#endif
+}
+
+CINDER_APP ( BundleBenchmarkApp, RendererGl ( RendererGl::Options ( ) ), Init );
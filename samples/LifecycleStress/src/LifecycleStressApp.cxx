@@ -0,0 +1,434 @@
+//
+//  LifecycleStressApp.cxx
+//  LifecycleStressApp
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive
+//
+
+#include "cinder/app/RendererGl.h"
+#include "cinder/app/App.h"
+#include "cinder/gl/gl.h"
+#include "cinder/Rand.h"
+#include "cinder/Timer.h"
+#include "AX-MediaPlayer.h"
+#include "AX-MediaPlayerReaper.h"
+
+#include <map>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+
+#ifdef CINDER_MSW
+    #include <windows.h>
+#endif
+
+using namespace ci;
+using namespace ci::app;
+
+// Drop a clip onto the window (or pass one on the command line). Worker threads create, play,
+// seek and destroy audio only players as fast as they can with random gaps, which is what
+// hammers the AutoInitialize ref count, while the main thread keeps a handful of video players
+// (hardware and CPU) churning through the same lifecycle, since those need the GL thread.
+// Every call is timed, the worst gap between two main thread updates is the stall, and once
+// everything is gone the live object counts, decoded frame memory and process handles are
+// checked for leaks. The report is printed and, with --out, written as JSON.
+//
+//  LifecycleStressApp <clip> [--players <n>] [--threads <n>] [--live <n>] [--out <report.json>] [--quit]
+
+class LifecycleStressApp : public app::App
+{
+public:
+    void setup ( ) override;
+    void update ( ) override;
+    void draw ( ) override;
+    void fileDrop ( FileDropEvent event ) override;
+    void cleanup ( ) override;
+
+protected:
+
+    // Power of two buckets from 0.125ms, everything past the last is in the last
+    struct Histogram
+    {
+        static constexpr size_t kBuckets = 14;
+
+        std::vector<double>             samples;
+        std::array<uint64_t, kBuckets>  buckets{ };
+
+        void Add ( double ms )
+        {
+            samples.push_back ( ms );
+            size_t bucket = 0;
+            for ( double edge = 0.125; ms >= edge && bucket < kBuckets - 1; edge *= 2.0 ) bucket++;
+            buckets[bucket]++;
+        }
+    };
+
+    struct VideoPlayer
+    {
+        AX::Video::MediaPlayerRef   player;
+        double                      createdAt{ 0.0 };
+        double                      nextActionAt{ 0.0 };
+        double                      destroyAt{ 0.0 };
+        bool                        ready{ false };
+    };
+
+    void startStress ( const fs::path & clip );
+    void workerLoop ( uint32_t seed );
+    void updateVideoPlayers ( double now );
+    void record ( const std::string & op, double ms );
+    void report ( );
+
+    template <typename Function>
+    auto timed ( const std::string & op, Function && function )
+    {
+        Timer timer{ true };
+        auto result = function ( );
+        record ( op, timer.getSeconds ( ) * 1000.0 );
+        return result;
+    }
+
+    static int64_t processHandleCount ( );
+
+    fs::path                    _clip;
+    fs::path                    _output;
+    size_t                      _targetPlayers{ 2000 };
+    size_t                      _threadCount{ 4 };
+    size_t                      _maxLiveVideo{ 8 };
+    bool                        _quitWhenDone{ false };
+
+    std::vector<std::thread>    _workers;
+    std::atomic_bool            _running{ false };
+    std::atomic<size_t>         _created{ 0 };
+    std::atomic<size_t>         _failed{ 0 };
+
+    std::vector<VideoPlayer>    _videoPlayers;
+    Rand                        _rand;
+    Timer                       _clock{ true };
+    double                      _lastUpdate{ -1.0 };
+    double                      _worstStall{ 0.0 };
+    double                      _startedAt{ 0.0 };
+    int64_t                     _baselineHandles{ 0 };
+    int                         _settleFrames{ 0 };
+
+    std::mutex                  _statsMutex;
+    std::map<std::string, Histogram> _stats;
+    std::string                 _status{ "Drop a clip to start" };
+
+    static constexpr int        kSettleFrames = 60;
+    static constexpr int64_t    kHandleSlack = 64;      // MediaFoundation keeps a few worker threads around after shutdown
+};
+
+void LifecycleStressApp::setup ( )
+{
+    auto & args = getCommandLineArgs ( );
+    fs::path clip;
+
+    for ( size_t i = 1; i < args.size ( ); i++ )
+    {
+        const std::string & arg = args[i];
+        bool hasValue = i + 1 < args.size ( );
+
+        if ( arg == "--players" && hasValue ) _targetPlayers = std::stoul ( args[++i] );
+        else if ( arg == "--threads" && hasValue ) _threadCount = std::stoul ( args[++i] );
+        else if ( arg == "--live" && hasValue ) _maxLiveVideo = std::stoul ( args[++i] );
+        else if ( arg == "--out" && hasValue ) _output = args[++i];
+        else if ( arg == "--quit" ) _quitWhenDone = true;
+        else clip = arg;
+    }
+
+    if ( !clip.empty ( ) && fs::is_regular_file ( clip ) ) startStress ( clip );
+}
+
+void LifecycleStressApp::fileDrop ( FileDropEvent event )
+{
+    if ( !_running && fs::is_regular_file ( event.getFile ( 0 ) ) ) startStress ( event.getFile ( 0 ) );
+}
+
+void LifecycleStressApp::startStress ( const fs::path & clip )
+{
+    // Taken before the first player so MediaFoundation's own startup shows up if it's never undone
+    _baselineHandles = processHandleCount ( );
+
+    _clip = clip;
+    _created = 0;
+    _failed = 0;
+    _worstStall = 0.0;
+    _settleFrames = 0;
+    _stats.clear ( );
+    _startedAt = _clock.getSeconds ( );
+    _running = true;
+
+    for ( size_t i = 0; i < _threadCount; i++ )
+    {
+        _workers.emplace_back ( [=] { workerLoop ( static_cast<uint32_t> ( i + 1 ) ); } );
+    }
+}
+
+void LifecycleStressApp::workerLoop ( uint32_t seed )
+{
+    Rand rand ( seed );
+    auto fmt = AX::Video::MediaPlayer::Format ( ).AudioOnly ( true ).Audio ( false ).AutoInitialize ( true );
+    auto pause = [&] ( float maxMs ) { std::this_thread::sleep_for ( std::chrono::microseconds ( static_cast<int> ( rand.nextFloat ( maxMs ) * 1000.0f ) ) ); };
+
+    while ( _running && _created.fetch_add ( 1 ) < _targetPlayers )
+    {
+        try
+        {
+            auto player = timed ( "create.audio", [&] { return AX::Video::MediaPlayer::Create ( _clip, fmt ); } );
+            if ( !player )
+            {
+                _failed++;
+                continue;
+            }
+
+            // Anywhere from straight away (before the engine has even opened the file) to well after
+            pause ( 20.0f );
+            timed ( "play.audio", [&] { player->Play ( ); return true; } );
+
+            const int seeks = rand.nextInt ( 4 );
+            for ( int i = 0; i < seeks; i++ )
+            {
+                pause ( 10.0f );
+                timed ( "seek.audio", [&] { player->SeekToPercentage ( rand.nextFloat ( ), rand.nextBool ( ) ); return true; } );
+            }
+
+            if ( rand.nextBool ( ) )
+            {
+                pause ( 5.0f );
+                timed ( "pause.audio", [&] { player->Pause ( ); return true; } );
+            }
+
+            pause ( 20.0f );
+            timed ( "destroy.audio", [&] { player = nullptr; return true; } );
+        }
+        catch ( const std::exception & e )
+        {
+            _failed++;
+            std::cout << "Error: " << e.what ( ) << std::endl;
+        }
+    }
+}
+
+void LifecycleStressApp::updateVideoPlayers ( double now )
+{
+    // Retire whatever's due first so there's room for new ones this frame
+    for ( auto it = _videoPlayers.begin ( ); it != _videoPlayers.end ( ); )
+    {
+        if ( now >= it->destroyAt )
+        {
+            timed ( "destroy.video", [&] { it->player = nullptr; return true; } );
+            it = _videoPlayers.erase ( it );
+            continue;
+        }
+
+        if ( now >= it->nextActionAt )
+        {
+            auto & player = it->player;
+            switch ( _rand.nextInt ( 4 ) )
+            {
+                case 0: timed ( "play.video", [&] { player->Play ( ); return true; } ); break;
+                case 1: timed ( "pause.video", [&] { player->Pause ( ); return true; } ); break;
+                default: timed ( "seek.video", [&] { player->SeekToPercentage ( _rand.nextFloat ( ), _rand.nextBool ( ) ); return true; } ); break;
+            }
+
+            it->nextActionAt = now + _rand.nextFloat ( 0.01f, 0.25f );
+        }
+
+        ++it;
+    }
+
+    while ( _running && _videoPlayers.size ( ) < _maxLiveVideo && _created.fetch_add ( 1 ) < _targetPlayers )
+    {
+        auto fmt = AX::Video::MediaPlayer::Format ( ).Audio ( false ).AutoInitialize ( true ).HardwareAccelerated ( _rand.nextBool ( ) );
+
+        VideoPlayer entry;
+        try
+        {
+            entry.player = timed ( "create.video", [&] { return AX::Video::MediaPlayer::Create ( _clip, fmt ); } );
+        }
+        catch ( const std::exception & e )
+        {
+            std::cout << "Error: " << e.what ( ) << std::endl;
+        }
+
+        if ( !entry.player )
+        {
+            _failed++;
+            continue;
+        }
+
+        entry.createdAt = now;
+        entry.nextActionAt = now + _rand.nextFloat ( 0.0f, 0.1f );
+        entry.destroyAt = now + _rand.nextFloat ( 0.05f, 2.0f );
+
+        // Entries move as others are erased, so find it again rather than holding on to it
+        auto * raw = entry.player.get ( );
+        entry.player->OnReady.connect ( [=]
+        {
+            auto self = std::find_if ( _videoPlayers.begin ( ), _videoPlayers.end ( ), [=] ( const VideoPlayer & v ) { return v.player.get ( ) == raw; } );
+            if ( self == _videoPlayers.end ( ) ) return;
+
+            self->ready = true;
+            record ( "ready.video", ( _clock.getSeconds ( ) - self->createdAt ) * 1000.0 );
+        } );
+
+        _videoPlayers.push_back ( std::move ( entry ) );
+    }
+}
+
+void LifecycleStressApp::record ( const std::string & op, double ms )
+{
+    std::unique_lock<std::mutex> lk ( _statsMutex );
+    _stats[op].Add ( ms );
+}
+
+void LifecycleStressApp::update ( )
+{
+    const double now = _clock.getSeconds ( );
+    if ( _running && _lastUpdate >= 0.0 ) _worstStall = std::max ( _worstStall, now - _lastUpdate );
+    _lastUpdate = now;
+
+    if ( !_running ) return;
+
+    updateVideoPlayers ( now );
+
+    const size_t created = std::min ( _created.load ( ), _targetPlayers );
+    _status = std::to_string ( created ) + " / " + std::to_string ( _targetPlayers ) + " players, "
+            + std::to_string ( AX::Video::LiveObjects::GetStats ( ).Live ( AX::Video::LiveObjects::Kind::Players ) ) + " alive";
+
+    if ( created < _targetPlayers || !_videoPlayers.empty ( ) ) return;
+
+    // Everyone's been created, wait for the workers' last players and the background teardown
+    // of all of them, then give the engines' own threads a moment to wind down before counting
+    if ( _settleFrames++ == 0 )
+    {
+        for ( auto & worker : _workers ) worker.join ( );
+        _workers.clear ( );
+
+        timed ( "teardown.wait", [&] { AX::Video::MediaPlayer::WaitForPendingDestruction ( ); return true; } );
+    }
+
+    if ( _settleFrames >= kSettleFrames )
+    {
+        _running = false;
+        report ( );
+        if ( _quitWhenDone ) quit ( );
+    }
+}
+
+void LifecycleStressApp::report ( )
+{
+    using Kind = AX::Video::LiveObjects::Kind;
+    const auto live = AX::Video::LiveObjects::GetStats ( );
+    const auto memory = AX::Video::MemoryBudget::Shared ( ).GetStats ( );
+    const auto teardown = AX::Video::Reaper::Shared ( ).GetStats ( );
+    const int64_t handleDelta = processHandleCount ( ) - _baselineHandles;
+    const bool handlesOk = _baselineHandles == 0 || handleDelta <= kHandleSlack;
+    const bool ok = live.IsClean ( ) && memory.used == 0 && teardown.pending == 0 && handlesOk && live.Peak ( Kind::MediaFoundation ) <= 1;
+
+    auto percentile = [] ( std::vector<double> values, double p )
+    {
+        if ( values.empty ( ) ) return 0.0;
+        std::sort ( values.begin ( ), values.end ( ) );
+        return values[std::min ( values.size ( ) - 1, static_cast<size_t> ( p * ( values.size ( ) - 1 ) + 0.5 ) )];
+    };
+
+    std::ostringstream json;
+    json << "{\n"
+         << "  \"clip\": \"" << _clip.generic_string ( ) << "\",\n"
+         << "  \"players\": " << std::min ( _created.load ( ), _targetPlayers ) << ", \"failed\": " << _failed.load ( )
+         << ", \"threads\": " << _threadCount << ", \"seconds\": " << _clock.getSeconds ( ) - _startedAt << ",\n"
+         << "  \"worstMainThreadStallMs\": " << _worstStall * 1000.0 << ",\n"
+         << "  \"operations\": {\n";
+
+    {
+        std::unique_lock<std::mutex> lk ( _statsMutex );
+        size_t n = 0;
+        for ( auto & [op, histogram] : _stats )
+        {
+            const auto & s = histogram.samples;
+            json << "    \"" << op << "\": { \"count\": " << s.size ( )
+                 << ", \"p50\": " << percentile ( s, 0.5 ) << ", \"p90\": " << percentile ( s, 0.9 )
+                 << ", \"p99\": " << percentile ( s, 0.99 ) << ", \"max\": " << ( s.empty ( ) ? 0.0 : *std::max_element ( s.begin ( ), s.end ( ) ) )
+                 << ", \"bucketsFromEighthMs\": [";
+            for ( size_t i = 0; i < histogram.buckets.size ( ); i++ ) json << ( i ? ", " : "" ) << histogram.buckets[i];
+            json << "] }" << ( ++n < _stats.size ( ) ? "," : "" ) << "\n";
+        }
+    }
+
+    json << "  },\n  \"live\": {\n";
+    for ( size_t i = 0; i < AX::Video::LiveObjects::kNumKinds; i++ )
+    {
+        json << "    \"" << AX::Video::LiveObjects::KindToString ( static_cast<Kind> ( i ) ) << "\": { \"live\": " << live.live[i]
+             << ", \"peak\": " << live.peak[i] << ", \"created\": " << live.created[i] << " }"
+             << ( i + 1 < AX::Video::LiveObjects::kNumKinds ? "," : "" ) << "\n";
+    }
+
+    json << "  },\n"
+         << "  \"frameMemory\": { \"used\": " << memory.used << ", \"peak\": " << memory.peak << ", \"accounts\": " << memory.accounts << " },\n"
+         << "  \"backgroundTeardown\": { \"completed\": " << teardown.completed << ", \"pending\": " << teardown.pending
+         << ", \"worstMs\": " << teardown.worstShutdownSeconds * 1000.0 << ", \"totalMs\": " << teardown.totalShutdownSeconds * 1000.0 << " },\n"
+         << "  \"handles\": { \"baseline\": " << _baselineHandles << ", \"delta\": " << handleDelta << " },\n"
+         << "  \"ok\": " << ( ok ? "true" : "false" ) << "\n"
+         << "}\n";
+
+    console ( ) << json.str ( );
+    if ( !_output.empty ( ) ) std::ofstream ( _output, std::ios::trunc ) << json.str ( );
+
+    _status = ok ? "Done, no leaks. See console" : "Done, LEAKS FOUND. See console";
+}
+
+int64_t LifecycleStressApp::processHandleCount ( )
+{
+#ifdef CINDER_MSW
+    DWORD count = 0;
+    if ( GetProcessHandleCount ( GetCurrentProcess ( ), &count ) ) return static_cast<int64_t> ( count );
+#endif
+    return 0;
+}
+
+void LifecycleStressApp::cleanup ( )
+{
+    _running = false;
+    for ( auto & worker : _workers ) worker.join ( );
+    _workers.clear ( );
+    _videoPlayers.clear ( );
+    AX::Video::MediaPlayer::WaitForPendingDestruction ( );
+}
+
+void LifecycleStressApp::draw ( )
+{
+    gl::clear ( Colorf::black ( ) );
+
+    // Leases are part of the lifecycle too, a player can be let go of with one just released
+    const size_t columns = 4;
+    const vec2 cell = vec2 ( getWindowSize ( ) ) / vec2 ( columns, 2 );
+    for ( size_t i = 0; i < _videoPlayers.size ( ); i++ )
+    {
+        if ( !_videoPlayers[i].ready ) continue;
+        auto lease = _videoPlayers[i].player->GetTexture ( );
+        if ( lease && lease->IsValid ( ) )
+        {
+            const vec2 origin = cell * vec2 ( i % columns, ( i / columns ) % 2 );
+            gl::draw ( lease->ToTexture ( ), Rectf ( origin, origin + cell ) );
+        }
+    }
+
+    gl::drawString ( _status, vec2 ( 20.0f, 20.0f ) );
+}
+
+void Init ( App::Settings * settings )
+{
+#ifdef CINDER_MSW
+    settings->setConsoleWindowEnabled ( );
+#endif
+    settings->setFrameRate ( 60.0f );
+}
+
+CINDER_APP ( LifecycleStressApp, RendererGl ( RendererGl::Options ( ) ), Init );
@@ -42,6 +42,7 @@ public:
     void draw ( ) override;
     void fileDrop ( FileDropEvent event ) override;
     void keyDown( KeyEvent event ) override;
+    void cleanup ( ) override;
 
 protected:
     void connectSignals();
@@ -100,6 +101,7 @@ void SimplePlaybackApp::connectSignals()
     _player->OnSeekStart.connect( [=] { std::cout << "OnSeekStart\n"; } );
     _player->OnSeekEnd.connect( [=] { std::cout << "OnSeekEnd\n"; } );
     _player->OnComplete.connect( [=] { std::cout << "OnComplete\n"; } );
+    _player->OnLoop.connect( [=] { std::cout << "OnLoop\n"; } );
     _player->OnReady.connect( [=] { std::cout << "OnReady: " << _player->GetDurationInSeconds() << std::endl; } );
     _player->OnError.connect( [=] ( AX::Video::MediaPlayer::Error error ) { _error = error; } );
     _player->OnBufferingStart.connect( [=] { std::cout << "OnBufferingStart\n"; } );
@@ -110,6 +112,14 @@ void SimplePlaybackApp::update ( )
 {
 }
 
+void SimplePlaybackApp::cleanup ( )
+{
+    // The player finishes tearing down in the background, let it while there's still a GL context
+    _texture = nullptr;
+    _player = nullptr;
+    AX::Video::MediaPlayer::WaitForPendingDestruction ( );
+}
+
 #ifdef HAS_DEBUG_UI
 struct ScopedWindow2
 {
@@ -8,11 +8,23 @@
 //
 
 #include "AX-MediaPlayer.h"
+#include "AX-MediaPlayerBundle.h"
+#include "AX-MediaPlayerSharedSession.h"
+#include "AX-MediaPlayerOfflineReader.h"
+#include "AX-MediaPlayerLoopPreroll.h"
+#include "AX-MediaPlayerAudioNode.h"
+#include "AX-MediaPlayerAudioPeaks.h"
+#include "AX-MediaPlayerFrameSink.h"
+#include "AX-MediaPlayerReaper.h"
 #include "cinder/app/App.h"
+#include "cinder/Log.h"
 #include "cinder/audio/Device.h"
+#include "cinder/audio/Context.h"
 
+#include <mutex>
 #include <cstdint>
 #include <iostream>
+#include <algorithm>
 #include <unordered_map>
 
 #ifdef WIN32
@@ -23,10 +35,75 @@
 
 using namespace ci;
 
+namespace
+{
+    using namespace AX::Video;
+
+    // Frames a player for `filePath` will hold, from the header without opening it
+    uint64_t EstimateFrameMemory ( const fs::path & filePath, const MediaPlayer::Format & fmt )
+    {
+        if ( fmt.IsAudioOnly ( ) || filePath.empty ( ) ) return 0;
+
+        auto info = ProbeMedia ( filePath );
+        if ( !info.hasVideo ) return 0;
+
+        size_t slots = 1;
+        if ( fmt.IsPresentationSyncEnabled ( ) ) slots = std::max<size_t> ( 4, fmt.PresentationOptions ( ).GetQueueDepth ( ) );
+        else if ( fmt.IsBackgroundTransferEnabled ( ) ) slots = 3;
+
+        return static_cast<uint64_t> ( info.width ) * info.height * 4 * slots;
+    }
+
+    // The estimate stays reserved until the player's real allocation replaces it
+    MemoryBudget::AccountRef AdmitPlayer ( uint64_t bytes, const std::string & name )
+    {
+        if ( auto reservation = MemoryBudget::Shared ( ).Admit ( bytes ) ) return reservation;
+
+        CI_LOG_W ( "Over the memory budget, not opening " << name );
+        return nullptr;
+    }
+
+    // Teardown finishes on the main thread, it's woken whenever there's some to finish
+    void RetireImpl ( std::shared_ptr<MediaPlayer::Impl> impl )
+    {
+        static std::once_flag once;
+        std::call_once ( once, [ ]
+        {
+            Reaper::Shared ( ).SetWaker ( [ ]
+            {
+                if ( auto app = app::App::get ( ) )
+                {
+                    app->dispatchAsync ( [ ] { Reaper::Shared ( ).DrainGLThread ( ); } );
+                }
+            } );
+        } );
+
+        impl->Detach ( );
+        Reaper::Shared ( ).Retire ( [impl] ( Reaper::Task done ) { impl->Shutdown ( std::move ( done ) ); }, [impl] ( ) mutable { impl = nullptr; } );
+    }
+
+    void WatchMemoryPressure ( )
+    {
+        static std::once_flag once;
+        std::call_once ( once, [ ]
+        {
+            MemoryBudget::Shared ( ).SetListener ( [ ] ( MemoryBudget::Pressure pressure )
+            {
+                if ( auto app = app::App::get ( ) )
+                {
+                    app->dispatchAsync ( [pressure] { MediaPlayer::OnMemoryPressure.emit ( pressure ); } );
+                }
+            } );
+        } );
+    }
+}
+
 namespace AX
 {
     namespace Video
     {
+        MediaPlayer::PressureSignal MediaPlayer::OnMemoryPressure;
+
         const std::string & MediaPlayer::ErrorToString ( MediaPlayer::Error error )
         {
             static std::unordered_map<MediaPlayer::Error, std::string> kErrors =
@@ -63,44 +140,420 @@ namespace AX
 
         void MediaPlayer::StaticShutdown ( )
         {
+            // MediaFoundation has to outlive every engine still shutting down
+            WaitForPendingDestruction ( );
             MediaPlayer::Impl::StaticShutdown ( );
         }
 
+        void MediaPlayer::WaitForPendingDestruction ( )
+        {
+            Reaper::Shared ( ).WaitForPending ( app::isMainThread ( ) );
+        }
+
+        AudioPeaksRef MediaPlayer::ComputeAudioPeaks ( const ci::fs::path & source, float binsPerSecond, const ci::fs::path & peakFile )
+        {
+            return AudioPeaks::Compute ( source, binsPerSecond, peakFile );
+        }
+
+        MediaInfo MediaPlayer::Probe ( const ci::fs::path & filePath )
+        {
+            return ProbeMedia ( filePath );
+        }
+
+        void MediaPlayer::CreateWhenAvailable ( const ci::fs::path & filePath, const Format & fmt, const std::function<void ( MediaPlayerRef )> & callback )
+        {
+            WatchMemoryPressure ( );
+            MemoryBudget::Shared ( ).Defer ( EstimateFrameMemory ( filePath, fmt ), [=]
+            {
+                auto app = app::App::get ( );
+                if ( !app ) return;
+
+                app->dispatchAsync ( [=]
+                {
+                    auto player = MediaPlayer::Create ( filePath, fmt );
+
+                    // Something else took the room between being let through and getting here, back in line
+                    if ( !player && MemoryBudget::Shared ( ).GetPressure ( ) == MemoryBudget::Pressure::Refuse )
+                    {
+                        CreateWhenAvailable ( filePath, fmt, callback );
+                        return;
+                    }
+
+                    if ( callback ) callback ( player );
+                } );
+            } );
+        }
+
         MediaPlayerRef MediaPlayer::Create ( const ci::DataSourceRef & source, const MediaPlayer::Format& fmt )
         {
-            return MediaPlayerRef ( new MediaPlayer ( source, fmt ) );
+            if ( source && source->isUrl ( ) && MediaBundle::IsBundleUrl ( source->getUrl ( ).str ( ) ) )
+            {
+                return MediaPlayer::Create ( MediaBundle::Resolve ( source->getUrl ( ).str ( ) ), fmt );
+            }
+
+            if ( fmt.IsOfflineEnabled ( ) )
+            {
+                if ( source && source->isFilePath ( ) ) return MediaPlayerRef ( new MediaPlayer ( source, fmt ) );
+
+                CI_LOG_E ( "Offline players need a local file, falling back to real time playback" );
+                return MediaPlayer::Create ( source, Format ( fmt ).Offline ( false ) );
+            }
+
+            if ( fmt.IsSharedSessionEnabled ( ) )
+            {
+                auto key = SharedSession::MakeKey ( source, fmt );
+                if ( !key.empty ( ) )
+                {
+                    auto decoderFormat = Format ( fmt ).SharedSession ( false );
+                    auto session = SharedSession::Attach ( key, [&] { return MediaPlayer::Create ( source, decoderFormat ); } );
+                    return session ? MediaPlayerRef ( new MediaPlayer ( session ) ) : nullptr;
+                }
+            }
+
+            WatchMemoryPressure ( );
+            MemoryBudget::AccountRef reservation;
+            if ( MemoryBudget::Shared ( ).IsEnabled ( ) )
+            {
+                const bool local = source && source->isFilePath ( );
+                const uint64_t bytes = local ? EstimateFrameMemory ( source->getFilePath ( ), fmt ) : 0;
+                reservation = AdmitPlayer ( bytes, local ? source->getFilePath ( ).string ( ) : ( source ? source->getUrl ( ).str ( ) : std::string ( ) ) );
+                if ( !reservation ) return nullptr;
+            }
+
+            // Already admitted, so these skip the byte source Create ( ) and take the reservation with them
+            if ( source && source->isUrl ( ) && fmt.IsHttpCacheEnabled ( ) && Impl::CanStreamByteSources ( ) )
+            {
+                if ( auto http = HttpByteSource::Create ( source->getUrl ( ).str ( ), fmt.HttpCacheOptions ( ) ) )
+                {
+                    return MediaPlayerRef ( new MediaPlayer ( http, fmt, std::move ( reservation ) ) );
+                }
+            }
+
+            if ( source && source->isFilePath ( ) && fmt.IsReadAheadEnabled ( ) && Impl::CanStreamByteSources ( ) )
+            {
+                if ( auto readAhead = ReadAheadByteSource::Create ( source->getFilePath ( ), fmt.ReadAheadOptions ( ) ) )
+                {
+                    return MediaPlayerRef ( new MediaPlayer ( readAhead, fmt, std::move ( reservation ) ) );
+                }
+            }
+
+            return MediaPlayerRef ( new MediaPlayer ( source, fmt, std::move ( reservation ) ) );
         }
 
         MediaPlayerRef MediaPlayer::Create ( const ci::fs::path & filePath, const Format & fmt )
         {
+            if ( MediaBundle::IsBundleUrl ( filePath.generic_string ( ) ) )
+            {
+                return MediaPlayer::Create ( MediaBundle::Resolve ( filePath.generic_string ( ) ), fmt );
+            }
+
             if ( !fs::exists ( filePath ) ) return nullptr;
             return MediaPlayer::Create ( loadFile ( filePath ), fmt );
         }
 
-        MediaPlayer::MediaPlayer ( const ci::DataSourceRef & source, const Format& fmt )
+        MediaPlayerRef MediaPlayer::Create ( const ByteSourceRef & source, const Format & fmt )
+        {
+            if ( !source ) return nullptr;
+
+            // Byte sources can't be probed up front, so they're only turned away once already over
+            WatchMemoryPressure ( );
+            auto reservation = AdmitPlayer ( 0, source->Name ( ) );
+            if ( !reservation ) return nullptr;
+            return MediaPlayerRef ( new MediaPlayer ( source, fmt, std::move ( reservation ) ) );
+        }
+
+        MediaPlayer::MediaPlayer ( const ci::DataSourceRef & source, const Format& fmt, MemoryBudget::AccountRef reservation )
             : _format ( fmt )
         {
-            _impl = std::make_unique<Impl> ( *this, source, _format );
-            _updateConnection = app::App::get ( )->getSignalUpdate ( ).connect ( [=] { Update ( ); } );
+            if ( _format.IsOfflineEnabled ( ) )
+            {
+                _offline = OfflineReader::Create ( source->getFilePath ( ), _format.StreamingUploadOptions ( ) );
+                if ( _offline )
+                {
+                    // The engine is still there for events and the rest of the API
+                    // but it never renders video or plays audio, the reader does all the work.
+                    _impl = std::make_shared<Impl> ( *this, source, Format ( _format ).AudioOnly ( true ).Audio ( false ) );
+                    ConnectUpdate ( );
+                    return;
+                }
+
+                _format.Offline ( false );
+            }
+
+            CreateAudioNode ( );
+            CreateLoop ( source );
+            _impl = std::make_shared<Impl> ( *this, source, _format, nullptr, std::move ( reservation ) );
+            ConnectUpdate ( );
+        }
+
+        MediaPlayer::MediaPlayer ( const ByteSourceRef & source, const Format& fmt, MemoryBudget::AccountRef reservation )
+            : _format ( fmt )
+            , _byteSource ( source )
+        {
+            if ( auto readAhead = std::dynamic_pointer_cast<ReadAheadByteSource> ( source ) )
+            {
+                // The seconds based window can't be sized until we know the duration
+                OnReady.connect ( [=] { readAhead->SetDurationHint ( GetDurationInSeconds ( ) ); } );
+            }
+
+            CreateAudioNode ( );
+            CreateLoop ( nullptr );
+            _impl = std::make_shared<Impl> ( *this, nullptr, _format, source, std::move ( reservation ) );
+            ConnectUpdate ( );
+        }
+
+        MediaPlayer::MediaPlayer ( const std::shared_ptr<SharedSession> & session )
+            : _session ( session )
+        {
+            // Shares the decoder's Impl rather than wrapping every call. The decoder
+            // owns the update connection and the buffering state, this player just has a view of it.
+            auto & decoder = _session->GetDecoder ( );
+            _format         = decoder->_format;
+            _byteSource     = decoder->_byteSource;
+            _audioNode      = decoder->_audioNode;
+            _impl           = decoder->_impl;
+            _sessionFrame   = _session->GetFrameSerial ( );
+            _session->Join ( this );
+
+            auto forward = [&] ( EventSignal & from, EventSignal & to )
+            {
+                _sessionConnections.push_back ( from.connect ( [&to] { to.emit ( ); } ) );
+            };
+
+            forward ( decoder->OnReady, OnReady );
+            forward ( decoder->OnComplete, OnComplete );
+            forward ( decoder->OnLoop, OnLoop );
+            forward ( decoder->OnPlay, OnPlay );
+            forward ( decoder->OnPause, OnPause );
+            forward ( decoder->OnSeekStart, OnSeekStart );
+            forward ( decoder->OnSeekEnd, OnSeekEnd );
+            forward ( decoder->OnBufferingStart, OnBufferingStart );
+            forward ( decoder->OnBufferingEnd, OnBufferingEnd );
+            _sessionConnections.push_back ( decoder->OnError.connect ( [this] ( Error error ) { OnError.emit ( error ); } ) );
+        }
+
+        void MediaPlayer::CreateAudioNode ( )
+        {
+            if ( _format.IsAudioEnabled ( ) && _format.IsAudioTapEnabled ( ) )
+            {
+                _audioNode = audio::master ( )->makeNode ( new AudioNode ( _format.AudioTapChannels ( ), _format.AudioTapRingSeconds ( ) ) );
+            }
+        }
+
+        void MediaPlayer::CreateLoop ( const ci::DataSourceRef & source )
+        {
+            if ( _format.IsSeamlessLoopEnabled ( ) && !_format.IsAudioOnly ( ) )
+            {
+                if ( source && source->isFilePath ( ) )
+                {
+                    _preroll = LoopPreroll::Create ( source->getFilePath ( ), _format.StreamingUploadOptions ( ) );
+                }
+                else
+                {
+                    CI_LOG_W ( "Seamless loops pre-roll from a local file, this player's wraps will wait on the seek" );
+                }
+            }
+
+            _loop = std::make_unique<LoopScheduler> ( _preroll != nullptr, _format.SeamlessLoopOptions ( ) );
+        }
+
+        void MediaPlayer::ConnectUpdate ( )
+        {
+            if ( _updateConnection.isConnected ( ) ) return;
+
+            // Audio only players with nothing to poll stay off the update signal
+            // entirely, so hundreds of them cost nothing per frame. Looping ones are ticked since
+            // that's where loops are noticed (and made, with loop points).
+            bool needsUpdate = _impl->NeedsUpdate ( ) || _format.GetBufferPolicy ( ).IsEnabled ( ) || std::dynamic_pointer_cast<HttpByteSource> ( _byteSource );
+            needsUpdate = needsUpdate || ( _loop && _loop->IsLooping ( ) );
+            if ( needsUpdate )
+            {
+                _updateConnection = app::App::get ( )->getSignalUpdate ( ).connect ( [=] { Update ( ); } );
+            }
         }
 
         bool MediaPlayer::Update ( )
         {
-            return _impl->Update ( );
+            bool result = _impl->Update ( );
+            UpdateBuffering ( );
+            UpdateLoop ( );
+            return result;
+        }
+
+        void MediaPlayer::UpdateLoop ( )
+        {
+            if ( !_loop || ( !_loop->IsLooping ( ) && !_loop->IsBridging ( ) ) ) return;
+
+            const auto state = _impl->GetState ( );
+            _loop->SetDuration ( state.duration );
+
+            // An audio tap decodes its own audio, so it wraps at the out point by itself instead of
+            // waiting on the engine's seek (which is a gap in the audio, however well it's hidden)
+            if ( _loop->IsWrapping ( ) ) _impl->SetAudioLoop ( _loop->GetIn ( ), _loop->GetOut ( ) );
+
+            if ( _preroll )
+            {
+                // Frames a wrap is showing aren't swapped out from under it
+                double in = 0.0, resume = 0.0;
+                std::vector<double> pts;
+                if ( !_loop->IsBridging ( ) && _preroll->Poll ( in, pts, resume ) )
+                {
+                    _loop->SetPreroll ( in, pts.data ( ), pts.size ( ), resume );
+                }
+
+                if ( _loop->WantsPreroll ( ) )
+                {
+                    _preroll->Request ( _loop->GetIn ( ), _loop->GetPrerollEnd ( ), _loop->GetOptions ( ).GetMaxPrerollFrames ( ) );
+                    _loop->BeginPreroll ( );
+                }
+            }
+
+            LoopScheduler::Playhead playhead;
+            playhead.position = state.position;
+            playhead.framePts = state.hasVideo ? state.framePts : -1.0;
+            playhead.rate = state.rate;
+            playhead.playing = !state.paused;
+            playhead.seeking = state.seeking;
+            playhead.complete = state.complete;
+
+            switch ( _loop->Tick ( app::getElapsedSeconds ( ), playhead ) )
+            {
+                case LoopScheduler::Action::Wrap:
+                {
+                    // Never paused, so the audio carries on. Play ( ) is for an engine that ran into the end of the clip.
+                    _impl->SeekToSeconds ( static_cast<float> ( _loop->GetSeekTarget ( ) ), false );
+                    _impl->Play ( );
+                    break;
+                }
+
+                default: break;
+            }
+
+            if ( _preroll && _preroll->Select ( _loop->GetBridgeFrame ( ) ) )
+            {
+                // Stands in for a frame from the engine, so it goes wherever those would
+                auto & sinks = _impl->GetFrameSinks ( );
+                if ( sinks.HasSinks ( FrameSink::Thread::Main ) ) sinks.Dispatch ( _preroll->GetFrame ( ), FrameSink::Thread::Main );
+            }
+
+            if ( _loop->TakeLoop ( ) ) OnLoop.emit ( );
+        }
+
+        void MediaPlayer::ApplyLoop ( )
+        {
+            // The engine only loops by itself when the wraps aren't being made here
+            _impl->SetLoop ( _loop->IsLooping ( ) && !_loop->IsWrapping ( ) );
+            if ( !_loop->IsWrapping ( ) ) _impl->SetAudioLoop ( 0.0, 0.0 );
+            ConnectUpdate ( );
+        }
+
+        void MediaPlayer::InterruptLoop ( )
+        {
+            if ( _loop ) _loop->Interrupt ( app::getElapsedSeconds ( ) );
+        }
+
+        bool MediaPlayer::IsBridgingLoop ( ) const
+        {
+            return _loop && _loop->IsBridging ( );
+        }
+
+        void MediaPlayer::UpdateBuffering ( )
+        {
+            auto & policy = _format.GetBufferPolicy ( );
+            auto http = std::dynamic_pointer_cast<HttpByteSource> ( _byteSource );
+
+            // A seamless wrap has the engine seeking on purpose, the pre-roll is covering for it
+            if ( IsBridgingLoop ( ) ) return;
+
+            if ( _holdingForBuffer )
+            {
+                float position = GetPositionInSeconds ( );
+                float duration = GetDurationInSeconds ( );
+                bool bufferedToEnd = IsReady ( ) && duration > 0.0f && position + GetBufferedSecondsAhead ( ) >= duration - 0.05f;
+
+                if ( IsReady ( ) && ( GetBufferedSecondsAhead ( ) >= _holdUntilSeconds || bufferedToEnd ) )
+                {
+                    EndHold ( );
+                    _impl->Play ( );
+                }
+
+                return;
+            }
+
+            bool stalled = http && http->IsStalled ( );
+            if ( policy.IsEnabled ( ) && _playRequested && IsPlaying ( ) && !IsComplete ( ) )
+            {
+                if ( stalled || GetBufferedSecondsAhead ( ) < 0.1f )
+                {
+                    _impl->Pause ( );
+                    BeginHold ( policy.GetResumeSeconds ( ) > 0.0f ? policy.GetResumeSeconds ( ) : policy.GetStartSeconds ( ) );
+                    _sourceWasStalled = stalled;
+                    return;
+                }
+            }
+
+            // The platform engines don't know our reads are blocked on the network, so report it for them
+            if ( http && stalled != _sourceWasStalled )
+            {
+                if ( stalled ) OnBufferingStart.emit ( ); else OnBufferingEnd.emit ( );
+            }
+
+            _sourceWasStalled = stalled;
+        }
+
+        void MediaPlayer::BeginHold ( float untilSeconds )
+        {
+            _holdingForBuffer = true;
+            _holdUntilSeconds = untilSeconds;
+            OnBufferingStart.emit ( );
+        }
+
+        void MediaPlayer::EndHold ( )
+        {
+            _holdingForBuffer = false;
+            OnBufferingEnd.emit ( );
         }
 
         void MediaPlayer::Play ( )
         {
+            if ( _session ) return _session->GetDecoder ( )->Play ( );
+            _playRequested = true;
+
+            // Already playing, the seamless wrap in progress carries on
+            if ( IsBridgingLoop ( ) ) return;
+
+            auto & policy = _format.GetBufferPolicy ( );
+            if ( policy.IsEnabled ( ) )
+            {
+                // Update ( ) starts playback once enough is buffered, which is also
+                // how a Play ( ) before the media is ready gets honoured
+                if ( !_holdingForBuffer ) BeginHold ( policy.GetStartSeconds ( ) );
+                UpdateBuffering ( );
+                return;
+            }
+
             _impl->Play ( );
         }
 
         void MediaPlayer::Pause ( )
         {
+            if ( _session ) return _session->GetDecoder ( )->Pause ( );
+            _playRequested = false;
+            InterruptLoop ( );
+            if ( _holdingForBuffer ) EndHold ( );
             _impl->Pause ( );
         }
 
         void MediaPlayer::TogglePlayback ( )
         {
+            if ( _session ) return _session->GetDecoder ( )->TogglePlayback ( );
+            if ( IsBridgingLoop ( ) ) return Pause ( );
+            if ( _format.GetBufferPolicy ( ).IsEnabled ( ) )
+            {
+                if ( _playRequested ) Pause ( ); else Play ( );
+                return;
+            }
+
             _impl->TogglePlayback ( );
         }
 
@@ -121,67 +574,193 @@ namespace AX
 
         void MediaPlayer::SetMuted ( bool mute )
         {
-            _impl->SetMuted ( mute );
+            if ( _session ) return _session->SetMuted ( this, mute );
+            if ( _audioNode )
+            {
+                _audioNode->SetMuted ( mute );
+            }
+            else
+            {
+                _impl->SetMuted ( mute );
+            }
         }
 
         bool MediaPlayer::IsMuted ( ) const
         {
+            if ( _session ) return _session->IsMuted ( this );
+            if ( _audioNode ) return _audioNode->IsMuted ( );
             return _impl->IsMuted ( );
         }
 
         void MediaPlayer::SetVolume ( float volume )
         {
-            _impl->SetVolume ( volume );
+            if ( _session ) return _session->SetVolume ( this, volume );
+            if ( _audioNode )
+            {
+                _audioNode->SetVolume ( volume );
+            }
+            else
+            {
+                _impl->SetVolume ( volume );
+            }
         }
 
         float MediaPlayer::GetVolume ( ) const
         {
+            if ( _session ) return _session->GetVolume ( this );
+            if ( _audioNode ) return _audioNode->GetVolume ( );
             return _impl->GetVolume ( );
         }
 
+        void MediaPlayer::SetVisible ( bool visible )
+        {
+            if ( _session ) return _session->SetVisible ( this, visible );
+            _visible = visible;
+        }
+
+        bool MediaPlayer::IsVisible ( ) const
+        {
+            if ( _session ) return _session->IsVisible ( this );
+            return _visible;
+        }
+
         void MediaPlayer::SetLoop ( bool loop )
         {
-            _impl->SetLoop ( loop );
+            if ( _session ) return _session->GetDecoder ( )->SetLoop ( loop );
+            if ( !_loop ) return _impl->SetLoop ( loop );
+
+            _loop->SetLooping ( loop );
+            ApplyLoop ( );
         }
 
         bool MediaPlayer::IsLooping ( ) const
         {
-            return _impl->IsLooping ( );
+            if ( _session ) return _session->GetDecoder ( )->IsLooping ( );
+            return _loop ? _loop->IsLooping ( ) : _impl->IsLooping ( );
+        }
+
+        void MediaPlayer::SetLoopPoints ( float inSeconds, float outSeconds )
+        {
+            if ( _session ) return _session->GetDecoder ( )->SetLoopPoints ( inSeconds, outSeconds );
+            if ( !_loop ) return;
+
+            _loop->SetPoints ( inSeconds, outSeconds );
+            ApplyLoop ( );
+        }
+
+        MediaPlayer::TimeRange MediaPlayer::GetLoopPoints ( ) const
+        {
+            if ( _session ) return _session->GetDecoder ( )->GetLoopPoints ( );
+            if ( !_loop ) return { 0.0f, GetDurationInSeconds ( ) };
+
+            // The out point is only known once the duration is when it's the end of the clip
+            double out = _loop->GetOut ( ) > 0.0 ? _loop->GetOut ( ) : GetDurationInSeconds ( );
+            return { static_cast<float> ( _loop->GetIn ( ) ), static_cast<float> ( out ) };
+        }
+
+        LoopScheduler::Stats MediaPlayer::GetLoopStats ( ) const
+        {
+            if ( _session ) return _session->GetDecoder ( )->GetLoopStats ( );
+            return _loop ? _loop->GetStats ( ) : LoopScheduler::Stats ( );
         }
 
         const ivec2 & MediaPlayer::GetSize ( ) const
         {
+            if ( _offline ) return _offline->GetSize ( );
             return _impl->GetSize ( );
         }
 
         void MediaPlayer::SeekToSeconds ( float seconds, bool approximate )
         {
+            if ( _offline )
+            {
+                FrameAt ( seconds );
+                return;
+            }
+
+            if ( _session ) return _session->GetDecoder ( )->SeekToSeconds ( seconds, approximate );
+            InterruptLoop ( );
             return _impl->SeekToSeconds ( seconds, approximate );
         }
 
         void MediaPlayer::SeekToPercentage ( float normalizedTime, bool approximate )
         {
+            if ( _offline )
+            {
+                FrameAt ( std::clamp ( normalizedTime, 0.0f, 1.0f ) * _offline->GetDurationInSeconds ( ) );
+                return;
+            }
+
+            if ( _session ) return _session->GetDecoder ( )->SeekToPercentage ( normalizedTime, approximate );
+            InterruptLoop ( );
             return _impl->SeekToPercentage ( std::clamp ( normalizedTime, 0.0f, 1.0f ), approximate );
         }
 
         void MediaPlayer::FrameStep ( int delta )
         {
+            if ( _offline )
+            {
+                // Only forwards, there's no going back a frame without knowing the timestamps
+                while ( delta-- > 0 && NextFrame ( ) );
+                return;
+            }
+
+            if ( _session ) return _session->GetDecoder ( )->FrameStep ( delta );
+            InterruptLoop ( );
             return _impl->FrameStep ( delta );
         }
 
+        std::future<void> MediaPlayer::FlushCommands ( )
+        {
+            if ( _session ) return _session->GetDecoder ( )->FlushCommands ( );
+            return _impl->FlushCommands ( );
+        }
+
+        bool MediaPlayer::NextFrame ( )
+        {
+            if ( !_offline ) return false;
+            if ( !_offline->NextFrame ( ) ) return false;
+
+            DispatchOfflineFrame ( );
+            return true;
+        }
+
+        bool MediaPlayer::FrameAt ( double seconds )
+        {
+            if ( !_offline ) return false;
+
+            uint64_t index = _offline->GetFrameIndex ( );
+            if ( !_offline->FrameAt ( seconds ) ) return false;
+
+            if ( _offline->GetFrameIndex ( ) != index ) DispatchOfflineFrame ( );
+            return true;
+        }
+
+        void MediaPlayer::DispatchOfflineFrame ( )
+        {
+            // Decoded and shown on the caller's thread, so both kinds of sink get it here
+            auto & sinks = _impl->GetFrameSinks ( );
+            auto frame = _offline->GetFrame ( );
+            sinks.Dispatch ( frame, FrameSink::Thread::Producer );
+            sinks.Dispatch ( frame, FrameSink::Thread::Main );
+        }
+
         bool MediaPlayer::IsComplete ( ) const
         {
+            if ( _offline ) return _offline->IsComplete ( );
             return _impl->IsComplete ( );
         }
 
         bool MediaPlayer::IsPaused ( ) const
         {
+            if ( _session ) return _session->GetDecoder ( )->IsPaused ( );
+            if ( IsBridgingLoop ( ) ) return false;     // Even if the engine ran into the end before the seek landed
             return _impl->IsPaused ( );
         }
 
         bool MediaPlayer::IsPlaying ( ) const
         {
-            return _impl->IsPlaying ( );
+            return !IsPaused ( );
         }
 
         bool MediaPlayer::IsSeeking ( ) const
@@ -201,38 +780,225 @@ namespace AX
 
         bool MediaPlayer::HasVideo ( ) const
         {
+            if ( _offline ) return true;
             return _impl->HasVideo ( );
         }
 
         float MediaPlayer::GetPositionInSeconds ( ) const
         {
+            if ( _offline ) return static_cast<float> ( _offline->GetTime ( ) );
+            if ( _session ) return _session->GetDecoder ( )->GetPositionInSeconds ( );
+            if ( IsBridgingLoop ( ) && _preroll->IsShowing ( ) ) return static_cast<float> ( _preroll->GetFramePts ( ) );
             return _impl->GetPositionInSeconds ( );
         }
 
         float MediaPlayer::GetDurationInSeconds ( ) const
         {
+            if ( _offline ) return static_cast<float> ( _offline->GetDurationInSeconds ( ) );
             return _impl->GetDurationInSeconds ( );
         }
 
+        MediaPlayer::State MediaPlayer::GetState ( ) const
+        {
+            if ( _offline )
+            {
+                const auto & size = _offline->GetSize ( );
+
+                State state;
+                state.version = _offline->GetFrameIndex ( );
+                state.position = _offline->GetTime ( );
+                state.duration = _offline->GetDurationInSeconds ( );
+                state.framePts = _offline->GetFramePts ( );
+                state.framesPresented = _offline->GetFrameIndex ( );
+                state.width = size.x;
+                state.height = size.y;
+                state.ready = true;
+                state.complete = _offline->IsComplete ( );
+                state.hasVideo = true;
+                return state;
+            }
+
+            if ( _session )
+            {
+                State state = _session->GetDecoder ( )->GetState ( );
+                state.volume = _session->GetVolume ( this );
+                state.muted = _session->IsMuted ( this );
+                return state;
+            }
+
+            State state = _impl->GetState ( );
+            if ( _loop )
+            {
+                state.looping = _loop->IsLooping ( );
+
+                // The pre-rolled frames are what's on screen, the engine is still on its way back
+                if ( IsBridgingLoop ( ) )
+                {
+                    state.paused = false;
+                    if ( _preroll->IsShowing ( ) ) state.position = state.framePts = _preroll->GetFramePts ( );
+                }
+            }
+
+            if ( _audioNode )
+            {
+                state.volume = _audioNode->GetVolume ( );
+                state.muted = _audioNode->IsMuted ( );
+            }
+
+            return state;
+        }
+
         bool MediaPlayer::CheckNewFrame ( ) const
         {
+            if ( _session ) return _sessionFrame != _session->GetFrameSerial ( );
+            if ( _offline ) return _offline->CheckNewFrame ( );
+            if ( _preroll && _preroll->IsShowing ( ) ) return _preroll->CheckNewFrame ( );
             return _impl->CheckNewFrame ( );
         }
 
         const Surface8uRef & MediaPlayer::GetSurface ( ) const
         {
+            if ( _session )
+            {
+                _sessionFrame = _session->GetFrameSerial ( );
+                return _session->GetSurface ( );
+            }
+
+            if ( _offline ) return _offline->GetSurface ( );
+            if ( _preroll && _preroll->IsShowing ( ) ) return _preroll->GetSurface ( );
             return _impl->GetSurface ( );
         }
 
         MediaPlayer::FrameLeaseRef MediaPlayer::GetTexture ( ) const
         {
+            if ( _session )
+            {
+                _sessionFrame = _session->GetFrameSerial ( );
+                return _session->GetTexture ( );
+            }
+
+            if ( _offline ) return _offline->GetTexture ( );
+            if ( _preroll && _preroll->IsShowing ( ) ) return _preroll->GetTexture ( );
             return _impl->GetTexture ( );
         }
 
+        ReadAheadByteSource::Stats MediaPlayer::GetReadAheadStats ( ) const
+        {
+            if ( auto readAhead = std::dynamic_pointer_cast<ReadAheadByteSource> ( _byteSource ) )
+            {
+                return readAhead->GetStats ( );
+            }
+
+            return { };
+        }
+
+        HttpByteSource::Stats MediaPlayer::GetHttpCacheStats ( ) const
+        {
+            if ( auto http = std::dynamic_pointer_cast<HttpByteSource> ( _byteSource ) )
+            {
+                return http->GetStats ( );
+            }
+
+            return { };
+        }
+
+        FrameScheduler::Stats MediaPlayer::GetFrameStats ( ) const
+        {
+            return _impl->GetFrameStats ( );
+        }
+
+        void MediaPlayer::SetPresentationTarget ( double secondsFromNow )
+        {
+            _impl->SetPresentationTarget ( secondsFromNow );
+        }
+
+        PresentationScheduler::Stats MediaPlayer::GetPresentationStats ( ) const
+        {
+            return _impl->GetPresentationStats ( );
+        }
+
+        void MediaPlayer::AddFrameSink ( const FrameSinkRef & sink )
+        {
+            if ( !_offline && ( _format.IsHardwareAccelerated ( ) || _format.IsAudioOnly ( ) ) )
+            {
+                CI_LOG_W ( "Frame sinks only receive frames from CPU (non hardware accelerated) video players" );
+            }
+
+            _impl->GetFrameSinks ( ).Add ( sink );
+        }
+
+        void MediaPlayer::RemoveFrameSink ( const FrameSinkRef & sink )
+        {
+            _impl->GetFrameSinks ( ).Remove ( sink );
+        }
+
+        StreamingTexture::Stats MediaPlayer::GetUploadStats ( ) const
+        {
+            return _impl->GetUploadStats ( );
+        }
+
+        MediaPlayer::TimeRanges MediaPlayer::GetBufferedRanges ( ) const
+        {
+            auto http = std::dynamic_pointer_cast<HttpByteSource> ( _byteSource );
+            if ( !http ) return _impl->GetBufferedRanges ( );
+
+            // Size ( ) would block on the main thread until it's known
+            if ( !http->IsOpen ( ) ) return { };
+
+            // Assumes a roughly constant bitrate to map bytes on disk to time,
+            // which is close enough for deciding when to start or resume playback.
+            TimeRanges result;
+            double duration = GetDurationInSeconds ( );
+            double size = static_cast<double> ( http->Size ( ) );
+            if ( duration <= 0.0 || size <= 0.0 ) return result;
+
+            for ( auto & range : http->GetCachedRanges ( ) )
+            {
+                result.push_back ( { static_cast<float> ( range.begin / size * duration ), static_cast<float> ( range.end / size * duration ) } );
+            }
+
+            return result;
+        }
+
+        float MediaPlayer::GetBufferedSecondsAhead ( ) const
+        {
+            float position = std::max ( 0.0f, GetPositionInSeconds ( ) );
+            for ( auto & range : GetBufferedRanges ( ) )
+            {
+                if ( position >= range.start - 0.05f && position <= range.end )
+                {
+                    return range.end - position;
+                }
+            }
+
+            return 0.0f;
+        }
+
         MediaPlayer::~MediaPlayer ( )
         {
-            _impl = nullptr;
+            if ( _session )
+            {
+                // The decoder's audio node and Impl aren't ours to tear down
+                for ( auto & connection : _sessionConnections ) connection.disconnect ( );
+                _session->Leave ( this );
+                _audioNode = nullptr;
+                _impl = nullptr;
+                _session = nullptr;
+                return;
+            }
+
+            // Off the update signal first, then the Impl can't call back into this. The rest of
+            // it goes in the background, see WaitForPendingDestruction ( ).
             _updateConnection.disconnect ( );
+            if ( _impl ) RetireImpl ( std::move ( _impl ) );
+            _offline = nullptr;
+            _preroll = nullptr;
+
+            if ( _audioNode )
+            {
+                _audioNode->disconnectAll ( );
+                _audioNode = nullptr;
+            }
         }
     }
 }
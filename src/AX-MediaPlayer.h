@@ -15,6 +15,15 @@
 #include "cinder/Filesystem.h"
 #include "cinder/DataSource.h"
 #include "cinder/Noncopyable.h"
+#include "AX-MediaPlayerByteSource.h"
+#include "AX-MediaPlayerReadAhead.h"
+#include "AX-MediaPlayerHttpSource.h"
+#include "AX-MediaPlayerFrameScheduler.h"
+#include "AX-MediaPlayerPresentationScheduler.h"
+#include "AX-MediaPlayerLoopScheduler.h"
+#include "AX-MediaPlayerStreamingTexture.h"
+#include "AX-MediaPlayerMemoryBudget.h"
+#include "AX-MediaPlayerLiveObjects.h"
 
 namespace cinder
 {
@@ -26,12 +35,19 @@ namespace cinder
 
 namespace AX::Video
 {
+    using AudioPeaksRef = std::shared_ptr<class AudioPeaks>;
+    using FrameSinkRef = std::shared_ptr<class FrameSink>;
+
+    class SharedSession;
+    class OfflineReader;
+    class LoopPreroll;
     using MediaPlayerRef = std::shared_ptr<class MediaPlayer>;
     class MediaPlayer : public ci::Noncopyable
     {
     public:
 
         class Impl;
+        class AudioNode;
         
         enum class Error
         {
@@ -56,6 +72,61 @@ namespace AX::Video
             virtual bool IsValid ( ) const { return false; };
         };
 
+        struct TimeRange
+        {
+            float start{ 0.0f };
+            float end{ 0.0f };
+        };
+
+        using TimeRanges = std::vector<TimeRange>;
+
+        // Everything the getters below answer with, published by the backend once
+        // per tick (and on engine events or a timer for players that aren't ticked) so reading it is a
+        // plain memory read that's safe from any thread. Volume, mute and loop reflect a setter
+        // straight away, the rest reflect the engine as of the last publish.
+        struct State
+        {
+            uint64_t    version{ 0 };           // Bumped by every publish
+            double      position{ 0.0 };
+            double      duration{ 0.0 };
+            float       rate{ 1.0f };
+            float       volume{ 1.0f };
+            double      bufferedStart{ 0.0 };   // The buffered range the position is in, if any
+            double      bufferedEnd{ 0.0 };
+            double      framePts{ -1.0 };       // Of the frame on screen, -1 until there is one
+            uint64_t    framesPresented{ 0 };   // New frames swapped in so far
+            int32_t     width{ 0 };
+            int32_t     height{ 0 };
+            bool        ready{ false };
+            bool        paused{ true };
+            bool        seeking{ false };
+            bool        complete{ false };
+            bool        hasAudio{ false };
+            bool        hasVideo{ false };
+            bool        muted{ false };
+            bool        looping{ false };
+        };
+
+        // Playback won't start until StartSeconds of media is buffered ahead of
+        // the playhead, and if the buffer runs dry it's paused until ResumeSeconds is back.
+        // Both zero (the default) leaves buffering decisions up to the platform.
+        struct BufferPolicy
+        {
+            BufferPolicy & StartSeconds ( float seconds ) { _startSeconds = seconds; return *this; }
+            BufferPolicy & ResumeSeconds ( float seconds ) { _resumeSeconds = seconds; return *this; }
+
+            float   GetStartSeconds ( ) const { return _startSeconds; }
+            float   GetResumeSeconds ( ) const { return _resumeSeconds; }
+            bool    IsEnabled ( ) const { return _startSeconds > 0.0f || _resumeSeconds > 0.0f; }
+
+            BufferPolicy ( ) { };
+
+        protected:
+
+            float   _startSeconds{ 0.0f };
+            float   _resumeSeconds{ 0.0f };
+        };
+
         struct Format
         {
             Format & Audio ( bool enabled ) { _audioEnabled = enabled; return *this; }
@@ -63,12 +134,67 @@ namespace AX::Video
             Format & AudioDevice ( const ci::audio::DeviceFwdRef & device );
             Format & HardwareAccelerated ( bool accelerated ) { _hardwareAccelerated = accelerated; return *this; }
             Format & AutoInitialize ( bool autoInit ) { _autoInit = autoInit; return *this; }
+            Format & ReadAhead ( bool enabled, const ReadAheadByteSource::Options & options = ReadAheadByteSource::Options ( ) ) { _readAhead = enabled; _readAheadOptions = options; return *this; }
+            Format & HttpCache ( bool enabled, const HttpByteSource::Options & options = HttpByteSource::Options ( ) ) { _httpCache = enabled; _httpCacheOptions = options; return *this; }
+            Format & Buffering ( const BufferPolicy & policy ) { _bufferPolicy = policy; return *this; }
+            Format & AudioTap ( bool enabled, size_t channels = 2, float ringSeconds = 0.1f ) { _audioTap = enabled; _audioTapChannels = channels; _audioTapRingSeconds = ringSeconds; return *this; }
+            Format & FrameDropping ( bool enabled, const FrameScheduler::Options & options = FrameScheduler::Options ( ) ) { _frameDropping = enabled; _frameDroppingOptions = options; return *this; }
+
+            // Windows only. Frames are transferred and converted on the shared Executor
+            // the moment the engine has them and Update ( ) only swaps in the latest. Costs two extra
+            // frames of GPU / CPU memory. Every player is polled by the same thread.
+            Format & BackgroundTransfer ( bool enabled ) { _backgroundTransfer = enabled; return *this; }
+
+            // Windows only, implies BackgroundTransfer. Frames are queued as they're
+            // decoded and Update ( ) picks the one that matches the next display refresh.
+            Format & PresentationSync ( bool enabled, const PresentationScheduler::Options & options = PresentationScheduler::Options ( ) ) { _presentationSync = enabled; _presentationOptions = options; return *this; }
+
+            // Players created from the same file / url with the same format attach to
+            // one decoder instead of each opening their own. Transport (play / pause / seek / rate /
+            // loop points) is shared between them, volume, mute and SetVisible ( ) are per player.
+            Format & SharedSession ( bool enabled ) { _sharedSession = enabled; return *this; }
+
+            // CPU (non hardware accelerated) players stream frames into one texture
+            // through a ring of pixel buffers instead of creating a new texture per GetTexture ( ).
+            // Off by default since a lease is then a view of that texture, overwritten by the next
+            // upload, so anything that keeps one across frames (cross-fades, trails) needs a copy.
+            Format & StreamingUpload ( bool enabled, const StreamingTexture::Options & options = StreamingTexture::Options ( ) ) { _streamingUpload = enabled; _streamingOptions = options; return *this; }
+
+            // Local files only. No playback clock, video is pulled a frame at a time
+            // with NextFrame ( ) / FrameAt ( ) as fast as it decodes and never dropped (for export
+            // and render farm jobs). Play / Pause don't move the video, audio isn't played.
+            Format & Offline ( bool enabled ) { _offline = enabled; return *this; }
+
+            // Local files only. Loops (whole clip or SetLoopPoints ( )) wrap without
+            // waiting on the seek back, the frames after the in point are decoded ahead of time and
+            // shown while it happens, see LoopScheduler. The player never pauses so the audio carries
+            // on, and with AudioTap (Windows) it wraps by itself without a gap.
+            Format & SeamlessLoop ( bool enabled, const LoopScheduler::Options & options = LoopScheduler::Options ( ) ) { _seamlessLoop = enabled; _seamlessLoopOptions = options; return *this; }
 
             bool    IsAudioEnabled ( ) const { return _audioEnabled;  }
             bool    IsAudioOnly ( ) const { return _audioOnly; }
             bool    IsHardwareAccelerated ( ) const { return _hardwareAccelerated; }
             const std::string & AudioDeviceID ( ) const { return _audioDeviceId; }
             bool    IsAutoInitialized ( ) const { return _autoInit; };
+            bool    IsReadAheadEnabled ( ) const { return _readAhead; }
+            const ReadAheadByteSource::Options & ReadAheadOptions ( ) const { return _readAheadOptions; }
+            bool    IsHttpCacheEnabled ( ) const { return _httpCache; }
+            const HttpByteSource::Options & HttpCacheOptions ( ) const { return _httpCacheOptions; }
+            const BufferPolicy & GetBufferPolicy ( ) const { return _bufferPolicy; }
+            bool    IsAudioTapEnabled ( ) const { return _audioTap; }
+            size_t  AudioTapChannels ( ) const { return _audioTapChannels; }
+            float   AudioTapRingSeconds ( ) const { return _audioTapRingSeconds; }
+            bool    IsFrameDroppingEnabled ( ) const { return _frameDropping; }
+            const FrameScheduler::Options & FrameDroppingOptions ( ) const { return _frameDroppingOptions; }
+            bool    IsBackgroundTransferEnabled ( ) const { return _backgroundTransfer; }
+            bool    IsPresentationSyncEnabled ( ) const { return _presentationSync; }
+            const PresentationScheduler::Options & PresentationOptions ( ) const { return _presentationOptions; }
+            bool    IsSharedSessionEnabled ( ) const { return _sharedSession; }
+            bool    IsStreamingUploadEnabled ( ) const { return _streamingUpload; }
+            const StreamingTexture::Options & StreamingUploadOptions ( ) const { return _streamingOptions; }
+            bool    IsOfflineEnabled ( ) const { return _offline; }
+            bool    IsSeamlessLoopEnabled ( ) const { return _seamlessLoop; }
+            const LoopScheduler::Options & SeamlessLoopOptions ( ) const { return _seamlessLoopOptions; }
 
             Format ( ) { };
 
@@ -79,15 +205,37 @@ namespace AX::Video
             bool        _hardwareAccelerated{ false };
             std::string _audioDeviceId{ "" };
             bool        _autoInit{ true };
+            bool        _readAhead{ false };
+            ReadAheadByteSource::Options _readAheadOptions;
+            bool        _httpCache{ false };
+            HttpByteSource::Options _httpCacheOptions;
+            BufferPolicy _bufferPolicy;
+            bool        _audioTap{ false };
+            size_t      _audioTapChannels{ 2 };
+            float       _audioTapRingSeconds{ 0.1f };
+            bool        _frameDropping{ false };
+            FrameScheduler::Options _frameDroppingOptions;
+            bool        _backgroundTransfer{ false };
+            bool        _presentationSync{ false };
+            PresentationScheduler::Options _presentationOptions;
+            bool        _sharedSession{ false };
+            bool        _streamingUpload{ false };
+            StreamingTexture::Options _streamingOptions;
+            bool        _offline{ false };
+            bool        _seamlessLoop{ false };
+            LoopScheduler::Options _seamlessLoopOptions;
         };
 
         using   FrameLeaseRef = std::unique_ptr<FrameLease>;
+        using   AudioNodeRef  = std::shared_ptr<AudioNode>;
         
         using   EventSignal     = ci::signals::Signal<void ( )>;
         using   ErrorSignal     = ci::signals::Signal<void ( Error )>;
+        using   PressureSignal  = ci::signals::Signal<void ( MemoryBudget::Pressure )>;
 
         static  MediaPlayerRef Create ( const ci::DataSourceRef & source, const Format & fmt = Format ( ) );
         static  MediaPlayerRef Create ( const ci::fs::path & filePath, const Format & fmt = Format ( ) );
+        static  MediaPlayerRef Create ( const ByteSourceRef & source, const Format & fmt = Format ( ) );
 
         // @note(andrew): If !fmt.IsAutoInitialized(), these are required to be called manually.
         // The use case is to have any heavy initialization / shutdown not be tied to the lifetime
@@ -95,7 +243,32 @@ namespace AX::Video
         // video players often.
         static  void StaticInitialize ( );
         static  void StaticShutdown ( );
+
+        // Letting go of a player only detaches it (no more signals, nothing more
+        // is transferred), the engine is shut down in the background and its textures are freed
+        // on the main thread a frame or more later. Blocks until every player let go of so far
+        // is completely gone; call it before the GL context or the app goes away. StaticShutdown ( )
+        // calls it too.
+        static  void WaitForPendingDestruction ( );
         
+        // Decodes the audio track faster than real time (in parallel chunks, no
+        // player or output device involved) into a min / max / RMS overview for waveform drawing.
+        // With no `peakFile` the result is cached and reused until the source changes.
+        static  AudioPeaksRef ComputeAudioPeaks ( const ci::fs::path & source, float binsPerSecond, const ci::fs::path & peakFile = { } );
+
+        // Duration, size, codecs and frame rate straight from the container header,
+        // without creating a player or waiting on OnReady. Cheap enough to call for every file in
+        // a folder, see MediaLibrary for doing exactly that (in parallel, with a cache).
+        static  MediaInfo Probe ( const ci::fs::path & filePath );
+
+        // With a MemoryBudget configured, Create ( ) returns nullptr once it's under
+        // Refuse pressure (or the clip wouldn't fit). This waits for room instead and hands the
+        // player over on the main thread when there is some, possibly straight away.
+        static  void CreateWhenAvailable ( const ci::fs::path & filePath, const Format & fmt, const std::function<void ( MediaPlayerRef )> & callback );
+
+        // Emitted on the main thread whenever the shared MemoryBudget's pressure level changes
+        static  PressureSignal OnMemoryPressure;
+
         static  const std::string & ErrorToString ( Error error );
         inline const Format & GetFormat ( ) const { return _format; }
 
@@ -113,9 +286,21 @@ namespace AX::Video
         void    SetVolume ( float volume );
         float   GetVolume ( ) const;
 
+        // Whether anything is drawing this player. Players in a shared session that nobody is
+        // drawing stop taking frames from it, standalone players just remember it.
+        void    SetVisible ( bool visible );
+        bool    IsVisible ( ) const;
+
         void    SetLoop ( bool loop );
         bool    IsLooping ( ) const;
 
+        // While looping, go back to `inSeconds` on reaching `outSeconds` (<= 0 for
+        // the end of the clip) instead of looping the whole clip. Both zero clears them. These
+        // wraps are seeks the player makes itself, see Format::SeamlessLoop for hiding them.
+        void    SetLoopPoints ( float inSeconds, float outSeconds );
+        TimeRange GetLoopPoints ( ) const;
+        LoopScheduler::Stats GetLoopStats ( ) const;
+
         const   ci::ivec2& GetSize ( ) const;
         inline  ci::Area   GetBounds ( ) const { return ci::Area ( ci::ivec2(0), GetSize() ); }
         inline  bool       IsHardwareAccelerated ( ) const { return _format.IsHardwareAccelerated ( ); }
@@ -134,6 +319,20 @@ namespace AX::Video
 
         void    FrameStep ( int delta );
 
+        // On Windows the control calls above (play / pause / seeks / volume / mute /
+        // loop / rate / frame step) return straight away and are applied in order on the shared
+        // Executor, repeats of the same kind collapsing into the latest. The future is ready once
+        // every call made before it has reached the engine. Ready immediately everywhere else.
+        std::future<void> FlushCommands ( );
+
+        State   GetState ( ) const;
+
+        // Only with Format::Offline ( true ). Both block until the frame is decoded, NextFrame ( )
+        // returns every frame in order and FrameAt ( ) the one on screen at `seconds`. The
+        // position reported by GetPositionInSeconds ( ) is the virtual clock they move.
+        bool    NextFrame ( );
+        bool    FrameAt ( double seconds );
+
         float   GetPositionInSeconds ( ) const;
         float   GetDurationInSeconds ( ) const;
         
@@ -142,8 +341,38 @@ namespace AX::Video
         const ci::Surface8uRef & GetSurface ( ) const;
         FrameLeaseRef GetTexture ( ) const;
 
+        // Only valid with Format::AudioTap ( true ), the player's audio no longer goes to a device by itself
+        const AudioNodeRef & GetAudioNode ( ) const { return _audioNode; }
+
+        // Only populated for local files played with Format::ReadAhead ( true )
+        ReadAheadByteSource::Stats GetReadAheadStats ( ) const;
+
+        // Only populated for http urls played with Format::HttpCache ( true )
+        HttpByteSource::Stats GetHttpCacheStats ( ) const;
+
+        // Only populated with Format::FrameDropping ( true ). In the HalfSize degraded mode the
+        // surface / texture is half of GetSize ( ) until the player recovers.
+        FrameScheduler::Stats GetFrameStats ( ) const;
+
+        // Only with Format::PresentationSync ( true ). Normally the next refresh is predicted from
+        // the compositor, headless apps say when the frame picked by the next Update ( ) will be seen.
+        void    SetPresentationTarget ( double secondsFromNow );
+        PresentationScheduler::Stats GetPresentationStats ( ) const;
+
+        // Extra outputs for every decoded frame, see FrameSink. CPU players only.
+        void    AddFrameSink ( const FrameSinkRef & sink );
+        void    RemoveFrameSink ( const FrameSinkRef & sink );
+
+        // Only populated for CPU players with Format::StreamingUpload ( true ) once GetTexture ( ) has been used
+        StreamingTexture::Stats GetUploadStats ( ) const;
+
+        // Time ranges that can currently be played without waiting on the network
+        TimeRanges GetBufferedRanges ( ) const;
+        float   GetBufferedSecondsAhead ( ) const;
+
         EventSignal OnReady;
         EventSignal OnComplete;
+        EventSignal OnLoop;         // Once per wrap, when the in point's frame replaces the out point's
         EventSignal OnPlay;
         EventSignal OnPause;
         
@@ -159,11 +388,39 @@ namespace AX::Video
 
     protected:
 
-        MediaPlayer ( const ci::DataSourceRef & source, const Format & format );
+        MediaPlayer ( const ci::DataSourceRef & source, const Format & format, MemoryBudget::AccountRef reservation = nullptr );
+        MediaPlayer ( const ByteSourceRef & source, const Format & format, MemoryBudget::AccountRef reservation = nullptr );
+        MediaPlayer ( const std::shared_ptr<SharedSession> & session );
         bool Update ( );
+        void UpdateBuffering ( );
+        void BeginHold ( float untilSeconds );
+        void EndHold ( );
+        void CreateAudioNode ( );
+        void ConnectUpdate ( );
+        void DispatchOfflineFrame ( );
+        void CreateLoop ( const ci::DataSourceRef & source );
+        void ApplyLoop ( );
+        void UpdateLoop ( );
+        void InterruptLoop ( );
+        bool IsBridgingLoop ( ) const;
         
+        LiveObjects::Scoped      _live{ LiveObjects::Kind::Players };   // First in, last out
         Format                   _format;
-        std::unique_ptr<Impl>    _impl;
+        ByteSourceRef            _byteSource;
+        AudioNodeRef             _audioNode;
+        std::shared_ptr<SharedSession> _session;
+        std::shared_ptr<Impl>    _impl;
+        std::unique_ptr<OfflineReader> _offline;
+        std::unique_ptr<LoopScheduler> _loop;
+        std::unique_ptr<LoopPreroll> _preroll;
         ci::signals::Connection  _updateConnection;
+        std::vector<ci::signals::Connection> _sessionConnections;
+        mutable uint64_t         _sessionFrame{ 0 };
+        bool                     _visible{ true };
+
+        bool                     _playRequested{ false };
+        bool                     _holdingForBuffer{ false };
+        float                    _holdUntilSeconds{ 0.0f };
+        bool                     _sourceWasStalled{ false };
     };
 }
\ No newline at end of file
@@ -0,0 +1,39 @@
+//
+//  AX-MediaPlayerAudioDecoder.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <filesystem>
+
+namespace AX::Video
+{
+    // Pulls decoded float PCM out of a file as fast as the platform decoder
+    // can go, with no clock and no output device. Each instance is single threaded, open
+    // one per thread to decode different parts of the same file in parallel.
+    class AudioDecoder
+    {
+    public:
+
+        // Implemented per platform, nullptr if the file has no decodable audio
+        static std::unique_ptr<AudioDecoder> Create ( const std::filesystem::path & path );
+
+        virtual ~AudioDecoder ( ) { };
+
+        virtual size_t  GetChannels ( ) const = 0;
+        virtual double  GetSampleRate ( ) const = 0;
+        virtual double  GetDurationInSeconds ( ) const = 0;
+
+        // May land before the requested time, use the timestamps Decode ( ) reports
+        virtual bool    Seek ( double seconds ) = 0;
+
+        // Replaces `interleaved` with the next packet, false at the end of the stream
+        virtual bool    Decode ( std::vector<float> & interleaved, double & startSeconds ) = 0;
+    };
+}
@@ -0,0 +1,183 @@
+//
+//  AX-MediaPlayerAudioNode.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerAudioNode.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace AX::Video
+{
+    MediaPlayer::AudioNode::AudioNode ( size_t channels, float ringSeconds, const ci::audio::Node::Format & format )
+        : ci::audio::InputNode ( ci::audio::Node::Format ( format ).channels ( channels ).channelMode ( ci::audio::Node::ChannelMode::SPECIFIED ) )
+        , _ringSeconds ( ringSeconds )
+    { }
+
+    void MediaPlayer::AudioNode::SetSourceFormat ( size_t channels, double sampleRate )
+    {
+        std::unique_lock<std::mutex> lk ( _formatMutex );
+
+        _sourceChannels = std::max<size_t> ( channels, 1 );
+        _sourceSampleRate.store ( sampleRate );
+        _limitFrames = static_cast<size_t> ( std::ceil ( sampleRate * _ringSeconds ) );
+        _ring.Allocate ( _sourceChannels, _limitFrames );
+        _flushPending.store ( false );
+
+        AllocateScratch ( );
+    }
+
+    void MediaPlayer::AudioNode::initialize ( )
+    {
+        std::unique_lock<std::mutex> lk ( _formatMutex );
+        AllocateScratch ( );
+    }
+
+    void MediaPlayer::AudioNode::AllocateScratch ( )
+    {
+        // Enough source frames for a whole block at the fastest ratio we'll resample by, plus the carried frames
+        size_t frames = static_cast<size_t> ( std::ceil ( getFramesPerBlock ( ) * kMaxRatio ) ) + 4;
+
+        _scratch.assign ( std::max<size_t> ( _sourceChannels, 1 ), std::vector<float> ( frames, 0.0f ) );
+        _scratchPointers.resize ( _scratch.size ( ) );
+        _carryFrames = 0;
+        _phase = 0.0;
+    }
+
+    size_t MediaPlayer::AudioNode::Push ( const float * interleaved, size_t frames )
+    {
+        if ( _flushPending.load ( ) || _ring.GetCapacity ( ) == 0 ) return 0;
+
+        return _ring.Write ( interleaved, std::min ( frames, GetPushableFrames ( ) ) );
+    }
+
+    size_t MediaPlayer::AudioNode::Push ( const float * const * planar, size_t frames )
+    {
+        if ( _flushPending.load ( ) || _ring.GetCapacity ( ) == 0 ) return 0;
+
+        return _ring.Write ( planar, std::min ( frames, GetPushableFrames ( ) ) );
+    }
+
+    size_t MediaPlayer::AudioNode::GetPushableFrames ( ) const
+    {
+        // The ring is rounded up to a power of two, only fill it as far as was asked for
+        size_t buffered = _ring.GetReadAvailable ( );
+        return _limitFrames > buffered ? _limitFrames - buffered : 0;
+    }
+
+    void MediaPlayer::AudioNode::Flush ( )
+    {
+        // Only the consumer may move the read head, so the audio thread does the
+        // actual clear and Push ( ) refuses new audio until it has, otherwise post-seek audio
+        // could be thrown away along with the stale frames.
+        if ( isEnabled ( ) )
+        {
+            _flushPending.store ( true );
+        }
+        else
+        {
+            std::unique_lock<std::mutex> lk ( _formatMutex );
+            _ring.Clear ( );
+            _carryFrames = 0;
+            _phase = 0.0;
+        }
+    }
+
+    void MediaPlayer::AudioNode::process ( ci::audio::Buffer * buffer )
+    {
+        buffer->zero ( );
+
+        std::unique_lock<std::mutex> lk ( _formatMutex, std::try_to_lock );
+        if ( !lk.owns_lock ( ) || _ring.GetCapacity ( ) == 0 ) return;
+
+        if ( _flushPending.load ( ) )
+        {
+            _ring.Clear ( );
+            _carryFrames = 0;
+            _phase = 0.0;
+            _flushPending.store ( false );
+        }
+
+        const size_t frames = buffer->getNumFrames ( );
+        const double sourceRate = _sourceSampleRate.load ( );
+        const double ratio = std::clamp ( sourceRate / getSampleRate ( ) * _playbackRate.load ( ), 1.0 / kMaxRatio, kMaxRatio );
+
+        double latency = ( _ring.GetReadAvailable ( ) + _carryFrames ) / sourceRate + static_cast<double> ( frames ) / getSampleRate ( );
+        _latencySeconds.store ( latency );
+        if ( latency > _maxLatencySeconds.load ( ) ) _maxLatencySeconds.store ( latency );
+
+        if ( !_active.load ( ) ) return;
+
+        // Linear interpolation, the last output frame needs one source frame past it
+        const size_t needed = static_cast<size_t> ( _phase + ( frames - 1 ) * ratio ) + 2;
+        const size_t consumed = static_cast<size_t> ( _phase + frames * ratio );
+        const size_t total = std::max ( needed, consumed );
+
+        for ( size_t c = 0; c < _scratch.size ( ); c++ ) _scratchPointers[c] = _scratch[c].data ( ) + _carryFrames;
+        size_t available = _carryFrames + _ring.Read ( _scratchPointers.data ( ), total - _carryFrames );
+
+        if ( available < total )
+        {
+            if ( !_starved ) _underruns++;
+            _starved = true;
+
+            for ( auto & channel : _scratch ) std::fill ( channel.begin ( ) + available, channel.begin ( ) + total, 0.0f );
+        }
+        else
+        {
+            _starved = false;
+        }
+
+        const float gain = _muted.load ( ) ? 0.0f : _volume.load ( );
+        for ( size_t c = 0; c < buffer->getNumChannels ( ); c++ )
+        {
+            const float * in = _scratch[std::min ( c, _scratch.size ( ) - 1 )].data ( );
+            float * out = buffer->getChannel ( c );
+
+            for ( size_t i = 0; i < frames; i++ )
+            {
+                double position = _phase + i * ratio;
+                size_t index = static_cast<size_t> ( position );
+                float t = static_cast<float> ( position - index );
+                out[i] = ( in[index] + ( in[index + 1] - in[index] ) * t ) * gain;
+            }
+        }
+
+        if ( available < total )
+        {
+            // Start clean once audio arrives again rather than interpolating across the gap
+            _carryFrames = 0;
+            _phase = 0.0;
+        }
+        else
+        {
+            _carryFrames = total - consumed;
+            for ( auto & channel : _scratch ) std::copy ( channel.begin ( ) + consumed, channel.begin ( ) + total, channel.begin ( ) );
+            _phase += frames * ratio - consumed;
+        }
+
+        _framesRendered += frames;
+    }
+
+    MediaPlayer::AudioNode::Stats MediaPlayer::AudioNode::GetStats ( ) const
+    {
+        Stats stats;
+        stats.latencySeconds = _latencySeconds.load ( );
+        stats.maxLatencySeconds = _maxLatencySeconds.load ( );
+        stats.underruns = _underruns.load ( );
+        stats.overflows = _overflows.load ( );
+        stats.framesRendered = _framesRendered.load ( );
+        stats.sourceSampleRate = _sourceSampleRate.load ( );
+
+        if ( stats.sourceSampleRate > 0.0 && getSampleRate ( ) > 0 )
+        {
+            stats.latencyBoundSeconds = _limitFrames / stats.sourceSampleRate + static_cast<double> ( getFramesPerBlock ( ) ) / getSampleRate ( );
+        }
+
+        return stats;
+    }
+}
@@ -0,0 +1,99 @@
+//
+//  AX-MediaPlayerAudioNode.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include "AX-MediaPlayer.h"
+#include "AX-MediaPlayerAudioRing.h"
+#include "cinder/audio/InputNode.h"
+
+#include <mutex>
+#include <atomic>
+
+namespace AX::Video
+{
+    // Decoded PCM from a player with Format::AudioTap ( true ). The platform
+    // decoder pushes into a lock free ring and the audio thread pulls from it, resampling
+    // to the context's rate, so the player can be routed, mixed and analysed like any other
+    // node instead of opening its own output stream. Like any input node it has to be
+    // connected and enabled.
+    class MediaPlayer::AudioNode : public ci::audio::InputNode
+    {
+    public:
+
+        struct Stats
+        {
+            double      latencySeconds{ 0.0 };      // Decoded to rendered, as of the last block
+            double      maxLatencySeconds{ 0.0 };
+            double      latencyBoundSeconds{ 0.0 }; // Can never exceed a full ring plus one block
+            uint64_t    underruns{ 0 };             // Times the ring ran dry while playing
+            uint64_t    overflows{ 0 };             // Frames dropped because the ring was full
+            uint64_t    framesRendered{ 0 };
+            double      sourceSampleRate{ 0.0 };
+        };
+
+        AudioNode ( size_t channels, float ringSeconds, const ci::audio::Node::Format & format = ci::audio::Node::Format ( ) );
+
+        // Decoder side, only ever from a single producer thread. Push ( ) takes what fits, a
+        // producer that can wait retries the rest and one that can't reports it with Drop ( ).
+        void        SetSourceFormat ( size_t channels, double sampleRate );
+        size_t      Push ( const float * interleaved, size_t frames );
+        size_t      Push ( const float * const * planar, size_t frames );
+        void        Drop ( size_t frames ) { _overflows += frames; }
+        void        Flush ( );
+        bool        IsFlushPending ( ) const { return _flushPending.load ( ); }
+        size_t      GetBufferedFrames ( ) const { return _ring.GetReadAvailable ( ); }
+        double      GetSourceSampleRate ( ) const { return _sourceSampleRate.load ( ); }
+
+        // Player side, silence without counting underruns while inactive
+        void        SetActive ( bool active ) { _active.store ( active ); }
+        bool        IsActive ( ) const { return _active.load ( ); }
+        void        SetPlaybackRate ( float rate ) { _playbackRate.store ( rate ); }
+
+        void        SetVolume ( float volume ) { _volume.store ( volume ); }
+        float       GetVolume ( ) const { return _volume.load ( ); }
+        void        SetMuted ( bool muted ) { _muted.store ( muted ); }
+        bool        IsMuted ( ) const { return _muted.load ( ); }
+
+        Stats       GetStats ( ) const;
+
+    protected:
+
+        void        initialize ( ) override;
+        void        process ( ci::audio::Buffer * buffer ) override;
+        void        AllocateScratch ( );
+        size_t      GetPushableFrames ( ) const;
+
+        static constexpr double kMaxRatio = 4.0;
+
+        size_t                  _sourceChannels{ 0 };
+        float                   _ringSeconds{ 0.1f };
+        size_t                  _limitFrames{ 0 };
+        AudioRing               _ring;
+        std::mutex              _formatMutex;
+        std::atomic<double>     _sourceSampleRate{ 0.0 };
+        std::atomic_bool        _flushPending{ false };
+        std::atomic_bool        _active{ false };
+        std::atomic<float>      _playbackRate{ 1.0f };
+        std::atomic<float>      _volume{ 1.0f };
+        std::atomic_bool        _muted{ false };
+
+        // Audio thread only
+        std::vector<std::vector<float>> _scratch;
+        std::vector<float *>    _scratchPointers;
+        size_t                  _carryFrames{ 0 };
+        double                  _phase{ 0.0 };
+        bool                    _starved{ false };
+
+        std::atomic<double>     _latencySeconds{ 0.0 };
+        std::atomic<double>     _maxLatencySeconds{ 0.0 };
+        std::atomic<uint64_t>   _underruns{ 0 };
+        std::atomic<uint64_t>   _overflows{ 0 };
+        std::atomic<uint64_t>   _framesRendered{ 0 };
+    };
+}
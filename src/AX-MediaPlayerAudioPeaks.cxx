@@ -0,0 +1,384 @@
+//
+//  AX-MediaPlayerAudioPeaks.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerAudioPeaks.h"
+#include "AX-MediaPlayerAudioDecoder.h"
+#include "AX-MediaPlayerExecutor.h"
+
+#include <cmath>
+#include <atomic>
+#include <cfloat>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+    #include <emmintrin.h>
+    #define AX_MEDIAPLAYER_PEAKS_SSE2
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+    #include <arm_neon.h>
+    #define AX_MEDIAPLAYER_PEAKS_NEON
+#endif
+
+namespace
+{
+    static const char kMagic[4] = { 'A', 'X', 'P', 'K' };
+    static const uint32_t kVersion = 1;
+
+    struct PeakHeader
+    {
+        char        magic[4];
+        uint32_t    version;
+        uint32_t    channels;
+        uint32_t    reserved;
+        double      sampleRate;
+        double      binsPerSecond;
+        uint64_t    binCount;
+        double      duration;
+        uint64_t    sourceSize;
+        int64_t     sourceTime;
+    };
+
+    static_assert ( sizeof ( PeakHeader ) == 64, "Peak header must be 64 bytes" );
+    static_assert ( sizeof ( AX::Video::AudioPeaks::Bin ) == 6, "Peak bins must be tightly packed" );
+
+    struct Accumulator
+    {
+        float       min{ FLT_MAX };
+        float       max{ -FLT_MAX };
+        double      sumSquares{ 0.0 };
+        uint64_t    count{ 0 };
+    };
+
+    bool GetSourceStamp ( const std::filesystem::path & source, uint64_t & size, int64_t & time )
+    {
+        std::error_code ec;
+        size = std::filesystem::file_size ( source, ec );
+        if ( ec ) return false;
+
+        time = static_cast<int64_t> ( std::filesystem::last_write_time ( source, ec ).time_since_epoch ( ).count ( ) );
+        return !ec;
+    }
+
+    AX::Video::AudioPeaks::Bin Quantize ( const Accumulator & accumulator )
+    {
+        if ( accumulator.count == 0 ) return { 0, 0, 0 };
+
+        auto toSigned = [] ( float v ) { return static_cast<int16_t> ( std::lround ( std::clamp ( v, -1.0f, 1.0f ) * 32767.0f ) ); };
+        double rms = std::sqrt ( accumulator.sumSquares / accumulator.count );
+
+        return { toSigned ( accumulator.min ), toSigned ( accumulator.max ), static_cast<uint16_t> ( std::lround ( std::clamp ( rms, 0.0, 1.0 ) * 65535.0 ) ) };
+    }
+}
+
+namespace AX::Video
+{
+    void AudioPeaks::Reduce ( const float * samples, size_t count, float & min, float & max, double & sumSquares )
+    {
+        size_t i = 0;
+
+#if defined(AX_MEDIAPLAYER_PEAKS_SSE2)
+        if ( count >= 4 )
+        {
+            __m128 vmin = _mm_set1_ps ( min );
+            __m128 vmax = _mm_set1_ps ( max );
+            __m128 vsum = _mm_setzero_ps ( );
+
+            for ( ; i + 4 <= count; i += 4 )
+            {
+                __m128 v = _mm_loadu_ps ( samples + i );
+                vmin = _mm_min_ps ( vmin, v );
+                vmax = _mm_max_ps ( vmax, v );
+                vsum = _mm_add_ps ( vsum, _mm_mul_ps ( v, v ) );
+            }
+
+            alignas ( 16 ) float lanes[3][4];
+            _mm_store_ps ( lanes[0], vmin );
+            _mm_store_ps ( lanes[1], vmax );
+            _mm_store_ps ( lanes[2], vsum );
+
+            for ( int l = 0; l < 4; l++ )
+            {
+                min = std::min ( min, lanes[0][l] );
+                max = std::max ( max, lanes[1][l] );
+                sumSquares += lanes[2][l];
+            }
+        }
+#elif defined(AX_MEDIAPLAYER_PEAKS_NEON)
+        if ( count >= 4 )
+        {
+            float32x4_t vmin = vdupq_n_f32 ( min );
+            float32x4_t vmax = vdupq_n_f32 ( max );
+            float32x4_t vsum = vdupq_n_f32 ( 0.0f );
+
+            for ( ; i + 4 <= count; i += 4 )
+            {
+                float32x4_t v = vld1q_f32 ( samples + i );
+                vmin = vminq_f32 ( vmin, v );
+                vmax = vmaxq_f32 ( vmax, v );
+                vsum = vmlaq_f32 ( vsum, v, v );
+            }
+
+            float lanes[3][4];
+            vst1q_f32 ( lanes[0], vmin );
+            vst1q_f32 ( lanes[1], vmax );
+            vst1q_f32 ( lanes[2], vsum );
+
+            for ( int l = 0; l < 4; l++ )
+            {
+                min = std::min ( min, lanes[0][l] );
+                max = std::max ( max, lanes[1][l] );
+                sumSquares += lanes[2][l];
+            }
+        }
+#endif
+
+        for ( ; i < count; i++ )
+        {
+            min = std::min ( min, samples[i] );
+            max = std::max ( max, samples[i] );
+            sumSquares += static_cast<double> ( samples[i] ) * samples[i];
+        }
+    }
+
+    std::filesystem::path AudioPeaks::GetCachePath ( const std::filesystem::path & source, float binsPerSecond )
+    {
+        uint64_t size = 0;
+        int64_t time = 0;
+        GetSourceStamp ( source, size, time );
+
+        // FNV-1a over everything that makes a cached overview stale
+        uint64_t hash = 14695981039346656037ull;
+        auto mix = [&] ( const void * data, size_t length )
+        {
+            auto bytes = static_cast<const uint8_t *> ( data );
+            for ( size_t i = 0; i < length; i++ ) { hash ^= bytes[i]; hash *= 1099511628211ull; }
+        };
+
+        auto path = std::filesystem::absolute ( source ).generic_string ( );
+        mix ( path.data ( ), path.size ( ) );
+        mix ( &size, sizeof ( size ) );
+        mix ( &time, sizeof ( time ) );
+        mix ( &binsPerSecond, sizeof ( binsPerSecond ) );
+
+        char name[32];
+        std::snprintf ( name, sizeof ( name ), "%016llx.axpk", static_cast<unsigned long long> ( hash ) );
+
+        std::error_code ec;
+        return std::filesystem::temp_directory_path ( ec ) / "AX-MediaPlayer" / "peaks" / name;
+    }
+
+    AudioPeaksRef AudioPeaks::Open ( const std::filesystem::path & path )
+    {
+        auto file = MappedFile::Open ( path );
+        if ( !file || file->Size ( ) < sizeof ( PeakHeader ) ) return nullptr;
+
+        PeakHeader header;
+        std::memcpy ( &header, file->Data ( ), sizeof ( header ) );
+
+        if ( std::memcmp ( header.magic, kMagic, sizeof ( kMagic ) ) != 0 || header.version != kVersion || header.channels == 0 ) return nullptr;
+
+        // Divided rather than multiplied, a corrupt bin count would wrap the product
+        if ( header.binCount > ( file->Size ( ) - sizeof ( PeakHeader ) ) / sizeof ( Bin ) / header.channels ) return nullptr;
+
+        AudioPeaksRef peaks{ new AudioPeaks ( ) };
+        peaks->_file = file;
+        peaks->_bins = reinterpret_cast<const Bin *> ( file->Data ( ) + sizeof ( PeakHeader ) );
+        peaks->_channels = header.channels;
+        peaks->_binCount = header.binCount;
+        peaks->_binsPerSecond = header.binsPerSecond;
+        peaks->_sampleRate = header.sampleRate;
+        peaks->_duration = header.duration;
+        peaks->_sourceSize = header.sourceSize;
+        peaks->_sourceTime = header.sourceTime;
+
+        return peaks;
+    }
+
+    AudioPeaksRef AudioPeaks::Compute ( const std::filesystem::path & source, float binsPerSecond, const std::filesystem::path & output, int threads )
+    {
+        if ( binsPerSecond <= 0.0f ) return nullptr;
+
+        uint64_t sourceSize = 0;
+        int64_t sourceTime = 0;
+        if ( !GetSourceStamp ( source, sourceSize, sourceTime ) ) return nullptr;
+
+        auto path = output.empty ( ) ? GetCachePath ( source, binsPerSecond ) : output;
+        if ( output.empty ( ) )
+        {
+            auto cached = Open ( path );
+            if ( cached && cached->_sourceSize == sourceSize && cached->_sourceTime == sourceTime ) return cached;
+        }
+
+        auto probe = AudioDecoder::Create ( source );
+        if ( !probe ) return nullptr;
+
+        const size_t channels = probe->GetChannels ( );
+        const double sampleRate = probe->GetSampleRate ( );
+        const double duration = probe->GetDurationInSeconds ( );
+        const uint64_t binCount = static_cast<uint64_t> ( std::ceil ( duration * binsPerSecond ) );
+        if ( channels == 0 || sampleRate <= 0.0 || binCount == 0 ) return nullptr;
+
+        // First frame of each bin, a frame f lands in bin floor ( f * binsPerSecond / sampleRate )
+        const double framesPerBin = sampleRate / binsPerSecond;
+        auto firstFrameOfBin = [&] ( uint64_t bin ) { return static_cast<int64_t> ( std::ceil ( bin * framesPerBin ) ); };
+        auto binOfFrame = [&] ( int64_t frame )
+        {
+            // Nudge the estimate so it always agrees with firstFrameOfBin, otherwise a rounding
+            // disagreement on a bin edge would produce an empty span
+            uint64_t bin = static_cast<uint64_t> ( std::max ( 0.0, std::floor ( frame / framesPerBin ) ) );
+            while ( bin > 0 && firstFrameOfBin ( bin ) > frame ) bin--;
+            while ( firstFrameOfBin ( bin + 1 ) <= frame ) bin++;
+            return bin;
+        };
+
+        // Chunks are cut on bin edges so every bin belongs to exactly one
+        // thread and nothing needs merging. Short files aren't worth more than one decoder.
+        auto & executor = Executor::Shared ( );
+        if ( threads <= 0 ) threads = static_cast<int> ( executor.GetThreadCount ( ) ) + 1;
+        threads = static_cast<int> ( std::clamp<uint64_t> ( static_cast<uint64_t> ( duration / 10.0 ), 1, static_cast<uint64_t> ( threads ) ) );
+
+        std::vector<Bin> bins ( binCount * channels, Bin{ 0, 0, 0 } );
+        std::vector<std::unique_ptr<AudioDecoder>> decoders ( threads );
+        std::atomic_bool failed{ false };
+
+        // Chunks run on whichever thread takes them and a decoder has to stay on the one that
+        // made it, so the probe is only worth keeping when the caller does everything itself
+        if ( threads == 1 ) decoders[0] = std::move ( probe );
+        probe.reset ( );
+
+        auto decodeChunk = [&] ( int chunk )
+        {
+            uint64_t firstBin = binCount * chunk / threads;
+            uint64_t endBin = binCount * ( chunk + 1 ) / threads;
+            int64_t firstFrame = firstFrameOfBin ( firstBin );
+            int64_t endFrame = endBin == binCount ? INT64_MAX : firstFrameOfBin ( endBin );
+
+            auto & decoder = decoders[chunk];
+            if ( !decoder ) decoder = AudioDecoder::Create ( source );
+            if ( !decoder || decoder->GetChannels ( ) != channels )
+            {
+                // A chunk left empty would be cached as silence
+                decoder.reset ( );
+                failed.store ( true );
+                return;
+            }
+
+            // Another chunk already failed, nothing here is going to be kept
+            if ( failed.load ( ) )
+            {
+                decoder.reset ( );
+                return;
+            }
+
+            if ( firstFrame > 0 ) decoder->Seek ( firstFrame / sampleRate );
+
+            std::vector<float> packet;
+            std::vector<float> planar;
+            std::vector<Accumulator> accumulators ( channels );
+            uint64_t currentBin = firstBin;
+            int64_t nextFrame = -1;
+            double start = 0.0;
+
+            auto flush = [&]
+            {
+                if ( currentBin < endBin )
+                {
+                    for ( size_t c = 0; c < channels; c++ ) bins[currentBin * channels + c] = Quantize ( accumulators[c] );
+                }
+                std::fill ( accumulators.begin ( ), accumulators.end ( ), Accumulator ( ) );
+            };
+
+            while ( decoder->Decode ( packet, start ) )
+            {
+                size_t frames = packet.size ( ) / channels;
+
+                // Trust the running count over per packet timestamps unless they jump (i.e a gap)
+                int64_t stamped = std::llround ( start * sampleRate );
+                if ( nextFrame < 0 || std::abs ( stamped - nextFrame ) > static_cast<int64_t> ( sampleRate / 1000.0 ) ) nextFrame = stamped;
+
+                int64_t frame = nextFrame;
+                nextFrame += static_cast<int64_t> ( frames );
+
+                size_t position = 0;
+                if ( frame < firstFrame )
+                {
+                    position = static_cast<size_t> ( std::min<int64_t> ( firstFrame - frame, static_cast<int64_t> ( frames ) ) );
+                    frame += static_cast<int64_t> ( position );
+                }
+
+                while ( position < frames && frame < endFrame )
+                {
+                    uint64_t bin = binOfFrame ( frame );
+                    if ( bin != currentBin )
+                    {
+                        flush ( );
+                        currentBin = bin;
+                    }
+
+                    int64_t binEnd = std::min ( firstFrameOfBin ( bin + 1 ), endFrame );
+                    size_t span = static_cast<size_t> ( std::min<int64_t> ( binEnd - frame, static_cast<int64_t> ( frames - position ) ) );
+
+                    planar.resize ( span );
+                    for ( size_t c = 0; c < channels; c++ )
+                    {
+                        const float * in = packet.data ( ) + position * channels + c;
+                        for ( size_t i = 0; i < span; i++ ) planar[i] = in[i * channels];
+
+                        auto & accumulator = accumulators[c];
+                        Reduce ( planar.data ( ), span, accumulator.min, accumulator.max, accumulator.sumSquares );
+                        accumulator.count += span;
+                    }
+
+                    position += span;
+                    frame += static_cast<int64_t> ( span );
+                }
+
+                if ( frame >= endFrame ) break;
+            }
+
+            flush ( );
+
+            // Platform decoders may hold per thread state (COM on Windows), release them where they were made
+            decoder.reset ( );
+        };
+
+        executor.ParallelFor ( Executor::Priority::Background, static_cast<size_t> ( threads ), [&] ( size_t chunk ) { decodeChunk ( static_cast<int> ( chunk ) ); } );
+        if ( failed.load ( ) ) return nullptr;
+
+        std::error_code ec;
+        std::filesystem::create_directories ( path.parent_path ( ), ec );
+
+        PeakHeader header{ };
+        std::memcpy ( header.magic, kMagic, sizeof ( kMagic ) );
+        header.version = kVersion;
+        header.channels = static_cast<uint32_t> ( channels );
+        header.sampleRate = sampleRate;
+        header.binsPerSecond = binsPerSecond;
+        header.binCount = binCount;
+        header.duration = duration;
+        header.sourceSize = sourceSize;
+        header.sourceTime = sourceTime;
+
+        // Write beside and rename so a reader never maps a half written file
+        auto partial = path;
+        partial += ".part";
+
+        {
+            std::ofstream file ( partial, std::ios::binary | std::ios::trunc );
+            file.write ( reinterpret_cast<const char *> ( &header ), sizeof ( header ) );
+            file.write ( reinterpret_cast<const char *> ( bins.data ( ) ), static_cast<std::streamsize> ( bins.size ( ) * sizeof ( Bin ) ) );
+            if ( !file ) return nullptr;
+        }
+
+        std::filesystem::rename ( partial, path, ec );
+        if ( ec ) return nullptr;
+
+        return Open ( path );
+    }
+}
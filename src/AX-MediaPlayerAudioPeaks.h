@@ -0,0 +1,71 @@
+//
+//  AX-MediaPlayerAudioPeaks.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include "AX-MediaPlayerMappedFile.h"
+
+#include <vector>
+#include <string>
+
+namespace AX::Video
+{
+    using AudioPeaksRef = std::shared_ptr<class AudioPeaks>;
+
+    // Min / max / RMS overview of a file's audio at a fixed number of bins
+    // per second, for drawing waveforms. Stored as 16 bit values in a file that's mapped
+    // straight back in, so a two hour clip's overview is a few MB and opens instantly.
+    class AudioPeaks
+    {
+    public:
+
+        struct Bin
+        {
+            int16_t     min;
+            int16_t     max;
+            uint16_t    rms;
+        };
+
+        // Decodes `source` in parallel chunks and writes the peak file. With no `output`
+        // the result is cached by path, size and modification time and reused next time.
+        static AudioPeaksRef    Compute ( const std::filesystem::path & source, float binsPerSecond, const std::filesystem::path & output = { }, int threads = 0 );
+        static AudioPeaksRef    Open ( const std::filesystem::path & path );
+        static std::filesystem::path GetCachePath ( const std::filesystem::path & source, float binsPerSecond );
+
+        // SIMD min / max / sum of squares over a run of samples from one channel
+        static void             Reduce ( const float * samples, size_t count, float & min, float & max, double & sumSquares );
+
+        inline size_t   GetChannels ( ) const { return _channels; }
+        inline uint64_t GetBinCount ( ) const { return _binCount; }
+        inline double   GetBinsPerSecond ( ) const { return _binsPerSecond; }
+        inline double   GetSampleRate ( ) const { return _sampleRate; }
+        inline double   GetDurationInSeconds ( ) const { return _duration; }
+
+        // Bins are stored [bin][channel]
+        inline const Bin & GetBin ( uint64_t bin, size_t channel ) const { return _bins[bin * _channels + channel]; }
+        inline float    GetMin ( uint64_t bin, size_t channel ) const { return GetBin ( bin, channel ).min / 32767.0f; }
+        inline float    GetMax ( uint64_t bin, size_t channel ) const { return GetBin ( bin, channel ).max / 32767.0f; }
+        inline float    GetRms ( uint64_t bin, size_t channel ) const { return GetBin ( bin, channel ).rms / 65535.0f; }
+
+        inline const MappedFileRef & GetFile ( ) const { return _file; }
+
+    protected:
+
+        AudioPeaks ( ) { };
+
+        MappedFileRef   _file;
+        const Bin *     _bins{ nullptr };
+        size_t          _channels{ 0 };
+        uint64_t        _binCount{ 0 };
+        double          _binsPerSecond{ 0.0 };
+        double          _sampleRate{ 0.0 };
+        double          _duration{ 0.0 };
+        uint64_t        _sourceSize{ 0 };
+        int64_t         _sourceTime{ 0 };
+    };
+}
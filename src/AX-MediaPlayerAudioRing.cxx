@@ -0,0 +1,98 @@
+//
+//  AX-MediaPlayerAudioRing.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerAudioRing.h"
+
+#include <algorithm>
+
+namespace AX::Video
+{
+    void AudioRing::Allocate ( size_t channels, size_t minimumFrames )
+    {
+        _capacity = 1;
+        while ( _capacity < minimumFrames ) _capacity <<= 1;
+
+        _channels = std::max<size_t> ( channels, 1 );
+        _mask = _capacity - 1;
+        _data.assign ( _capacity * _channels, 0.0f );
+        _readIndex.store ( 0 );
+        _writeIndex.store ( 0 );
+    }
+
+    size_t AudioRing::GetReadAvailable ( ) const
+    {
+        return _writeIndex.load ( std::memory_order_acquire ) - _readIndex.load ( std::memory_order_acquire );
+    }
+
+    size_t AudioRing::GetWriteAvailable ( ) const
+    {
+        return _capacity - GetReadAvailable ( );
+    }
+
+    size_t AudioRing::Write ( const float * interleaved, size_t frames )
+    {
+        size_t write = _writeIndex.load ( std::memory_order_relaxed );
+        size_t read = _readIndex.load ( std::memory_order_acquire );
+        frames = std::min ( frames, _capacity - ( write - read ) );
+
+        // At most two contiguous runs either side of the wrap
+        size_t first = std::min ( frames, _capacity - ( write & _mask ) );
+        std::copy_n ( interleaved, first * _channels, _data.data ( ) + ( write & _mask ) * _channels );
+        std::copy_n ( interleaved + first * _channels, ( frames - first ) * _channels, _data.data ( ) );
+
+        _writeIndex.store ( write + frames, std::memory_order_release );
+        return frames;
+    }
+
+    size_t AudioRing::Write ( const float * const * planar, size_t frames )
+    {
+        size_t write = _writeIndex.load ( std::memory_order_relaxed );
+        size_t read = _readIndex.load ( std::memory_order_acquire );
+        frames = std::min ( frames, _capacity - ( write - read ) );
+
+        for ( size_t i = 0; i < frames; i++ )
+        {
+            float * frame = _data.data ( ) + ( ( write + i ) & _mask ) * _channels;
+            for ( size_t c = 0; c < _channels; c++ ) frame[c] = planar[c][i];
+        }
+
+        _writeIndex.store ( write + frames, std::memory_order_release );
+        return frames;
+    }
+
+    size_t AudioRing::Read ( float * const * planar, size_t frames )
+    {
+        size_t read = _readIndex.load ( std::memory_order_relaxed );
+        size_t write = _writeIndex.load ( std::memory_order_acquire );
+        frames = std::min ( frames, write - read );
+
+        for ( size_t i = 0; i < frames; i++ )
+        {
+            const float * frame = _data.data ( ) + ( ( read + i ) & _mask ) * _channels;
+            for ( size_t c = 0; c < _channels; c++ ) planar[c][i] = frame[c];
+        }
+
+        _readIndex.store ( read + frames, std::memory_order_release );
+        return frames;
+    }
+
+    size_t AudioRing::Skip ( size_t frames )
+    {
+        size_t read = _readIndex.load ( std::memory_order_relaxed );
+        size_t write = _writeIndex.load ( std::memory_order_acquire );
+        frames = std::min ( frames, write - read );
+
+        _readIndex.store ( read + frames, std::memory_order_release );
+        return frames;
+    }
+
+    void AudioRing::Clear ( )
+    {
+        _readIndex.store ( _writeIndex.load ( std::memory_order_acquire ), std::memory_order_release );
+    }
+}
@@ -0,0 +1,55 @@
+//
+//  AX-MediaPlayerAudioRing.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+
+namespace AX::Video
+{
+    // Wait-free single producer / single consumer ring of interleaved
+    // float frames. Write ( ) must only ever be called from one thread and Read ( ) /
+    // Clear ( ) from one other, which is exactly the decoder -> audio thread hand off.
+    class AudioRing
+    {
+    public:
+
+        AudioRing ( ) { };
+        AudioRing ( size_t channels, size_t minimumFrames ) { Allocate ( channels, minimumFrames ); }
+
+        // Not thread safe, neither side may be touching the ring while it's resized
+        void    Allocate ( size_t channels, size_t minimumFrames );
+
+        size_t  Write ( const float * interleaved, size_t frames );
+        size_t  Write ( const float * const * planar, size_t frames );
+
+        // Deinterleaves into one pointer per channel
+        size_t  Read ( float * const * planar, size_t frames );
+        size_t  Skip ( size_t frames );
+        void    Clear ( );
+
+        size_t  GetReadAvailable ( ) const;
+        size_t  GetWriteAvailable ( ) const;
+
+        inline size_t GetChannels ( ) const { return _channels; }
+        inline size_t GetCapacity ( ) const { return _capacity; }
+
+    protected:
+
+        std::vector<float>  _data;
+        size_t              _channels{ 0 };
+        size_t              _capacity{ 0 };
+        size_t              _mask{ 0 };
+
+        // Free running frame counters, only ever masked on access
+        alignas ( 64 ) std::atomic<size_t> _readIndex{ 0 };
+        alignas ( 64 ) std::atomic<size_t> _writeIndex{ 0 };
+    };
+}
@@ -0,0 +1,308 @@
+//
+//  AX-MediaPlayerBundle.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerBundle.h"
+
+#include <mutex>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <unordered_set>
+
+namespace
+{
+    static const char kMagic[4] = { 'A', 'X', 'M', 'B' };
+
+    struct BundleHeader
+    {
+        char        magic[4];
+        uint32_t    version;
+        uint32_t    alignment;
+        uint32_t    entryCount;
+        uint64_t    indexOffset;
+        uint64_t    indexSize;
+        uint8_t     reserved[32];
+    };
+
+    struct BundleRecord
+    {
+        uint64_t    offset;
+        uint64_t    length;
+        uint32_t    nameLength;
+        uint32_t    metadataLength;
+    };
+
+    static_assert ( sizeof ( BundleHeader ) == 64, "Bundle header must be 64 bytes" );
+    static_assert ( sizeof ( BundleRecord ) == 24, "Bundle record must be 24 bytes" );
+
+    inline uint64_t AlignUp ( uint64_t value, uint64_t alignment )
+    {
+        return ( value + alignment - 1 ) / alignment * alignment;
+    }
+
+    std::string EncodeMetadata ( const AX::Video::MediaBundle::Metadata & metadata )
+    {
+        std::string result;
+        for ( auto & [key, value] : metadata )
+        {
+            result += key + "=" + value + "\n";
+        }
+        return result;
+    }
+
+    AX::Video::MediaBundle::Metadata DecodeMetadata ( const char * data, size_t length )
+    {
+        AX::Video::MediaBundle::Metadata result;
+        std::string text ( data, length );
+
+        size_t start = 0;
+        while ( start < text.size ( ) )
+        {
+            size_t end = text.find ( '\n', start );
+            if ( end == std::string::npos ) end = text.size ( );
+
+            auto line = text.substr ( start, end - start );
+            auto split = line.find ( '=' );
+            if ( split != std::string::npos )
+            {
+                result[line.substr ( 0, split )] = line.substr ( split + 1 );
+            }
+
+            start = end + 1;
+        }
+
+        return result;
+    }
+
+    std::mutex                                      kMountMutex;
+    std::vector<AX::Video::MediaBundleRef>          kMountedBundles;
+}
+
+namespace AX::Video
+{
+    MediaBundleRef MediaBundle::Open ( const std::filesystem::path & path )
+    {
+        auto file = MappedFile::Open ( path );
+        if ( !file ) return nullptr;
+
+        MediaBundleRef bundle{ new MediaBundle ( ) };
+        bundle->_file = file;
+
+        if ( !bundle->ParseIndex ( ) ) return nullptr;
+        return bundle;
+    }
+
+    bool MediaBundle::ParseIndex ( )
+    {
+        if ( _file->Size ( ) < sizeof ( BundleHeader ) ) return false;
+
+        BundleHeader header;
+        std::memcpy ( &header, _file->Data ( ), sizeof ( header ) );
+
+        if ( std::memcmp ( header.magic, kMagic, sizeof ( kMagic ) ) != 0 ) return false;
+        if ( header.version != kVersion ) return false;
+
+        // Everything here comes from the file, so the checks are all written as
+        // subtractions from what's known to fit. `a + b > size` wraps for a crafted offset.
+        const uint64_t fileSize = _file->Size ( );
+        if ( header.indexOffset > fileSize || header.indexSize > fileSize - header.indexOffset ) return false;
+        if ( header.entryCount > header.indexSize / sizeof ( BundleRecord ) ) return false;
+
+        const uint8_t * index = _file->Data ( ) + header.indexOffset;
+        uint64_t cursor = 0;
+
+        _entries.reserve ( header.entryCount );
+        for ( uint32_t i = 0; i < header.entryCount; i++ )
+        {
+            BundleRecord record;
+            if ( cursor > header.indexSize || sizeof ( record ) > header.indexSize - cursor ) return false;
+            std::memcpy ( &record, index + cursor, sizeof ( record ) );
+
+            const uint64_t payload = static_cast<uint64_t> ( record.nameLength ) + record.metadataLength;
+            if ( payload > header.indexSize - cursor - sizeof ( record ) ) return false;
+            if ( record.offset > fileSize || record.length > fileSize - record.offset ) return false;
+
+            const char * name = reinterpret_cast<const char *> ( index + cursor + sizeof ( record ) );
+
+            Entry entry;
+            entry.name.assign ( name, record.nameLength );
+            entry.metadata = DecodeMetadata ( name + record.nameLength, record.metadataLength );
+            entry.offset = record.offset;
+            entry.length = record.length;
+
+            cursor += AlignUp ( sizeof ( record ) + payload, 8 );
+
+            _lookup[entry.name] = _entries.size ( );
+            _entries.push_back ( std::move ( entry ) );
+        }
+
+        return true;
+    }
+
+    bool MediaBundle::Pack ( const std::filesystem::path & output, const std::vector<PackInput> & inputs, uint32_t alignment, std::string * error )
+    {
+        auto fail = [&] ( const std::string & message )
+        {
+            if ( error ) *error = message;
+            return false;
+        };
+
+        if ( alignment == 0 || ( alignment & ( alignment - 1 ) ) != 0 ) return fail ( "Alignment must be a power of two" );
+
+        struct Pending
+        {
+            BundleRecord    record;
+            std::string     name;
+            std::string     metadata;
+        };
+
+        std::vector<Pending> pending;
+        pending.reserve ( inputs.size ( ) );
+
+        std::unordered_set<std::string> names;
+        uint64_t indexSize = 0;
+        for ( auto & input : inputs )
+        {
+            std::error_code ec;
+            auto size = std::filesystem::file_size ( input.file, ec );
+            if ( ec ) return fail ( "Unable to read " + input.file.string ( ) );
+
+            Pending entry{ };
+            entry.name = input.name.empty ( ) ? input.file.filename ( ).string ( ) : input.name;
+            entry.metadata = EncodeMetadata ( input.metadata );
+            entry.record.length = size;
+            entry.record.nameLength = static_cast<uint32_t> ( entry.name.size ( ) );
+            entry.record.metadataLength = static_cast<uint32_t> ( entry.metadata.size ( ) );
+
+            if ( !names.insert ( entry.name ).second ) return fail ( "Duplicate entry name " + entry.name );
+
+            indexSize += AlignUp ( sizeof ( BundleRecord ) + entry.name.size ( ) + entry.metadata.size ( ), 8 );
+            pending.push_back ( std::move ( entry ) );
+        }
+
+        uint64_t offset = AlignUp ( sizeof ( BundleHeader ) + indexSize, alignment );
+        for ( auto & entry : pending )
+        {
+            entry.record.offset = offset;
+            offset = AlignUp ( offset + entry.record.length, alignment );
+        }
+
+        std::ofstream file ( output, std::ios::binary | std::ios::trunc );
+        if ( !file ) return fail ( "Unable to open " + output.string ( ) + " for writing" );
+
+        BundleHeader header{ };
+        std::memcpy ( header.magic, kMagic, sizeof ( kMagic ) );
+        header.version = kVersion;
+        header.alignment = alignment;
+        header.entryCount = static_cast<uint32_t> ( pending.size ( ) );
+        header.indexOffset = sizeof ( BundleHeader );
+        header.indexSize = indexSize;
+        file.write ( reinterpret_cast<const char *> ( &header ), sizeof ( header ) );
+
+        static const char kZeros[4096] = { };
+        auto pad = [&] ( uint64_t target )
+        {
+            uint64_t position = static_cast<uint64_t> ( file.tellp ( ) );
+            while ( position < target )
+            {
+                auto count = std::min<uint64_t> ( target - position, sizeof ( kZeros ) );
+                file.write ( kZeros, static_cast<std::streamsize> ( count ) );
+                position += count;
+            }
+        };
+
+        for ( auto & entry : pending )
+        {
+            uint64_t start = static_cast<uint64_t> ( file.tellp ( ) );
+            file.write ( reinterpret_cast<const char *> ( &entry.record ), sizeof ( entry.record ) );
+            file.write ( entry.name.data ( ), entry.name.size ( ) );
+            file.write ( entry.metadata.data ( ), entry.metadata.size ( ) );
+            pad ( start + AlignUp ( sizeof ( BundleRecord ) + entry.name.size ( ) + entry.metadata.size ( ), 8 ) );
+        }
+
+        std::vector<char> buffer ( 1 << 20 );
+        for ( size_t i = 0; i < pending.size ( ); i++ )
+        {
+            pad ( pending[i].record.offset );
+
+            std::ifstream input ( inputs[i].file, std::ios::binary );
+            if ( !input ) return fail ( "Unable to read " + inputs[i].file.string ( ) );
+
+            uint64_t remaining = pending[i].record.length;
+            while ( remaining > 0 && input )
+            {
+                auto count = std::min<uint64_t> ( remaining, buffer.size ( ) );
+                input.read ( buffer.data ( ), static_cast<std::streamsize> ( count ) );
+                file.write ( buffer.data ( ), input.gcount ( ) );
+                remaining -= static_cast<uint64_t> ( input.gcount ( ) );
+            }
+
+            if ( remaining != 0 ) return fail ( inputs[i].file.string ( ) + " changed size while packing" );
+        }
+
+        if ( !file ) return fail ( "Failed writing " + output.string ( ) );
+        return true;
+    }
+
+    void MediaBundle::Mount ( const MediaBundleRef & bundle )
+    {
+        if ( !bundle ) return;
+
+        std::unique_lock<std::mutex> lk ( kMountMutex );
+        if ( std::find ( kMountedBundles.begin ( ), kMountedBundles.end ( ), bundle ) == kMountedBundles.end ( ) )
+        {
+            kMountedBundles.push_back ( bundle );
+        }
+    }
+
+    void MediaBundle::Unmount ( const MediaBundleRef & bundle )
+    {
+        // Any players already created from this bundle hold a reference
+        // to the mapping through their ByteSource so it's safe to unmount at any time
+        std::unique_lock<std::mutex> lk ( kMountMutex );
+        kMountedBundles.erase ( std::remove ( kMountedBundles.begin ( ), kMountedBundles.end ( ), bundle ), kMountedBundles.end ( ) );
+    }
+
+    bool MediaBundle::IsBundleUrl ( const std::string & url )
+    {
+        return url.compare ( 0, std::strlen ( kUrlScheme ), kUrlScheme ) == 0;
+    }
+
+    ByteSourceRef MediaBundle::Resolve ( const std::string & url )
+    {
+        if ( !IsBundleUrl ( url ) ) return nullptr;
+        auto name = url.substr ( std::strlen ( kUrlScheme ) );
+
+        std::unique_lock<std::mutex> lk ( kMountMutex );
+        for ( auto & bundle : kMountedBundles )
+        {
+            if ( auto source = bundle->OpenEntry ( name ) ) return source;
+        }
+
+        return nullptr;
+    }
+
+    const MediaBundle::Entry * MediaBundle::Find ( const std::string & name ) const
+    {
+        auto it = _lookup.find ( name );
+        return it != _lookup.end ( ) ? &_entries[it->second] : nullptr;
+    }
+
+    ByteSourceRef MediaBundle::OpenEntry ( const std::string & name ) const
+    {
+        if ( auto entry = Find ( name ) )
+        {
+            // Clips are streamed front to back once they're playing
+            _file->Advise ( entry->offset, entry->length, MappedFile::Advice::Sequential );
+            auto key = _file->Path ( ).string ( ) + "@" + std::to_string ( entry->offset ) + "+" + std::to_string ( entry->length );
+            return MemoryByteSource::Create ( entry->name, _file->Data ( ) + entry->offset, entry->length, shared_from_this ( ), key );
+        }
+
+        return nullptr;
+    }
+}
@@ -0,0 +1,82 @@
+//
+//  AX-MediaPlayerBundle.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include "AX-MediaPlayerMappedFile.h"
+#include "AX-MediaPlayerByteSource.h"
+
+#include <map>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace AX::Video
+{
+    using MediaBundleRef = std::shared_ptr<class MediaBundle>;
+
+    // A packed container of many small clips so an installation only
+    // pays for one open ( ) + mmap ( ) at startup instead of one per clip.
+    //
+    // Layout (little endian):
+    //   Header   64 bytes, see kMagic / kVersion
+    //   Index    entryCount records of { offset, length, nameLength, metadataLength, name, metadata }
+    //            with each record padded out to 8 bytes
+    //   Payloads each one starting on an `alignment` boundary
+    //
+    // Players are created from a mounted bundle with MediaPlayer::Create ( "bundle://name" )
+    class MediaBundle : public std::enable_shared_from_this<MediaBundle>
+    {
+    public:
+
+        using Metadata = std::map<std::string, std::string>;
+
+        struct Entry
+        {
+            std::string name;
+            uint64_t    offset{ 0 };
+            uint64_t    length{ 0 };
+            Metadata    metadata;
+        };
+
+        struct PackInput
+        {
+            std::filesystem::path   file;
+            std::string             name;
+            Metadata                metadata;
+        };
+
+        static constexpr uint32_t       kVersion = 1;
+        static constexpr uint32_t       kDefaultAlignment = 4096;
+        static constexpr const char *   kUrlScheme = "bundle://";
+
+        static MediaBundleRef   Open ( const std::filesystem::path & path );
+        static bool             Pack ( const std::filesystem::path & output, const std::vector<PackInput> & inputs, uint32_t alignment = kDefaultAlignment, std::string * error = nullptr );
+
+        // Mounted bundles are searched in the order they were mounted when resolving a bundle:// url
+        static void             Mount ( const MediaBundleRef & bundle );
+        static void             Unmount ( const MediaBundleRef & bundle );
+        static bool             IsBundleUrl ( const std::string & url );
+        static ByteSourceRef    Resolve ( const std::string & url );
+
+        const Entry *           Find ( const std::string & name ) const;
+        ByteSourceRef           OpenEntry ( const std::string & name ) const;
+
+        inline const std::vector<Entry> &   Entries ( ) const { return _entries; }
+        inline const MappedFileRef &        File ( ) const { return _file; }
+
+    protected:
+
+        MediaBundle ( ) { };
+        bool ParseIndex ( );
+
+        MappedFileRef                           _file;
+        std::vector<Entry>                      _entries;
+        std::unordered_map<std::string, size_t> _lookup;
+    };
+}
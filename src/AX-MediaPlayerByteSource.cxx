@@ -0,0 +1,37 @@
+//
+//  AX-MediaPlayerByteSource.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerByteSource.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace AX::Video
+{
+    ByteSourceRef MemoryByteSource::Create ( const std::string & name, const uint8_t * data, uint64_t size, std::shared_ptr<const void> owner, const std::string & key )
+    {
+        if ( !data || size == 0 ) return nullptr;
+        return ByteSourceRef ( new MemoryByteSource ( name, data, size, std::move ( owner ), key ) );
+    }
+
+    MemoryByteSource::MemoryByteSource ( const std::string & name, const uint8_t * data, uint64_t size, std::shared_ptr<const void> owner, const std::string & key )
+        : ByteSource ( name, key )
+        , _data ( data )
+        , _size ( size )
+        , _owner ( std::move ( owner ) )
+    { }
+
+    size_t MemoryByteSource::Read ( uint64_t offset, void * destination, size_t length )
+    {
+        if ( offset >= _size ) return 0;
+
+        size_t count = static_cast<size_t> ( std::min<uint64_t> ( length, _size - offset ) );
+        std::memcpy ( destination, _data + offset, count );
+        return count;
+    }
+}
@@ -0,0 +1,69 @@
+//
+//  AX-MediaPlayerByteSource.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace AX::Video
+{
+    using ByteSourceRef = std::shared_ptr<class ByteSource>;
+
+    // A random access, read-only stream of bytes that the platform
+    // backends can pull from instead of handing a file path or url to the OS.
+    // Read ( ) may be called from any thread, and from several at once.
+    class ByteSource
+    {
+    public:
+
+        virtual ~ByteSource ( ) { };
+
+        virtual uint64_t        Size ( ) const = 0;
+        virtual size_t          Read ( uint64_t offset, void * destination, size_t length ) = 0;
+
+        // Only non-null if the whole source is resident in (or mapped into) memory
+        virtual const uint8_t * Data ( ) const { return nullptr; }
+
+        // Used by the backends to sniff the container type from the extension
+        inline const std::string & Name ( ) const { return _name; }
+
+        // Where the bytes come from (a path, url or bundle entry), for anything cached per source.
+        // Two sources with the same key have the same contents. Falls back to the name.
+        inline const std::string & Key ( ) const { return _key.empty ( ) ? _name : _key; }
+
+    protected:
+
+        ByteSource ( const std::string & name, const std::string & key = { } ) : _name ( name ), _key ( key ) { }
+
+        std::string _name;
+        std::string _key;
+    };
+
+    class MemoryByteSource : public ByteSource
+    {
+    public:
+
+        // `owner` is kept alive for as long as this source is, i.e the mapping `data` points into
+        static ByteSourceRef Create ( const std::string & name, const uint8_t * data, uint64_t size, std::shared_ptr<const void> owner = nullptr, const std::string & key = { } );
+
+        uint64_t        Size ( ) const override { return _size; }
+        size_t          Read ( uint64_t offset, void * destination, size_t length ) override;
+        const uint8_t * Data ( ) const override { return _data; }
+
+    protected:
+
+        MemoryByteSource ( const std::string & name, const uint8_t * data, uint64_t size, std::shared_ptr<const void> owner, const std::string & key );
+
+        const uint8_t *             _data{ nullptr };
+        uint64_t                    _size{ 0 };
+        std::shared_ptr<const void> _owner;
+    };
+}
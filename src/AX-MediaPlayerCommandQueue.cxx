@@ -0,0 +1,120 @@
+//
+//  AX-MediaPlayerCommandQueue.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerCommandQueue.h"
+
+#include <iostream>
+
+namespace AX::Video
+{
+    CommandQueue::CommandQueue ( Executor::Priority priority, Executor & executor )
+        : _executor ( executor )
+        , _priority ( priority )
+    { }
+
+    void CommandQueue::Push ( Kind kind, Executor::Task apply )
+    {
+        if ( !apply ) return;
+
+        Node * node = new Node{ kind, std::move ( apply ) };
+        node->next = _state->head.load ( std::memory_order_relaxed );
+        while ( !_state->head.compare_exchange_weak ( node->next, node ) ) { }
+
+        _state->pushed.fetch_add ( 1, std::memory_order_relaxed );
+
+        // Whoever flips `scheduled` owns the one drain that's allowed to be in flight
+        if ( !_state->scheduled.exchange ( true ) )
+        {
+            _executor.Submit ( _priority, [state = _state] { Drain ( state ); } );
+        }
+    }
+
+    std::future<void> CommandQueue::Flush ( )
+    {
+        auto promise = std::make_shared<std::promise<void>> ( );
+        auto future = promise->get_future ( );
+        Push ( Kind::Ordered, [promise] { promise->set_value ( ); } );
+        return future;
+    }
+
+    void CommandQueue::Drain ( const std::shared_ptr<State> & state )
+    {
+        while ( true )
+        {
+            Node * stack = state->head.exchange ( nullptr );
+            if ( !stack )
+            {
+                // A push that landed after the exchange saw `scheduled` still set and left it
+                // to this drain, so look once more before giving up the job
+                state->scheduled.store ( false );
+                if ( !state->head.load ( ) || state->scheduled.exchange ( true ) ) return;
+                continue;
+            }
+
+            // Newest first off the stack, flip it back into the order things were pushed, noting
+            // the last of every kind on the way since that's the only one that gets to run
+            Node * batch = nullptr;
+            Node * latest[kKindCount]{ };
+            while ( stack )
+            {
+                Node * next = stack->next;
+                if ( stack->kind != Kind::Ordered )
+                {
+                    auto & last = latest[static_cast<size_t> ( stack->kind )];
+                    if ( !last ) last = stack;
+                }
+
+                stack->next = batch;
+                batch = stack;
+                stack = next;
+            }
+
+            while ( batch )
+            {
+                std::unique_ptr<Node> node{ batch };
+                batch = batch->next;
+
+                if ( node->kind != Kind::Ordered && latest[static_cast<size_t> ( node->kind )] != node.get ( ) )
+                {
+                    state->coalesced.fetch_add ( 1, std::memory_order_relaxed );
+                    continue;
+                }
+
+                try
+                {
+                    node->apply ( );
+                }
+                catch ( const std::exception & e )
+                {
+                    std::cout << "Error: " << e.what ( ) << std::endl;
+                }
+
+                state->applied.fetch_add ( 1, std::memory_order_relaxed );
+            }
+        }
+    }
+
+    CommandQueue::Stats CommandQueue::GetStats ( ) const
+    {
+        Stats stats;
+        stats.pushed = _state->pushed.load ( );
+        stats.applied = _state->applied.load ( );
+        stats.coalesced = _state->coalesced.load ( );
+        return stats;
+    }
+
+    CommandQueue::State::~State ( )
+    {
+        for ( Node * node = head.load ( ); node; )
+        {
+            Node * next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+}
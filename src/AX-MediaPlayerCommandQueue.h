@@ -0,0 +1,83 @@
+//
+//  AX-MediaPlayerCommandQueue.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include "AX-MediaPlayerExecutor.h"
+
+namespace AX::Video
+{
+    // A player's control calls, queued by whoever makes them and applied in order
+    // by one Executor task at a time. Pushing is a single compare and swap onto a lock-free stack
+    // that the applying task takes all at once, so a caller never waits on the backend. Within
+    // what's taken together, only the latest command of each kind runs (sweeping the volume of
+    // 30 players is 30 pushes and, at most, a handful of engine calls per player).
+    class CommandQueue
+    {
+    public:
+
+        enum class Kind : uint8_t
+        {
+            Playback,       // Play / Pause
+            Seek,
+            Volume,
+            Muted,
+            Loop,
+            Rate,
+            Ordered,        // Never coalesced, i.e toggles, frame steps, shutdown
+        };
+
+        struct Stats
+        {
+            uint64_t    pushed{ 0 };
+            uint64_t    applied{ 0 };
+            uint64_t    coalesced{ 0 };     // Superseded by a later command of the same kind
+        };
+
+        CommandQueue ( Executor::Priority priority = Executor::Priority::Present, Executor & executor = Executor::Shared ( ) );
+
+        CommandQueue ( const CommandQueue & ) = delete;
+        CommandQueue & operator= ( const CommandQueue & ) = delete;
+
+        void                Push ( Kind kind, Executor::Task apply );
+
+        // Ready once everything pushed before it has been applied or superseded
+        std::future<void>   Flush ( );
+
+        Stats               GetStats ( ) const;
+
+    protected:
+
+        static constexpr size_t kKindCount = static_cast<size_t> ( Kind::Ordered );
+
+        struct Node
+        {
+            Kind                kind;
+            Executor::Task      apply;
+            Node *              next{ nullptr };
+        };
+
+        // Outlives the queue for as long as a drain is still running
+        struct State
+        {
+            std::atomic<Node *>     head{ nullptr };
+            std::atomic_bool        scheduled{ false };
+            std::atomic<uint64_t>   pushed{ 0 };
+            std::atomic<uint64_t>   applied{ 0 };
+            std::atomic<uint64_t>   coalesced{ 0 };
+
+            ~State ( );
+        };
+
+        static void Drain ( const std::shared_ptr<State> & state );
+
+        Executor &              _executor;
+        Executor::Priority      _priority;
+        std::shared_ptr<State>  _state{ std::make_shared<State> ( ) };
+    };
+}
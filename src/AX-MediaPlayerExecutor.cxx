@@ -0,0 +1,354 @@
+//
+//  AX-MediaPlayerExecutor.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerExecutor.h"
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+    #include <objbase.h>
+#endif
+
+#include <iostream>
+#include <algorithm>
+
+namespace
+{
+    using namespace AX::Video;
+
+    thread_local const Executor * tExecutor{ nullptr };
+    thread_local size_t tIndex{ 0 };
+
+    // Enough that one stalled read doesn't hold up every other player's
+    constexpr int kIoThreads = 4;
+
+    struct SharedState
+    {
+        std::mutex                  mutex;
+        Executor::Options           options;
+        std::unique_ptr<Executor>   executor;
+    };
+
+    SharedState & GetSharedState ( )
+    {
+        static SharedState kState;
+        return kState;
+    }
+
+    void Invoke ( const Executor::Task & task )
+    {
+        try
+        {
+            task ( );
+        }
+        catch ( const std::exception & e )
+        {
+            std::cout << "Error: " << e.what ( ) << std::endl;
+        }
+    }
+}
+
+namespace AX::Video
+{
+    bool Executor::Configure ( const Options & options )
+    {
+        auto & shared = GetSharedState ( );
+        std::unique_lock<std::mutex> lk ( shared.mutex );
+        if ( shared.executor ) return false;
+
+        shared.options = options;
+        return true;
+    }
+
+    Executor & Executor::Shared ( )
+    {
+        auto & shared = GetSharedState ( );
+        std::unique_lock<std::mutex> lk ( shared.mutex );
+        if ( !shared.executor ) shared.executor = std::make_unique<Executor> ( shared.options );
+
+        return *shared.executor;
+    }
+
+    Executor & Executor::Io ( )
+    {
+        static Executor kIo ( Options ( ).Threads ( kIoThreads ) );
+        return kIo;
+    }
+
+    bool Executor::IsWorkerThread ( )
+    {
+        return tExecutor != nullptr;
+    }
+
+    Executor::Executor ( const Options & options )
+    {
+        int threads = options.GetThreads ( );
+        if ( threads <= 0 ) threads = static_cast<int> ( std::thread::hardware_concurrency ( ) ) - 1;
+
+        // A task that's waiting on another (a Strand::Flush ( ), a transfer) needs a second worker to run it
+        threads = std::max ( 2, threads );
+
+        for ( int i = 0; i < threads; i++ ) _workers.push_back ( std::make_unique<Worker> ( ) );
+
+        // Every queue exists before any worker can go looking through them
+        for ( size_t i = 0; i < _workers.size ( ); i++ )
+        {
+            _workers[i]->thread = std::thread ( [=] { Run ( i ); } );
+        }
+    }
+
+    void Executor::Submit ( Priority priority, Task task )
+    {
+        if ( !task ) return;
+
+        // Work submitted from a worker (i.e the helpers of a ParallelFor inside
+        // a task) stays on that worker's queue where it's most likely to still be in cache,
+        // everything else is dealt out round robin and evened up by stealing
+        const size_t index = tExecutor == this ? tIndex : _nextQueue.fetch_add ( 1, std::memory_order_relaxed ) % _workers.size ( );
+        const size_t p = static_cast<size_t> ( priority );
+
+        auto & worker = *_workers[index];
+        {
+            std::unique_lock<std::mutex> lk ( worker.mutex );
+            worker.queues[p].push_back ( std::move ( task ) );
+            worker.sizes[p].store ( worker.queues[p].size ( ), std::memory_order_relaxed );
+        }
+
+        _submitted.fetch_add ( 1, std::memory_order_relaxed );
+        _pending.fetch_add ( 1 );
+
+        // A worker counts itself as sleeping before it checks _pending, so either it sees this
+        // task or this sees it and has to wake it
+        if ( _sleeping.load ( ) > 0 )
+        {
+            {
+                std::unique_lock<std::mutex> lk ( _mutex );
+            }
+
+            _wake.notify_one ( );
+        }
+    }
+
+    bool Executor::Take ( size_t index, Task & task )
+    {
+        const size_t count = _workers.size ( );
+
+        for ( size_t p = 0; p < kPriorityCount; p++ )
+        {
+            for ( size_t n = 0; n < count; n++ )
+            {
+                auto & worker = *_workers[( index + n ) % count];
+                if ( worker.sizes[p].load ( std::memory_order_relaxed ) == 0 ) continue;
+
+                std::unique_lock<std::mutex> lk ( worker.mutex );
+                auto & queue = worker.queues[p];
+                if ( queue.empty ( ) ) continue;
+
+                if ( n == 0 )
+                {
+                    task = std::move ( queue.back ( ) );
+                    queue.pop_back ( );
+                }
+                else
+                {
+                    task = std::move ( queue.front ( ) );
+                    queue.pop_front ( );
+                    _stolen.fetch_add ( 1, std::memory_order_relaxed );
+                }
+
+                worker.sizes[p].store ( queue.size ( ), std::memory_order_relaxed );
+                _pending.fetch_sub ( 1 );
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void Executor::Run ( size_t index )
+    {
+#ifdef _WIN32
+        // So anything run here can talk to the media engine without marshalling,
+        // this is what RunSynchronousInMTAThread ( ) relies on
+        CoInitializeEx ( nullptr, COINIT_MULTITHREADED );
+#endif
+
+        tExecutor = this;
+        tIndex = index;
+
+        Task task;
+        while ( true )
+        {
+            if ( Take ( index, task ) )
+            {
+                Invoke ( task );
+                task = nullptr;
+                _executed.fetch_add ( 1, std::memory_order_relaxed );
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lk ( _mutex );
+
+            // Whatever was submitted before shutdown still runs
+            if ( !_running && _pending.load ( ) == 0 ) break;
+
+            _sleeping.fetch_add ( 1 );
+            _wake.wait ( lk, [this] { return !_running || _pending.load ( ) > 0; } );
+            _sleeping.fetch_sub ( 1 );
+        }
+
+        tExecutor = nullptr;
+
+#ifdef _WIN32
+        CoUninitialize ( );
+#endif
+    }
+
+    void Executor::ParallelFor ( Priority priority, size_t count, const std::function<void ( size_t )> & function, size_t helpers )
+    {
+        if ( count == 0 ) return;
+
+        struct Batch
+        {
+            const std::function<void ( size_t )> * function;
+            size_t                  count;
+            std::atomic<size_t>     next{ 0 };
+            std::atomic<size_t>     done{ 0 };
+            std::mutex              mutex;
+            std::condition_variable finished;
+            std::exception_ptr      error;      // The first one thrown, under `mutex`
+        };
+
+        // Shared because a helper can start after the batch is long done, in
+        // which case there's nothing left for it to take and it never touches `function`
+        auto batch = std::make_shared<Batch> ( );
+        batch->function = &function;
+        batch->count = count;
+
+        // Every index counts as done whether or not it threw, so the caller's wait always ends
+        // and nothing is still inside `function` once it returns
+        auto drain = [] ( Batch & batch )
+        {
+            size_t ran = 0;
+            for ( size_t i = batch.next.fetch_add ( 1 ); i < batch.count; i = batch.next.fetch_add ( 1 ) )
+            {
+                try
+                {
+                    ( *batch.function ) ( i );
+                }
+                catch ( ... )
+                {
+                    std::unique_lock<std::mutex> lk ( batch.mutex );
+                    if ( !batch.error ) batch.error = std::current_exception ( );
+                }
+
+                ran++;
+            }
+
+            if ( ran > 0 && batch.done.fetch_add ( ran ) + ran == batch.count )
+            {
+                std::unique_lock<std::mutex> lk ( batch.mutex );
+                batch.finished.notify_all ( );
+            }
+        };
+
+        helpers = std::min ( { helpers, _workers.size ( ), count - 1 } );
+
+        for ( size_t i = 0; i < helpers; i++ )
+        {
+            Submit ( priority, [batch, drain] { drain ( *batch ); } );
+        }
+
+        drain ( *batch );
+
+        std::unique_lock<std::mutex> lk ( batch->mutex );
+        batch->finished.wait ( lk, [&] { return batch->done.load ( ) == count; } );
+
+        if ( batch->error ) std::rethrow_exception ( batch->error );
+    }
+
+    Executor::Stats Executor::GetStats ( ) const
+    {
+        Stats stats;
+        stats.threads = _workers.size ( );
+        stats.pending = _pending.load ( );
+        stats.submitted = _submitted.load ( );
+        stats.executed = _executed.load ( );
+        stats.stolen = _stolen.load ( );
+        return stats;
+    }
+
+    Executor::~Executor ( )
+    {
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            _running = false;
+        }
+
+        _wake.notify_all ( );
+        for ( auto & worker : _workers )
+        {
+            if ( worker->thread.joinable ( ) ) worker->thread.join ( );
+        }
+    }
+
+    Executor::Strand::Strand ( Priority priority, Executor & executor )
+        : _executor ( executor )
+        , _priority ( priority )
+    { }
+
+    void Executor::Strand::Post ( Task task )
+    {
+        if ( !task ) return;
+
+        bool schedule = false;
+        {
+            std::unique_lock<std::mutex> lk ( _state->mutex );
+            _state->tasks.push_back ( std::move ( task ) );
+            schedule = !_state->running;
+            _state->running = true;
+        }
+
+        // One drain at a time is what keeps them in order
+        if ( schedule )
+        {
+            _executor.Submit ( _priority, [state = _state] { Drain ( state ); } );
+        }
+    }
+
+    void Executor::Strand::Drain ( const std::shared_ptr<State> & state )
+    {
+        while ( true )
+        {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lk ( state->mutex );
+                if ( state->tasks.empty ( ) )
+                {
+                    state->running = false;
+                    return;
+                }
+
+                task = std::move ( state->tasks.front ( ) );
+                state->tasks.pop_front ( );
+            }
+
+            Invoke ( task );
+        }
+    }
+
+    void Executor::Strand::Flush ( )
+    {
+        std::promise<void> promise;
+        auto future = promise.get_future ( );
+        Post ( [&promise] { promise.set_value ( ); } );
+        future.wait ( );
+    }
+}
@@ -0,0 +1,161 @@
+//
+//  AX-MediaPlayerExecutor.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include <mutex>
+#include <cstdint>
+#include <deque>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <type_traits>
+#include <condition_variable>
+
+namespace AX::Video
+{
+    // The one pool of threads every player shares for its background work,
+    // instead of each one (or each feature) spinning up its own. Every worker has a queue per
+    // priority, takes the newest task from its own and steals the oldest from the others when
+    // it runs dry, always trying every queue of a higher priority before a lower one. Tasks
+    // that block (i.e reads) hold a worker while they do, so keep them at a priority that
+    // matches how badly something is waiting on them. No dependency on cinder, like MappedFile.
+    // On Windows every worker is in the multithreaded COM apartment.
+    class Executor
+    {
+    public:
+
+        enum class Priority
+        {
+            Present,        // The next frame on screen is waiting on it
+            Decode,         // Producing frames / samples ahead of when they're needed
+            Prefetch,       // Warming caches, nothing is blocked on it yet
+            Background,     // Teardown, analysis, indexing
+        };
+
+        static constexpr size_t kPriorityCount = 4;
+
+        struct Options
+        {
+            Options & Threads ( int threads ) { _threads = threads; return *this; }
+
+            int     GetThreads ( ) const { return _threads; }
+
+            Options ( ) { };
+
+        protected:
+
+            int     _threads{ 0 };      // Zero leaves one core for the app's main thread, never fewer than two
+        };
+
+        struct Stats
+        {
+            size_t      threads{ 0 };
+            size_t      pending{ 0 };       // Submitted but not started
+            uint64_t    submitted{ 0 };
+            uint64_t    executed{ 0 };
+            uint64_t    stolen{ 0 };        // Run by a worker other than the one it was queued on
+        };
+
+        using Task = std::function<void ( )>;
+
+        // Only takes effect before the first Shared ( ), returns false once the pool is running
+        static bool         Configure ( const Options & options );
+        static Executor &   Shared ( );
+
+        // A small pool of its own for tasks that block on I/O (i.e byte stream reads, which can
+        // wait on the network for seconds), so they never hold up a Shared ( ) worker
+        static Executor &   Io ( );
+
+        // True on any executor's worker threads
+        static bool         IsWorkerThread ( );
+
+        void        Submit ( Priority priority, Task task );
+
+        template <typename Function>
+        auto        Async ( Priority priority, Function && function ) -> std::future<std::invoke_result_t<Function>>
+        {
+            using Result = std::invoke_result_t<Function>;
+
+            auto task = std::make_shared<std::packaged_task<Result ( )>> ( std::forward<Function> ( function ) );
+            auto future = task->get_future ( );
+            Submit ( priority, [task] { ( *task ) ( ); } );
+            return future;
+        }
+
+        // Calls `function` for every index in [0, count) across the calling thread and up to
+        // `helpers` workers (zero runs it all on the caller) and returns once they've all run.
+        // The caller takes indices too, so it finishes even when every worker is busy. If any
+        // call throws the rest still run, and the first exception is rethrown here afterwards.
+        void        ParallelFor ( Priority priority, size_t count, const std::function<void ( size_t )> & function, size_t helpers = SIZE_MAX );
+
+        size_t      GetThreadCount ( ) const { return _workers.size ( ); }
+        Stats       GetStats ( ) const;
+
+        // Runs tasks one at a time in the order they were posted, on whichever worker is free
+        class Strand
+        {
+        public:
+
+            Strand ( Priority priority = Priority::Background, Executor & executor = Executor::Shared ( ) );
+
+            void    Post ( Task task );
+
+            // Blocks until everything posted so far has run. Not from inside one of its own tasks.
+            void    Flush ( );
+
+        protected:
+
+            struct State
+            {
+                std::mutex          mutex;
+                std::deque<Task>    tasks;
+                bool                running{ false };
+            };
+
+            static void Drain ( const std::shared_ptr<State> & state );
+
+            Executor &              _executor;
+            Priority                _priority;
+            std::shared_ptr<State>  _state{ std::make_shared<State> ( ) };
+        };
+
+        Executor ( const Options & options = Options ( ) );
+        ~Executor ( );
+
+        Executor ( const Executor & ) = delete;
+        Executor & operator= ( const Executor & ) = delete;
+
+    protected:
+
+        struct Worker
+        {
+            std::mutex          mutex;
+            std::deque<Task>    queues[kPriorityCount];
+            std::atomic<size_t> sizes[kPriorityCount]{ };   // Lets the others skip empty queues without locking
+            std::thread         thread;
+        };
+
+        bool        Take ( size_t index, Task & task );
+        void        Run ( size_t index );
+
+        std::vector<std::unique_ptr<Worker>> _workers;
+        std::atomic<size_t>     _nextQueue{ 0 };
+        std::atomic<size_t>     _pending{ 0 };
+        std::atomic<size_t>     _sleeping{ 0 };
+        std::atomic<uint64_t>   _submitted{ 0 };
+        std::atomic<uint64_t>   _executed{ 0 };
+        std::atomic<uint64_t>   _stolen{ 0 };
+        std::mutex              _mutex;
+        std::condition_variable _wake;
+        bool                    _running{ true };
+    };
+}
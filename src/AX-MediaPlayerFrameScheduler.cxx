@@ -0,0 +1,153 @@
+//
+//  AX-MediaPlayerFrameScheduler.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerFrameScheduler.h"
+
+#include <cmath>
+
+namespace AX::Video
+{
+    FrameScheduler::Decision FrameScheduler::Evaluate ( double pts, double clock, float rate, double now )
+    {
+        _lastNow = now;
+
+        // Reverse and paused stepping present whatever they're given
+        if ( rate <= 0.0f )
+        {
+            _lastPts = -1.0;
+            _stats.presented++;
+            return Decision::Present;
+        }
+
+        uint64_t missed = 0;
+        double delta = pts - _lastPts;
+
+        // Anything backwards or a long way forwards is a seek or a loop, not a slow app
+        if ( _lastPts >= 0.0 && delta > 0.0 && delta < 1.0 )
+        {
+            if ( _interval <= 0.0 || delta < _interval * 0.75 )
+            {
+                _interval = delta;
+            }
+            else if ( delta < _interval * 1.5 )
+            {
+                _interval += ( delta - _interval ) * 0.1;
+            }
+            else
+            {
+                missed = static_cast<uint64_t> ( std::llround ( delta / _interval ) ) - 1;
+            }
+        }
+
+        _lastPts = pts;
+        _stats.missed += missed;
+
+        const bool superseded = _interval > 0.0 && clock >= pts + _interval;
+        UpdateLoad ( superseded || missed > 0, now );
+
+        if ( superseded && _options.IsSkippingSuperseded ( ) && _consecutiveSkips < _options.GetMaxConsecutiveSkips ( ) )
+        {
+            _consecutiveSkips++;
+            _stats.skippedSuperseded++;
+            return Decision::Superseded;
+        }
+
+        if ( _activeMode == Degrade::HalfRate )
+        {
+            _dropNext = !_dropNext;
+            if ( !_dropNext )
+            {
+                _stats.droppedDegraded++;
+                return Decision::Degraded;
+            }
+        }
+
+        _consecutiveSkips = 0;
+        _stats.presented++;
+        return Decision::Present;
+    }
+
+    void FrameScheduler::UpdateLoad ( bool late, double now )
+    {
+        // A paused player stops producing frames, don't judge the next window by the gap
+        if ( _windowStart < 0.0 || now - _windowStart > kWindowSeconds * 4.0 )
+        {
+            _windowStart = now;
+            _windowFrames = 0;
+            _windowLate = 0;
+            _overloadedSince = -1.0;
+            _calmSince = -1.0;
+        }
+
+        _windowFrames++;
+        if ( late ) _windowLate++;
+
+        if ( now - _windowStart < kWindowSeconds ) return;
+
+        const double fraction = static_cast<double> ( _windowLate ) / _windowFrames;
+        const double threshold = _options.GetOverloadFraction ( );
+        _stats.lateFraction = fraction;
+
+        // Hysteresis, it takes a properly quiet stretch to come back up so a
+        // borderline app doesn't flip modes (and with HalfSize, reallocate targets) every second
+        if ( fraction > threshold )
+        {
+            if ( _overloadedSince < 0.0 ) _overloadedSince = _windowStart;
+        }
+        else
+        {
+            _overloadedSince = -1.0;
+        }
+
+        if ( fraction < threshold * 0.5 )
+        {
+            if ( _calmSince < 0.0 ) _calmSince = _windowStart;
+        }
+        else
+        {
+            _calmSince = -1.0;
+        }
+
+        _windowStart = now;
+        _windowFrames = 0;
+        _windowLate = 0;
+
+        if ( _activeMode == Degrade::None )
+        {
+            if ( _options.GetDegrade ( ) != Degrade::None && _overloadedSince >= 0.0 && now - _overloadedSince >= _options.GetDegradeAfterSeconds ( ) )
+            {
+                _activeMode = _options.GetDegrade ( );
+                _degradedSince = now;
+                _dropNext = false;
+                _stats.degradedTransitions++;
+            }
+        }
+        else if ( _calmSince >= 0.0 && now - _calmSince >= _options.GetRecoverAfterSeconds ( ) )
+        {
+            _stats.degradedSeconds += now - _degradedSince;
+            _activeMode = Degrade::None;
+            _degradedSince = -1.0;
+        }
+    }
+
+    void FrameScheduler::Reset ( )
+    {
+        _lastPts = -1.0;
+        _consecutiveSkips = 0;
+    }
+
+    FrameScheduler::Stats FrameScheduler::GetStats ( ) const
+    {
+        Stats stats = _stats;
+        stats.frameInterval = _interval;
+        stats.activeMode = _activeMode;
+        if ( _degradedSince >= 0.0 ) stats.degradedSeconds += _lastNow - _degradedSince;
+
+        return stats;
+    }
+}
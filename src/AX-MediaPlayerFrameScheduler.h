@@ -0,0 +1,114 @@
+//
+//  AX-MediaPlayerFrameScheduler.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include <cstdint>
+
+namespace AX::Video
+{
+    // Decides, per decoded frame, whether it's worth converting and copying
+    // at all by comparing its presentation time against the playback clock. A frame whose
+    // successor is already due is skipped rather than making a late update later still, and
+    // if the app stays behind for long enough the player steps down to a degraded mode
+    // until it has caught up again.
+    class FrameScheduler
+    {
+    public:
+
+        enum class Degrade
+        {
+            None,
+            HalfRate,   // Only every other frame is converted
+            HalfSize,   // Frames are converted at half resolution
+        };
+
+        enum class Decision
+        {
+            Present,
+            Superseded,     // The next frame was already due, converting this one is wasted work
+            Degraded,       // Dropped by the half rate mode
+        };
+
+        struct Options
+        {
+            Options & SkipSuperseded ( bool enabled ) { _skipSuperseded = enabled; return *this; }
+            Options & MaxConsecutiveSkips ( int count ) { _maxConsecutiveSkips = count; return *this; }
+            Options & DegradeTo ( Degrade mode ) { _degrade = mode; return *this; }
+            Options & OverloadFraction ( float fraction ) { _overloadFraction = fraction; return *this; }
+            Options & DegradeAfterSeconds ( float seconds ) { _degradeAfterSeconds = seconds; return *this; }
+            Options & RecoverAfterSeconds ( float seconds ) { _recoverAfterSeconds = seconds; return *this; }
+
+            bool    IsSkippingSuperseded ( ) const { return _skipSuperseded; }
+            int     GetMaxConsecutiveSkips ( ) const { return _maxConsecutiveSkips; }
+            Degrade GetDegrade ( ) const { return _degrade; }
+            float   GetOverloadFraction ( ) const { return _overloadFraction; }
+            float   GetDegradeAfterSeconds ( ) const { return _degradeAfterSeconds; }
+            float   GetRecoverAfterSeconds ( ) const { return _recoverAfterSeconds; }
+
+            Options ( ) { };
+
+        protected:
+
+            bool    _skipSuperseded{ true };
+            int     _maxConsecutiveSkips{ 2 };      // So a hopelessly slow app still sees something move
+            Degrade _degrade{ Degrade::HalfRate };
+            float   _overloadFraction{ 0.25f };     // Share of late frames that counts as overloaded
+            float   _degradeAfterSeconds{ 1.0f };
+            float   _recoverAfterSeconds{ 3.0f };
+        };
+
+        struct Stats
+        {
+            uint64_t    presented{ 0 };
+            uint64_t    skippedSuperseded{ 0 };     // Handed to us but not worth converting
+            uint64_t    droppedDegraded{ 0 };       // Thrown away by the half rate mode
+            uint64_t    missed{ 0 };                // Never seen at all, the update loop was too slow to be offered them
+            uint64_t    degradedTransitions{ 0 };
+            double      degradedSeconds{ 0.0 };
+            double      frameInterval{ 0.0 };       // Estimated from the timestamps
+            double      lateFraction{ 0.0 };        // Over the last measurement window
+            Degrade     activeMode{ Degrade::None };
+        };
+
+        FrameScheduler ( const Options & options = Options ( ) ) : _options ( options ) { };
+
+        // `pts` and `clock` are media time, `now` is any monotonic wall clock in seconds
+        Decision    Evaluate ( double pts, double clock, float rate, double now );
+
+        // Forget timing history after a seek or anything else that makes the timestamps jump
+        void        Reset ( );
+
+        Degrade     GetActiveMode ( ) const { return _activeMode; }
+        float       GetOutputScale ( ) const { return _activeMode == Degrade::HalfSize ? 0.5f : 1.0f; }
+        Stats       GetStats ( ) const;
+
+    protected:
+
+        void        UpdateLoad ( bool late, double now );
+
+        static constexpr double kWindowSeconds = 0.5;
+
+        Options     _options;
+        Stats       _stats;
+        Degrade     _activeMode{ Degrade::None };
+
+        double      _lastPts{ -1.0 };
+        double      _interval{ 0.0 };
+        int         _consecutiveSkips{ 0 };
+
+        double      _windowStart{ -1.0 };
+        uint32_t    _windowFrames{ 0 };
+        uint32_t    _windowLate{ 0 };
+        double      _overloadedSince{ -1.0 };
+        double      _calmSince{ -1.0 };
+        double      _degradedSince{ -1.0 };
+        double      _lastNow{ 0.0 };
+        bool        _dropNext{ false };
+    };
+}
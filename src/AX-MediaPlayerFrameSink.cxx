@@ -0,0 +1,186 @@
+//
+//  AX-MediaPlayerFrameSink.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerFrameSink.h"
+#include "cinder/Log.h"
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+#include <cstring>
+#include <algorithm>
+
+using namespace ci;
+
+namespace AX::Video
+{
+    std::shared_ptr<CallbackFrameSink> CallbackFrameSink::Create ( const Callback & callback, Thread thread )
+    {
+        if ( !callback ) return nullptr;
+        return std::shared_ptr<CallbackFrameSink> ( new CallbackFrameSink ( callback, thread ) );
+    }
+
+    std::shared_ptr<SurfaceFrameSink> SurfaceFrameSink::Create ( )
+    {
+        return std::shared_ptr<SurfaceFrameSink> ( new SurfaceFrameSink ( ) );
+    }
+
+    void SurfaceFrameSink::OnFrame ( const Frame & frame )
+    {
+        auto view = frame.AsSurface ( );
+        if ( !_surface || _surface->getSize ( ) != frame.size || _surface->getChannelOrder ( ) != frame.channelOrder )
+        {
+            _surface = Surface8u::create ( frame.size.x, frame.size.y, view.hasAlpha ( ), frame.channelOrder );
+        }
+
+        _surface->copyFrom ( view, view.getBounds ( ) );
+        _pts = frame.pts;
+    }
+
+    std::shared_ptr<TextureFrameSink> TextureFrameSink::Create ( const StreamingTexture::Options & options )
+    {
+        return std::shared_ptr<TextureFrameSink> ( new TextureFrameSink ( options ) );
+    }
+
+    void TextureFrameSink::OnFrame ( const Frame & frame )
+    {
+        if ( !_texture ) _texture = StreamingTexture::Create ( _options );
+        _texture->Upload ( frame.AsSurface ( ) );
+    }
+
+    std::shared_ptr<SharedMemoryFrameSink> SharedMemoryFrameSink::Create ( const std::string & name, size_t capacity )
+    {
+        if ( name.empty ( ) || capacity == 0 ) return nullptr;
+
+        std::shared_ptr<SharedMemoryFrameSink> sink ( new SharedMemoryFrameSink ( ) );
+        sink->_name = name;
+        sink->_mappedSize = sizeof ( Header ) + capacity;
+
+#ifdef _WIN32
+        const uint64_t size = sink->_mappedSize;
+        HANDLE mapping = CreateFileMappingA ( INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD> ( size >> 32 ), static_cast<DWORD> ( size & 0xFFFFFFFF ), name.c_str ( ) );
+        if ( !mapping )
+        {
+            CI_LOG_E ( "Couldn't create shared memory " << name );
+            return nullptr;
+        }
+
+        sink->_mapping = mapping;
+        void * data = MapViewOfFile ( mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0 );
+        if ( !data ) return nullptr;
+#else
+        // POSIX names need a single leading slash
+        std::string posixName = name[0] == '/' ? name : "/" + name;
+        sink->_fd = shm_open ( posixName.c_str ( ), O_CREAT | O_RDWR, 0644 );
+        if ( sink->_fd < 0 || ftruncate ( sink->_fd, static_cast<off_t> ( sink->_mappedSize ) ) != 0 )
+        {
+            CI_LOG_E ( "Couldn't create shared memory " << posixName );
+            return nullptr;
+        }
+
+        void * data = mmap ( nullptr, sink->_mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, sink->_fd, 0 );
+        if ( data == MAP_FAILED ) return nullptr;
+#endif
+
+        sink->_header = new ( data ) Header ( );
+        sink->_pixels = static_cast<uint8_t *> ( data ) + sizeof ( Header );
+        sink->_header->magic = kMagic;
+        sink->_header->version = kVersion;
+        sink->_header->sequence.store ( 0 );
+        sink->_header->capacity = capacity;
+        return sink;
+    }
+
+    void SharedMemoryFrameSink::OnFrame ( const Frame & frame )
+    {
+        const size_t rowBytes = static_cast<size_t> ( frame.size.x ) * ( frame.AsSurface ( ).getPixelInc ( ) );
+        if ( !_header || rowBytes * frame.size.y > _header->capacity )
+        {
+            _skipped++;
+            return;
+        }
+
+        // Odd while writing
+        const uint64_t sequence = _header->sequence.load ( std::memory_order_relaxed );
+        _header->sequence.store ( sequence + 1, std::memory_order_relaxed );
+        std::atomic_thread_fence ( std::memory_order_release );
+
+        _header->width = frame.size.x;
+        _header->height = frame.size.y;
+        _header->rowBytes = static_cast<uint32_t> ( rowBytes );
+        _header->channelOrder = static_cast<uint32_t> ( frame.channelOrder.getCode ( ) );
+        _header->pts = frame.pts;
+
+        for ( int y = 0; y < frame.size.y; y++ )
+        {
+            std::memcpy ( _pixels + y * rowBytes, frame.data + static_cast<size_t> ( y ) * frame.rowBytes, rowBytes );
+        }
+
+        _header->sequence.store ( sequence + 2, std::memory_order_release );
+        _written++;
+    }
+
+    SharedMemoryFrameSink::~SharedMemoryFrameSink ( )
+    {
+#ifdef _WIN32
+        if ( _header ) UnmapViewOfFile ( _header );
+        if ( _mapping ) CloseHandle ( _mapping );
+#else
+        if ( _header ) munmap ( _header, _mappedSize );
+        if ( _fd >= 0 )
+        {
+            close ( _fd );
+            shm_unlink ( ( _name[0] == '/' ? _name : "/" + _name ).c_str ( ) );
+        }
+#endif
+    }
+
+    void FrameSinkList::Add ( const FrameSinkRef & sink )
+    {
+        if ( !sink ) return;
+
+        std::unique_lock<std::mutex> lk ( _mutex );
+        if ( std::find ( _sinks.begin ( ), _sinks.end ( ), sink ) != _sinks.end ( ) ) return;
+
+        _sinks.push_back ( sink );
+        _counts[static_cast<int> ( sink->GetThread ( ) )]++;
+    }
+
+    void FrameSinkList::Remove ( const FrameSinkRef & sink )
+    {
+        std::unique_lock<std::mutex> lk ( _mutex );
+
+        auto it = std::find ( _sinks.begin ( ), _sinks.end ( ), sink );
+        if ( it == _sinks.end ( ) ) return;
+
+        _counts[static_cast<int> ( sink->GetThread ( ) )]--;
+        _sinks.erase ( it );
+    }
+
+    void FrameSinkList::Dispatch ( FrameSink::Frame frame, FrameSink::Thread thread )
+    {
+        if ( !frame.data || !HasSinks ( thread ) ) return;
+
+        std::unique_lock<std::mutex> lk ( _mutex );
+        frame.index = _delivered[static_cast<int> ( thread )]++;
+
+        for ( auto & sink : _sinks )
+        {
+            if ( sink->GetThread ( ) == thread ) sink->OnFrame ( frame );
+        }
+    }
+}
@@ -0,0 +1,195 @@
+//
+//  AX-MediaPlayerFrameSink.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include "AX-MediaPlayerStreamingTexture.h"
+#include "cinder/Surface.h"
+
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace AX::Video
+{
+    using FrameSinkRef = std::shared_ptr<class FrameSink>;
+
+    // Somewhere decoded CPU frames go in addition to (or instead of) the
+    // player's own surface / texture. Any number can be attached to one player with
+    // MediaPlayer::AddFrameSink ( ). A sink either gets frames on the main thread after
+    // they've been swapped in, or on the thread that produced them (the transfer thread with
+    // Format::BackgroundTransfer, otherwise inside the player's update) the moment they're
+    // decoded, as a view of the decoder's own memory. That view is only valid for the
+    // duration of OnFrame ( ) and the call holds up the decoder, so copy or be quick.
+    //
+    // Only CPU players produce frames for sinks, i.e Format ( ).HardwareAccelerated ( false ).
+    class FrameSink
+    {
+    public:
+
+        enum class Thread
+        {
+            Main,
+            Producer,
+        };
+
+        struct Frame
+        {
+            const uint8_t *         data{ nullptr };
+            ci::ivec2               size{ 0 };
+            int32_t                 rowBytes{ 0 };
+            ci::SurfaceChannelOrder channelOrder;
+            double                  pts{ 0.0 };
+            uint64_t                index{ 0 };     // Counts frames delivered on this thread
+
+            // Borrows `data`, no copy
+            ci::Surface8u AsSurface ( ) const { return ci::Surface8u ( const_cast<uint8_t *> ( data ), size.x, size.y, rowBytes, channelOrder ); }
+        };
+
+        virtual ~FrameSink ( ) { };
+
+        virtual Thread  GetThread ( ) const { return Thread::Main; }
+        virtual void    OnFrame ( const Frame & frame ) = 0;
+    };
+
+    // A std::function on either thread
+    class CallbackFrameSink : public FrameSink
+    {
+    public:
+
+        using Callback = std::function<void ( const Frame & )>;
+
+        static std::shared_ptr<CallbackFrameSink> Create ( const Callback & callback, Thread thread = Thread::Main );
+
+        Thread  GetThread ( ) const override { return _thread; }
+        void    OnFrame ( const Frame & frame ) override { _callback ( frame ); }
+
+    protected:
+
+        CallbackFrameSink ( const Callback & callback, Thread thread ) : _callback ( callback ), _thread ( thread ) { };
+
+        Callback    _callback;
+        Thread      _thread;
+    };
+
+    // Keeps its own copy of the latest frame, independent of the player's slots
+    class SurfaceFrameSink : public FrameSink
+    {
+    public:
+
+        static std::shared_ptr<SurfaceFrameSink> Create ( );
+
+        void    OnFrame ( const Frame & frame ) override;
+
+        const ci::Surface8uRef & GetSurface ( ) const { return _surface; }
+        double  GetPts ( ) const { return _pts; }
+
+    protected:
+
+        SurfaceFrameSink ( ) { };
+
+        ci::Surface8uRef    _surface;
+        double              _pts{ 0.0 };
+    };
+
+    // Streams every frame into one texture on the main thread (see StreamingTexture)
+    class TextureFrameSink : public FrameSink
+    {
+    public:
+
+        static std::shared_ptr<TextureFrameSink> Create ( const StreamingTexture::Options & options = StreamingTexture::Options ( ) );
+
+        void    OnFrame ( const Frame & frame ) override;
+
+        ci::gl::TextureRef GetTexture ( ) const { return _texture ? _texture->GetTexture ( ) : nullptr; }
+
+    protected:
+
+        TextureFrameSink ( const StreamingTexture::Options & options ) : _options ( options ) { };
+
+        StreamingTexture::Options _options;
+        StreamingTextureRef _texture;
+    };
+
+    // Publishes frames to a named shared memory region for another process,
+    // written straight from the producer thread. The region is a Header followed by the
+    // pixels. `sequence` is odd while a frame is being written, so a reader copies the pixels
+    // between two reads of an even, unchanged `sequence`.
+    class SharedMemoryFrameSink : public FrameSink
+    {
+    public:
+
+        static constexpr uint32_t kMagic = 0x46535841; // 'AXSF'
+        static constexpr uint32_t kVersion = 1;
+
+        struct Header
+        {
+            uint32_t                magic;
+            uint32_t                version;
+            std::atomic<uint64_t>   sequence;
+            uint32_t                width;
+            uint32_t                height;
+            uint32_t                rowBytes;
+            uint32_t                channelOrder;   // ci::SurfaceChannelOrder::getCode ( )
+            double                  pts;
+            uint64_t                capacity;       // Bytes available for pixels
+            uint8_t                 reserved[16];
+        };
+
+        // `capacity` is fixed for the life of the region, larger frames are skipped
+        static std::shared_ptr<SharedMemoryFrameSink> Create ( const std::string & name, size_t capacity = 3840 * 2160 * 4 );
+
+        ~SharedMemoryFrameSink ( );
+
+        Thread  GetThread ( ) const override { return Thread::Producer; }
+        void    OnFrame ( const Frame & frame ) override;
+
+        inline const std::string & GetName ( ) const { return _name; }
+        inline uint64_t GetFramesWritten ( ) const { return _written.load ( ); }
+        inline uint64_t GetFramesSkipped ( ) const { return _skipped.load ( ); }
+
+    protected:
+
+        SharedMemoryFrameSink ( ) { };
+
+        std::string             _name;
+        Header *                _header{ nullptr };
+        uint8_t *               _pixels{ nullptr };
+        size_t                  _mappedSize{ 0 };
+        std::atomic<uint64_t>   _written{ 0 };
+        std::atomic<uint64_t>   _skipped{ 0 };
+#ifdef _WIN32
+        void *                  _mapping{ nullptr };
+#else
+        int                     _fd{ -1 };
+#endif
+    };
+
+    // What the platform implementations keep per player. Dispatch holds the
+    // lock for the duration of the callbacks so once Remove ( ) returns a sink is never
+    // called again, which also means a sink mustn't add or remove sinks from OnFrame ( ).
+    class FrameSinkList
+    {
+    public:
+
+        void    Add ( const FrameSinkRef & sink );
+        void    Remove ( const FrameSinkRef & sink );
+
+        bool    HasSinks ( FrameSink::Thread thread ) const { return _counts[static_cast<int> ( thread )].load ( ) > 0; }
+        void    Dispatch ( FrameSink::Frame frame, FrameSink::Thread thread );
+
+    protected:
+
+        mutable std::mutex          _mutex;
+        std::vector<FrameSinkRef>   _sinks;
+        std::atomic<size_t>         _counts[2]{ };
+        uint64_t                    _delivered[2]{ };
+    };
+}
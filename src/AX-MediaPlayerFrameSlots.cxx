@@ -0,0 +1,136 @@
+//
+//  AX-MediaPlayerFrameSlots.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerFrameSlots.h"
+
+#include <algorithm>
+
+namespace AX::Video
+{
+    void FrameSlots::Reset ( size_t count )
+    {
+        std::unique_lock<std::mutex> lk ( _mutex );
+
+        _count = count > 3 ? std::min ( count, kMaxSlots ) : ( count == 3 ? 3 : 1 );
+        _front = 0;
+        _back = _count >= 3 ? 1 : 0;
+        _middle.store ( _count == 3 ? 2 : 0 );
+
+        for ( auto & slot : _slots ) slot = Slot ( );
+        _slots[_front].state = State::Front;
+        _slots[_back].state = State::Writing;
+    }
+
+    void FrameSlots::Publish ( double pts )
+    {
+        // Written before the exchange below, so it's visible to whoever swaps this slot in
+        _slots[_back].pts = pts;
+
+        if ( _count == 1 )
+        {
+            _middle.fetch_or ( kDirty );
+            return;
+        }
+
+        if ( _count == 3 )
+        {
+            _back = _middle.exchange ( static_cast<uint8_t> ( _back | kDirty ) ) & kIndexMask;
+            return;
+        }
+
+        std::unique_lock<std::mutex> lk ( _mutex );
+
+        auto & published = _slots[_back];
+        published.state = State::Queued;
+        published.pts = pts;
+        published.sequence = ++_sequence;
+
+        // Next write goes to a free slot, or over the oldest frame nobody picked in time
+        size_t next = _count;
+        for ( size_t i = 0; i < _count; i++ )
+        {
+            if ( _slots[i].state == State::Free ) { next = i; break; }
+            if ( _slots[i].state == State::Queued && ( next == _count || _slots[i].sequence < _slots[next].sequence ) ) next = i;
+        }
+
+        _slots[next].state = State::Writing;
+        _back = next;
+    }
+
+    bool FrameSlots::Swap ( )
+    {
+        if ( _count > 3 )
+        {
+            // Newest queued frame
+            double pts = 0.0;
+            uint64_t newest = 0;
+            {
+                std::unique_lock<std::mutex> lk ( _mutex );
+                for ( size_t i = 0; i < _count; i++ )
+                {
+                    if ( _slots[i].state == State::Queued && _slots[i].sequence > newest ) { newest = _slots[i].sequence; pts = _slots[i].pts; }
+                }
+            }
+
+            return newest > 0 && SwapTo ( pts );
+        }
+
+        if ( ( _middle.load ( ) & kDirty ) == 0 ) return false;
+
+        if ( _count == 1 )
+        {
+            _middle.fetch_and ( static_cast<uint8_t> ( ~kDirty ) );
+            return true;
+        }
+
+        _front = _middle.exchange ( static_cast<uint8_t> ( _front ) ) & kIndexMask;
+        return true;
+    }
+
+    size_t FrameSlots::GetQueued ( double * pts, size_t max ) const
+    {
+        std::unique_lock<std::mutex> lk ( _mutex );
+
+        const Slot * queued[kMaxSlots];
+        size_t count = 0;
+        for ( size_t i = 0; i < _count; i++ )
+        {
+            if ( _slots[i].state == State::Queued ) queued[count++] = &_slots[i];
+        }
+
+        std::sort ( queued, queued + count, [] ( const Slot * a, const Slot * b ) { return a->sequence < b->sequence; } );
+
+        count = std::min ( count, max );
+        for ( size_t i = 0; i < count; i++ ) pts[i] = queued[i]->pts;
+        return count;
+    }
+
+    bool FrameSlots::SwapTo ( double pts )
+    {
+        std::unique_lock<std::mutex> lk ( _mutex );
+
+        size_t chosen = _count;
+        for ( size_t i = 0; i < _count; i++ )
+        {
+            if ( _slots[i].state == State::Queued && _slots[i].pts == pts ) { chosen = i; break; }
+        }
+
+        if ( chosen == _count ) return false;
+
+        // Anything published before the chosen frame can never be wanted again
+        for ( size_t i = 0; i < _count; i++ )
+        {
+            if ( _slots[i].state == State::Queued && _slots[i].sequence < _slots[chosen].sequence ) _slots[i].state = State::Free;
+        }
+
+        _slots[_front].state = State::Free;
+        _slots[chosen].state = State::Front;
+        _front = chosen;
+        return true;
+    }
+}
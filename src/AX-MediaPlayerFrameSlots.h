@@ -0,0 +1,80 @@
+//
+//  AX-MediaPlayerFrameSlots.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace AX::Video
+{
+    // Index bookkeeping for handing converted frames from a producer thread
+    // to the main thread without either side ever waiting. With three slots the producer
+    // owns one, the consumer owns one and the third is the most recently published frame,
+    // which the consumer swaps for its own whenever there's something newer. Anything the
+    // consumer didn't get to in time is simply overwritten. With one slot (no producer
+    // thread) both sides share slot 0 and Publish ( ) / Swap ( ) just pass a flag along.
+    //
+    // With more than three slots it becomes a short queue of timestamped frames so the
+    // consumer can pick which one to show (see PresentationScheduler), at the cost of a
+    // lock held for a handful of instructions on either side.
+    class FrameSlots
+    {
+    public:
+
+        static constexpr size_t kMaxSlots = 8;
+
+        void    Reset ( size_t count );
+
+        size_t  GetCount ( ) const { return _count; }
+        size_t  GetWriteSlot ( ) const { return _back; }
+        size_t  GetReadSlot ( ) const { return _front; }
+        bool    IsQueued ( ) const { return _count > 3; }
+
+        // Consumer, timestamp the frame in GetReadSlot ( ) was published with
+        double  GetReadPts ( ) const { return _slots[_front].pts; }
+
+        // Producer, after filling GetWriteSlot ( )
+        void    Publish ( double pts = 0.0 );
+
+        // Consumer, true if GetReadSlot ( ) now holds a newer frame
+        bool    Swap ( );
+
+        // Consumer, queue mode only. Timestamps of everything waiting, oldest first.
+        size_t  GetQueued ( double * pts, size_t max ) const;
+
+        // Consumer, queue mode only. Shows the queued frame stamped `pts` and releases anything older.
+        bool    SwapTo ( double pts );
+
+    protected:
+
+        static constexpr uint8_t kDirty = 0x4;
+        static constexpr uint8_t kIndexMask = 0x3;
+
+        enum class State : uint8_t { Free, Writing, Queued, Front };
+
+        struct Slot
+        {
+            State       state{ State::Free };
+            double      pts{ 0.0 };
+            uint64_t    sequence{ 0 };
+        };
+
+        size_t                  _count{ 1 };
+        size_t                  _front{ 0 };    // Consumer only
+        size_t                  _back{ 0 };     // Producer only
+        std::atomic<uint8_t>    _middle{ 0 };
+
+        // Queue mode
+        mutable std::mutex      _mutex;
+        Slot                    _slots[kMaxSlots];
+        uint64_t                _sequence{ 0 };
+    };
+}
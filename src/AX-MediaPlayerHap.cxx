@@ -0,0 +1,640 @@
+//
+//  AX-MediaPlayerHap.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerHap.h"
+#include "AX-MediaPlayerQuickTime.h"
+
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+
+using namespace AX::Video;
+using namespace AX::Video::QuickTime;
+
+namespace
+{
+    // Section types, the high nibble is the compressor and the low nibble the texture format
+    static constexpr uint8_t kCompressorNone        = 0xA;
+    static constexpr uint8_t kCompressorSnappy      = 0xB;
+    static constexpr uint8_t kCompressorComplex     = 0xC;
+    static constexpr uint8_t kMultipleImages        = 0x0D;
+    static constexpr uint8_t kDecodeInstructions    = 0x01;
+    static constexpr uint8_t kChunkCompressorTable  = 0x02;
+    static constexpr uint8_t kChunkSizeTable        = 0x03;
+    static constexpr uint8_t kChunkOffsetTable      = 0x04;
+
+    static inline uint16_t ReadLE16 ( const uint8_t * p ) { return static_cast<uint16_t> ( p[0] | ( p[1] << 8 ) ); }
+    static inline uint32_t ReadLE24 ( const uint8_t * p ) { return p[0] | ( p[1] << 8 ) | ( p[2] << 16 ); }
+    static inline uint32_t ReadLE32 ( const uint8_t * p ) { return p[0] | ( p[1] << 8 ) | ( p[2] << 16 ) | ( static_cast<uint32_t> ( p[3] ) << 24 ); }
+
+    // A HAP section header is a 24 bit size and a type, or a zero size followed by a 32 bit one
+    static bool ReadSection ( const uint8_t * p, size_t available, size_t & size, uint8_t & type, size_t & header )
+    {
+        if ( available < 4 ) return false;
+
+        size = ReadLE24 ( p );
+        type = p[3];
+        header = 4;
+
+        if ( size == 0 )
+        {
+            if ( available < 8 ) return false;
+            size = ReadLE32 ( p + 4 );
+            header = 8;
+        }
+
+        return header + size <= available;
+    }
+
+    static bool IsHapCodec ( uint32_t codec )
+    {
+        return codec == FourCC ( 'H', 'a', 'p', '1' ) || codec == FourCC ( 'H', 'a', 'p', '5' ) || codec == FourCC ( 'H', 'a', 'p', 'Y' )
+            || codec == FourCC ( 'H', 'a', 'p', 'M' ) || codec == FourCC ( 'H', 'a', 'p', 'A' );
+    }
+
+    struct Color
+    {
+        uint8_t b, g, r, a;
+    };
+
+    static inline Color Expand565 ( uint16_t c )
+    {
+        uint8_t r = ( c >> 11 ) & 31, g = ( c >> 5 ) & 63, b = c & 31;
+        return { static_cast<uint8_t> ( ( b << 3 ) | ( b >> 2 ) ), static_cast<uint8_t> ( ( g << 2 ) | ( g >> 4 ) ), static_cast<uint8_t> ( ( r << 3 ) | ( r >> 2 ) ), 255 };
+    }
+
+    static inline uint8_t Mix ( uint8_t a, uint8_t b, int wa, int wb, int d )
+    {
+        return static_cast<uint8_t> ( ( a * wa + b * wb ) / d );
+    }
+
+    // BC1 colour endpoints, `fourColor` is forced inside BC3 blocks
+    static void DecodeColorBlock ( const uint8_t * block, bool fourColor, Color out[16] )
+    {
+        const uint16_t c0 = ReadLE16 ( block ), c1 = ReadLE16 ( block + 2 );
+        const uint32_t indices = ReadLE32 ( block + 4 );
+
+        Color palette[4] = { Expand565 ( c0 ), Expand565 ( c1 ) };
+        if ( fourColor || c0 > c1 )
+        {
+            palette[2] = { Mix ( palette[0].b, palette[1].b, 2, 1, 3 ), Mix ( palette[0].g, palette[1].g, 2, 1, 3 ), Mix ( palette[0].r, palette[1].r, 2, 1, 3 ), 255 };
+            palette[3] = { Mix ( palette[0].b, palette[1].b, 1, 2, 3 ), Mix ( palette[0].g, palette[1].g, 1, 2, 3 ), Mix ( palette[0].r, palette[1].r, 1, 2, 3 ), 255 };
+        }
+        else
+        {
+            palette[2] = { Mix ( palette[0].b, palette[1].b, 1, 1, 2 ), Mix ( palette[0].g, palette[1].g, 1, 1, 2 ), Mix ( palette[0].r, palette[1].r, 1, 1, 2 ), 255 };
+            palette[3] = { 0, 0, 0, 0 };
+        }
+
+        for ( int i = 0; i < 16; i++ ) out[i] = palette[( indices >> ( i * 2 ) ) & 3];
+    }
+
+    // BC3's alpha half and all of BC4
+    static void DecodeAlphaBlock ( const uint8_t * block, uint8_t out[16] )
+    {
+        const uint8_t a0 = block[0], a1 = block[1];
+        uint64_t indices = 0;
+        for ( int i = 0; i < 6; i++ ) indices |= static_cast<uint64_t> ( block[2 + i] ) << ( i * 8 );
+
+        uint8_t palette[8] = { a0, a1 };
+        if ( a0 > a1 )
+        {
+            for ( int i = 1; i <= 6; i++ ) palette[1 + i] = Mix ( a0, a1, 7 - i, i, 7 );
+        }
+        else
+        {
+            for ( int i = 1; i <= 4; i++ ) palette[1 + i] = Mix ( a0, a1, 5 - i, i, 5 );
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+
+        for ( int i = 0; i < 16; i++ ) out[i] = palette[( indices >> ( i * 3 ) ) & 7];
+    }
+}
+
+namespace AX::Video
+{
+    HapFileRef HapFile::Open ( const std::filesystem::path & path )
+    {
+        auto file = MappedFile::Open ( path );
+        if ( !file ) return nullptr;
+
+        HapFileRef hap{ new HapFile ( ) };
+        hap->_file = file;
+
+        const uint8_t * begin = file->Data ( );
+        const uint8_t * end = begin + file->Size ( );
+
+        Atom moov;
+        if ( !FindAtom ( begin, end, FourCC ( 'm', 'o', 'o', 'v' ), moov ) ) return nullptr;
+
+        // First HAP video track wins
+        const uint8_t * p = moov.data;
+        Atom trak;
+        while ( NextAtom ( p, moov.end, trak ) )
+        {
+            if ( trak.type == FourCC ( 't', 'r', 'a', 'k' ) && hap->ParseTrack ( trak.data, trak.end ) ) return hap;
+        }
+
+        return nullptr;
+    }
+
+    bool HapFile::ParseTrack ( const uint8_t * begin, const uint8_t * end )
+    {
+        Atom mdia, mdhd, hdlr, minf, stbl;
+        if ( !FindAtom ( begin, end, FourCC ( 'm', 'd', 'i', 'a' ), mdia ) ) return false;
+        if ( !FindAtom ( mdia.data, mdia.end, FourCC ( 'h', 'd', 'l', 'r' ), hdlr ) || hdlr.end - hdlr.data < 12 ) return false;
+        if ( ReadBE32 ( hdlr.data + 8 ) != FourCC ( 'v', 'i', 'd', 'e' ) ) return false;
+
+        if ( !FindAtom ( mdia.data, mdia.end, FourCC ( 'm', 'd', 'h', 'd' ), mdhd ) || mdhd.end - mdhd.data < 24 ) return false;
+        const bool v1 = mdhd.data[0] == 1;
+        if ( v1 && mdhd.end - mdhd.data < 36 ) return false;
+        const uint32_t timescale = ReadBE32 ( mdhd.data + ( v1 ? 20 : 12 ) );
+        if ( timescale == 0 ) return false;
+
+        if ( !FindAtom ( mdia.data, mdia.end, FourCC ( 'm', 'i', 'n', 'f' ), minf ) ) return false;
+        if ( !FindAtom ( minf.data, minf.end, FourCC ( 's', 't', 'b', 'l' ), stbl ) ) return false;
+
+        Atom stsd, stts, stsz, stsc, stco;
+        if ( !FindAtom ( stbl.data, stbl.end, FourCC ( 's', 't', 's', 'd' ), stsd ) || stsd.end - stsd.data < 8 + 36 ) return false;
+
+        // Version / flags, entry count, then the first sample description
+        const uint8_t * description = stsd.data + 8;
+        _codec = ReadBE32 ( description + 4 );
+        _width = ReadBE16 ( description + 32 );
+        _height = ReadBE16 ( description + 34 );
+        if ( !IsHapCodec ( _codec ) || _width <= 0 || _height <= 0 ) return false;
+
+        if ( !FindAtom ( stbl.data, stbl.end, FourCC ( 's', 't', 's', 'z' ), stsz ) || stsz.end - stsz.data < 12 ) return false;
+        if ( !FindAtom ( stbl.data, stbl.end, FourCC ( 's', 't', 's', 'c' ), stsc ) || stsc.end - stsc.data < 8 ) return false;
+        if ( !FindAtom ( stbl.data, stbl.end, FourCC ( 's', 't', 'c', 'o' ), stco ) && !FindAtom ( stbl.data, stbl.end, FourCC ( 'c', 'o', '6', '4' ), stco ) ) return false;
+        if ( !FindAtom ( stbl.data, stbl.end, FourCC ( 's', 't', 't', 's' ), stts ) || stts.end - stts.data < 8 ) return false;
+
+        // Sample sizes. The count comes from the file, so it's bounded by what could actually be
+        // there before anything is allocated for it: a size per sample in the atom, or for a
+        // fixed size, that many samples in the file.
+        const uint64_t fileSize = _file->Size ( );
+        const uint32_t fixedSize = ReadBE32 ( stsz.data + 4 );
+        const uint32_t sampleCount = ReadBE32 ( stsz.data + 8 );
+        if ( fixedSize == 0 && static_cast<uint64_t> ( stsz.end - stsz.data ) < 12 + sampleCount * 4ull ) return false;
+        if ( fixedSize != 0 && sampleCount > fileSize / fixedSize ) return false;
+        _samples.resize ( sampleCount );
+        for ( uint32_t i = 0; i < sampleCount; i++ ) _samples[i].size = fixedSize ? fixedSize : ReadBE32 ( stsz.data + 12 + i * 4 );
+
+        // Chunk offsets
+        const bool wide = stco.type == FourCC ( 'c', 'o', '6', '4' );
+        const uint32_t chunkCount = stco.end - stco.data >= 8 ? ReadBE32 ( stco.data + 4 ) : 0;
+        if ( static_cast<uint64_t> ( stco.end - stco.data ) < 8 + chunkCount * ( wide ? 8ull : 4ull ) ) return false;
+        auto chunkOffset = [&] ( uint32_t chunk ) { return wide ? ReadBE64 ( stco.data + 8 + chunk * 8 ) : ReadBE32 ( stco.data + 8 + chunk * 4 ); };
+
+        // Samples to chunks, each run covers chunks up to the next run's first chunk
+        const uint32_t runs = ReadBE32 ( stsc.data + 4 );
+        if ( static_cast<uint64_t> ( stsc.end - stsc.data ) < 8 + runs * 12ull ) return false;
+
+        uint32_t sample = 0;
+        for ( uint32_t run = 0; run < runs && sample < sampleCount; run++ )
+        {
+            const uint8_t * entry = stsc.data + 8 + run * 12;
+            const uint32_t firstChunk = ReadBE32 ( entry ) - 1;
+            const uint32_t perChunk = ReadBE32 ( entry + 4 );
+            const uint32_t lastChunk = run + 1 < runs ? ReadBE32 ( entry + 12 ) - 1 : chunkCount;
+
+            for ( uint32_t chunk = firstChunk; chunk < lastChunk && chunk < chunkCount && sample < sampleCount; chunk++ )
+            {
+                uint64_t offset = chunkOffset ( chunk );
+                for ( uint32_t i = 0; i < perChunk && sample < sampleCount; i++, sample++ )
+                {
+                    _samples[sample].offset = offset;
+                    offset += _samples[sample].size;
+                }
+            }
+        }
+
+        if ( sample != sampleCount ) return false;
+
+        // Timestamps
+        const uint32_t timeRuns = ReadBE32 ( stts.data + 4 );
+        if ( static_cast<uint64_t> ( stts.end - stts.data ) < 8 + timeRuns * 8ull ) return false;
+
+        uint64_t time = 0;
+        sample = 0;
+        for ( uint32_t run = 0; run < timeRuns; run++ )
+        {
+            const uint32_t count = ReadBE32 ( stts.data + 8 + run * 8 );
+            const uint32_t delta = ReadBE32 ( stts.data + 12 + run * 8 );
+            if ( run == 0 && delta > 0 ) _frameRate = timescale / static_cast<double> ( delta );
+
+            for ( uint32_t i = 0; i < count && sample < sampleCount; i++, sample++ )
+            {
+                _samples[sample].pts = time / static_cast<double> ( timescale );
+                time += delta;
+            }
+        }
+
+        for ( ; sample < sampleCount; sample++ ) _samples[sample].pts = time / static_cast<double> ( timescale );
+
+        // Nothing may point outside the file, checked so a huge offset can't wrap around
+        for ( auto & s : _samples )
+        {
+            if ( s.offset > fileSize || s.size > fileSize - s.offset ) return false;
+        }
+
+        _duration = time / static_cast<double> ( timescale );
+        return !_samples.empty ( );
+    }
+
+    int64_t HapFile::FrameIndexAt ( double seconds ) const
+    {
+        auto it = std::upper_bound ( _samples.begin ( ), _samples.end ( ), seconds + 1e-6, [] ( double t, const Sample & s ) { return t < s.pts; } );
+        return std::max<int64_t> ( 0, static_cast<int64_t> ( it - _samples.begin ( ) ) - 1 );
+    }
+
+    double HapFile::GetFramePts ( int64_t index ) const
+    {
+        if ( index < 0 || index >= GetFrameCount ( ) ) return 0.0;
+        return _samples[static_cast<size_t> ( index )].pts;
+    }
+
+    const uint8_t * HapFile::GetSample ( int64_t index, size_t & size ) const
+    {
+        if ( index < 0 || index >= GetFrameCount ( ) ) return nullptr;
+
+        auto & sample = _samples[static_cast<size_t> ( index )];
+        size = sample.size;
+        return _file->Data ( ) + sample.offset;
+    }
+
+    void HapFile::Prefetch ( int64_t index ) const
+    {
+        if ( index < 0 || index >= GetFrameCount ( ) ) return;
+
+        auto & sample = _samples[static_cast<size_t> ( index )];
+        _file->Advise ( sample.offset, sample.size, MappedFile::Advice::WillNeed );
+    }
+
+    HapDecoder::HapDecoder ( int threads, Executor::Priority priority )
+        : _threads ( threads > 0 ? threads : 8 )
+        , _priority ( priority )
+    { }
+
+    size_t HapDecoder::BlockBytes ( TextureFormat format )
+    {
+        return format == TextureFormat::BC1 || format == TextureFormat::BC4 ? 8 : 16;
+    }
+
+    size_t HapDecoder::ImageBytes ( TextureFormat format, int32_t width, int32_t height )
+    {
+        return static_cast<size_t> ( ( width + 3 ) / 4 ) * ( ( height + 3 ) / 4 ) * BlockBytes ( format );
+    }
+
+    bool HapDecoder::Decode ( const uint8_t * sample, size_t size, int32_t width, int32_t height, Frame & frame )
+    {
+        auto start = std::chrono::steady_clock::now ( );
+
+        _chunks.clear ( );
+        frame.imageCount = 0;
+        frame.width = width;
+        frame.height = height;
+
+        size_t sectionSize = 0, header = 0;
+        uint8_t type = 0;
+        bool ok = sample && ReadSection ( sample, size, sectionSize, type, header );
+
+        if ( ok && type == kMultipleImages )
+        {
+            // Hap Q Alpha, a colour image and an alpha image one after the other
+            const uint8_t * p = sample + header;
+            size_t remaining = sectionSize;
+
+            while ( ok && remaining > 0 && frame.imageCount < 2 )
+            {
+                size_t innerSize = 0, innerHeader = 0;
+                uint8_t innerType = 0;
+                ok = ReadSection ( p, remaining, innerSize, innerType, innerHeader )
+                  && DecodeImage ( p + innerHeader, innerSize, innerType, frame.images[frame.imageCount++], width, height );
+
+                p += innerHeader + innerSize;
+                remaining -= innerHeader + innerSize;
+            }
+        }
+        else if ( ok )
+        {
+            ok = DecodeImage ( sample + header, sectionSize, type, frame.images[frame.imageCount++], width, height );
+        }
+
+        if ( ok && !_chunks.empty ( ) )
+        {
+            _failed.store ( false );
+            RunChunks ( );
+            ok = !_failed.load ( );
+        }
+
+        double ms = std::chrono::duration<double, std::milli> ( std::chrono::steady_clock::now ( ) - start ).count ( );
+        _stats.chunks += _chunks.size ( );
+        if ( ok )
+        {
+            _stats.frames++;
+            _stats.lastDecodeMs = ms;
+            _stats.averageDecodeMs += ( ms - _stats.averageDecodeMs ) / std::min<uint64_t> ( _stats.frames, 60 );
+        }
+        else
+        {
+            _stats.failures++;
+        }
+
+        return ok;
+    }
+
+    bool HapDecoder::DecodeImage ( const uint8_t * section, size_t size, uint8_t type, Image & image, int32_t width, int32_t height )
+    {
+        switch ( type & 0x0F )
+        {
+            case 0xB: image.format = TextureFormat::BC1; break;
+            case 0xE: image.format = TextureFormat::BC3; break;
+            case 0xF: image.format = TextureFormat::YCoCgBC3; break;
+            case 0x1: image.format = TextureFormat::BC4; break;
+            default: return false; // BC6 / BC7 variants aren't handled
+        }
+
+        const size_t expected = ImageBytes ( image.format, width, height );
+        image.blocks.resize ( expected );
+
+        switch ( type >> 4 )
+        {
+            case kCompressorNone:
+            {
+                if ( size < expected ) return false;
+                _chunks.push_back ( { section, expected, image.blocks.data ( ), expected, false } );
+                return true;
+            }
+
+            case kCompressorSnappy:
+            {
+                _chunks.push_back ( { section, size, image.blocks.data ( ), expected, true } );
+                return true;
+            }
+
+            case kCompressorComplex:
+            {
+                size_t instructionsSize = 0, header = 0;
+                uint8_t instructionsType = 0;
+                if ( !ReadSection ( section, size, instructionsSize, instructionsType, header ) || instructionsType != kDecodeInstructions ) return false;
+
+                const uint8_t * compressors = nullptr;
+                const uint8_t * sizes = nullptr;
+                const uint8_t * offsets = nullptr;
+                size_t chunkCount = 0, sizeCount = 0, offsetCount = 0;
+
+                const uint8_t * p = section + header;
+                size_t remaining = instructionsSize;
+                while ( remaining > 0 )
+                {
+                    size_t entrySize = 0, entryHeader = 0;
+                    uint8_t entryType = 0;
+                    if ( !ReadSection ( p, remaining, entrySize, entryType, entryHeader ) ) return false;
+
+                    const uint8_t * entry = p + entryHeader;
+                    if ( entryType == kChunkCompressorTable ) { compressors = entry; chunkCount = entrySize; }
+                    if ( entryType == kChunkSizeTable ) { sizes = entry; sizeCount = entrySize / 4; }
+                    if ( entryType == kChunkOffsetTable ) { offsets = entry; offsetCount = entrySize / 4; }
+
+                    p += entryHeader + entrySize;
+                    remaining -= entryHeader + entrySize;
+                }
+
+                if ( !compressors || !sizes || sizeCount != chunkCount || ( offsets && offsetCount != chunkCount ) ) return false;
+
+                // Chunks follow the instructions, each one expands to the next run of blocks
+                const uint8_t * data = section + header + instructionsSize;
+                const size_t dataSize = size - header - instructionsSize;
+                size_t srcOffset = 0, dstOffset = 0;
+
+                for ( size_t i = 0; i < chunkCount; i++ )
+                {
+                    const size_t chunkSize = ReadLE32 ( sizes + i * 4 );
+                    if ( offsets ) srcOffset = ReadLE32 ( offsets + i * 4 );
+                    if ( srcOffset + chunkSize > dataSize ) return false;
+
+                    const bool compressed = compressors[i] == kCompressorSnappy;
+                    if ( !compressed && compressors[i] != kCompressorNone ) return false;
+
+                    size_t length = chunkSize;
+                    if ( compressed && !SnappyLength ( data + srcOffset, chunkSize, length ) ) return false;
+                    if ( dstOffset + length > expected ) return false;
+
+                    _chunks.push_back ( { data + srcOffset, chunkSize, image.blocks.data ( ) + dstOffset, length, compressed } );
+                    srcOffset += chunkSize;
+                    dstOffset += length;
+                }
+
+                return dstOffset == expected;
+            }
+
+            default: return false;
+        }
+    }
+
+    void HapDecoder::RunChunks ( )
+    {
+        // The calling thread works too, a single chunk isn't worth waking anyone for
+        Executor::Shared ( ).ParallelFor ( _priority, _chunks.size ( ), [this] ( size_t i ) { DecodeChunk ( _chunks[i] ); }, static_cast<size_t> ( _threads - 1 ) );
+    }
+
+    void HapDecoder::DecodeChunk ( const Chunk & chunk )
+    {
+        if ( chunk.compressed )
+        {
+            if ( !SnappyDecompress ( chunk.src, chunk.srcSize, chunk.dst, chunk.dstSize ) ) _failed.store ( true );
+        }
+        else
+        {
+            std::memcpy ( chunk.dst, chunk.src, chunk.dstSize );
+        }
+    }
+
+    bool HapDecoder::SnappyLength ( const uint8_t * src, size_t srcSize, size_t & length )
+    {
+        // Little endian base 128 varint, at most 32 bits
+        length = 0;
+        for ( size_t i = 0; i < std::min<size_t> ( srcSize, 5 ); i++ )
+        {
+            length |= static_cast<size_t> ( src[i] & 0x7F ) << ( i * 7 );
+            if ( ( src[i] & 0x80 ) == 0 ) return true;
+        }
+
+        return false;
+    }
+
+    bool HapDecoder::SnappyDecompress ( const uint8_t * src, size_t srcSize, uint8_t * dst, size_t dstSize )
+    {
+        size_t length = 0;
+        if ( !SnappyLength ( src, srcSize, length ) || length != dstSize ) return false;
+
+        const uint8_t * end = src + srcSize;
+        while ( *src++ & 0x80 ) { }
+
+        size_t written = 0;
+        while ( src < end )
+        {
+            const uint8_t tag = *src++;
+            size_t count = 0, offset = 0;
+
+            switch ( tag & 3 )
+            {
+                case 0: // Literal, lengths over 60 are stored in the next 1 - 4 bytes
+                {
+                    count = tag >> 2;
+                    if ( count >= 60 )
+                    {
+                        const size_t bytes = count - 59;
+                        if ( static_cast<size_t> ( end - src ) < bytes ) return false;
+
+                        count = 0;
+                        for ( size_t i = 0; i < bytes; i++ ) count |= static_cast<size_t> ( src[i] ) << ( i * 8 );
+                        src += bytes;
+                    }
+
+                    count += 1;
+                    if ( static_cast<size_t> ( end - src ) < count || written + count > dstSize ) return false;
+
+                    std::memcpy ( dst + written, src, count );
+                    src += count;
+                    written += count;
+                    continue;
+                }
+
+                case 1:
+                {
+                    if ( end - src < 1 ) return false;
+                    count = ( ( tag >> 2 ) & 7 ) + 4;
+                    offset = ( static_cast<size_t> ( tag >> 5 ) << 8 ) | *src++;
+                    break;
+                }
+
+                case 2:
+                {
+                    if ( end - src < 2 ) return false;
+                    count = ( tag >> 2 ) + 1;
+                    offset = ReadLE16 ( src );
+                    src += 2;
+                    break;
+                }
+
+                case 3:
+                {
+                    if ( end - src < 4 ) return false;
+                    count = ( tag >> 2 ) + 1;
+                    offset = ReadLE32 ( src );
+                    src += 4;
+                    break;
+                }
+            }
+
+            if ( offset == 0 || offset > written || written + count > dstSize ) return false;
+
+            // Copies can overlap their own output (runs), only then go a byte at a time
+            uint8_t * out = dst + written;
+            const uint8_t * from = out - offset;
+            if ( offset >= count )
+            {
+                std::memcpy ( out, from, count );
+            }
+            else
+            {
+                for ( size_t i = 0; i < count; i++ ) out[i] = from[i];
+            }
+
+            written += count;
+        }
+
+        return written == dstSize;
+    }
+
+    void HapDecoder::ToBGRA ( const Frame & frame, uint8_t * dst, size_t rowBytes )
+    {
+        if ( frame.imageCount == 0 ) return;
+
+        auto & image = frame.images[0];
+        const Image * alpha = frame.imageCount > 1 && frame.images[1].format == TextureFormat::BC4 ? &frame.images[1] : nullptr;
+        const int32_t blocksWide = ( frame.width + 3 ) / 4;
+        const int32_t blocksHigh = ( frame.height + 3 ) / 4;
+        const size_t blockBytes = BlockBytes ( image.format );
+
+        Color texels[16];
+        uint8_t values[16];
+        uint8_t alphaValues[16];
+
+        for ( int32_t by = 0; by < blocksHigh; by++ )
+        {
+            for ( int32_t bx = 0; bx < blocksWide; bx++ )
+            {
+                const size_t index = static_cast<size_t> ( by ) * blocksWide + bx;
+                const uint8_t * block = image.blocks.data ( ) + index * blockBytes;
+
+                switch ( image.format )
+                {
+                    case TextureFormat::BC1:
+                    {
+                        DecodeColorBlock ( block, false, texels );
+                        break;
+                    }
+
+                    case TextureFormat::BC3:
+                    {
+                        DecodeColorBlock ( block + 8, true, texels );
+                        DecodeAlphaBlock ( block, values );
+                        for ( int i = 0; i < 16; i++ ) texels[i].a = values[i];
+                        break;
+                    }
+
+                    case TextureFormat::YCoCgBC3:
+                    {
+                        // Co, Cg and a scale in RGB, luma in alpha (see the HAP spec's ScaledCoCgYToRGBA)
+                        DecodeColorBlock ( block + 8, true, texels );
+                        DecodeAlphaBlock ( block, values );
+                        for ( int i = 0; i < 16; i++ )
+                        {
+                            const float scale = texels[i].b / 8.0f + 1.0f;
+                            const float co = ( texels[i].r - 128.0f ) / scale;
+                            const float cg = ( texels[i].g - 128.0f ) / scale;
+                            const float y = values[i];
+
+                            texels[i].r = static_cast<uint8_t> ( std::clamp ( y + co - cg, 0.0f, 255.0f ) );
+                            texels[i].g = static_cast<uint8_t> ( std::clamp ( y + cg, 0.0f, 255.0f ) );
+                            texels[i].b = static_cast<uint8_t> ( std::clamp ( y - co - cg, 0.0f, 255.0f ) );
+                            texels[i].a = 255;
+                        }
+                        break;
+                    }
+
+                    case TextureFormat::BC4:
+                    {
+                        // Alpha-only on its own is shown as a grey matte
+                        DecodeAlphaBlock ( block, values );
+                        for ( int i = 0; i < 16; i++ ) texels[i] = { values[i], values[i], values[i], 255 };
+                        break;
+                    }
+                }
+
+                if ( alpha )
+                {
+                    DecodeAlphaBlock ( alpha->blocks.data ( ) + index * 8, alphaValues );
+                    for ( int i = 0; i < 16; i++ ) texels[i].a = alphaValues[i];
+                }
+
+                // Edge blocks hang over the image
+                const int32_t rows = std::min ( 4, frame.height - by * 4 );
+                const int32_t columns = std::min ( 4, frame.width - bx * 4 );
+                for ( int32_t y = 0; y < rows; y++ )
+                {
+                    std::memcpy ( dst + ( by * 4 + y ) * rowBytes + bx * 16, &texels[y * 4], columns * 4 );
+                }
+            }
+        }
+    }
+}
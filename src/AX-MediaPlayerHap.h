@@ -0,0 +1,152 @@
+//
+//  AX-MediaPlayerHap.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include "AX-MediaPlayerMappedFile.h"
+#include "AX-MediaPlayerExecutor.h"
+
+#include <atomic>
+#include <vector>
+
+namespace AX::Video
+{
+    using HapFileRef = std::shared_ptr<class HapFile>;
+
+    constexpr uint32_t FourCC ( char a, char b, char c, char d )
+    {
+        return ( uint32_t ( uint8_t ( a ) ) << 24 ) | ( uint32_t ( uint8_t ( b ) ) << 16 ) | ( uint32_t ( uint8_t ( c ) ) << 8 ) | uint32_t ( uint8_t ( d ) );
+    }
+
+    // The video track of a QuickTime movie encoded with one of the HAP codecs
+    // (Hap1, Hap5, HapY, HapM, HapA). Only the sample table is parsed, samples are views into
+    // the memory mapped file. No dependency on cinder, like MappedFile.
+    class HapFile
+    {
+    public:
+
+        static HapFileRef Open ( const std::filesystem::path & path );
+
+        inline uint32_t GetCodec ( ) const { return _codec; }     // The sample description's four cc, i.e FourCC ( 'H', 'a', 'p', '1' )
+        inline int32_t  GetWidth ( ) const { return _width; }
+        inline int32_t  GetHeight ( ) const { return _height; }
+        inline int64_t  GetFrameCount ( ) const { return static_cast<int64_t> ( _samples.size ( ) ); }
+        inline double   GetFrameRate ( ) const { return _frameRate; }
+        inline double   GetDurationInSeconds ( ) const { return _duration; }
+        inline bool     HasAlpha ( ) const { return _codec != FourCC ( 'H', 'a', 'p', '1' ) && _codec != FourCC ( 'H', 'a', 'p', 'Y' ); }
+        inline const MappedFileRef & GetFile ( ) const { return _file; }
+
+        // Last frame that starts at or before `seconds`
+        int64_t         FrameIndexAt ( double seconds ) const;
+        double          GetFramePts ( int64_t index ) const;
+
+        // nullptr when out of range
+        const uint8_t * GetSample ( int64_t index, size_t & size ) const;
+        void            Prefetch ( int64_t index ) const;
+
+    protected:
+
+        struct Sample
+        {
+            uint64_t    offset;
+            uint32_t    size;
+            double      pts;
+        };
+
+        HapFile ( ) { };
+
+        bool            ParseTrack ( const uint8_t * begin, const uint8_t * end );
+
+        MappedFileRef           _file;
+        uint32_t                _codec{ 0 };
+        int32_t                 _width{ 0 };
+        int32_t                 _height{ 0 };
+        double                  _frameRate{ 0.0 };
+        double                  _duration{ 0.0 };
+        std::vector<Sample>     _samples;
+    };
+
+    // Turns HAP samples back into the BC (S3TC / RGTC) blocks they were made
+    // from. Encoders split each frame into chunks that are Snappy compressed independently,
+    // those are decompressed in parallel on the shared Executor. The result can be
+    // uploaded to a compressed texture as is, or expanded to BGRA on the CPU with ToBGRA ( ).
+    class HapDecoder
+    {
+    public:
+
+        enum class TextureFormat
+        {
+            BC1,            // RGB DXT1, Hap
+            BC3,            // RGBA DXT5, Hap Alpha
+            YCoCgBC3,       // Scaled YCoCg in DXT5, Hap Q
+            BC4,            // Single channel RGTC1, the alpha of Hap Q Alpha / Hap Alpha-Only
+        };
+
+        struct Image
+        {
+            TextureFormat           format{ TextureFormat::BC1 };
+            std::vector<uint8_t>    blocks;
+        };
+
+        // Hap Q Alpha has two images, colour then alpha, everything else has one
+        struct Frame
+        {
+            Image                   images[2];
+            int32_t                 imageCount{ 0 };
+            int32_t                 width{ 0 };
+            int32_t                 height{ 0 };
+        };
+
+        struct Stats
+        {
+            uint64_t    frames{ 0 };
+            uint64_t    chunks{ 0 };
+            uint64_t    failures{ 0 };
+            double      lastDecodeMs{ 0.0 };
+            double      averageDecodeMs{ 0.0 };
+        };
+
+        // The most threads (the caller's included) one frame is spread across, zero for 8.
+        // Present priority by default since a player decodes when a frame is asked for.
+        HapDecoder ( int threads = 0, Executor::Priority priority = Executor::Priority::Present );
+
+        bool        Decode ( const uint8_t * sample, size_t size, int32_t width, int32_t height, Frame & frame );
+        Stats       GetStats ( ) const { return _stats; }
+
+        static size_t BlockBytes ( TextureFormat format );
+        static size_t ImageBytes ( TextureFormat format, int32_t width, int32_t height );
+
+        // CPU fallback, BGRA with straight alpha. The alpha image of a two image frame is merged in.
+        static void ToBGRA ( const Frame & frame, uint8_t * dst, size_t rowBytes );
+
+        // Raw Snappy (no framing), false if `src` is corrupt or doesn't expand to exactly `dstSize`
+        static bool SnappyLength ( const uint8_t * src, size_t srcSize, size_t & length );
+        static bool SnappyDecompress ( const uint8_t * src, size_t srcSize, uint8_t * dst, size_t dstSize );
+
+    protected:
+
+        struct Chunk
+        {
+            const uint8_t * src;
+            size_t          srcSize;
+            uint8_t *       dst;
+            size_t          dstSize;
+            bool            compressed;
+        };
+
+        bool        DecodeImage ( const uint8_t * section, size_t size, uint8_t type, Image & image, int32_t width, int32_t height );
+        void        RunChunks ( );
+        void        DecodeChunk ( const Chunk & chunk );
+
+        int                     _threads{ 8 };
+        Executor::Priority      _priority{ Executor::Priority::Present };
+        Stats                   _stats;
+        std::vector<Chunk>      _chunks;
+        std::atomic<bool>       _failed{ false };
+    };
+}
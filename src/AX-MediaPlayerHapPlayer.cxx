@@ -0,0 +1,323 @@
+//
+//  AX-MediaPlayerHapPlayer.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerHapPlayer.h"
+#include "cinder/app/App.h"
+#include "cinder/gl/gl.h"
+#include "cinder/Log.h"
+
+#include <cmath>
+#include <algorithm>
+
+using namespace ci;
+
+namespace
+{
+    using TextureFormat = AX::Video::HapDecoder::TextureFormat;
+
+    static const char * kVertexShader = R"(
+        #version 150
+        uniform mat4 ciModelViewProjection;
+        in vec4 ciPosition;
+        in vec2 ciTexCoord0;
+        out vec2 vTexCoord;
+
+        void main ( )
+        {
+            vTexCoord = ciTexCoord0;
+            gl_Position = ciModelViewProjection * ciPosition;
+        }
+    )";
+
+    // From the HAP reference ScaledCoCgYToRGBA shader
+    static const char * kFragmentShader = R"(
+        #version 150
+        uniform sampler2D uCoCgSY;
+        uniform sampler2D uAlpha;
+        uniform bool uHasAlpha;
+        in vec2 vTexCoord;
+        out vec4 oColor;
+
+        void main ( )
+        {
+            vec4 CoCgSY = texture ( uCoCgSY, vTexCoord ) - vec4 ( 0.50196078431373, 0.50196078431373, 0.0, 0.0 );
+            float scale = ( CoCgSY.z * ( 255.0 / 8.0 ) ) + 1.0;
+            float Co = CoCgSY.x / scale;
+            float Cg = CoCgSY.y / scale;
+            float Y = CoCgSY.w;
+
+            oColor = vec4 ( Y + Co - Cg, Y + Cg, Y - Co - Cg, uHasAlpha ? texture ( uAlpha, vTexCoord ).r : 1.0 );
+        }
+    )";
+
+    static GLenum ToGLFormat ( TextureFormat format )
+    {
+        switch ( format )
+        {
+            case TextureFormat::BC1:        return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            case TextureFormat::BC3:
+            case TextureFormat::YCoCgBC3:   return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case TextureFormat::BC4:        return GL_COMPRESSED_RED_RGTC1;
+        }
+
+        return 0;
+    }
+
+    class HapFrameLease : public AX::Video::MediaPlayer::FrameLease
+    {
+    public:
+
+        HapFrameLease ( const gl::TextureRef & texture )
+            : _texture ( texture )
+        { }
+
+        gl::TextureRef ToTexture ( ) const override { return _texture; }
+
+    protected:
+
+        bool IsValid ( ) const override { return _texture != nullptr; }
+
+        gl::TextureRef _texture;
+    };
+}
+
+namespace AX::Video
+{
+    HapPlayerRef HapPlayer::Create ( const ci::fs::path & path, const Options & options )
+    {
+        auto file = HapFile::Open ( path );
+        if ( !file )
+        {
+            CI_LOG_E ( "Couldn't find a HAP video track in " << path );
+            return nullptr;
+        }
+
+        return HapPlayerRef ( new HapPlayer ( file, options ) );
+    }
+
+    HapPlayer::HapPlayer ( const HapFileRef & file, const Options & options )
+        : _file ( file )
+        , _decoder ( std::make_unique<HapDecoder> ( options.GetThreads ( ) ) )
+    {
+        SetFrame ( 0 );
+        Anchor ( );
+
+        if ( auto app = app::App::get ( ) )
+        {
+            _updateConnection = app->getSignalUpdate ( ).connect ( [this] { Update ( ); } );
+        }
+    }
+
+    void HapPlayer::Play ( )
+    {
+        if ( _complete && !_loop ) SetFrame ( 0 );
+
+        _complete = false;
+        _playing = true;
+        Anchor ( );
+    }
+
+    void HapPlayer::Pause ( )
+    {
+        _playing = false;
+    }
+
+    void HapPlayer::TogglePlayback ( )
+    {
+        if ( _playing ) Pause ( ); else Play ( );
+    }
+
+    void HapPlayer::SeekToFrame ( int64_t index )
+    {
+        _complete = false;
+        SetFrame ( std::clamp<int64_t> ( index, 0, GetFrameCount ( ) - 1 ) );
+        Anchor ( );
+    }
+
+    void HapPlayer::SeekToSeconds ( double seconds )
+    {
+        SeekToFrame ( _file->FrameIndexAt ( seconds ) );
+    }
+
+    void HapPlayer::FrameStep ( int delta )
+    {
+        _playing = false;
+        SeekToFrame ( _index + delta );
+    }
+
+    void HapPlayer::Anchor ( )
+    {
+        _anchorTime = Clock::now ( );
+        _anchorPts = _file->GetFramePts ( _index );
+    }
+
+    bool HapPlayer::Update ( )
+    {
+        if ( !_playing ) return false;
+
+        // Same as RawVideoPlayer, measured from the last anchor so there's nothing to drift
+        double position = _anchorPts + std::chrono::duration<double> ( Clock::now ( ) - _anchorTime ).count ( );
+        const double duration = GetDurationInSeconds ( );
+
+        if ( position >= duration )
+        {
+            if ( _loop && duration > 0.0 )
+            {
+                position = std::fmod ( position, duration );
+            }
+            else
+            {
+                SetFrame ( GetFrameCount ( ) - 1 );
+                _playing = false;
+                _complete = true;
+                OnComplete.emit ( );
+                return true;
+            }
+        }
+
+        const int64_t target = _file->FrameIndexAt ( position );
+        if ( target == _index ) return false;
+
+        // Playing never goes backwards by itself, so that's the wrap
+        const bool looped = _loop && target < _index;
+        SetFrame ( target );
+        if ( looped ) OnLoop.emit ( );
+        return true;
+    }
+
+    void HapPlayer::SetFrame ( int64_t index )
+    {
+        _hasNewFrame = _hasNewFrame || index != _index;
+        _index = index;
+
+        // Samples are small next to raw frames, one ahead is plenty
+        const int64_t next = index + 1 < GetFrameCount ( ) ? index + 1 : ( _loop ? 0 : -1 );
+        _file->Prefetch ( next );
+    }
+
+    bool HapPlayer::DecodeCurrent ( ) const
+    {
+        if ( _decodedIndex == _index ) return true;
+
+        size_t size = 0;
+        const uint8_t * sample = _file->GetSample ( _index, size );
+        if ( !_decoder->Decode ( sample, size, _file->GetWidth ( ), _file->GetHeight ( ), _frame ) )
+        {
+            CI_LOG_W ( "Couldn't decode HAP frame " << _index );
+            return false;
+        }
+
+        _decodedIndex = _index;
+        return true;
+    }
+
+    const Surface8uRef & HapPlayer::GetSurface ( ) const
+    {
+        _hasNewFrame = false;
+        if ( _surfaceIndex == _index && _surface ) return _surface;
+        if ( !DecodeCurrent ( ) ) return _surface;
+
+        if ( !_surface ) _surface = Surface8u::create ( _frame.width, _frame.height, _file->HasAlpha ( ), SurfaceChannelOrder::BGRA );
+
+        HapDecoder::ToBGRA ( _frame, _surface->getData ( ), _surface->getRowBytes ( ) );
+        _surfaceIndex = _index;
+        return _surface;
+    }
+
+    void HapPlayer::Upload ( ) const
+    {
+        for ( int32_t i = 0; i < _frame.imageCount; i++ )
+        {
+            auto & image = _frame.images[i];
+            const GLenum format = ToGLFormat ( image.format );
+            const GLsizei bytes = static_cast<GLsizei> ( image.blocks.size ( ) );
+
+            if ( !_textures[i] )
+            {
+                GLuint id = 0;
+                glGenTextures ( 1, &id );
+                glBindTexture ( GL_TEXTURE_2D, id );
+                glTexParameteri ( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
+                glTexParameteri ( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+                glTexParameteri ( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+                glTexParameteri ( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+
+                if ( image.format == TextureFormat::BC4 && _frame.imageCount == 1 )
+                {
+                    // Alpha-only on its own, shown as a grey matte like ToBGRA ( )
+                    const GLint swizzle[] = { GL_RED, GL_RED, GL_RED, GL_ONE };
+                    glTexParameteriv ( GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle );
+                }
+
+                glCompressedTexImage2D ( GL_TEXTURE_2D, 0, format, _frame.width, _frame.height, 0, bytes, image.blocks.data ( ) );
+                glBindTexture ( GL_TEXTURE_2D, 0 );
+
+                // Blocks are stored top row first
+                _textures[i] = gl::Texture::create ( GL_TEXTURE_2D, id, _frame.width, _frame.height, false );
+                _textures[i]->setTopDown ( true );
+                continue;
+            }
+
+            gl::ScopedTextureBind scopedTexture ( _textures[i] );
+            glCompressedTexSubImage2D ( GL_TEXTURE_2D, 0, 0, 0, _frame.width, _frame.height, format, bytes, image.blocks.data ( ) );
+        }
+
+        if ( _frame.images[0].format != TextureFormat::YCoCgBC3 ) return;
+
+        if ( !_convert )
+        {
+            _convert = gl::GlslProg::create ( gl::GlslProg::Format ( ).vertex ( kVertexShader ).fragment ( kFragmentShader ) );
+            _convert->uniform ( "uCoCgSY", 0 );
+            _convert->uniform ( "uAlpha", 1 );
+            _convert->uniform ( "uHasAlpha", _frame.imageCount > 1 );
+        }
+
+        const ivec2 size = GetSize ( );
+        if ( !_fbo )
+        {
+            _fbo = gl::Fbo::create ( size.x, size.y, gl::Fbo::Format ( ).colorTexture ( gl::Texture::Format ( ).internalFormat ( GL_RGBA8 ) ).disableDepth ( ) );
+        }
+
+        gl::ScopedFramebuffer scopedFbo ( _fbo );
+        gl::ScopedViewport scopedViewport ( ivec2 ( 0 ), size );
+        gl::ScopedMatrices scopedMatrices;
+        gl::ScopedBlend scopedBlend ( false );
+        gl::ScopedGlslProg scopedProg ( _convert );
+        gl::ScopedTextureBind color ( _textures[0], 0 );
+        gl::ScopedTextureBind alpha ( _textures[_frame.imageCount > 1 ? 1 : 0], 1 );
+
+        gl::setMatricesWindow ( size );
+        gl::drawSolidRect ( Rectf ( vec2 ( 0 ), size ), vec2 ( 0, 0 ), vec2 ( 1, 1 ) );
+    }
+
+    MediaPlayer::FrameLeaseRef HapPlayer::GetTexture ( ) const
+    {
+        _hasNewFrame = false;
+
+        if ( _textureIndex != _index )
+        {
+            if ( !DecodeCurrent ( ) ) return nullptr;
+
+            Upload ( );
+            _textureIndex = _index;
+        }
+
+        const bool converted = _frame.images[0].format == TextureFormat::YCoCgBC3;
+        return std::make_unique<HapFrameLease> ( converted ? _fbo->getColorTexture ( ) : _textures[0] );
+    }
+
+    gl::TextureRef HapPlayer::GetCompressedTexture ( int image ) const
+    {
+        return image >= 0 && image < 2 ? _textures[image] : nullptr;
+    }
+
+    HapPlayer::~HapPlayer ( )
+    {
+        _updateConnection.disconnect ( );
+    }
+}
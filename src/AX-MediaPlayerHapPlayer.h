@@ -0,0 +1,120 @@
+//
+//  AX-MediaPlayerHapPlayer.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include "AX-MediaPlayer.h"
+#include "AX-MediaPlayerHap.h"
+#include "cinder/gl/GlslProg.h"
+#include "cinder/gl/Fbo.h"
+
+#include <chrono>
+
+namespace AX::Video
+{
+    using HapPlayerRef = std::shared_ptr<class HapPlayer>;
+
+    // Plays HAP encoded QuickTime movies, which neither Media Foundation nor
+    // AVFoundation can. Frames are decoded on demand (the first GetTexture ( ) / GetSurface ( )
+    // after the frame changes), which is a Snappy decompress spread across the shared
+    // Executor, then the BC blocks go to the GPU as they are. Hap and Hap Alpha textures are
+    // handed out as the compressed textures themselves, Hap Q / Hap Q Alpha are converted from
+    // YCoCg by a shader into an FBO (GetCompressedTexture ( ) has the raw ones for custom
+    // shaders). GetSurface ( ) expands the blocks on the CPU. No audio.
+    class HapPlayer
+    {
+    public:
+
+        struct Options
+        {
+            Options & Threads ( int threads ) { _threads = threads; return *this; }
+
+            int     GetThreads ( ) const { return _threads; }
+
+            Options ( ) { };
+
+        protected:
+
+            int     _threads{ 0 };      // Most threads a frame is decoded across, zero for 8
+        };
+
+        using EventSignal = MediaPlayer::EventSignal;
+
+        static HapPlayerRef Create ( const ci::fs::path & path, const Options & options = Options ( ) );
+
+        ~HapPlayer ( );
+
+        void    Play ( );
+        void    Pause ( );
+        void    TogglePlayback ( );
+        bool    IsPlaying ( ) const { return _playing; }
+        bool    IsComplete ( ) const { return _complete; }
+
+        void    SetLoop ( bool loop ) { _loop = loop; }
+        bool    IsLooping ( ) const { return _loop; }
+
+        void    SeekToFrame ( int64_t index );
+        void    SeekToSeconds ( double seconds );
+        void    FrameStep ( int delta );
+
+        inline  int64_t GetFrameIndex ( ) const { return _index; }
+        inline  int64_t GetFrameCount ( ) const { return _file->GetFrameCount ( ); }
+        inline  double  GetPositionInSeconds ( ) const { return _file->GetFramePts ( _index ); }
+        inline  double  GetDurationInSeconds ( ) const { return _file->GetDurationInSeconds ( ); }
+        inline  ci::ivec2 GetSize ( ) const { return { _file->GetWidth ( ), _file->GetHeight ( ) }; }
+        inline  const HapFileRef & GetFile ( ) const { return _file; }
+
+        // Advances the clock, called automatically from the app's update signal
+        bool    Update ( );
+
+        bool    CheckNewFrame ( ) const { return _hasNewFrame; }
+
+        const ci::Surface8uRef & GetSurface ( ) const;
+        MediaPlayer::FrameLeaseRef GetTexture ( ) const;
+
+        // The BC texture for image 0 (colour) or 1 (Hap Q Alpha's alpha), as uploaded
+        ci::gl::TextureRef GetCompressedTexture ( int image = 0 ) const;
+
+        HapDecoder::Stats GetDecodeStats ( ) const { return _decoder->GetStats ( ); }
+
+        EventSignal OnComplete;
+        EventSignal OnLoop;         // Each time playback wraps back to the start
+
+    protected:
+
+        using Clock = std::chrono::steady_clock;
+
+        HapPlayer ( const HapFileRef & file, const Options & options );
+
+        void    SetFrame ( int64_t index );
+        void    Anchor ( );
+        bool    DecodeCurrent ( ) const;
+        void    Upload ( ) const;
+
+        HapFileRef              _file;
+        std::unique_ptr<HapDecoder> _decoder;
+        ci::signals::Connection _updateConnection;
+
+        int64_t                 _index{ 0 };
+        bool                    _playing{ false };
+        bool                    _complete{ false };
+        bool                    _loop{ false };
+        Clock::time_point       _anchorTime;
+        double                  _anchorPts{ 0.0 };
+        mutable bool            _hasNewFrame{ true };
+
+        mutable HapDecoder::Frame   _frame;
+        mutable int64_t             _decodedIndex{ -1 };
+        mutable ci::Surface8uRef    _surface;
+        mutable int64_t             _surfaceIndex{ -1 };
+        mutable ci::gl::TextureRef  _textures[2];
+        mutable int64_t             _textureIndex{ -1 };
+        mutable ci::gl::FboRef      _fbo;
+        mutable ci::gl::GlslProgRef _convert;
+    };
+}
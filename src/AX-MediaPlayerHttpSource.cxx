@@ -0,0 +1,839 @@
+//
+//  AX-MediaPlayerHttpSource.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerHttpSource.h"
+
+#include <chrono>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    #pragma comment(lib, "ws2_32.lib")
+#else
+    #include <netdb.h>
+    #include <unistd.h>
+    #include <sys/time.h>
+    #include <sys/socket.h>
+#endif
+
+namespace
+{
+#ifdef _WIN32
+    using SocketHandle = SOCKET;
+    static const SocketHandle kInvalidSocket = INVALID_SOCKET;
+    inline void CloseSocket ( SocketHandle socket ) { closesocket ( socket ); }
+#else
+    using SocketHandle = int;
+    static const SocketHandle kInvalidSocket = -1;
+    inline void CloseSocket ( SocketHandle socket ) { close ( socket ); }
+#endif
+
+    struct ParsedUrl
+    {
+        std::string host;
+        std::string port{ "80" };
+        std::string path{ "/" };
+    };
+
+    struct HttpResponse
+    {
+        int                                             status{ 0 };
+        std::unordered_map<std::string, std::string>    headers;
+    };
+
+    using BodyCallback = std::function<bool ( const uint8_t *, size_t )>;
+
+    // Headers come off the network, so anything that isn't a plain number is an error
+    bool ParseUnsigned ( const std::string & text, uint64_t & value )
+    {
+        auto begin = text.data ( ) + std::min ( text.size ( ), text.find_first_not_of ( ' ' ) );
+        auto end = text.data ( ) + text.size ( );
+        while ( end > begin && ( end[-1] == ' ' || end[-1] == '\t' ) ) end--;
+
+        auto result = std::from_chars ( begin, end, value );
+        return result.ec == std::errc ( ) && result.ptr == end && begin != end;
+    }
+
+    bool ParseUrl ( const std::string & url, ParsedUrl & parsed )
+    {
+        static const std::string kScheme = "http://";
+        if ( url.compare ( 0, kScheme.size ( ), kScheme ) != 0 ) return false;
+
+        auto rest = url.substr ( kScheme.size ( ) );
+        auto slash = rest.find ( '/' );
+        auto authority = rest.substr ( 0, slash );
+        if ( slash != std::string::npos ) parsed.path = rest.substr ( slash );
+
+        auto colon = authority.rfind ( ':' );
+        if ( colon != std::string::npos )
+        {
+            parsed.host = authority.substr ( 0, colon );
+            parsed.port = authority.substr ( colon + 1 );
+        }
+        else
+        {
+            parsed.host = authority;
+        }
+
+        return !parsed.host.empty ( );
+    }
+
+    void InitializeSockets ( )
+    {
+#ifdef _WIN32
+        static std::once_flag kOnce;
+        std::call_once ( kOnce, [] { WSADATA data; WSAStartup ( MAKEWORD ( 2, 2 ), &data ); } );
+#endif
+    }
+
+    SocketHandle Connect ( const ParsedUrl & url, float timeoutSeconds )
+    {
+        InitializeSockets ( );
+
+        addrinfo hints{ };
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+
+        addrinfo * addresses = nullptr;
+        if ( getaddrinfo ( url.host.c_str ( ), url.port.c_str ( ), &hints, &addresses ) != 0 ) return kInvalidSocket;
+
+        SocketHandle result = kInvalidSocket;
+        for ( addrinfo * address = addresses; address && result == kInvalidSocket; address = address->ai_next )
+        {
+            SocketHandle handle = socket ( address->ai_family, address->ai_socktype, address->ai_protocol );
+            if ( handle == kInvalidSocket ) continue;
+
+#ifdef _WIN32
+            DWORD timeout = static_cast<DWORD> ( timeoutSeconds * 1000.0f );
+#else
+            timeval timeout{ static_cast<time_t> ( timeoutSeconds ), static_cast<suseconds_t> ( ( timeoutSeconds - static_cast<int> ( timeoutSeconds ) ) * 1e6f ) };
+#endif
+            setsockopt ( handle, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char *> ( &timeout ), sizeof ( timeout ) );
+            setsockopt ( handle, SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char *> ( &timeout ), sizeof ( timeout ) );
+
+            if ( connect ( handle, address->ai_addr, static_cast<int> ( address->ai_addrlen ) ) == 0 )
+            {
+                result = handle;
+            }
+            else
+            {
+                CloseSocket ( handle );
+            }
+        }
+
+        freeaddrinfo ( addresses );
+        return result;
+    }
+
+    // Deliberately minimal HTTP/1.1, one request per connection, no chunked
+    // encoding (range responses are never chunked in practice) and redirects to http only.
+    bool HttpGet ( const std::string & url, int64_t rangeBegin, int64_t rangeEnd, float timeoutSeconds, HttpResponse & response, const BodyCallback & onBody, int redirects = 3 )
+    {
+        ParsedUrl parsed;
+        if ( !ParseUrl ( url, parsed ) ) return false;
+
+        SocketHandle socket = Connect ( parsed, timeoutSeconds );
+        if ( socket == kInvalidSocket ) return false;
+
+        std::ostringstream request;
+        request << "GET " << parsed.path << " HTTP/1.1\r\n";
+        request << "Host: " << parsed.host << "\r\n";
+        if ( rangeBegin >= 0 ) request << "Range: bytes=" << rangeBegin << "-" << rangeEnd << "\r\n";
+        request << "User-Agent: AX-MediaPlayer\r\n";
+        request << "Connection: close\r\n\r\n";
+
+        auto text = request.str ( );
+        if ( send ( socket, text.data ( ), static_cast<int> ( text.size ( ) ), 0 ) != static_cast<int> ( text.size ( ) ) )
+        {
+            CloseSocket ( socket );
+            return false;
+        }
+
+        std::vector<char> buffer ( 64 * 1024 );
+        std::string header;
+        size_t headerEnd = std::string::npos;
+
+        while ( headerEnd == std::string::npos )
+        {
+            int count = recv ( socket, buffer.data ( ), static_cast<int> ( buffer.size ( ) ), 0 );
+            if ( count <= 0 )
+            {
+                CloseSocket ( socket );
+                return false;
+            }
+
+            header.append ( buffer.data ( ), count );
+            headerEnd = header.find ( "\r\n\r\n" );
+        }
+
+        std::string body = header.substr ( headerEnd + 4 );
+        header.resize ( headerEnd );
+
+        std::istringstream lines ( header );
+        std::string line;
+        std::getline ( lines, line );
+
+        auto space = line.find ( ' ' );
+        response.status = space != std::string::npos ? std::atoi ( line.c_str ( ) + space + 1 ) : 0;
+
+        while ( std::getline ( lines, line ) )
+        {
+            if ( !line.empty ( ) && line.back ( ) == '\r' ) line.pop_back ( );
+
+            auto colon = line.find ( ':' );
+            if ( colon == std::string::npos ) continue;
+
+            auto key = line.substr ( 0, colon );
+            auto value = line.substr ( colon + 1 );
+            std::transform ( key.begin ( ), key.end ( ), key.begin ( ), [] ( unsigned char c ) { return static_cast<char> ( std::tolower ( c ) ); } );
+            value.erase ( 0, value.find_first_not_of ( ' ' ) );
+            response.headers[key] = value;
+        }
+
+        if ( response.status >= 300 && response.status < 400 && response.headers.count ( "location" ) && redirects > 0 )
+        {
+            CloseSocket ( socket );
+            auto location = response.headers["location"];
+            response = { };
+            return HttpGet ( location, rangeBegin, rangeEnd, timeoutSeconds, response, onBody, redirects - 1 );
+        }
+
+        if ( response.status != 200 && response.status != 206 )
+        {
+            CloseSocket ( socket );
+            return false;
+        }
+
+        int64_t remaining = -1;
+        if ( response.headers.count ( "content-length" ) )
+        {
+            uint64_t length = 0;
+            if ( !ParseUnsigned ( response.headers["content-length"], length ) || length > static_cast<uint64_t> ( INT64_MAX ) )
+            {
+                CloseSocket ( socket );
+                return false;
+            }
+
+            remaining = static_cast<int64_t> ( length );
+        }
+
+        bool keepGoing = true;
+        auto deliver = [&] ( const char * data, size_t length )
+        {
+            if ( remaining >= 0 ) length = static_cast<size_t> ( std::min<int64_t> ( remaining, static_cast<int64_t> ( length ) ) );
+            if ( length > 0 ) keepGoing = onBody ( reinterpret_cast<const uint8_t *> ( data ), length );
+            if ( remaining >= 0 ) remaining -= static_cast<int64_t> ( length );
+        };
+
+        deliver ( body.data ( ), body.size ( ) );
+
+        bool complete = remaining == 0;
+        while ( keepGoing && !complete )
+        {
+            int count = recv ( socket, buffer.data ( ), static_cast<int> ( buffer.size ( ) ), 0 );
+            if ( count < 0 ) break;
+
+            // Without a content length the server closing the connection is the end of the body
+            if ( count == 0 )
+            {
+                complete = remaining < 0;
+                break;
+            }
+
+            deliver ( buffer.data ( ), static_cast<size_t> ( count ) );
+            complete = remaining == 0;
+        }
+
+        CloseSocket ( socket );
+        return complete || !keepGoing;
+    }
+
+    uint64_t HashUrl ( const std::string & url )
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for ( unsigned char c : url )
+        {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+}
+
+namespace AX::Video
+{
+    std::filesystem::path HttpByteSource::Options::GetCacheDirectory ( ) const
+    {
+        if ( !_cacheDirectory.empty ( ) ) return _cacheDirectory;
+
+        std::error_code ec;
+        return std::filesystem::temp_directory_path ( ec ) / "AX-MediaPlayer" / "http";
+    }
+
+    bool HttpByteSource::IsSupportedUrl ( const std::string & url )
+    {
+        ParsedUrl parsed;
+        return ParseUrl ( url, parsed );
+    }
+
+    HttpByteSourceRef HttpByteSource::Create ( const std::string & url, const Options & options )
+    {
+        if ( !IsSupportedUrl ( url ) ) return nullptr;
+
+        HttpByteSourceRef source{ new HttpByteSource ( url, options ) };
+
+        // The first worker finds out the size before it starts on any downloads
+        for ( int i = 0; i < source->_options.GetParallelRequests ( ); i++ )
+        {
+            source->_workers.emplace_back ( [source = source.get ( ), opener = i == 0] { source->Run ( opener ); } );
+        }
+
+        return source;
+    }
+
+    HttpByteSource::HttpByteSource ( const std::string & url, const Options & options )
+        : ByteSource ( url.substr ( url.find_last_of ( '/' ) + 1 ), url )
+        , _url ( url )
+        , _options ( options )
+    {
+        if ( _options.GetSegmentSize ( ) < 64 * 1024 ) _options.SegmentSize ( 64 * 1024 );
+        if ( _options.GetParallelRequests ( ) < 1 ) _options.ParallelRequests ( 1 );
+
+        // Strip any query string so the backend can still sniff the extension
+        auto query = _name.find ( '?' );
+        if ( query != std::string::npos ) _name.resize ( query );
+
+        char hash[17];
+        std::snprintf ( hash, sizeof ( hash ), "%016llx", static_cast<unsigned long long> ( HashUrl ( _url ) ) );
+        _cacheDirectory = _options.GetCacheDirectory ( ) / hash;
+    }
+
+    void HttpByteSource::Open ( )
+    {
+        std::error_code ec;
+        std::filesystem::create_directories ( _cacheDirectory, ec );
+
+        uint64_t cachedSize = 0;
+        bool cachedRanges = true;
+        {
+            // Size and range support on the first line, the url (which can have spaces in it) on the rest
+            std::ifstream info ( _cacheDirectory / "info" );
+            std::string cachedUrl;
+            if ( info >> cachedSize >> cachedRanges && std::getline ( info >> std::ws, cachedUrl ) )
+            {
+                if ( cachedUrl != _url ) cachedSize = 0;
+            }
+            else
+            {
+                cachedSize = 0;
+            }
+        }
+
+        uint64_t size = 0;
+        bool rangesSupported = true;
+
+        HttpResponse response;
+        bool reachable = HttpGet ( _url, 0, 0, _options.GetTimeoutSeconds ( ), response, [] ( const uint8_t *, size_t ) { return false; } );
+
+        if ( reachable )
+        {
+            if ( response.status == 206 && response.headers.count ( "content-range" ) )
+            {
+                auto & range = response.headers["content-range"];
+                auto slash = range.find ( '/' );
+                if ( slash == std::string::npos || !ParseUnsigned ( range.substr ( slash + 1 ), size ) ) size = 0;
+            }
+            else if ( response.status == 200 && response.headers.count ( "content-length" ) )
+            {
+                // The server ignored the range, so everything has to come down in one go
+                if ( !ParseUnsigned ( response.headers["content-length"], size ) ) size = 0;
+                rangesSupported = false;
+            }
+
+            // The remote file changed, everything we have is stale
+            if ( cachedSize != 0 && cachedSize != size )
+            {
+                std::filesystem::remove_all ( _cacheDirectory, ec );
+                std::filesystem::create_directories ( _cacheDirectory, ec );
+            }
+
+            if ( size != 0 )
+            {
+                std::ofstream info ( _cacheDirectory / "info", std::ios::trunc );
+                info << size << " " << rangesSupported << "\n" << _url << "\n";
+            }
+        }
+        else
+        {
+            // Offline, but whatever made it to disk last time can still be played
+            size = cachedSize;
+            rangesSupported = cachedRanges;
+        }
+
+        std::vector<SegmentState> segments;
+        if ( size != 0 )
+        {
+            uint64_t count = ( size + _options.GetSegmentSize ( ) - 1 ) / _options.GetSegmentSize ( );
+            segments.resize ( static_cast<size_t> ( count ), SegmentState::Missing );
+
+            for ( uint64_t i = 0; i < count; i++ )
+            {
+                uint64_t begin = i * _options.GetSegmentSize ( );
+                auto length = std::filesystem::file_size ( SegmentPath ( i ), ec );
+                if ( !ec && length == std::min<uint64_t> ( _options.GetSegmentSize ( ), size - begin ) ) segments[i] = SegmentState::Cached;
+            }
+        }
+
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            _size = size;
+            _rangesSupported = rangesSupported;
+            _segments = std::move ( segments );
+            _touched.assign ( _segments.size ( ), false );
+            _openState = size != 0 ? OpenState::Open : OpenState::Failed;
+        }
+
+        _segmentChanged.notify_all ( );
+        _workAvailable.notify_all ( );
+
+        // Another run (or a smaller limit) may have left the cache over
+        TrimCache ( );
+    }
+
+    bool HttpByteSource::WaitUntilOpen ( ) const
+    {
+        std::unique_lock<std::mutex> lk ( _mutex );
+        if ( _openState == OpenState::Opening )
+        {
+            _waiting++;
+            _segmentChanged.wait ( lk, [&] { return _openState != OpenState::Opening || !_running; } );
+            _waiting--;
+        }
+
+        return _openState == OpenState::Open;
+    }
+
+    bool HttpByteSource::IsOpen ( ) const
+    {
+        std::unique_lock<std::mutex> lk ( _mutex );
+        return _openState == OpenState::Open;
+    }
+
+    uint64_t HttpByteSource::Size ( ) const
+    {
+        return WaitUntilOpen ( ) ? _size : 0;
+    }
+
+    std::filesystem::path HttpByteSource::SegmentPath ( uint64_t segment ) const
+    {
+        return _cacheDirectory / ( std::to_string ( segment ) + ".seg" );
+    }
+
+    size_t HttpByteSource::SegmentLength ( uint64_t segment ) const
+    {
+        uint64_t begin = segment * _options.GetSegmentSize ( );
+        return static_cast<size_t> ( std::min<uint64_t> ( _options.GetSegmentSize ( ), _size - begin ) );
+    }
+
+    void HttpByteSource::Enqueue ( uint64_t segment, bool urgent )
+    {
+        auto & state = _segments[segment];
+        if ( state == SegmentState::Cached ) return;
+
+        auto queued = std::find ( _queue.begin ( ), _queue.end ( ), segment );
+        if ( queued != _queue.end ( ) )
+        {
+            if ( !urgent ) return;
+            _queue.erase ( queued );
+        }
+        else if ( state == SegmentState::Pending )
+        {
+            // Already being downloaded
+            return;
+        }
+
+        state = SegmentState::Pending;
+        if ( urgent ) _queue.push_front ( segment ); else _queue.push_back ( segment );
+        _workAvailable.notify_one ( );
+    }
+
+    void HttpByteSource::Prefetch ( uint64_t fromSegment )
+    {
+        uint64_t end = std::min<uint64_t> ( _segments.size ( ), fromSegment + 1 + _options.GetPrefetchSegments ( ) );
+        for ( uint64_t segment = fromSegment + 1; segment < end; segment++ )
+        {
+            if ( _segments[segment] == SegmentState::Missing ) Enqueue ( segment, false );
+        }
+    }
+
+    void HttpByteSource::Run ( bool opener )
+    {
+        if ( opener ) Open ( );
+
+        while ( true )
+        {
+            uint64_t segment = 0;
+            {
+                std::unique_lock<std::mutex> lk ( _mutex );
+                _workAvailable.wait ( lk, [&] { return !_running || !_queue.empty ( ); } );
+                if ( !_running ) return;
+
+                segment = _queue.front ( );
+                _queue.pop_front ( );
+
+                if ( !_rangesSupported )
+                {
+                    // One worker pulls the whole file down, everyone else has nothing to do
+                    if ( _fetchingEverything ) continue;
+                    _fetchingEverything = true;
+                }
+            }
+
+            bool ok = _rangesSupported ? Fetch ( segment ) : FetchEverything ( );
+
+            {
+                std::unique_lock<std::mutex> lk ( _mutex );
+                if ( !ok )
+                {
+                    _stats.failedRequests++;
+                    for ( auto & state : _segments )
+                    {
+                        if ( state == SegmentState::Pending && ( !_rangesSupported || &state == &_segments[segment] ) ) state = SegmentState::Missing;
+                    }
+                }
+
+                _fetchingEverything = false;
+            }
+
+            _segmentChanged.notify_all ( );
+        }
+    }
+
+    bool HttpByteSource::Fetch ( uint64_t segment )
+    {
+        uint64_t begin = segment * _options.GetSegmentSize ( );
+        size_t length = SegmentLength ( segment );
+
+        std::vector<uint8_t> data;
+        data.reserve ( length );
+
+        for ( int attempt = 0; attempt < 3; attempt++ )
+        {
+            {
+                std::unique_lock<std::mutex> lk ( _mutex );
+                if ( !_running ) return false;
+                _stats.requests++;
+            }
+
+            data.clear ( );
+            HttpResponse response;
+            bool ok = HttpGet ( _url, static_cast<int64_t> ( begin ), static_cast<int64_t> ( begin + length - 1 ), _options.GetTimeoutSeconds ( ), response, [&] ( const uint8_t * bytes, size_t count )
+            {
+                data.insert ( data.end ( ), bytes, bytes + count );
+                return data.size ( ) <= length;
+            } );
+
+            if ( ok && response.status == 206 && data.size ( ) == length )
+            {
+                return StoreSegment ( segment, data.data ( ), data.size ( ) );
+            }
+        }
+
+        return false;
+    }
+
+    bool HttpByteSource::FetchEverything ( )
+    {
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            for ( auto & state : _segments )
+            {
+                if ( state == SegmentState::Missing ) state = SegmentState::Pending;
+            }
+            _stats.requests++;
+        }
+
+        std::vector<uint8_t> pending;
+        uint64_t segment = 0;
+        bool stored = true;
+
+        HttpResponse response;
+        bool ok = HttpGet ( _url, -1, -1, _options.GetTimeoutSeconds ( ), response, [&] ( const uint8_t * bytes, size_t count )
+        {
+            while ( count > 0 && stored && segment < _segments.size ( ) )
+            {
+                size_t take = std::min ( count, SegmentLength ( segment ) - pending.size ( ) );
+                pending.insert ( pending.end ( ), bytes, bytes + take );
+                bytes += take;
+                count -= take;
+
+                if ( pending.size ( ) == SegmentLength ( segment ) )
+                {
+                    stored = StoreSegment ( segment++, pending.data ( ), pending.size ( ) );
+                    pending.clear ( );
+                    _segmentChanged.notify_all ( );
+                }
+            }
+
+            std::unique_lock<std::mutex> lk ( _mutex );
+            return _running && stored;
+        } );
+
+        return ok && stored && segment == _segments.size ( );
+    }
+
+    bool HttpByteSource::StoreSegment ( uint64_t segment, const uint8_t * data, size_t length )
+    {
+        // Write then rename so a crash never leaves a truncated segment that looks complete
+        auto path = SegmentPath ( segment );
+        auto partial = path;
+        partial += ".part" + std::to_string ( std::hash<std::thread::id>{ } ( std::this_thread::get_id ( ) ) );
+
+        {
+            std::ofstream file ( partial, std::ios::binary | std::ios::trunc );
+            file.write ( reinterpret_cast<const char *> ( data ), static_cast<std::streamsize> ( length ) );
+            if ( !file ) return false;
+        }
+
+        std::error_code ec;
+        std::filesystem::rename ( partial, path, ec );
+        if ( ec ) return false;
+
+        bool trim = false;
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            _segments[segment] = SegmentState::Cached;
+            _touched[segment] = true;
+            _stats.networkBytes += length;
+
+            // Scanning the whole cache per segment is wasteful, so it's allowed to go a little over
+            const uint64_t limit = _options.GetMaxCacheBytes ( );
+            _untrimmedBytes += length;
+            if ( limit > 0 && _untrimmedBytes >= std::max<uint64_t> ( limit / 8, _options.GetSegmentSize ( ) ) )
+            {
+                _untrimmedBytes = 0;
+                trim = true;
+            }
+        }
+
+        if ( trim ) TrimCache ( );
+        return true;
+    }
+
+    void HttpByteSource::TrimCache ( )
+    {
+        namespace fs = std::filesystem;
+
+        const uint64_t limit = _options.GetMaxCacheBytes ( );
+        if ( limit == 0 ) return;
+
+        // Every source shares the one cache, so only one of them trims it at a time
+        static std::mutex kTrimMutex;
+        std::unique_lock<std::mutex> trim ( kTrimMutex );
+
+        struct Entry
+        {
+            fs::path            path;
+            fs::file_time_type  used;
+            uint64_t            size{ 0 };
+        };
+
+        std::vector<Entry> entries;
+        uint64_t total = 0;
+
+        std::error_code ec;
+        for ( fs::directory_iterator url ( _options.GetCacheDirectory ( ), ec ), end; !ec && url != end; url.increment ( ec ) )
+        {
+            std::error_code inner;
+            if ( !url->is_directory ( inner ) ) continue;
+
+            for ( fs::directory_iterator file ( url->path ( ), inner ); !inner && file != end; file.increment ( inner ) )
+            {
+                if ( file->path ( ).extension ( ) != ".seg" ) continue;
+
+                std::error_code timeError, sizeError;
+                Entry entry{ file->path ( ), file->last_write_time ( timeError ), file->file_size ( sizeError ) };
+                if ( timeError || sizeError ) continue;
+
+                total += entry.size;
+                entries.push_back ( std::move ( entry ) );
+            }
+        }
+
+        if ( total <= limit ) return;
+
+        // The mtime is bumped whenever a segment is played, so the oldest is the least recently used
+        std::sort ( entries.begin ( ), entries.end ( ), [] ( const Entry & a, const Entry & b ) { return a.used < b.used; } );
+
+        for ( auto & entry : entries )
+        {
+            if ( total <= limit ) break;
+            if ( !fs::remove ( entry.path, ec ) ) continue;
+
+            total -= entry.size;
+            if ( entry.path.parent_path ( ) != _cacheDirectory ) continue;
+
+            // One of ours, Read ( ) would notice the file's gone but this way it's fetched rather than waited on
+            auto stem = entry.path.stem ( ).string ( );
+            uint64_t segment = 0;
+            if ( !ParseUnsigned ( stem, segment ) ) continue;
+
+            std::unique_lock<std::mutex> lk ( _mutex );
+            if ( segment < _segments.size ( ) && _segments[segment] == SegmentState::Cached )
+            {
+                _segments[segment] = SegmentState::Missing;
+                _touched[segment] = false;
+            }
+        }
+    }
+
+    size_t HttpByteSource::Read ( uint64_t offset, void * destination, size_t length )
+    {
+        if ( !WaitUntilOpen ( ) || offset >= _size || length == 0 ) return 0;
+        length = static_cast<size_t> ( std::min<uint64_t> ( length, _size - offset ) );
+
+        auto output = static_cast<uint8_t *> ( destination );
+        uint64_t segmentSize = _options.GetSegmentSize ( );
+        auto timeout = std::chrono::duration<float> ( _options.GetTimeoutSeconds ( ) );
+        size_t total = 0;
+        int refetches = 0;
+
+        while ( total < length )
+        {
+            uint64_t position = offset + total;
+            uint64_t segment = position / segmentSize;
+
+            {
+                std::unique_lock<std::mutex> lk ( _mutex );
+                Prefetch ( segment );
+
+                if ( _segments[segment] != SegmentState::Cached )
+                {
+                    auto start = std::chrono::steady_clock::now ( );
+                    auto deadline = start + timeout;
+
+                    _waiting++;
+                    _stats.stalls++;
+
+                    while ( _running && _segments[segment] != SegmentState::Cached && std::chrono::steady_clock::now ( ) < deadline )
+                    {
+                        // Covers both the first request and retrying after a failed download
+                        if ( _segments[segment] == SegmentState::Missing ) Enqueue ( segment, true );
+                        _segmentChanged.wait_until ( lk, deadline );
+                    }
+
+                    _waiting--;
+                    _stats.stallSeconds += std::chrono::duration<double> ( std::chrono::steady_clock::now ( ) - start ).count ( );
+
+                    if ( _segments[segment] != SegmentState::Cached ) break;
+                }
+            }
+
+            size_t within = static_cast<size_t> ( position - segment * segmentSize );
+            size_t count = std::min ( length - total, SegmentLength ( segment ) - within );
+
+            std::ifstream file ( SegmentPath ( segment ), std::ios::binary );
+            file.seekg ( static_cast<std::streamoff> ( within ) );
+            file.read ( reinterpret_cast<char *> ( output + total ), static_cast<std::streamsize> ( count ) );
+
+            if ( static_cast<size_t> ( file.gcount ( ) ) != count )
+            {
+                // Evicted or cleared from under us, go around again and wait for it to be fetched
+                std::unique_lock<std::mutex> lk ( _mutex );
+                if ( _segments[segment] == SegmentState::Cached ) _segments[segment] = SegmentState::Missing;
+                _touched[segment] = false;
+                if ( ++refetches > 2 ) break;
+                continue;
+            }
+
+            bool touch = false;
+            {
+                std::unique_lock<std::mutex> lk ( _mutex );
+                _stats.cacheBytes += count;
+                touch = !_touched[segment];
+                _touched[segment] = true;
+            }
+
+            // Once per run is enough to keep a segment that's being played off the eviction list
+            if ( touch )
+            {
+                std::error_code ec;
+                std::filesystem::last_write_time ( SegmentPath ( segment ), std::filesystem::file_time_type::clock::now ( ), ec );
+            }
+
+            total += count;
+        }
+
+        return total;
+    }
+
+    std::vector<HttpByteSource::Range> HttpByteSource::GetCachedRanges ( ) const
+    {
+        std::unique_lock<std::mutex> lk ( _mutex );
+
+        std::vector<Range> ranges;
+        uint64_t segmentSize = _options.GetSegmentSize ( );
+
+        for ( uint64_t segment = 0; segment < _segments.size ( ); segment++ )
+        {
+            if ( _segments[segment] != SegmentState::Cached ) continue;
+
+            uint64_t begin = segment * segmentSize;
+            uint64_t end = begin + SegmentLength ( segment );
+
+            if ( !ranges.empty ( ) && ranges.back ( ).end == begin )
+            {
+                ranges.back ( ).end = end;
+            }
+            else
+            {
+                ranges.push_back ( { begin, end } );
+            }
+        }
+
+        return ranges;
+    }
+
+    bool HttpByteSource::IsFullyCached ( ) const
+    {
+        std::unique_lock<std::mutex> lk ( _mutex );
+        if ( _openState != OpenState::Open ) return false;
+        return std::all_of ( _segments.begin ( ), _segments.end ( ), [] ( SegmentState state ) { return state == SegmentState::Cached; } );
+    }
+
+    HttpByteSource::Stats HttpByteSource::GetStats ( ) const
+    {
+        std::unique_lock<std::mutex> lk ( _mutex );
+        return _stats;
+    }
+
+    HttpByteSource::~HttpByteSource ( )
+    {
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            _running = false;
+        }
+
+        _workAvailable.notify_all ( );
+        _segmentChanged.notify_all ( );
+
+        for ( auto & worker : _workers ) worker.join ( );
+    }
+}
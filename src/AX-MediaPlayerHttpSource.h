@@ -0,0 +1,156 @@
+//
+//  AX-MediaPlayerHttpSource.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include "AX-MediaPlayerByteSource.h"
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <filesystem>
+#include <condition_variable>
+
+namespace AX::Video
+{
+    using HttpByteSourceRef = std::shared_ptr<class HttpByteSource>;
+
+    // Plays a remote file through HTTP range requests, persisting every
+    // segment it downloads to a disk cache keyed by url. A looping remote clip only
+    // ever touches the network on its first pass, and so does every later run of the
+    // app. Plain http only, https urls are left to the platform's own streaming.
+    //
+    // Every url gets its own directory under the cache directory, and all of them together
+    // are kept to roughly MaxCacheBytes by deleting the least recently played segments.
+    //
+    // Create ( ) doesn't touch the network, the size is found out in the background and
+    // Size ( ) / Read ( ) wait for it. A server that can't be reached (and hasn't been
+    // cached) reads as an empty file, so the player errors rather than falling back.
+    class HttpByteSource : public ByteSource
+    {
+    public:
+
+        struct Options
+        {
+            Options & SegmentSize ( size_t bytes ) { _segmentSize = bytes; return *this; }
+            Options & ParallelRequests ( int count ) { _parallelRequests = count; return *this; }
+            Options & PrefetchSegments ( int count ) { _prefetchSegments = count; return *this; }
+            Options & CacheDirectory ( const std::filesystem::path & path ) { _cacheDirectory = path; return *this; }
+            Options & TimeoutSeconds ( float seconds ) { _timeoutSeconds = seconds; return *this; }
+            // Across every url in the cache directory, 0 for no limit
+            Options & MaxCacheBytes ( uint64_t bytes ) { _maxCacheBytes = bytes; return *this; }
+
+            size_t  GetSegmentSize ( ) const { return _segmentSize; }
+            int     GetParallelRequests ( ) const { return _parallelRequests; }
+            int     GetPrefetchSegments ( ) const { return _prefetchSegments; }
+            float   GetTimeoutSeconds ( ) const { return _timeoutSeconds; }
+            uint64_t GetMaxCacheBytes ( ) const { return _maxCacheBytes; }
+            std::filesystem::path GetCacheDirectory ( ) const;
+
+            Options ( ) { };
+
+        protected:
+
+            size_t                  _segmentSize{ 1 << 20 };
+            int                     _parallelRequests{ 4 };
+            int                     _prefetchSegments{ 16 };
+            float                   _timeoutSeconds{ 10.0f };
+            uint64_t                _maxCacheBytes{ 2ull << 30 };
+            std::filesystem::path   _cacheDirectory;
+        };
+
+        struct Range
+        {
+            uint64_t begin{ 0 };
+            uint64_t end{ 0 };
+        };
+
+        struct Stats
+        {
+            uint64_t    networkBytes{ 0 };
+            uint64_t    cacheBytes{ 0 };        // Served from segments already on disk
+            uint64_t    requests{ 0 };
+            uint64_t    failedRequests{ 0 };
+            uint64_t    stalls{ 0 };
+            double      stallSeconds{ 0.0 };
+        };
+
+        static bool                 IsSupportedUrl ( const std::string & url );
+        static HttpByteSourceRef    Create ( const std::string & url, const Options & options = Options ( ) );
+
+        uint64_t            Size ( ) const override;
+        size_t              Read ( uint64_t offset, void * destination, size_t length ) override;
+
+        // False while the size is still being found out, Size ( ) blocks until then
+        bool                IsOpen ( ) const;
+
+        // Contiguous byte ranges that are on disk and can be served without the network
+        std::vector<Range>  GetCachedRanges ( ) const;
+        bool                IsFullyCached ( ) const;
+
+        // True while a Read ( ) is blocked waiting on a download (or on the source opening)
+        bool                IsStalled ( ) const { return _waiting.load ( ) > 0; }
+        Stats               GetStats ( ) const;
+
+        inline const std::string & GetUrl ( ) const { return _url; }
+
+        ~HttpByteSource ( );
+
+    protected:
+
+        enum class OpenState : uint8_t
+        {
+            Opening,
+            Open,
+            Failed,
+        };
+
+        enum class SegmentState : uint8_t
+        {
+            Missing,
+            Pending,
+            Cached,
+        };
+
+        HttpByteSource ( const std::string & url, const Options & options );
+
+        void                    Open ( );
+        bool                    WaitUntilOpen ( ) const;
+        void                    Run ( bool opener );
+        bool                    Fetch ( uint64_t segment );
+        bool                    FetchEverything ( );
+        bool                    StoreSegment ( uint64_t segment, const uint8_t * data, size_t length );
+        void                    Enqueue ( uint64_t segment, bool urgent );
+        void                    Prefetch ( uint64_t fromSegment );
+        void                    TrimCache ( );
+        std::filesystem::path   SegmentPath ( uint64_t segment ) const;
+        size_t                  SegmentLength ( uint64_t segment ) const;
+
+        std::string                 _url;
+        Options                     _options;
+        std::filesystem::path       _cacheDirectory;
+        uint64_t                    _size{ 0 };
+        bool                        _rangesSupported{ true };
+
+        mutable std::mutex          _mutex;
+        mutable std::condition_variable _segmentChanged;    // Also signalled once open
+        OpenState                   _openState{ OpenState::Opening };
+        std::condition_variable     _workAvailable;
+        std::vector<SegmentState>   _segments;
+        std::vector<bool>           _touched;           // Segments whose mtime says they were used this run
+        uint64_t                    _untrimmedBytes{ 0 };
+        std::deque<uint64_t>        _queue;
+        std::vector<std::thread>    _workers;
+        bool                        _running{ true };
+        bool                        _fetchingEverything{ false };
+        mutable std::atomic_int     _waiting{ 0 };
+        Stats                       _stats;
+    };
+}
@@ -0,0 +1,308 @@
+//
+//  AX-MediaPlayerLibrary.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerLibrary.h"
+#include "AX-MediaPlayerExecutor.h"
+
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+
+namespace
+{
+    static const char kMagic[4] = { 'A', 'X', 'M', 'L' };
+    static const uint32_t kVersion = 1;
+
+    struct LibraryHeader
+    {
+        char        magic[4];
+        uint32_t    version;
+        uint32_t    recordBytes;
+        uint32_t    reserved;
+        uint64_t    recordCount;
+        uint64_t    stringBytes;
+    };
+
+    static_assert ( sizeof ( LibraryHeader ) == 32, "Library header must be 32 bytes" );
+
+    std::string MakeKey ( const std::filesystem::path & path )
+    {
+        std::error_code ec;
+        auto absolute = std::filesystem::absolute ( path, ec );
+        return ( ec ? path : absolute ).lexically_normal ( ).generic_string ( );
+    }
+
+    uint64_t HashKey ( const std::string & key )
+    {
+        // FNV-1a
+        uint64_t hash = 14695981039346656037ull;
+        for ( char c : key ) { hash ^= static_cast<uint8_t> ( c ); hash *= 1099511628211ull; }
+        return hash;
+    }
+
+    bool IsUnder ( const std::string & key, const std::string & root )
+    {
+        if ( key.size ( ) <= root.size ( ) || key.compare ( 0, root.size ( ), root ) != 0 ) return false;
+        return root.back ( ) == '/' || key[root.size ( )] == '/';
+    }
+
+    std::string LowerExtension ( const std::filesystem::path & path )
+    {
+        auto extension = path.extension ( ).string ( );
+        std::transform ( extension.begin ( ), extension.end ( ), extension.begin ( ), [] ( unsigned char c ) { return static_cast<char> ( std::tolower ( c ) ); } );
+        return extension;
+    }
+}
+
+namespace AX::Video
+{
+    struct MediaLibrary::Record
+    {
+        uint64_t    hash;           // Of the path, the table is sorted on this
+        uint64_t    size;
+        int64_t     modified;
+        uint64_t    pathOffset;     // Into the string table that follows the records
+        uint64_t    pathLength;
+        MediaInfo   info;
+    };
+
+    MediaLibraryRef MediaLibrary::Open ( const std::filesystem::path & cachePath, const Options & options )
+    {
+        MediaLibraryRef library{ new MediaLibrary ( ) };
+        library->_cachePath = cachePath;
+        library->_options = options;
+
+        // A missing or stale cache just means everything gets probed
+        if ( !cachePath.empty ( ) ) library->MapCache ( );
+        return library;
+    }
+
+    bool MediaLibrary::MapCache ( )
+    {
+        _cache = nullptr;
+        _records = nullptr;
+        _recordCount = 0;
+        _strings = nullptr;
+        _stringBytes = 0;
+
+        auto file = MappedFile::Open ( _cachePath );
+        if ( !file || file->Size ( ) < sizeof ( LibraryHeader ) ) return false;
+
+        LibraryHeader header;
+        std::memcpy ( &header, file->Data ( ), sizeof ( header ) );
+
+        if ( std::memcmp ( header.magic, kMagic, sizeof ( kMagic ) ) != 0 || header.version != kVersion || header.recordBytes != sizeof ( Record ) ) return false;
+        if ( header.recordCount > ( file->Size ( ) - sizeof ( LibraryHeader ) ) / sizeof ( Record ) ) return false;
+
+        const uint64_t tableBytes = sizeof ( LibraryHeader ) + header.recordCount * sizeof ( Record );
+        if ( file->Size ( ) - tableBytes < header.stringBytes ) return false;
+
+        _cache = file;
+        _records = reinterpret_cast<const Record *> ( file->Data ( ) + sizeof ( LibraryHeader ) );
+        _recordCount = header.recordCount;
+        _strings = reinterpret_cast<const char *> ( file->Data ( ) + tableBytes );
+        _stringBytes = header.stringBytes;
+
+        return true;
+    }
+
+    std::string MediaLibrary::RecordPath ( const Record & record ) const
+    {
+        if ( record.pathOffset > _stringBytes || record.pathLength > _stringBytes - record.pathOffset ) return { };
+        return std::string ( _strings + record.pathOffset, static_cast<size_t> ( record.pathLength ) );
+    }
+
+    const MediaLibrary::Record * MediaLibrary::FindCached ( const std::string & key, uint64_t hash ) const
+    {
+        const Record * end = _records + _recordCount;
+        const Record * it = std::lower_bound ( _records, end, hash, [] ( const Record & r, uint64_t h ) { return r.hash < h; } );
+
+        for ( ; it != end && it->hash == hash; ++it )
+        {
+            if ( it->pathLength == key.size ( ) && RecordPath ( *it ) == key ) return it;
+        }
+
+        return nullptr;
+    }
+
+    MediaLibrary::Stats MediaLibrary::Scan ( const std::filesystem::path & root )
+    {
+        const auto start = std::chrono::steady_clock::now ( );
+        const std::string rootKey = MakeKey ( root );
+        const auto & extensions = _options.GetExtensions ( );
+
+        std::vector<Entry> found;
+        auto consider = [&] ( const std::filesystem::directory_entry & item )
+        {
+            std::error_code ec;
+            if ( !item.is_regular_file ( ec ) ) return;
+
+            // Entries are keyed by the narrow path, which Windows can't produce for every name
+            // (it throws). Those files are left out rather than failing the scan part way through.
+            try
+            {
+                ( void ) item.path ( ).generic_string ( );
+            }
+            catch ( const std::exception & )
+            {
+                return;
+            }
+
+            if ( !extensions.empty ( ) && std::find ( extensions.begin ( ), extensions.end ( ), LowerExtension ( item.path ( ) ) ) == extensions.end ( ) ) return;
+
+            // The walk already has these on Windows, elsewhere it's one stat per file
+            Entry entry;
+            entry.path = item.path ( );
+            entry.size = item.file_size ( ec );
+            if ( ec ) return;
+            entry.modified = static_cast<int64_t> ( item.last_write_time ( ec ).time_since_epoch ( ).count ( ) );
+            if ( ec ) return;
+
+            found.push_back ( std::move ( entry ) );
+        };
+
+        std::error_code ec;
+        const auto walkOptions = std::filesystem::directory_options::skip_permission_denied;
+        if ( _options.IsRecursive ( ) )
+        {
+            for ( std::filesystem::recursive_directory_iterator it ( rootKey, walkOptions, ec ), end; !ec && it != end; it.increment ( ec ) ) consider ( *it );
+        }
+        else
+        {
+            for ( std::filesystem::directory_iterator it ( rootKey, walkOptions, ec ), end; !ec && it != end; it.increment ( ec ) ) consider ( *it );
+        }
+
+        // Unchanged files come from the last scan or the cache, the rest are probed. Each probe
+        // is a few page faults into a different file, so they're spread across the pool.
+        std::atomic<uint64_t> cached{ 0 }, probed{ 0 }, failed{ 0 };
+        Executor::Shared ( ).ParallelFor ( Executor::Priority::Background, found.size ( ), [&] ( size_t i )
+        {
+            Entry & entry = found[i];
+            const std::string key = entry.path.generic_string ( );
+
+            auto known = _index.find ( key );
+            if ( known != _index.end ( ) && _entries[known->second].size == entry.size && _entries[known->second].modified == entry.modified )
+            {
+                entry.info = _entries[known->second].info;
+                cached++;
+                return;
+            }
+
+            const Record * record = _records ? FindCached ( key, HashKey ( key ) ) : nullptr;
+            if ( record && record->size == entry.size && record->modified == entry.modified )
+            {
+                entry.info = record->info;
+                cached++;
+                return;
+            }
+
+            entry.info = ProbeMedia ( entry.path );
+            probed++;
+            if ( !entry.info ) failed++;
+        } );
+
+        // Swap out everything that was known under this root
+        _entries.erase ( std::remove_if ( _entries.begin ( ), _entries.end ( ), [&] ( const Entry & e )
+        {
+            return IsUnder ( e.path.generic_string ( ), rootKey );
+        } ), _entries.end ( ) );
+
+        for ( auto & entry : found ) _entries.push_back ( std::move ( entry ) );
+
+        _index.clear ( );
+        for ( size_t i = 0; i < _entries.size ( ); i++ ) _index[_entries[i].path.generic_string ( )] = i;
+
+        if ( std::find ( _scannedRoots.begin ( ), _scannedRoots.end ( ), rootKey ) == _scannedRoots.end ( ) ) _scannedRoots.push_back ( rootKey );
+
+        Stats stats;
+        stats.files = found.size ( );
+        stats.cached = cached.load ( );
+        stats.probed = probed.load ( );
+        stats.failed = failed.load ( );
+        stats.seconds = std::chrono::duration<double> ( std::chrono::steady_clock::now ( ) - start ).count ( );
+        return stats;
+    }
+
+    const MediaLibrary::Entry * MediaLibrary::Find ( const std::filesystem::path & path ) const
+    {
+        auto it = _index.find ( MakeKey ( path ) );
+        return it != _index.end ( ) ? &_entries[it->second] : nullptr;
+    }
+
+    bool MediaLibrary::Save ( )
+    {
+        if ( _cachePath.empty ( ) ) return false;
+
+        std::vector<Record> records;
+        std::string strings;
+
+        auto add = [&] ( const std::string & key, uint64_t size, int64_t modified, const MediaInfo & info )
+        {
+            Record record{ };
+            record.hash = HashKey ( key );
+            record.size = size;
+            record.modified = modified;
+            record.pathOffset = strings.size ( );
+            record.pathLength = key.size ( );
+            record.info = info;
+
+            records.push_back ( record );
+            strings += key;
+        };
+
+        for ( const auto & entry : _entries ) add ( entry.path.generic_string ( ), entry.size, entry.modified, entry.info );
+
+        // Carry over what the cache knew about places that weren't scanned this time
+        for ( uint64_t i = 0; i < _recordCount; i++ )
+        {
+            const Record & record = _records[i];
+            const std::string key = RecordPath ( record );
+            if ( key.empty ( ) || _index.count ( key ) ) continue;
+            if ( std::any_of ( _scannedRoots.begin ( ), _scannedRoots.end ( ), [&] ( const std::string & root ) { return IsUnder ( key, root ); } ) ) continue;
+
+            add ( key, record.size, record.modified, record.info );
+        }
+
+        std::sort ( records.begin ( ), records.end ( ), [] ( const Record & a, const Record & b ) { return a.hash < b.hash; } );
+
+        LibraryHeader header{ };
+        std::memcpy ( header.magic, kMagic, sizeof ( kMagic ) );
+        header.version = kVersion;
+        header.recordBytes = sizeof ( Record );
+        header.recordCount = records.size ( );
+        header.stringBytes = strings.size ( );
+
+        std::error_code ec;
+        if ( _cachePath.has_parent_path ( ) ) std::filesystem::create_directories ( _cachePath.parent_path ( ), ec );
+
+        // Write beside and rename so a reader never maps a half written file
+        auto partial = _cachePath;
+        partial += ".part";
+
+        {
+            std::ofstream file ( partial, std::ios::binary | std::ios::trunc );
+            file.write ( reinterpret_cast<const char *> ( &header ), sizeof ( header ) );
+            file.write ( reinterpret_cast<const char *> ( records.data ( ) ), static_cast<std::streamsize> ( records.size ( ) * sizeof ( Record ) ) );
+            file.write ( strings.data ( ), static_cast<std::streamsize> ( strings.size ( ) ) );
+            if ( !file ) return false;
+        }
+
+        // Windows won't replace a file that's mapped
+        _cache = nullptr;
+        _records = nullptr;
+        _recordCount = 0;
+
+        std::filesystem::rename ( partial, _cachePath, ec );
+        MapCache ( );
+
+        return !ec;
+    }
+}
@@ -0,0 +1,100 @@
+//
+//  AX-MediaPlayerLibrary.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include "AX-MediaPlayerProbe.h"
+#include "AX-MediaPlayerMappedFile.h"
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+namespace AX::Video
+{
+    using MediaLibraryRef = std::shared_ptr<class MediaLibrary>;
+
+    // Probes whole directory trees at once, in parallel on the shared Executor,
+    // and remembers the results in a cache file keyed by path, size and modification time.
+    // The cache is a sorted table that's mapped straight back in and searched in place, so a
+    // rescan only costs the directory walk plus a probe of whatever changed. Scan ( ) and
+    // Save ( ) aren't safe to call at the same time as each other or the lookups.
+    // No dependency on cinder, like MappedFile.
+    class MediaLibrary
+    {
+    public:
+
+        struct Options
+        {
+            // Lowercase, with the dot. Everything when empty.
+            Options & Extensions ( std::vector<std::string> extensions ) { _extensions = std::move ( extensions ); return *this; }
+            Options & Recursive ( bool recursive ) { _recursive = recursive; return *this; }
+
+            const std::vector<std::string> & GetExtensions ( ) const { return _extensions; }
+            bool    IsRecursive ( ) const { return _recursive; }
+
+            Options ( ) { };
+
+        protected:
+
+            std::vector<std::string>    _extensions{ ".mp4", ".mov", ".m4v", ".m4a", ".y4m", ".wav" };
+            bool                        _recursive{ true };
+        };
+
+        struct Entry
+        {
+            std::filesystem::path   path;
+            uint64_t                size{ 0 };
+            int64_t                 modified{ 0 };
+            MediaInfo               info;
+        };
+
+        struct Stats
+        {
+            uint64_t    files{ 0 };         // Found by the walk
+            uint64_t    cached{ 0 };        // Unchanged since they were last probed
+            uint64_t    probed{ 0 };
+            uint64_t    failed{ 0 };        // Probed but not a container we know, still listed
+            double      seconds{ 0.0 };
+        };
+
+        // With no `cachePath` nothing is remembered between runs
+        static MediaLibraryRef Open ( const std::filesystem::path & cachePath, const Options & options = Options ( ) );
+
+        // Replaces whatever was known about `root` with what's there now
+        Stats   Scan ( const std::filesystem::path & root );
+
+        // Writes the cache, keeping anything it held from roots that weren't scanned this time
+        bool    Save ( );
+
+        // nullptr when `path` wasn't found by a scan
+        const Entry * Find ( const std::filesystem::path & path ) const;
+        inline const std::vector<Entry> & GetEntries ( ) const { return _entries; }
+
+    protected:
+
+        struct Record;
+
+        MediaLibrary ( ) { };
+
+        bool            MapCache ( );
+        const Record *  FindCached ( const std::string & key, uint64_t hash ) const;
+        std::string     RecordPath ( const Record & record ) const;
+
+        std::filesystem::path       _cachePath;
+        Options                     _options;
+        MappedFileRef               _cache;
+        const Record *              _records{ nullptr };
+        uint64_t                    _recordCount{ 0 };
+        const char *                _strings{ nullptr };
+        uint64_t                    _stringBytes{ 0 };
+        std::vector<Entry>          _entries;
+        std::unordered_map<std::string, size_t> _index;     // Generic path to entry
+        std::vector<std::string>    _scannedRoots;
+    };
+}
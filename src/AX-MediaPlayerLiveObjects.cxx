@@ -0,0 +1,84 @@
+//
+//  AX-MediaPlayerLiveObjects.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerLiveObjects.h"
+
+#include <atomic>
+
+namespace
+{
+    using Kind = AX::Video::LiveObjects::Kind;
+
+    struct Counter
+    {
+        std::atomic<int64_t>    live{ 0 };
+        std::atomic<int64_t>    peak{ 0 };
+        std::atomic<uint64_t>   created{ 0 };
+    };
+
+    Counter kCounters[AX::Video::LiveObjects::kNumKinds];
+}
+
+namespace AX::Video
+{
+    void LiveObjects::Add ( Kind kind, int64_t count )
+    {
+        if ( count <= 0 ) return;
+
+        auto & counter = kCounters[static_cast<size_t> ( kind )];
+        const int64_t live = counter.live.fetch_add ( count, std::memory_order_relaxed ) + count;
+        counter.created.fetch_add ( static_cast<uint64_t> ( count ), std::memory_order_relaxed );
+
+        int64_t peak = counter.peak.load ( std::memory_order_relaxed );
+        while ( live > peak && !counter.peak.compare_exchange_weak ( peak, live, std::memory_order_relaxed ) ) { }
+    }
+
+    void LiveObjects::Remove ( Kind kind, int64_t count )
+    {
+        if ( count <= 0 ) return;
+        kCounters[static_cast<size_t> ( kind )].live.fetch_sub ( count, std::memory_order_relaxed );
+    }
+
+    LiveObjects::Stats LiveObjects::GetStats ( )
+    {
+        Stats stats;
+        for ( size_t i = 0; i < kNumKinds; i++ )
+        {
+            stats.live[i] = kCounters[i].live.load ( std::memory_order_relaxed );
+            stats.peak[i] = kCounters[i].peak.load ( std::memory_order_relaxed );
+            stats.created[i] = kCounters[i].created.load ( std::memory_order_relaxed );
+        }
+
+        return stats;
+    }
+
+    bool LiveObjects::Stats::IsClean ( ) const
+    {
+        for ( int64_t count : live )
+        {
+            if ( count != 0 ) return false;
+        }
+
+        return true;
+    }
+
+    const char * LiveObjects::KindToString ( Kind kind )
+    {
+        switch ( kind )
+        {
+            case Kind::Players: return "Players";
+            case Kind::Engines: return "Engines";
+            case Kind::MediaFoundation: return "MediaFoundation";
+            case Kind::Surfaces: return "Surfaces";
+            case Kind::SharedTextures: return "SharedTextures";
+            case Kind::InteropObjects: return "InteropObjects";
+        }
+
+        return "Unknown";
+    }
+}
@@ -0,0 +1,76 @@
+//
+//  AX-MediaPlayerLiveObjects.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace AX::Video
+{
+    // Process wide counts of everything a player allocates that has to be given
+    // back: players, engines, the MediaFoundation startup itself, frame surfaces, shared
+    // textures and the interop registrations that tie them to GL. Once every player is gone
+    // (and any pending teardown has finished) they should all read zero, anything else is a
+    // leak. Peak is the most there have been at once, for the other direction.
+    // Relaxed atomics, cheap enough to leave on. No dependency on cinder, like MappedFile.
+    class LiveObjects
+    {
+    public:
+
+        enum class Kind : uint8_t
+        {
+            Players,
+            Engines,
+            MediaFoundation,
+            Surfaces,
+            SharedTextures,
+            InteropObjects,
+        };
+
+        static constexpr size_t kNumKinds = 6;
+
+        // Counted for as long as it's alive. As a member it's also uncounted if the owner's
+        // constructor throws, which Add / Remove by hand would miss.
+        class Scoped
+        {
+        public:
+
+            Scoped ( Kind kind ) : _kind ( kind ) { Add ( kind ); }
+            ~Scoped ( ) { Remove ( _kind ); }
+
+            Scoped ( const Scoped & ) = delete;
+            Scoped & operator= ( const Scoped & ) = delete;
+
+        protected:
+
+            Kind    _kind;
+        };
+
+        struct Stats
+        {
+            std::array<int64_t, kNumKinds>  live{ };        // Right now
+            std::array<int64_t, kNumKinds>  peak{ };        // Highest live has been
+            std::array<uint64_t, kNumKinds> created{ };     // Ever
+
+            int64_t     Live ( Kind kind ) const { return live[static_cast<size_t> ( kind )]; }
+            int64_t     Peak ( Kind kind ) const { return peak[static_cast<size_t> ( kind )]; }
+            uint64_t    Created ( Kind kind ) const { return created[static_cast<size_t> ( kind )]; }
+
+            // Nothing outstanding
+            bool        IsClean ( ) const;
+        };
+
+        static void         Add ( Kind kind, int64_t count = 1 );
+        static void         Remove ( Kind kind, int64_t count = 1 );
+        static Stats        GetStats ( );
+
+        static const char * KindToString ( Kind kind );
+    };
+}
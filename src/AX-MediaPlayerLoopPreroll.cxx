@@ -0,0 +1,200 @@
+//
+//  AX-MediaPlayerLoopPreroll.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerLoopPreroll.h"
+#include "cinder/Log.h"
+
+#include <iostream>
+
+using namespace ci;
+
+namespace
+{
+    // Container timestamps don't survive the round trip through seconds exactly
+    constexpr double kEpsilon = 1e-4;
+
+    class PrerollFrameLease : public AX::Video::MediaPlayer::FrameLease
+    {
+    public:
+
+        PrerollFrameLease ( const gl::TextureRef & texture )
+            : _texture ( texture )
+        { }
+
+        gl::TextureRef ToTexture ( ) const override { return _texture; }
+
+    protected:
+
+        bool IsValid ( ) const override { return _texture != nullptr; }
+
+        gl::TextureRef _texture;
+    };
+}
+
+namespace AX::Video
+{
+    LoopPrerollRef LoopPreroll::Create ( const ci::fs::path & path, const StreamingTexture::Options & options )
+    {
+        if ( path.empty ( ) ) return nullptr;
+        return LoopPrerollRef ( new LoopPreroll ( path, options ) );
+    }
+
+    LoopPreroll::LoopPreroll ( const ci::fs::path & path, const StreamingTexture::Options & options )
+        : _path ( path )
+        , _textureOptions ( options )
+    { }
+
+    void LoopPreroll::Request ( double in, double end, size_t maxFrames )
+    {
+        if ( _job ) _job->cancelled.store ( true );
+
+        auto job = std::make_shared<Job> ( );
+        _job = job;
+
+        Executor::Shared ( ).Submit ( Executor::Priority::Prefetch, [job, path = _path, in, end, maxFrames]
+        {
+            try
+            {
+                Decode ( path, in, end, maxFrames, *job );
+            }
+            catch ( const std::exception & e )
+            {
+                std::cout << "Error: " << e.what ( ) << std::endl;
+            }
+
+            std::unique_lock<std::mutex> lk ( job->mutex );
+            job->batch.in = in;
+            job->done = true;
+        } );
+    }
+
+    void LoopPreroll::Decode ( const ci::fs::path & path, double in, double end, size_t maxFrames, Job & job )
+    {
+        auto decoder = VideoDecoder::Create ( path );
+        if ( !decoder || !decoder->Seek ( in ) ) return;
+
+        const ivec2 size ( decoder->GetWidth ( ), decoder->GetHeight ( ) );
+        std::vector<Surface8uRef> frames;
+        std::vector<double> pts;
+        double resume = end;
+
+        // The seek lands on the keyframe at or before the in point, everything
+        // between there and the in point is decoded into the same surface and thrown away.
+        Surface8uRef surface;
+        double timestamp = 0.0;
+        while ( !job.cancelled.load ( ) )
+        {
+            if ( !surface ) surface = Surface8u::create ( size.x, size.y, false, SurfaceChannelOrder::BGRX );
+            if ( !decoder->Decode ( surface->getData ( ), surface->getRowBytes ( ), timestamp ) )
+            {
+                // Ran off the end of the clip, the engine picks up a frame after the last one
+                if ( pts.size ( ) > 1 ) resume = pts.back ( ) + ( pts.back ( ) - pts[pts.size ( ) - 2] );
+                break;
+            }
+
+            if ( timestamp < in - kEpsilon ) continue;
+            if ( timestamp >= end - kEpsilon || frames.size ( ) >= maxFrames )
+            {
+                resume = timestamp;
+                break;
+            }
+
+            frames.push_back ( std::move ( surface ) );
+            pts.push_back ( timestamp );
+        }
+
+        if ( job.cancelled.load ( ) ) return;
+
+        std::unique_lock<std::mutex> lk ( job.mutex );
+        job.batch.frames = std::move ( frames );
+        job.batch.pts = std::move ( pts );
+        job.batch.resume = resume;
+    }
+
+    bool LoopPreroll::Poll ( double & in, std::vector<double> & pts, double & resume )
+    {
+        if ( !_job ) return false;
+
+        {
+            std::unique_lock<std::mutex> lk ( _job->mutex );
+            if ( !_job->done ) return false;
+
+            _batch = std::move ( _job->batch );
+        }
+
+        _job = nullptr;
+        _selected = -1;
+        _uploaded = -1;
+
+        if ( _batch.frames.empty ( ) )
+        {
+            CI_LOG_W ( "Couldn't pre-roll " << _path << " from " << _batch.in << "s, looping without it" );
+        }
+
+        uint64_t bytes = 0;
+        for ( auto & frame : _batch.frames ) bytes += static_cast<uint64_t> ( frame->getRowBytes ( ) ) * frame->getHeight ( );
+        _memory->Set ( bytes );
+
+        in = _batch.in;
+        pts = _batch.pts;
+        resume = _batch.resume;
+        return true;
+    }
+
+    bool LoopPreroll::Select ( int index )
+    {
+        if ( index >= static_cast<int> ( _batch.frames.size ( ) ) ) index = -1;
+        if ( index == _selected ) return false;
+
+        _selected = index;
+        _hasNewFrame = index >= 0;
+        return index >= 0;
+    }
+
+    const Surface8uRef & LoopPreroll::GetSurface ( ) const
+    {
+        static Surface8uRef kNone;
+
+        _hasNewFrame = false;
+        return _selected >= 0 ? _batch.frames[_selected] : kNone;
+    }
+
+    MediaPlayer::FrameLeaseRef LoopPreroll::GetTexture ( ) const
+    {
+        _hasNewFrame = false;
+        if ( _selected < 0 ) return nullptr;
+
+        if ( !_texture ) _texture = StreamingTexture::Create ( _textureOptions );
+        if ( _uploaded != _selected )
+        {
+            _texture->Upload ( *_batch.frames[_selected] );
+            _uploaded = _selected;
+        }
+
+        return std::make_unique<PrerollFrameLease> ( _texture->GetTexture ( ) );
+    }
+
+    double LoopPreroll::GetFramePts ( ) const
+    {
+        return _selected >= 0 ? _batch.pts[_selected] : -1.0;
+    }
+
+    FrameSink::Frame LoopPreroll::GetFrame ( ) const
+    {
+        if ( _selected < 0 ) return { };
+
+        const auto & frame = _batch.frames[_selected];
+        return { frame->getData ( ), frame->getSize ( ), frame->getRowBytes ( ), frame->getChannelOrder ( ), _batch.pts[_selected] };
+    }
+
+    LoopPreroll::~LoopPreroll ( )
+    {
+        if ( _job ) _job->cancelled.store ( true );
+        _memory->Set ( 0 );
+    }
+}
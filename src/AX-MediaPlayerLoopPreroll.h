@@ -0,0 +1,88 @@
+//
+//  AX-MediaPlayerLoopPreroll.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include "AX-MediaPlayer.h"
+#include "AX-MediaPlayerVideoDecoder.h"
+#include "AX-MediaPlayerExecutor.h"
+#include "AX-MediaPlayerFrameSink.h"
+
+#include <mutex>
+#include <atomic>
+
+namespace AX::Video
+{
+    using LoopPrerollRef = std::unique_ptr<class LoopPreroll>;
+
+    // The frames a seamless loop shows while the engine seeks back, see
+    // LoopScheduler. They're decoded on the shared Executor (Prefetch) with a VideoDecoder of
+    // their own, so the player's engine is never touched, and kept as CPU surfaces for as long
+    // as the in point stays put. Counted against the MemoryBudget like any other frames.
+    class LoopPreroll
+    {
+    public:
+
+        static LoopPrerollRef Create ( const ci::fs::path & path, const StreamingTexture::Options & options = StreamingTexture::Options ( ) );
+
+        // Decodes from `in` up to (not including) `end` in the background, at most `maxFrames` of
+        // them. Anything still being decoded for an earlier request is abandoned.
+        void    Request ( double in, double end, size_t maxFrames );
+
+        // Hands over the frames from the last request once they're decoded, replacing the ones
+        // before. `pts` ascending, `resume` is the timestamp of the frame after the last of them.
+        bool    Poll ( double & in, std::vector<double> & pts, double & resume );
+
+        // The frame that's shown, -1 for none. True when that's a change.
+        bool    Select ( int index );
+        inline  bool IsShowing ( ) const { return _selected >= 0; }
+
+        bool    CheckNewFrame ( ) const { return _hasNewFrame; }
+        const ci::Surface8uRef & GetSurface ( ) const;
+        MediaPlayer::FrameLeaseRef GetTexture ( ) const;
+        double  GetFramePts ( ) const;
+
+        // A view of the selected frame for frame sinks
+        FrameSink::Frame GetFrame ( ) const;
+
+        ~LoopPreroll ( );
+
+    protected:
+
+        struct Batch
+        {
+            double  in{ 0.0 };
+            double  resume{ 0.0 };
+            std::vector<ci::Surface8uRef> frames;
+            std::vector<double> pts;
+        };
+
+        // Shared with the decode in flight, which can outlive the player
+        struct Job
+        {
+            std::atomic_bool    cancelled{ false };
+            std::mutex          mutex;
+            bool                done{ false };
+            Batch               batch;
+        };
+
+        LoopPreroll ( const ci::fs::path & path, const StreamingTexture::Options & options );
+
+        static void Decode ( const ci::fs::path & path, double in, double end, size_t maxFrames, Job & job );
+
+        ci::fs::path            _path;
+        StreamingTexture::Options _textureOptions;
+        mutable StreamingTextureRef _texture;
+        mutable int             _uploaded{ -1 };
+        std::shared_ptr<Job>    _job;
+        Batch                   _batch;
+        int                     _selected{ -1 };
+        mutable bool            _hasNewFrame{ false };
+        MemoryBudget::AccountRef _memory{ MemoryBudget::Shared ( ).OpenAccount ( ) };
+    };
+}
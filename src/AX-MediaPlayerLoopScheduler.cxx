@@ -0,0 +1,269 @@
+//
+//  AX-MediaPlayerLoopScheduler.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerLoopScheduler.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace
+{
+    // Container timestamps don't survive the round trip through seconds exactly
+    constexpr double kEpsilon = 1e-4;
+
+    // How close to the out / in points a jump back has to start / land to count as a loop when
+    // the engine made it, and how far past the out point a playhead can be and still wrap
+    constexpr double kWrapTolerance = 0.5;
+
+    // After a user seek, jumps back for this long are the seek and not a loop
+    constexpr double kInterruptGraceSeconds = 1.0;
+
+    // How quickly the seek lead comes down when the engine's seeks get quicker
+    constexpr double kSeekLeadSmoothing = 0.5;
+
+    // Gives up waiting on the engine rather than holding a frame forever
+    constexpr double kSeekTimeoutSeconds = 5.0;
+}
+
+namespace AX::Video
+{
+    LoopScheduler::LoopScheduler ( bool preroll, const Options & options )
+        : _preroll ( preroll )
+        , _options ( options )
+    {
+        _stats.seekLeadSeconds = _seekLead;
+    }
+
+    void LoopScheduler::SetLooping ( bool looping )
+    {
+        _looping = looping;
+    }
+
+    void LoopScheduler::SetPoints ( double in, double out )
+    {
+        _in = std::max ( 0.0, in );
+        _out = std::max ( 0.0, out );
+
+        // Frames for the old points stay put (a wrap in progress is still showing them) but
+        // they won't be used for the next one
+        if ( _prerollFor >= 0.0 && ( _prerollFor != _in || _resume >= GetOut ( ) ) )
+        {
+            _prerollFor = -1.0;
+        }
+
+        _prerollPending = -1.0;
+    }
+
+    void LoopScheduler::SetDuration ( double duration )
+    {
+        _duration = duration;
+    }
+
+    double LoopScheduler::GetOut ( ) const
+    {
+        if ( _out <= 0.0 ) return _duration;
+        return _duration > 0.0 ? std::min ( _out, _duration ) : _out;
+    }
+
+    double LoopScheduler::GetPrerollEnd ( ) const
+    {
+        // Never more than half the loop, the engine has to have somewhere to pick up from
+        return std::min ( _in + _options.GetPrerollSeconds ( ), _in + ( GetOut ( ) - _in ) * 0.5 );
+    }
+
+    bool LoopScheduler::WantsPreroll ( ) const
+    {
+        return _preroll && IsWrapping ( ) && GetOut ( ) > _in && _prerollFor != _in && _prerollPending != _in;
+    }
+
+    void LoopScheduler::BeginPreroll ( )
+    {
+        _prerollPending = _in;
+    }
+
+    bool LoopScheduler::SetPreroll ( double in, const double * pts, size_t count, double resume )
+    {
+        if ( in != _in ) return false;
+
+        _prerollPending = -1.0;
+        _prerollPts.assign ( pts, pts + count );
+        _resume = resume;
+        _prerollFor = count > 0 ? in : -1.0;
+
+        _stats.prerollFrames = count;
+        _stats.prerollSeconds = count > 0 ? resume - in : 0.0;
+        return count > 0;
+    }
+
+    bool LoopScheduler::HasPreroll ( ) const
+    {
+        return _preroll && _prerollFor == _in && !_prerollPts.empty ( ) && _resume > _in && _resume < GetOut ( );
+    }
+
+    LoopScheduler::Action LoopScheduler::Tick ( double now, const Playhead & playhead )
+    {
+        // Frames picked now are seen about a tick from now, which is also how far ahead a wrap is made
+        if ( _lastTick >= 0.0 )
+        {
+            const double elapsed = now - _lastTick;
+            if ( elapsed > 0.0 && elapsed < 0.25 ) _tickInterval += ( elapsed - _tickInterval ) * 0.1;
+        }
+        _lastTick = now;
+
+        const double out = GetOut ( );
+        const double rate = playhead.rate > 0.0f ? static_cast<double> ( playhead.rate ) : 1.0;
+        Action action = Action::None;
+        bool expected = false;
+
+        if ( _phase == Phase::Playing && IsWrapping ( ) && out > _in && playhead.rate > 0.0f && ( playhead.playing || playhead.complete ) && !playhead.seeking )
+        {
+            if ( playhead.position + _tickInterval * rate >= out && playhead.position < out + kWrapTolerance )
+            {
+                _stats.wraps++;
+                _wrappedAt = now;
+                _wrapAt = now + std::max ( 0.0, out - playhead.position ) / rate;
+                _landedAt = -1.0;
+
+                if ( HasPreroll ( ) )
+                {
+                    // Sent ahead by how long its seeks take, so it lands about where the pre-roll has got to
+                    _phase = Phase::Bridging;
+                    _engineAtWrap = playhead.framePts >= 0.0 ? playhead.framePts : playhead.position;
+                    _seekTarget = std::clamp ( _in + _seekLead * rate, _in, _resume );
+                }
+                else
+                {
+                    _phase = Phase::Seeking;
+                    _seekTarget = _in;
+                }
+
+                expected = true;
+                action = Action::Wrap;
+            }
+        }
+        else if ( _phase == Phase::Bridging && _landedAt < 0.0 )
+        {
+            // It plays on towards the out point until the seek lands, then it's back near the in point.
+            // Only once the commands from the wrap have had a tick to get to the engine.
+            const double engine = playhead.framePts >= 0.0 ? playhead.framePts : playhead.position;
+            if ( now > _wrappedAt && !playhead.seeking && engine < _engineAtWrap - kEpsilon )
+            {
+                const double latency = now - _wrappedAt;
+                _landedAt = now;
+                _stats.worstSeekSeconds = std::max ( _stats.worstSeekSeconds, latency );
+
+                // Up straight away since landing behind means a held frame, down gradually
+                if ( latency > _seekLead ) _seekLead = latency; else _seekLead += ( latency - _seekLead ) * kSeekLeadSmoothing;
+                _stats.seekLeadSeconds = _seekLead;
+            }
+        }
+
+        if ( _phase == Phase::Bridging )
+        {
+            const double media = _in + ( now - _wrapAt ) * rate;
+            auto it = std::upper_bound ( _prerollPts.begin ( ), _prerollPts.end ( ), media + kEpsilon );
+            _bridgeFrame = std::max ( 0, static_cast<int> ( it - _prerollPts.begin ( ) ) - 1 );
+
+            // Once the pre-roll runs out its last frame is held, so the engine only has to get that far
+            const double due = std::min ( media, _resume );
+            const double engine = playhead.framePts >= 0.0 ? playhead.framePts : playhead.position;
+
+            if ( _landedAt >= 0.0 && engine >= due - _tickInterval * rate )
+            {
+                // Hand over to the engine. Behind, and the last pre-rolled frame was held waiting for it. Ahead, and
+                // the frames in between are skipped. Either is only visible if it's more than a tick.
+                const double held = now - ( _wrapAt + ( _resume - _in ) / rate );
+                const double ahead = ( engine - media ) / rate;
+
+                if ( held > _tickInterval ) NoteStall ( held );
+                else if ( ahead > _tickInterval ) NoteSkip ( ahead );
+                else _stats.seamlessWraps++;
+
+                _phase = Phase::Playing;
+                _bridgeFrame = -1;
+            }
+            else if ( now - _wrappedAt > kSeekTimeoutSeconds )
+            {
+                // The engine never came back, show whatever it has
+                NoteStall ( now - _wrapAt );
+                _phase = Phase::Playing;
+                _bridgeFrame = -1;
+            }
+        }
+
+        const double shown = GetBridgeFrame ( ) >= 0 ? _prerollPts[_bridgeFrame] : ( playhead.framePts >= 0.0 ? playhead.framePts : playhead.position );
+        NoteShown ( now, shown, expected || _phase == Phase::Seeking );
+
+        if ( _phase == Phase::Seeking && now - _wrappedAt > kSeekTimeoutSeconds )
+        {
+            NoteStall ( now - _wrapAt );
+            _phase = Phase::Playing;
+        }
+
+        return action;
+    }
+
+    void LoopScheduler::NoteShown ( double now, double shown, bool expected )
+    {
+        if ( _lastShown >= 0.0 && shown < _lastShown - kEpsilon )
+        {
+            bool wrapped = false;
+            if ( expected )
+            {
+                // Ours, so no guessing. Without pre-roll this is the engine arriving back at the in point.
+                wrapped = true;
+                if ( _phase == Phase::Seeking )
+                {
+                    const double late = now - _wrapAt;
+                    if ( late > _tickInterval ) NoteStall ( late ); else _stats.seamlessWraps++;
+                    _phase = Phase::Playing;
+                }
+            }
+            else
+            {
+                // The engine's own loop, from (about) the end back to (about) the start
+                const bool interrupted = _interruptedAt >= 0.0 && now - _interruptedAt < kInterruptGraceSeconds;
+                wrapped = _looping && !interrupted && _lastShown >= GetOut ( ) - kWrapTolerance && shown <= _in + kWrapTolerance;
+            }
+
+            if ( wrapped )
+            {
+                _stats.loops++;
+                _loopPending = true;
+            }
+        }
+
+        _lastShown = shown;
+    }
+
+    void LoopScheduler::NoteStall ( double seconds )
+    {
+        _stats.stalledWraps++;
+        _stats.worstStallSeconds = std::max ( _stats.worstStallSeconds, seconds );
+    }
+
+    void LoopScheduler::NoteSkip ( double seconds )
+    {
+        _stats.skippedWraps++;
+        _stats.worstSkipSeconds = std::max ( _stats.worstSkipSeconds, seconds );
+    }
+
+    void LoopScheduler::Interrupt ( double now )
+    {
+        _interruptedAt = now;
+        _phase = Phase::Playing;
+        _bridgeFrame = -1;
+    }
+
+    bool LoopScheduler::TakeLoop ( )
+    {
+        const bool looped = _loopPending;
+        _loopPending = false;
+        return looped;
+    }
+}
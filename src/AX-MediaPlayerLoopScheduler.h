@@ -0,0 +1,168 @@
+//
+//  AX-MediaPlayerLoopScheduler.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace AX::Video
+{
+    // Decides when a looping player wraps and notices when it has. A loop is
+    // reported when the pts of the frame on screen jumps from the out point back to the in
+    // point, so it lines up with what's actually seen rather than with a seek event.
+    //
+    // With in / out points (or pre-roll enabled) the wraps are made here instead of by the
+    // engine. The frames just after the in point are decoded ahead of time (see LoopPreroll)
+    // and shown on schedule when the out point comes round. The engine is never paused, it's
+    // sent back while they're on screen, to just past the in point by however long its seeks
+    // have been taking, so it lands about where the pre-roll has got to and carries on from
+    // there. Its audio plays on throughout. The seek is hidden unless it takes longer than the
+    // pre-roll lasts. No dependency on cinder, like MappedFile.
+    class LoopScheduler
+    {
+    public:
+
+        struct Options
+        {
+            Options & PrerollSeconds ( float seconds ) { _prerollSeconds = seconds; return *this; }
+            Options & MaxPrerollFrames ( size_t frames ) { _maxPrerollFrames = frames; return *this; }
+
+            float   GetPrerollSeconds ( ) const { return _prerollSeconds; }
+            size_t  GetMaxPrerollFrames ( ) const { return _maxPrerollFrames; }
+
+            Options ( ) { };
+
+        protected:
+
+            float   _prerollSeconds{ 0.5f };    // Has to cover the longest seek back to the in point
+            size_t  _maxPrerollFrames{ 30 };    // Every one is a full frame of CPU memory
+        };
+
+        enum class Action : uint8_t
+        {
+            None,
+            Wrap,           // Seek to GetSeekTarget ( ) and keep (or start) playing
+        };
+
+        // What the player reported this tick
+        struct Playhead
+        {
+            double  position{ 0.0 };
+            double  framePts{ -1.0 };       // Of the frame on screen, -1 when there's no video
+            float   rate{ 1.0f };
+            bool    playing{ false };
+            bool    seeking{ false };
+            bool    complete{ false };
+        };
+
+        struct Stats
+        {
+            uint64_t    loops{ 0 };                 // Wraps seen on screen, one per OnLoop
+            uint64_t    wraps{ 0 };                 // Made here rather than by the engine
+            uint64_t    seamlessWraps{ 0 };         // Engine took over within a tick of the pre-roll
+            uint64_t    stalledWraps{ 0 };          // Picture held past its time (no pre-roll, or it wasn't enough)
+            uint64_t    skippedWraps{ 0 };          // Engine landed ahead of the pre-roll, frames were skipped
+            double      worstStallSeconds{ 0.0 };
+            double      worstSkipSeconds{ 0.0 };
+            double      worstSeekSeconds{ 0.0 };    // From a wrap to the engine having landed
+            double      seekLeadSeconds{ 0.0 };     // How far past the in point the next wrap sends the engine
+            size_t      prerollFrames{ 0 };
+            double      prerollSeconds{ 0.0 };      // Media time they cover
+        };
+
+        LoopScheduler ( bool preroll, const Options & options = Options ( ) );
+
+        void        SetLooping ( bool looping );
+        bool        IsLooping ( ) const { return _looping; }
+
+        // `out` <= 0 is the end of the clip. Both zero loops the whole clip.
+        void        SetPoints ( double in, double out );
+        void        SetDuration ( double duration );
+        double      GetIn ( ) const { return _in; }
+        double      GetOut ( ) const;
+        bool        HasPoints ( ) const { return _in > 0.0 || _out > 0.0; }
+
+        // Whether wraps are made here, otherwise the engine loops by itself
+        bool        IsWrapping ( ) const { return _looping && ( _preroll || HasPoints ( ) ); }
+
+        // True when frames from GetIn ( ) up to GetPrerollEnd ( ) should be decoded, then BeginPreroll ( )
+        bool        WantsPreroll ( ) const;
+        double      GetPrerollEnd ( ) const;
+        void        BeginPreroll ( );
+
+        // The decoded frames' timestamps (ascending) and the one after the last of them, which is
+        // where the engine picks up. Ignored if the in point has moved since it was asked for.
+        bool        SetPreroll ( double in, const double * pts, size_t count, double resume );
+
+        Action      Tick ( double now, const Playhead & playhead );
+
+        // Where the engine should seek to for the Wrap just returned
+        double      GetSeekTarget ( ) const { return _seekTarget; }
+
+        // While the pre-rolled frames are standing in for the engine
+        bool        IsBridging ( ) const { return _phase == Phase::Bridging; }
+
+        // Index of the pre-rolled frame to show, -1 when it's the engine's own
+        int         GetBridgeFrame ( ) const { return IsBridging ( ) ? _bridgeFrame : -1; }
+
+        // A user seek or transport call, abandons a wrap in progress. Any jump back soon after
+        // isn't a loop.
+        void        Interrupt ( double now );
+
+        // True once for each loop since the last call
+        bool        TakeLoop ( );
+
+        const Options & GetOptions ( ) const { return _options; }
+        Stats       GetStats ( ) const { return _stats; }
+
+    protected:
+
+        enum class Phase : uint8_t
+        {
+            Playing,
+            Seeking,        // Wrapped without pre-roll, waiting to see the in point
+            Bridging,       // Pre-rolled frames on screen until the engine's own catch up with them
+        };
+
+        bool        HasPreroll ( ) const;
+        void        NoteShown ( double now, double shown, bool expected );
+        void        NoteStall ( double seconds );
+        void        NoteSkip ( double seconds );
+
+        bool        _preroll{ false };
+        Options     _options;
+        Stats       _stats;
+
+        bool        _looping{ false };
+        double      _in{ 0.0 };
+        double      _out{ 0.0 };
+        double      _duration{ 0.0 };
+
+        std::vector<double> _prerollPts;
+        double      _prerollFor{ -1.0 };    // In point the frames start at, -1 for none
+        double      _prerollPending{ -1.0 };
+        double      _resume{ 0.0 };
+
+        Phase       _phase{ Phase::Playing };
+        double      _seekTarget{ 0.0 };
+        double      _wrappedAt{ 0.0 };      // When the wrap was made
+        double      _wrapAt{ 0.0 };         // When the in point is due on screen
+        double      _landedAt{ -1.0 };
+        double      _engineAtWrap{ 0.0 };   // Where the engine was when it was sent back
+        double      _seekLead{ 0.1 };       // Seconds the engine's seeks take, a guess until the first one
+        int         _bridgeFrame{ -1 };
+
+        double      _lastTick{ -1.0 };
+        double      _tickInterval{ 1.0 / 60.0 };
+        double      _lastShown{ -1.0 };
+        double      _interruptedAt{ -1.0 };
+        bool        _loopPending{ false };
+    };
+}
@@ -0,0 +1,107 @@
+//
+//  AX-MediaPlayerMappedFile.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerMappedFile.h"
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+#include <algorithm>
+
+namespace AX::Video
+{
+    MappedFileRef MappedFile::Open ( const std::filesystem::path & path )
+    {
+        MappedFileRef file{ new MappedFile ( ) };
+        file->_path = path;
+
+#ifdef _WIN32
+        HANDLE handle = CreateFileW ( path.wstring ( ).c_str ( ), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+        if ( handle == INVALID_HANDLE_VALUE ) return nullptr;
+        file->_file = handle;
+
+        LARGE_INTEGER size{ };
+        if ( !GetFileSizeEx ( handle, &size ) || size.QuadPart == 0 ) return nullptr;
+
+        file->_mapping = CreateFileMappingW ( handle, nullptr, PAGE_READONLY, 0, 0, nullptr );
+        if ( !file->_mapping ) return nullptr;
+
+        file->_data = static_cast<const uint8_t *> ( MapViewOfFile ( file->_mapping, FILE_MAP_READ, 0, 0, 0 ) );
+        if ( !file->_data ) return nullptr;
+
+        file->_size = static_cast<uint64_t> ( size.QuadPart );
+#else
+        file->_fd = open ( path.c_str ( ), O_RDONLY | O_CLOEXEC );
+        if ( file->_fd < 0 ) return nullptr;
+
+        struct stat info{ };
+        if ( fstat ( file->_fd, &info ) != 0 || info.st_size == 0 ) return nullptr;
+
+        void * data = mmap ( nullptr, static_cast<size_t> ( info.st_size ), PROT_READ, MAP_SHARED, file->_fd, 0 );
+        if ( data == MAP_FAILED ) return nullptr;
+
+        file->_data = static_cast<const uint8_t *> ( data );
+        file->_size = static_cast<uint64_t> ( info.st_size );
+#endif
+
+        return file;
+    }
+
+    void MappedFile::Advise ( uint64_t offset, uint64_t length, Advice advice ) const
+    {
+        if ( !_data || offset >= _size ) return;
+        length = std::min ( length, _size - offset );
+
+#ifdef _WIN32
+        if ( advice == Advice::WillNeed )
+        {
+            WIN32_MEMORY_RANGE_ENTRY range{ const_cast<uint8_t *> ( _data + offset ), static_cast<SIZE_T> ( length ) };
+            PrefetchVirtualMemory ( GetCurrentProcess ( ), 1, &range, 0 );
+        }
+#else
+        // madvise wants a page aligned address
+        static const uint64_t kPageSize = static_cast<uint64_t> ( sysconf ( _SC_PAGESIZE ) );
+        uint64_t aligned = offset - ( offset % kPageSize );
+        length += offset - aligned;
+
+        int flag = MADV_NORMAL;
+        switch ( advice )
+        {
+            case Advice::Normal:        flag = MADV_NORMAL; break;
+            case Advice::Sequential:    flag = MADV_SEQUENTIAL; break;
+            case Advice::Random:        flag = MADV_RANDOM; break;
+            case Advice::WillNeed:      flag = MADV_WILLNEED; break;
+            case Advice::DontNeed:      flag = MADV_DONTNEED; break;
+        }
+
+        madvise ( const_cast<uint8_t *> ( _data + aligned ), static_cast<size_t> ( length ), flag );
+#endif
+    }
+
+    MappedFile::~MappedFile ( )
+    {
+#ifdef _WIN32
+        if ( _data ) UnmapViewOfFile ( _data );
+        if ( _mapping ) CloseHandle ( _mapping );
+        if ( _file ) CloseHandle ( _file );
+#else
+        if ( _data ) munmap ( const_cast<uint8_t *> ( _data ), static_cast<size_t> ( _size ) );
+        if ( _fd >= 0 ) close ( _fd );
+#endif
+        _data = nullptr;
+    }
+}
@@ -0,0 +1,64 @@
+//
+//  AX-MediaPlayerMappedFile.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <filesystem>
+
+namespace AX::Video
+{
+    using MappedFileRef = std::shared_ptr<class MappedFile>;
+
+    // Read-only view of an entire file. Deliberately has no
+    // dependency on cinder so the command line tools can share it.
+    class MappedFile
+    {
+    public:
+
+        enum class Advice
+        {
+            Normal,
+            Sequential,
+            Random,
+            WillNeed,
+            DontNeed,
+        };
+
+        static MappedFileRef Open ( const std::filesystem::path & path );
+
+        MappedFile ( const MappedFile & ) = delete;
+        MappedFile & operator= ( const MappedFile & ) = delete;
+
+        inline const uint8_t *  Data ( ) const { return _data; }
+        inline uint64_t         Size ( ) const { return _size; }
+        inline const std::filesystem::path & Path ( ) const { return _path; }
+
+        // Hints to the OS how a range is about to be accessed. A no-op where unsupported.
+        void Advise ( uint64_t offset, uint64_t length, Advice advice ) const;
+
+        ~MappedFile ( );
+
+    protected:
+
+        MappedFile ( ) { };
+
+        std::filesystem::path   _path;
+        const uint8_t *         _data{ nullptr };
+        uint64_t                _size{ 0 };
+
+#ifdef _WIN32
+        void *                  _file{ nullptr };
+        void *                  _mapping{ nullptr };
+#else
+        int                     _fd{ -1 };
+#endif
+    };
+}
@@ -0,0 +1,197 @@
+//
+//  AX-MediaPlayerMemoryBudget.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerMemoryBudget.h"
+
+#include <vector>
+#include <iostream>
+#include <algorithm>
+
+namespace
+{
+    uint64_t Threshold ( uint64_t budget, float fraction )
+    {
+        if ( budget == 0 ) return UINT64_MAX;
+        return static_cast<uint64_t> ( static_cast<double> ( budget ) * std::max ( fraction, 0.0f ) );
+    }
+}
+
+namespace AX::Video
+{
+    MemoryBudget & MemoryBudget::Shared ( )
+    {
+        static MemoryBudget budget;
+        return budget;
+    }
+
+    void MemoryBudget::Configure ( const Options & options )
+    {
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            _options = options;
+            _shrinkBytes.store ( Threshold ( options.GetBudget ( ), options.GetShrinkAt ( ) ) );
+            _downscaleBytes.store ( Threshold ( options.GetBudget ( ), options.GetDownscaleAt ( ) ) );
+            _refuseBytes.store ( Threshold ( options.GetBudget ( ), options.GetRefuseAt ( ) ) );
+        }
+
+        Evaluate ( );
+        RunDeferred ( );
+    }
+
+    MemoryBudget::Options MemoryBudget::GetOptions ( ) const
+    {
+        std::unique_lock<std::mutex> lk ( _mutex );
+        return _options;
+    }
+
+    MemoryBudget::AccountRef MemoryBudget::OpenAccount ( )
+    {
+        _accounts++;
+        return AccountRef ( new Account ( *this ) );
+    }
+
+    MemoryBudget::AccountRef MemoryBudget::Admit ( uint64_t bytes )
+    {
+        const uint64_t limit = _refuseBytes.load ( );
+
+        uint64_t used = _used.load ( );
+        do
+        {
+            if ( limit != UINT64_MAX && ( bytes > limit || used > limit - bytes ) )
+            {
+                _refused++;
+                return nullptr;
+            }
+        }
+        while ( !_used.compare_exchange_weak ( used, used + bytes ) );
+
+        auto account = OpenAccount ( );
+        account->_bytes.store ( bytes );
+
+        NotePeak ( used + bytes );
+        Evaluate ( );
+        return account;
+    }
+
+    void MemoryBudget::Defer ( uint64_t bytes, std::function<void ( )> open )
+    {
+        if ( !open ) return;
+
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            _deferred.push_back ( { bytes, std::move ( open ) } );
+            _deferredCount.store ( _deferred.size ( ) );
+        }
+
+        RunDeferred ( );
+    }
+
+    void MemoryBudget::SetListener ( Listener listener )
+    {
+        std::unique_lock<std::mutex> lk ( _mutex );
+        _listener = std::move ( listener );
+    }
+
+    void MemoryBudget::Adjust ( uint64_t previous, uint64_t bytes )
+    {
+        if ( previous == bytes ) return;
+
+        const uint64_t used = bytes > previous ? _used.fetch_add ( bytes - previous ) + ( bytes - previous ) : _used.fetch_sub ( previous - bytes ) - ( previous - bytes );
+
+        NotePeak ( used );
+        Evaluate ( );
+        if ( bytes < previous && _deferredCount.load ( ) > 0 ) RunDeferred ( );
+    }
+
+    void MemoryBudget::NotePeak ( uint64_t used )
+    {
+        uint64_t peak = _peak.load ( );
+        while ( used > peak && !_peak.compare_exchange_weak ( peak, used ) ) { }
+    }
+
+    void MemoryBudget::Evaluate ( )
+    {
+        const uint64_t used = _used.load ( );
+
+        Pressure pressure = Pressure::None;
+        if ( used >= _refuseBytes.load ( ) ) pressure = Pressure::Refuse;
+        else if ( used >= _downscaleBytes.load ( ) ) pressure = Pressure::Downscale;
+        else if ( used >= _shrinkBytes.load ( ) ) pressure = Pressure::Shrink;
+
+        if ( _pressure.exchange ( pressure ) == pressure ) return;
+
+        Listener listener;
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            listener = _listener;
+        }
+
+        if ( listener ) listener ( pressure );
+    }
+
+    void MemoryBudget::RunDeferred ( )
+    {
+        // Whatever is let through counts against the room left for the ones behind it, or a
+        // single freed player would let the whole queue in at once
+        std::vector<std::function<void ( )>> ready;
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+
+            const uint64_t limit = _refuseBytes.load ( );
+            uint64_t used = _used.load ( );
+            while ( !_deferred.empty ( ) && ( limit == UINT64_MAX || used + _deferred.front ( ).bytes <= limit ) )
+            {
+                used += _deferred.front ( ).bytes;
+                ready.push_back ( std::move ( _deferred.front ( ).open ) );
+                _deferred.pop_front ( );
+            }
+
+            _deferredCount.store ( _deferred.size ( ) );
+        }
+
+        for ( auto & open : ready )
+        {
+            try
+            {
+                open ( );
+            }
+            catch ( const std::exception & e )
+            {
+                std::cout << "Error: " << e.what ( ) << std::endl;
+            }
+        }
+    }
+
+    MemoryBudget::Stats MemoryBudget::GetStats ( ) const
+    {
+        Stats stats;
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            stats.budget = _options.GetBudget ( );
+            stats.deferred = _deferred.size ( );
+        }
+
+        stats.used = _used.load ( );
+        stats.peak = _peak.load ( );
+        stats.accounts = _accounts.load ( );
+        stats.refused = _refused.load ( );
+        stats.pressure = _pressure.load ( );
+        return stats;
+    }
+
+    void MemoryBudget::Account::Set ( uint64_t bytes )
+    {
+        _budget.Adjust ( _bytes.exchange ( bytes ), bytes );
+    }
+
+    MemoryBudget::Account::~Account ( )
+    {
+        _budget.Adjust ( _bytes.exchange ( 0 ), 0 );
+        _budget._accounts--;
+    }
+}
@@ -0,0 +1,152 @@
+//
+//  AX-MediaPlayerMemoryBudget.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <functional>
+
+namespace AX::Video
+{
+    // Process wide accounting of decoded frame memory (render targets, frame
+    // queues, surfaces). Every player holds an Account and keeps it up to date, the total is
+    // compared against a budget to give a pressure level that players poll each tick and
+    // react to in order: Shrink drops frame queues to their minimum, Downscale halves output
+    // resolution and Refuse turns new players away (or defers them until there's room).
+    // Unlimited until Configure ( ) is given a budget. No dependency on cinder, like MappedFile.
+    class MemoryBudget
+    {
+    public:
+
+        enum class Pressure : uint8_t
+        {
+            None,
+            Shrink,
+            Downscale,
+            Refuse,
+        };
+
+        struct Options
+        {
+            Options & Budget ( uint64_t bytes ) { _budget = bytes; return *this; }
+            Options & ShrinkAt ( float fraction ) { _shrinkAt = fraction; return *this; }
+            Options & DownscaleAt ( float fraction ) { _downscaleAt = fraction; return *this; }
+            Options & RefuseAt ( float fraction ) { _refuseAt = fraction; return *this; }
+
+            uint64_t GetBudget ( ) const { return _budget; }
+            float   GetShrinkAt ( ) const { return _shrinkAt; }
+            float   GetDownscaleAt ( ) const { return _downscaleAt; }
+            float   GetRefuseAt ( ) const { return _refuseAt; }
+
+            Options ( ) { };
+
+        protected:
+
+            uint64_t    _budget{ 0 };           // Bytes, zero for no limit
+            float       _shrinkAt{ 0.75f };     // Fractions of the budget
+            float       _downscaleAt{ 0.9f };
+            float       _refuseAt{ 1.0f };
+        };
+
+        struct Stats
+        {
+            uint64_t    budget{ 0 };
+            uint64_t    used{ 0 };
+            uint64_t    peak{ 0 };
+            uint64_t    accounts{ 0 };
+            uint64_t    refused{ 0 };           // Admit ( ) said no
+            uint64_t    deferred{ 0 };          // Waiting in Defer ( ) right now
+            Pressure    pressure{ Pressure::None };
+        };
+
+        class Account
+        {
+        public:
+
+            Account ( const Account & ) = delete;
+            Account & operator= ( const Account & ) = delete;
+
+            // What the owner has allocated right now, replaces the last value
+            void        Set ( uint64_t bytes );
+            uint64_t    Get ( ) const { return _bytes.load ( ); }
+
+            ~Account ( );
+
+        protected:
+
+            friend class MemoryBudget;
+            Account ( MemoryBudget & budget ) : _budget ( budget ) { }
+
+            MemoryBudget &          _budget;
+            std::atomic<uint64_t>   _bytes{ 0 };
+        };
+
+        using AccountRef = std::unique_ptr<Account>;
+        using Listener = std::function<void ( Pressure )>;
+
+        static MemoryBudget & Shared ( );
+
+        // Can change at any time, the pressure follows straight away
+        void        Configure ( const Options & options );
+        Options     GetOptions ( ) const;
+        bool        IsEnabled ( ) const { return _refuseBytes.load ( ) != UINT64_MAX; }
+
+        AccountRef  OpenAccount ( );
+
+        // A load and a compare, cheap enough to poll per frame from any thread
+        Pressure    GetPressure ( ) const { return _pressure.load ( std::memory_order_relaxed ); }
+
+        // For something about to allocate `bytes`: an account already holding them if that keeps
+        // the total under RefuseAt, otherwise null. Taken in one step so a burst of callers can't
+        // all fit into the same room, the owner Set ( )s the real figure once it has allocated.
+        AccountRef  Admit ( uint64_t bytes );
+
+        // Runs `open` once `bytes` fits, in the order they were deferred. Straight away (on the
+        // caller) if it already fits, otherwise on whichever thread frees up the room.
+        void        Defer ( uint64_t bytes, std::function<void ( )> open );
+
+        // Called on whichever thread changed the level, once per change
+        void        SetListener ( Listener listener );
+
+        Stats       GetStats ( ) const;
+
+    protected:
+
+        struct Deferred
+        {
+            uint64_t                bytes;
+            std::function<void ( )> open;
+        };
+
+        MemoryBudget ( ) { };
+
+        void        Adjust ( uint64_t previous, uint64_t bytes );
+        void        NotePeak ( uint64_t used );
+        void        Evaluate ( );
+        void        RunDeferred ( );
+
+        std::atomic<uint64_t>   _used{ 0 };
+        std::atomic<uint64_t>   _peak{ 0 };
+        std::atomic<uint64_t>   _accounts{ 0 };
+        std::atomic<uint64_t>   _refused{ 0 };
+        std::atomic<uint64_t>   _shrinkBytes{ UINT64_MAX };
+        std::atomic<uint64_t>   _downscaleBytes{ UINT64_MAX };
+        std::atomic<uint64_t>   _refuseBytes{ UINT64_MAX };
+        std::atomic<Pressure>   _pressure{ Pressure::None };
+        std::atomic<size_t>     _deferredCount{ 0 };
+
+        mutable std::mutex      _mutex;
+        Options                 _options;
+        std::deque<Deferred>    _deferred;
+        Listener                _listener;
+    };
+}
@@ -0,0 +1,434 @@
+//
+//  AX-MediaPlayerMosaic.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerMosaic.h"
+
+#include <cmath>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+    #include <emmintrin.h>
+    #define AX_MEDIAPLAYER_MOSAIC_SSE2
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+    #include <arm_neon.h>
+    #define AX_MEDIAPLAYER_MOSAIC_NEON
+#endif
+
+using namespace ci;
+
+namespace
+{
+    // Rows handed to a thread at a time, small enough to balance a handful of cells
+    static constexpr int kRowsPerJob = 16;
+
+    static inline uint32_t LoadPixel ( const uint8_t * p )
+    {
+        uint32_t value;
+        std::memcpy ( &value, p, sizeof ( value ) );
+        return value;
+    }
+}
+
+namespace AX::Video
+{
+    MosaicCompositorRef MosaicCompositor::Create ( const Options & options )
+    {
+        if ( options.GetSize ( ).x <= 0 || options.GetSize ( ).y <= 0 ) return nullptr;
+        return MosaicCompositorRef ( new MosaicCompositor ( options ) );
+    }
+
+    MosaicCompositor::MosaicCompositor ( const Options & options )
+        : _options ( options )
+    {
+        auto & order = _options.GetChannelOrder ( );
+        _surface = Surface8u::create ( _options.GetSize ( ).x, _options.GetSize ( ).y, true, order );
+
+        auto & bg = _options.GetBackground ( );
+        _background[order.getRedOffset ( )] = bg.r;
+        _background[order.getGreenOffset ( )] = bg.g;
+        _background[order.getBlueOffset ( )] = bg.b;
+        _background[order.getAlphaOffset ( )] = bg.a;
+
+        // Starts out as all background
+        for ( int y = 0; y < _surface->getHeight ( ); y++ )
+        {
+            uint8_t * row = _surface->getData ( ivec2 ( 0, y ) );
+            for ( int x = 0; x < _surface->getWidth ( ); x++ ) std::memcpy ( row + x * 4, _background, 4 );
+        }
+    }
+
+    Area MosaicCompositor::GetGridCell ( int index ) const
+    {
+        const int columns = std::max ( 1, _options.GetColumns ( ) );
+        const int rows = std::max ( 1, _options.GetRows ( ) );
+        const int gutter = _options.GetGutter ( );
+        const ivec2 size = _options.GetSize ( );
+
+        int column = index % columns;
+        int row = index / columns;
+
+        int x1 = size.x * column / columns;
+        int x2 = size.x * ( column + 1 ) / columns;
+        int y1 = size.y * row / rows;
+        int y2 = size.y * ( row + 1 ) / rows;
+
+        return Area ( x1 + gutter / 2, y1 + gutter / 2, x2 - ( gutter - gutter / 2 ), y2 - ( gutter - gutter / 2 ) );
+    }
+
+    bool MosaicCompositor::Add ( const MediaPlayerRef & player )
+    {
+        const int capacity = std::max ( 1, _options.GetColumns ( ) ) * std::max ( 1, _options.GetRows ( ) );
+        for ( int index = 0; index < capacity; index++ )
+        {
+            bool taken = std::any_of ( _cells.begin ( ), _cells.end ( ), [=] ( const Cell & cell ) { return cell.gridIndex == index; } );
+            if ( taken ) continue;
+
+            if ( !Add ( player, GetGridCell ( index ) ) ) return false;
+            _cells.back ( ).gridIndex = index;
+            return true;
+        }
+
+        return false;
+    }
+
+    bool MosaicCompositor::Add ( const MediaPlayerRef & player, const Area & bounds )
+    {
+        if ( !player ) return false;
+
+        Area clipped = bounds;
+        clipped.clipBy ( _surface->getBounds ( ) );
+        if ( clipped.getWidth ( ) <= 0 || clipped.getHeight ( ) <= 0 ) return false;
+
+        Cell cell;
+        cell.player = player;
+        cell.bounds = clipped;
+        _cells.push_back ( std::move ( cell ) );
+        return true;
+    }
+
+    void MosaicCompositor::Remove ( const MediaPlayerRef & player )
+    {
+        for ( auto it = _cells.begin ( ); it != _cells.end ( ); )
+        {
+            if ( it->player == player )
+            {
+                _cleared.push_back ( it->bounds );
+                it = _cells.erase ( it );
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    void MosaicCompositor::SetAlpha ( const MediaPlayerRef & player, float alpha )
+    {
+        for ( auto & cell : _cells )
+        {
+            if ( cell.player == player && cell.alpha != alpha )
+            {
+                cell.alpha = std::clamp ( alpha, 0.0f, 1.0f );
+                cell.dirty = true;
+            }
+        }
+    }
+
+    void MosaicCompositor::Prepare ( Cell & cell, const Surface8uRef & frame )
+    {
+        const ivec2 sourceSize = frame->getSize ( );
+        const int32_t pixelInc = frame->getPixelInc ( );
+
+        // Where each output channel comes from in the source pixel
+        auto & order = _surface->getChannelOrder ( );
+        cell.order[order.getRedOffset ( )] = static_cast<int8_t> ( frame->getRedOffset ( ) );
+        cell.order[order.getGreenOffset ( )] = static_cast<int8_t> ( frame->getGreenOffset ( ) );
+        cell.order[order.getBlueOffset ( )] = static_cast<int8_t> ( frame->getBlueOffset ( ) );
+        cell.order[order.getAlphaOffset ( )] = static_cast<int8_t> ( frame->hasAlpha ( ) ? frame->getAlphaOffset ( ) : -1 );
+
+        cell.frame = frame;
+        if ( sourceSize == cell.sourceSize && pixelInc == cell.sourcePixelInc && !cell.weights.empty ( ) ) return;
+
+        cell.sourceSize = sourceSize;
+        cell.sourcePixelInc = pixelInc;
+        cell.content = cell.bounds;
+
+        if ( _options.IsKeepingAspect ( ) )
+        {
+            const float scale = std::min ( cell.bounds.getWidth ( ) / static_cast<float> ( sourceSize.x ), cell.bounds.getHeight ( ) / static_cast<float> ( sourceSize.y ) );
+            const int w = std::max ( 1, static_cast<int> ( std::lround ( sourceSize.x * scale ) ) );
+            const int h = std::max ( 1, static_cast<int> ( std::lround ( sourceSize.y * scale ) ) );
+            const int x = cell.bounds.x1 + ( cell.bounds.getWidth ( ) - w ) / 2;
+            const int y = cell.bounds.y1 + ( cell.bounds.getHeight ( ) - h ) / 2;
+            cell.content = Area ( x, y, x + w, y + h );
+        }
+
+        const int width = cell.content.getWidth ( );
+        cell.left.resize ( width );
+        cell.right.resize ( width );
+        cell.weights.resize ( width );
+
+        const double step = sourceSize.x / static_cast<double> ( width );
+        for ( int x = 0; x < width; x++ )
+        {
+            double sx = std::clamp ( ( x + 0.5 ) * step - 0.5, 0.0, sourceSize.x - 1.0 );
+            int x0 = static_cast<int> ( sx );
+            int x1 = std::min ( x0 + 1, sourceSize.x - 1 );
+
+            cell.left[x] = x0 * pixelInc;
+            cell.right[x] = x1 * pixelInc;
+            cell.weights[x] = static_cast<uint8_t> ( std::lround ( ( sx - x0 ) * 128.0 ) );
+        }
+
+        // Letterboxing changed, so the whole cell gets repainted
+        cell.dirty = true;
+    }
+
+    void MosaicCompositor::ScaleRow ( const uint8_t * top, const uint8_t * bottom, int weightY, const int32_t * left, const int32_t * right, const uint8_t * weights, int sourcePixelInc, const int8_t order[4], uint8_t * dst, int width, int alpha, const uint8_t background[4] )
+    {
+        int x = 0;
+
+#if defined(AX_MEDIAPLAYER_MOSAIC_SSE2) || defined(AX_MEDIAPLAYER_MOSAIC_NEON)
+        // The vector paths cover 4 byte pixels that are either in the output's
+        // order or have red and blue swapped, which is every surface the platforms hand out.
+        const bool rgb = order[0] >= 0 && order[1] >= 0 && order[2] >= 0 && order[0] < 4 && order[1] < 4 && order[2] < 4;
+        const bool same = order[0] == 0 && order[1] == 1 && order[2] == 2;
+        const bool swapped = order[0] == 2 && order[1] == 1 && order[2] == 0;
+        const bool opaque = order[3] < 0;
+        const bool vectorized = sourcePixelInc == 4 && rgb && ( same || swapped ) && ( opaque || order[3] == 3 );
+
+        if ( vectorized )
+        {
+            // Blend in source order, the swizzle happens last
+            uint8_t bg[4];
+            std::memcpy ( bg, background, 4 );
+            if ( swapped ) std::swap ( bg[0], bg[2] );
+
+#if defined(AX_MEDIAPLAYER_MOSAIC_SSE2)
+            const __m128i zero = _mm_setzero_si128 ( );
+            const __m128i k128 = _mm_set1_epi16 ( 128 );
+            const __m128i k64 = _mm_set1_epi16 ( 64 );
+            const __m128i wy = _mm_set1_epi16 ( static_cast<short> ( weightY ) );
+            const __m128i iwy = _mm_sub_epi16 ( k128, wy );
+            const __m128i wa = _mm_set1_epi16 ( static_cast<short> ( alpha ) );
+            const __m128i bgw = _mm_mullo_epi16 ( _mm_set_epi16 ( bg[3], bg[2], bg[1], bg[0], bg[3], bg[2], bg[1], bg[0] ), _mm_sub_epi16 ( k128, wa ) );
+            const __m128i alphaMask = _mm_set_epi32 ( 0, 0, static_cast<int> ( 0xFF000000 ), static_cast<int> ( 0xFF000000 ) );
+
+            for ( ; x + 2 <= width; x += 2 )
+            {
+                __m128i tl = _mm_unpacklo_epi8 ( _mm_set_epi32 ( 0, 0, LoadPixel ( top + left[x + 1] ), LoadPixel ( top + left[x] ) ), zero );
+                __m128i tr = _mm_unpacklo_epi8 ( _mm_set_epi32 ( 0, 0, LoadPixel ( top + right[x + 1] ), LoadPixel ( top + right[x] ) ), zero );
+                __m128i bl = _mm_unpacklo_epi8 ( _mm_set_epi32 ( 0, 0, LoadPixel ( bottom + left[x + 1] ), LoadPixel ( bottom + left[x] ) ), zero );
+                __m128i br = _mm_unpacklo_epi8 ( _mm_set_epi32 ( 0, 0, LoadPixel ( bottom + right[x + 1] ), LoadPixel ( bottom + right[x] ) ), zero );
+
+                const short w0 = weights[x];
+                const short w1 = weights[x + 1];
+                __m128i wx = _mm_set_epi16 ( w1, w1, w1, w1, w0, w0, w0, w0 );
+                __m128i iwx = _mm_sub_epi16 ( k128, wx );
+
+                // Every product stays under 255 * 128 so 16 bit lanes never overflow
+                __m128i t = _mm_srli_epi16 ( _mm_add_epi16 ( _mm_add_epi16 ( _mm_mullo_epi16 ( tl, iwx ), _mm_mullo_epi16 ( tr, wx ) ), k64 ), 7 );
+                __m128i b = _mm_srli_epi16 ( _mm_add_epi16 ( _mm_add_epi16 ( _mm_mullo_epi16 ( bl, iwx ), _mm_mullo_epi16 ( br, wx ) ), k64 ), 7 );
+                __m128i v = _mm_srli_epi16 ( _mm_add_epi16 ( _mm_add_epi16 ( _mm_mullo_epi16 ( t, iwy ), _mm_mullo_epi16 ( b, wy ) ), k64 ), 7 );
+
+                if ( alpha < 128 ) v = _mm_srli_epi16 ( _mm_add_epi16 ( _mm_add_epi16 ( _mm_mullo_epi16 ( v, wa ), bgw ), k64 ), 7 );
+                if ( swapped ) v = _mm_shufflehi_epi16 ( _mm_shufflelo_epi16 ( v, _MM_SHUFFLE ( 3, 0, 1, 2 ) ), _MM_SHUFFLE ( 3, 0, 1, 2 ) );
+
+                __m128i packed = _mm_packus_epi16 ( v, zero );
+                if ( opaque ) packed = _mm_or_si128 ( packed, alphaMask );
+                _mm_storel_epi64 ( reinterpret_cast<__m128i *> ( dst + x * 4 ), packed );
+            }
+#else
+            const uint16x8_t k128 = vdupq_n_u16 ( 128 );
+            const uint16x8_t k64 = vdupq_n_u16 ( 64 );
+            const uint16x8_t wy = vdupq_n_u16 ( static_cast<uint16_t> ( weightY ) );
+            const uint16x8_t iwy = vsubq_u16 ( k128, wy );
+            const uint16x8_t wa = vdupq_n_u16 ( static_cast<uint16_t> ( alpha ) );
+            const uint8_t bgPair[8] = { bg[0], bg[1], bg[2], bg[3], bg[0], bg[1], bg[2], bg[3] };
+            const uint16x8_t bgw = vmulq_u16 ( vmovl_u8 ( vld1_u8 ( bgPair ) ), vsubq_u16 ( k128, wa ) );
+            const uint8_t swizzle[8] = { 2, 1, 0, 3, 6, 5, 4, 7 };
+            const uint8x8_t swizzleTable = vld1_u8 ( swizzle );
+            const uint8_t mask[8] = { 0, 0, 0, 0xFF, 0, 0, 0, 0xFF };
+            const uint8x8_t alphaMask = vld1_u8 ( mask );
+
+            auto load = [] ( const uint8_t * a, const uint8_t * b )
+            {
+                uint32x2_t pair = vdup_n_u32 ( LoadPixel ( a ) );
+                pair = vset_lane_u32 ( LoadPixel ( b ), pair, 1 );
+                return vmovl_u8 ( vreinterpret_u8_u32 ( pair ) );
+            };
+
+            for ( ; x + 2 <= width; x += 2 )
+            {
+                uint16x8_t tl = load ( top + left[x], top + left[x + 1] );
+                uint16x8_t tr = load ( top + right[x], top + right[x + 1] );
+                uint16x8_t bl = load ( bottom + left[x], bottom + left[x + 1] );
+                uint16x8_t br = load ( bottom + right[x], bottom + right[x + 1] );
+
+                uint16x8_t wx = vcombine_u16 ( vdup_n_u16 ( weights[x] ), vdup_n_u16 ( weights[x + 1] ) );
+                uint16x8_t iwx = vsubq_u16 ( k128, wx );
+
+                uint16x8_t t = vshrq_n_u16 ( vaddq_u16 ( vmlaq_u16 ( vmulq_u16 ( tl, iwx ), tr, wx ), k64 ), 7 );
+                uint16x8_t b = vshrq_n_u16 ( vaddq_u16 ( vmlaq_u16 ( vmulq_u16 ( bl, iwx ), br, wx ), k64 ), 7 );
+                uint16x8_t v = vshrq_n_u16 ( vaddq_u16 ( vmlaq_u16 ( vmulq_u16 ( t, iwy ), b, wy ), k64 ), 7 );
+
+                if ( alpha < 128 ) v = vshrq_n_u16 ( vaddq_u16 ( vmlaq_u16 ( bgw, v, wa ), k64 ), 7 );
+
+                uint8x8_t packed = vmovn_u16 ( v );
+                if ( swapped ) packed = vtbl1_u8 ( packed, swizzleTable );
+                if ( opaque ) packed = vorr_u8 ( packed, alphaMask );
+                vst1_u8 ( dst + x * 4, packed );
+            }
+#endif
+        }
+#endif
+
+        // Whatever's left, and any layout the vector paths don't cover
+        for ( ; x < width; x++ )
+        {
+            const int w = weights[x];
+            for ( int c = 0; c < 4; c++ )
+            {
+                const int s = order[c];
+                if ( s < 0 )
+                {
+                    dst[x * 4 + c] = 255;
+                    continue;
+                }
+
+                int t = ( top[left[x] + s] * ( 128 - w ) + top[right[x] + s] * w + 64 ) >> 7;
+                int b = ( bottom[left[x] + s] * ( 128 - w ) + bottom[right[x] + s] * w + 64 ) >> 7;
+                int v = ( t * ( 128 - weightY ) + b * weightY + 64 ) >> 7;
+                if ( alpha < 128 ) v = ( v * alpha + background[c] * ( 128 - alpha ) + 64 ) >> 7;
+                dst[x * 4 + c] = static_cast<uint8_t> ( v );
+            }
+        }
+    }
+
+    void MosaicCompositor::Draw ( const Job & job )
+    {
+        const Cell & cell = *job.cell;
+        const Area & bounds = cell.bounds;
+        const Area & content = cell.content;
+        const int alpha = static_cast<int> ( std::lround ( cell.alpha * 128.0f ) );
+
+        auto fill = [&] ( uint8_t * row, int count )
+        {
+            for ( int i = 0; i < count; i++ ) std::memcpy ( row + i * 4, _background, 4 );
+        };
+
+        const double step = cell.sourceSize.y / static_cast<double> ( std::max ( 1, content.getHeight ( ) ) );
+        for ( int y = job.rowBegin; y < job.rowEnd; y++ )
+        {
+            uint8_t * row = _surface->getData ( ivec2 ( bounds.x1, y ) );
+            if ( !cell.frame || y < content.y1 || y >= content.y2 )
+            {
+                fill ( row, bounds.getWidth ( ) );
+                continue;
+            }
+
+            fill ( row, content.x1 - bounds.x1 );
+            fill ( row + ( content.x2 - bounds.x1 ) * 4, bounds.x2 - content.x2 );
+
+            double sy = std::clamp ( ( y - content.y1 + 0.5 ) * step - 0.5, 0.0, cell.sourceSize.y - 1.0 );
+            int y0 = static_cast<int> ( sy );
+            int y1 = std::min ( y0 + 1, cell.sourceSize.y - 1 );
+            int weightY = static_cast<int> ( std::lround ( ( sy - y0 ) * 128.0 ) );
+
+            const uint8_t * top = cell.frame->getData ( ivec2 ( 0, y0 ) );
+            const uint8_t * bottom = cell.frame->getData ( ivec2 ( 0, y1 ) );
+            ScaleRow ( top, bottom, weightY, cell.left.data ( ), cell.right.data ( ), cell.weights.data ( ), cell.sourcePixelInc, cell.order, row + ( content.x1 - bounds.x1 ) * 4, content.getWidth ( ), alpha, _background );
+        }
+    }
+
+    bool MosaicCompositor::Update ( )
+    {
+        auto start = std::chrono::steady_clock::now ( );
+
+        _jobs.clear ( );
+        for ( auto & cell : _cells )
+        {
+            // A player's surface is only the consumer's until its next swap, after
+            // that (with BackgroundTransfer) it's handed back to the producer and written over. So
+            // a redraw for an alpha or layout change reads whatever the player has now, never a
+            // frame kept from an earlier Update ( ).
+            if ( cell.player->CheckNewFrame ( ) || cell.dirty )
+            {
+                if ( auto & frame = cell.player->GetSurface ( ) )
+                {
+                    Prepare ( cell, frame );
+                    cell.dirty = true;
+                }
+            }
+
+            if ( !cell.dirty )
+            {
+                _stats.cellsSkipped++;
+                continue;
+            }
+
+            for ( int y = cell.bounds.y1; y < cell.bounds.y2; y += kRowsPerJob )
+            {
+                _jobs.push_back ( { &cell, y, std::min ( y + kRowsPerJob, cell.bounds.y2 ) } );
+            }
+
+            cell.dirty = false;
+            _stats.cellsDrawn++;
+        }
+
+        for ( auto & area : _cleared )
+        {
+            for ( int y = area.y1; y < area.y2; y++ )
+            {
+                uint8_t * row = _surface->getData ( ivec2 ( area.x1, y ) );
+                for ( int x = 0; x < area.getWidth ( ); x++ ) std::memcpy ( row + x * 4, _background, 4 );
+            }
+        }
+
+        bool changed = !_jobs.empty ( ) || !_cleared.empty ( );
+        _cleared.clear ( );
+        if ( !changed ) return false;
+
+        RunJobs ( );
+        for ( auto & cell : _cells ) cell.frame = nullptr;
+
+        double ms = std::chrono::duration<double, std::milli> ( std::chrono::steady_clock::now ( ) - start ).count ( );
+        _stats.composites++;
+        _stats.lastComposeMs = ms;
+        _stats.averageComposeMs += ( ms - _stats.averageComposeMs ) / std::min<uint64_t> ( _stats.composites, 60 );
+        _needsUpload = true;
+        return true;
+    }
+
+    gl::TextureRef MosaicCompositor::GetTexture ( )
+    {
+        if ( !_texture )
+        {
+            _texture = gl::Texture::create ( *_surface );
+            _stats.uploads++;
+        }
+        else if ( _needsUpload )
+        {
+            _texture->update ( *_surface );
+            _stats.uploads++;
+        }
+
+        _needsUpload = false;
+        return _texture;
+    }
+
+    void MosaicCompositor::RunJobs ( )
+    {
+        // The calling thread does its share, so one fewer helper. Present priority since the
+        // composite is for the frame that's about to be drawn.
+        const int threads = _options.GetThreads ( ) > 0 ? _options.GetThreads ( ) : 8;
+        Executor::Shared ( ).ParallelFor ( Executor::Priority::Present, _jobs.size ( ), [this] ( size_t i ) { Draw ( _jobs[i] ); }, static_cast<size_t> ( threads - 1 ) );
+    }
+}
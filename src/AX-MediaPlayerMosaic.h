@@ -0,0 +1,144 @@
+//
+//  AX-MediaPlayerMosaic.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include "AX-MediaPlayer.h"
+#include "AX-MediaPlayerExecutor.h"
+
+#include <vector>
+
+namespace AX::Video
+{
+    using MosaicCompositorRef = std::shared_ptr<class MosaicCompositor>;
+
+    // Composites the CPU frames of many players into one pre-allocated surface,
+    // so a wall of 64 small players is one upload and one draw rather than 64 of each. Only
+    // cells whose player produced a new frame are redrawn, each one scaled (bilinear) into
+    // its cell and blended over the background with the cell's alpha, with the rows split
+    // across the shared Executor. Needs players with CPU surfaces, i.e
+    // Format ( ).HardwareAccelerated ( false ), and works without a GL context via GetSurface ( ).
+    class MosaicCompositor
+    {
+    public:
+
+        struct Options
+        {
+            Options & Size ( const ci::ivec2 & size ) { _size = size; return *this; }
+            Options & Grid ( int columns, int rows ) { _columns = columns; _rows = rows; return *this; }
+            Options & Gutter ( int pixels ) { _gutter = pixels; return *this; }
+            Options & Background ( const ci::ColorA8u & color ) { _background = color; return *this; }
+            Options & KeepAspect ( bool keep ) { _keepAspect = keep; return *this; }
+            Options & ChannelOrder ( const ci::SurfaceChannelOrder & order ) { _channelOrder = order; return *this; }
+            Options & Threads ( int threads ) { _threads = threads; return *this; }
+
+            const ci::ivec2 & GetSize ( ) const { return _size; }
+            int     GetColumns ( ) const { return _columns; }
+            int     GetRows ( ) const { return _rows; }
+            int     GetGutter ( ) const { return _gutter; }
+            const ci::ColorA8u & GetBackground ( ) const { return _background; }
+            bool    IsKeepingAspect ( ) const { return _keepAspect; }
+            const ci::SurfaceChannelOrder & GetChannelOrder ( ) const { return _channelOrder; }
+            int     GetThreads ( ) const { return _threads; }
+
+            Options ( ) { };
+
+        protected:
+
+            ci::ivec2   _size{ 1920, 1080 };
+            int         _columns{ 8 };
+            int         _rows{ 8 };
+            int         _gutter{ 0 };
+            ci::ColorA8u _background{ 0, 0, 0, 255 };
+            bool        _keepAspect{ true };
+            ci::SurfaceChannelOrder _channelOrder{ ci::SurfaceChannelOrder::BGRA }; // Matches the Windows surfaces, nothing to swizzle
+            int         _threads{ 0 };                                                  // Most threads a composite is spread across, zero for 8
+        };
+
+        struct Stats
+        {
+            uint64_t    composites{ 0 };        // Update ( ) calls that changed something
+            uint64_t    cellsDrawn{ 0 };
+            uint64_t    cellsSkipped{ 0 };      // No new frame, left as they were
+            uint64_t    uploads{ 0 };
+            double      lastComposeMs{ 0.0 };
+            double      averageComposeMs{ 0.0 };
+        };
+
+        static MosaicCompositorRef Create ( const Options & options = Options ( ) );
+
+        // Takes the next free grid cell, or a custom area of the output. False if the grid is full.
+        bool        Add ( const MediaPlayerRef & player );
+        bool        Add ( const MediaPlayerRef & player, const ci::Area & bounds );
+        void        Remove ( const MediaPlayerRef & player );
+        void        SetAlpha ( const MediaPlayerRef & player, float alpha );
+
+        // Redraws every cell with a new frame. True if the surface changed.
+        bool        Update ( );
+
+        const ci::Surface8uRef & GetSurface ( ) const { return _surface; }
+
+        // Uploads the surface if it changed since the last call
+        ci::gl::TextureRef GetTexture ( );
+
+        inline const Options & GetOptions ( ) const { return _options; }
+        Stats       GetStats ( ) const { return _stats; }
+
+        // Bilinear scale of one output row from two source rows, blended over
+        // `background` by `alpha` (0 - 128). `left` / `right` are byte offsets of each output
+        // pixel's neighbours in the source rows and `weights` the right hand weight (0 - 128).
+        // `order` maps each output channel to a source byte, -1 for opaque alpha.
+        static void ScaleRow ( const uint8_t * top, const uint8_t * bottom, int weightY, const int32_t * left, const int32_t * right, const uint8_t * weights, int sourcePixelInc, const int8_t order[4], uint8_t * dst, int width, int alpha, const uint8_t background[4] );
+
+    protected:
+
+        struct Cell
+        {
+            MediaPlayerRef      player;
+            ci::Area            bounds;
+            ci::Area            content;        // bounds less any letterboxing
+            float               alpha{ 1.0f };
+            int                 gridIndex{ -1 };
+            bool                dirty{ true };
+
+            // Rebuilt when the source size or layout changes
+            ci::ivec2           sourceSize{ 0 };
+            int32_t             sourcePixelInc{ 0 };
+            std::vector<int32_t> left;
+            std::vector<int32_t> right;
+            std::vector<uint8_t> weights;
+            int8_t              order[4];
+            ci::Surface8uRef    frame;          // Only for the duration of the Update ( ) that drew it
+        };
+
+        struct Job
+        {
+            Cell *  cell;
+            int     rowBegin;
+            int     rowEnd;
+        };
+
+        MosaicCompositor ( const Options & options );
+
+        ci::Area    GetGridCell ( int index ) const;
+        void        Prepare ( Cell & cell, const ci::Surface8uRef & frame );
+        void        Draw ( const Job & job );
+        void        RunJobs ( );
+
+        Options                 _options;
+        Stats                   _stats;
+        ci::Surface8uRef        _surface;
+        ci::gl::TextureRef      _texture;
+        bool                    _needsUpload{ true };
+        std::vector<Cell>       _cells;
+        std::vector<ci::Area>   _cleared;       // Left behind by removed cells
+        uint8_t                 _background[4];
+
+        std::vector<Job>        _jobs;
+    };
+}
@@ -0,0 +1,161 @@
+//
+//  AX-MediaPlayerOfflineReader.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerOfflineReader.h"
+#include "cinder/Log.h"
+
+#include <algorithm>
+
+using namespace ci;
+
+namespace
+{
+    // Container timestamps don't survive the round trip through seconds exactly
+    constexpr double kEpsilon = 1e-4;
+
+    // Further ahead than this it's cheaper to seek than to decode everything in between
+    constexpr double kSeekAheadSeconds = 2.0;
+
+    class OfflineFrameLease : public AX::Video::MediaPlayer::FrameLease
+    {
+    public:
+
+        OfflineFrameLease ( const gl::TextureRef & texture )
+            : _texture ( texture )
+        { }
+
+        gl::TextureRef ToTexture ( ) const override { return _texture; }
+
+    protected:
+
+        bool IsValid ( ) const override { return _texture != nullptr; }
+
+        gl::TextureRef _texture;
+    };
+}
+
+namespace AX::Video
+{
+    OfflineReaderRef OfflineReader::Create ( const ci::fs::path & path, const StreamingTexture::Options & options )
+    {
+        auto decoder = VideoDecoder::Create ( path );
+        if ( !decoder )
+        {
+            CI_LOG_E ( "Couldn't open " << path << " for offline decoding" );
+            return nullptr;
+        }
+
+        return OfflineReaderRef ( new OfflineReader ( std::move ( decoder ), options ) );
+    }
+
+    OfflineReader::OfflineReader ( std::unique_ptr<VideoDecoder> decoder, const StreamingTexture::Options & options )
+        : _decoder ( std::move ( decoder ) )
+        , _textureOptions ( options )
+        , _size ( _decoder->GetWidth ( ), _decoder->GetHeight ( ) )
+    {
+        _current = Surface8u::create ( _size.x, _size.y, false, SurfaceChannelOrder::BGRX );
+        _next = Surface8u::create ( _size.x, _size.y, false, SurfaceChannelOrder::BGRX );
+    }
+
+    bool OfflineReader::DecodeNext ( )
+    {
+        if ( _hasNext ) return true;
+        if ( _ended ) return false;
+
+        if ( !_decoder->Decode ( _next->getData ( ), _next->getRowBytes ( ), _nextPts ) )
+        {
+            _ended = true;
+            return false;
+        }
+
+        _hasNext = true;
+        return true;
+    }
+
+    void OfflineReader::Promote ( )
+    {
+        std::swap ( _current, _next );
+        _currentPts = _nextPts;
+        _hasCurrent = true;
+        _hasNext = false;
+        _hasNewFrame = true;
+        _index++;
+    }
+
+    bool OfflineReader::Seek ( double seconds )
+    {
+        if ( !_decoder->Seek ( std::max ( 0.0, seconds ) ) ) return false;
+
+        // Whatever was decoded ahead belongs to the old position
+        _hasNext = false;
+        _ended = false;
+        return true;
+    }
+
+    bool OfflineReader::NextFrame ( )
+    {
+        if ( !DecodeNext ( ) ) return false;
+
+        Promote ( );
+        _time = _currentPts;
+        return true;
+    }
+
+    bool OfflineReader::FrameAt ( double seconds )
+    {
+        const double target = seconds + kEpsilon;
+
+        bool behind = _hasCurrent && target < _currentPts;
+        bool farAhead = _hasCurrent && seconds - _currentPts > kSeekAheadSeconds;
+        if ( behind || farAhead )
+        {
+            // The platform seek lands on the keyframe at or before the target,
+            // from there it's decoded forward like any other request. If the seek fails the
+            // forward walk below still gets there when the target is ahead.
+            if ( Seek ( seconds ) ) _hasCurrent = false;
+        }
+
+        while ( DecodeNext ( ) && _nextPts <= target )
+        {
+            Promote ( );
+        }
+
+        // Before the first frame (or a seek that landed past the target), show the earliest we have
+        if ( !_hasCurrent && _hasNext ) Promote ( );
+
+        _time = seconds;
+        return _hasCurrent;
+    }
+
+    const Surface8uRef & OfflineReader::GetSurface ( ) const
+    {
+        _hasNewFrame = false;
+        return _current;
+    }
+
+    MediaPlayer::FrameLeaseRef OfflineReader::GetTexture ( ) const
+    {
+        _hasNewFrame = false;
+        if ( !_hasCurrent ) return nullptr;
+
+        if ( !_texture ) _texture = StreamingTexture::Create ( _textureOptions );
+        if ( _uploadedIndex != _index )
+        {
+            _texture->Upload ( *_current );
+            _uploadedIndex = _index;
+        }
+
+        return std::make_unique<OfflineFrameLease> ( _texture->GetTexture ( ) );
+    }
+
+    FrameSink::Frame OfflineReader::GetFrame ( ) const
+    {
+        if ( !_hasCurrent ) return { };
+        return { _current->getData ( ), _size, _current->getRowBytes ( ), _current->getChannelOrder ( ), _currentPts };
+    }
+}
@@ -0,0 +1,81 @@
+//
+//  AX-MediaPlayerOfflineReader.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include "AX-MediaPlayer.h"
+#include "AX-MediaPlayerVideoDecoder.h"
+#include "AX-MediaPlayerFrameSink.h"
+
+namespace AX::Video
+{
+    using OfflineReaderRef = std::unique_ptr<class OfflineReader>;
+
+    // The video side of a Format::Offline ( true ) player. There's no playback
+    // clock, time only moves when NextFrame ( ) or FrameAt ( ) is called and both block until
+    // the frame they're after has been decoded. Every frame the file contains comes out of
+    // NextFrame ( ) exactly once, in order, and FrameAt ( t ) always lands on the frame that
+    // would be on screen at `t` (the last one with a timestamp <= t), so a render driven by
+    // either produces identical output on every run at whatever speed the decoder manages.
+    //
+    // One frame is decoded ahead so FrameAt ( ) knows when to stop without a second seek.
+    class OfflineReader
+    {
+    public:
+
+        static OfflineReaderRef Create ( const ci::fs::path & path, const StreamingTexture::Options & options = StreamingTexture::Options ( ) );
+
+        // Next frame in decode order, false once the stream has ended (the last frame stays current)
+        bool    NextFrame ( );
+
+        // The frame that's on screen at `seconds`, seeking if it's behind us or a long way ahead
+        bool    FrameAt ( double seconds );
+
+        inline  double GetTime ( ) const { return _time; }
+        inline  double GetFramePts ( ) const { return _currentPts; }
+        inline  uint64_t GetFrameIndex ( ) const { return _index; }
+        inline  bool   HasFrame ( ) const { return _hasCurrent; }
+        inline  bool   IsComplete ( ) const { return _ended && !_hasNext; }
+
+        inline  const ci::ivec2 & GetSize ( ) const { return _size; }
+        inline  double GetDurationInSeconds ( ) const { return _decoder->GetDurationInSeconds ( ); }
+        inline  double GetFrameRate ( ) const { return _decoder->GetFrameRate ( ); }
+
+        bool    CheckNewFrame ( ) const { return _hasNewFrame; }
+        const ci::Surface8uRef & GetSurface ( ) const;
+        MediaPlayer::FrameLeaseRef GetTexture ( ) const;
+
+        // A view of the current frame for frame sinks
+        FrameSink::Frame GetFrame ( ) const;
+
+    protected:
+
+        OfflineReader ( std::unique_ptr<VideoDecoder> decoder, const StreamingTexture::Options & options );
+
+        bool    DecodeNext ( );
+        void    Promote ( );
+        bool    Seek ( double seconds );
+
+        std::unique_ptr<VideoDecoder> _decoder;
+        StreamingTexture::Options _textureOptions;
+        mutable StreamingTextureRef _texture;
+        mutable uint64_t        _uploadedIndex{ 0 };
+
+        ci::ivec2               _size{ 0 };
+        ci::Surface8uRef        _current;
+        ci::Surface8uRef        _next;
+        double                  _currentPts{ 0.0 };
+        double                  _nextPts{ 0.0 };
+        bool                    _hasCurrent{ false };
+        bool                    _hasNext{ false };
+        bool                    _ended{ false };
+        double                  _time{ 0.0 };
+        uint64_t                _index{ 0 };        // Frames promoted so far, 0 before the first
+        mutable bool            _hasNewFrame{ false };
+    };
+}
@@ -0,0 +1,179 @@
+//
+//  AX-MediaPlayerPresentationScheduler.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerPresentationScheduler.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace AX::Video
+{
+    PresentationScheduler::PresentationScheduler ( const Options & options )
+        : _options ( options )
+    {
+        Reset ( );
+    }
+
+    void PresentationScheduler::Reset ( )
+    {
+        _locked = false;
+        _bias = 0.0;
+        _currentPts = -1.0;
+        _lastQueuedPts = -1.0;
+        _heldFor = 0;
+        _phaseCount = 0;
+        _phaseHead = 0;
+    }
+
+    int PresentationScheduler::Select ( const double * queued, size_t count, double displayMedia, double refreshInterval )
+    {
+        _stats.refreshes++;
+        _refresh = refreshInterval;
+
+        if ( count == 0 )
+        {
+            _heldFor++;
+            return -1;
+        }
+
+        // Timestamps going backwards is a seek or a loop, none of the cadence history applies
+        const double newest = queued[count - 1];
+        if ( _lastQueuedPts >= 0.0 && newest < _lastQueuedPts ) Reset ( );
+
+        auto observe = [&] ( double delta )
+        {
+            if ( delta <= 0.0 || delta >= 1.0 ) return;
+            if ( _interval <= 0.0 || delta < _interval * 0.75 ) _interval = delta;
+            else if ( delta < _interval * 1.5 ) _interval += ( delta - _interval ) * 0.1;
+        };
+
+        if ( _lastQueuedPts >= 0.0 && newest > _lastQueuedPts && count == 1 ) observe ( newest - _lastQueuedPts );
+        for ( size_t i = 1; i < count; i++ ) observe ( queued[i] - queued[i - 1] );
+        _lastQueuedPts = newest;
+
+        int pick = static_cast<int> ( count ) - 1;
+
+        if ( _interval > 0.0 && _refresh > 0.0 )
+        {
+            const double latency = _options.GetLatencyRefreshes ( ) * _refresh;
+
+            // Where this refresh falls within the frame grid
+            double phase = std::fmod ( displayMedia - latency - newest, _interval );
+            if ( phase < 0.0 ) phase += _interval;
+
+            _phases[_phaseHead] = phase;
+            _phaseHead = ( _phaseHead + 1 ) % kPhaseSamples;
+            _phaseCount = std::min ( _phaseCount + 1, kPhaseSamples );
+
+            double position = std::fmod ( phase - _bias + _interval, _interval );
+            double guard = std::min ( _refresh, _interval ) / 8.0;
+            if ( !_locked || position < guard || position > _interval - guard ) Relock ( );
+
+            const double target = displayMedia - latency - _bias;
+
+            pick = -1;
+            for ( size_t i = 0; i < count; i++ )
+            {
+                if ( queued[i] <= target + 1e-6 ) pick = static_cast<int> ( i );
+            }
+
+            // Nothing old enough yet (i.e right after a seek), anything beats a blank frame
+            if ( pick < 0 && _currentPts < 0.0 ) pick = 0;
+        }
+
+        // Never step backwards or reshow what's already up
+        if ( pick < 0 || queued[pick] <= _currentPts )
+        {
+            _heldFor++;
+            return -1;
+        }
+
+        _stats.framesSkipped += static_cast<uint64_t> ( pick );
+        RecordShown ( queued[pick], displayMedia );
+        return pick;
+    }
+
+    void PresentationScheduler::Relock ( )
+    {
+        if ( _phaseCount == 0 ) return;
+
+        // Put the frame boundary in the middle of the widest stretch of the
+        // frame that no refresh has landed in, so clock jitter can't flip a decision
+        double sorted[kPhaseSamples];
+        std::copy ( _phases, _phases + _phaseCount, sorted );
+        std::sort ( sorted, sorted + _phaseCount );
+
+        double widest = sorted[0] + _interval - sorted[_phaseCount - 1];
+        double center = std::fmod ( sorted[_phaseCount - 1] + widest * 0.5, _interval );
+        for ( size_t i = 1; i < _phaseCount; i++ )
+        {
+            double gap = sorted[i] - sorted[i - 1];
+            if ( gap > widest )
+            {
+                widest = gap;
+                center = sorted[i - 1] + gap * 0.5;
+            }
+        }
+
+        // Rates with no short cadence (25 on 60) land everywhere, moving wouldn't buy anything
+        if ( _locked )
+        {
+            double margin = _interval;
+            for ( size_t i = 0; i < _phaseCount; i++ )
+            {
+                double distance = std::abs ( sorted[i] - _bias );
+                margin = std::min ( margin, std::min ( distance, _interval - distance ) );
+            }
+
+            if ( widest * 0.5 <= margin * 1.5 ) return;
+            _stats.relocks++;
+        }
+
+        _bias = center;
+        _locked = true;
+    }
+
+    void PresentationScheduler::RecordShown ( double pts, double displayMedia )
+    {
+        const double latency = _options.GetLatencyRefreshes ( ) * _refresh;
+        const double errorMs = ( displayMedia - ( pts + latency + _bias ) ) * 1000.0;
+        const int range = std::max ( 1, _options.GetHistogramRangeMs ( ) );
+
+        if ( _stats.errorHistogram.empty ( ) )
+        {
+            _stats.errorHistogram.assign ( range * 2 + 1, 0 );
+            _stats.histogramRangeMs = range;
+        }
+
+        int bin = std::clamp ( static_cast<int> ( std::lround ( errorMs ) ), -range, range ) + range;
+        _stats.errorHistogram[bin]++;
+
+        _stats.framesShown++;
+        _errorSum += errorMs;
+        _stats.meanErrorMs = _errorSum / _stats.framesShown;
+        _stats.maxAbsErrorMs = std::max ( _stats.maxAbsErrorMs, std::abs ( errorMs ) );
+
+        if ( _currentPts >= 0.0 )
+        {
+            _stats.recentCadence.push_back ( _heldFor );
+            if ( _stats.recentCadence.size ( ) > 12 ) _stats.recentCadence.erase ( _stats.recentCadence.begin ( ) );
+        }
+
+        _currentPts = pts;
+        _heldFor = 1;
+    }
+
+    PresentationScheduler::Stats PresentationScheduler::GetStats ( ) const
+    {
+        Stats stats = _stats;
+        stats.frameInterval = _interval;
+        stats.refreshInterval = _refresh;
+        stats.delaySeconds = _options.GetLatencyRefreshes ( ) * _refresh + _bias;
+        return stats;
+    }
+}
@@ -0,0 +1,100 @@
+//
+//  AX-MediaPlayerPresentationScheduler.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace AX::Video
+{
+    // Picks which of a few recently decoded frames belongs on screen at the
+    // next display refresh, rather than whatever happened to be newest when Update ran.
+    // Frames are shown a fixed latency behind the clock so the right one has always been
+    // decoded already, and that latency is nudged by a phase bias so frame boundaries sit
+    // as far from refresh boundaries as the content and display rates allow. That's what
+    // turns 24p on a 60hz output into a steady 3:2 instead of a jittery mix of 2s, 3s and 4s.
+    class PresentationScheduler
+    {
+    public:
+
+        struct Options
+        {
+            Options & QueueDepth ( size_t frames ) { _queueDepth = frames; return *this; }
+            Options & LatencyRefreshes ( float refreshes ) { _latencyRefreshes = refreshes; return *this; }
+            Options & RefreshRate ( float hz ) { _refreshRate = hz; return *this; }
+            Options & HistogramRangeMs ( int ms ) { _histogramRangeMs = ms; return *this; }
+
+            size_t  GetQueueDepth ( ) const { return _queueDepth; }
+            float   GetLatencyRefreshes ( ) const { return _latencyRefreshes; }
+            float   GetRefreshRate ( ) const { return _refreshRate; }
+            int     GetHistogramRangeMs ( ) const { return _histogramRangeMs; }
+
+            Options ( ) { };
+
+        protected:
+
+            size_t  _queueDepth{ 6 };           // Slots including the one on screen and the one being written
+            float   _latencyRefreshes{ 1.0f };  // How far behind the clock frames are shown
+            float   _refreshRate{ 0.0f };       // Zero asks the platform for the display's rate
+            int     _histogramRangeMs{ 50 };
+        };
+
+        struct Stats
+        {
+            // One millisecond bins from -range to +range, the ends also collect anything beyond
+            std::vector<uint32_t> errorHistogram;
+            int         histogramRangeMs{ 0 };
+            double      meanErrorMs{ 0.0 };
+            double      maxAbsErrorMs{ 0.0 };
+            uint64_t    framesShown{ 0 };
+            uint64_t    framesSkipped{ 0 };     // Decoded but never on screen
+            uint64_t    refreshes{ 0 };
+            uint64_t    relocks{ 0 };           // Times the cadence phase had to be moved
+            double      frameInterval{ 0.0 };
+            double      refreshInterval{ 0.0 };
+            double      delaySeconds{ 0.0 };    // Total media time the picture runs behind the clock
+            std::vector<int> recentCadence;     // Refreshes each of the last few frames was held for, i.e 3,2,3,2
+        };
+
+        PresentationScheduler ( const Options & options = Options ( ) );
+
+        // `displayMedia` is the media time at the refresh the selection will be shown on and
+        // `refreshInterval` the refresh period in media seconds. Returns the index into
+        // `queued` (oldest first) to show, or -1 to keep showing the current frame.
+        int         Select ( const double * queued, size_t count, double displayMedia, double refreshInterval );
+
+        void        Reset ( );
+        Stats       GetStats ( ) const;
+
+    protected:
+
+        void        Relock ( );
+        void        RecordShown ( double pts, double displayMedia );
+
+        static constexpr size_t kPhaseSamples = 48;
+
+        Options     _options;
+        Stats       _stats;
+        double      _errorSum{ 0.0 };
+
+        double      _interval{ 0.0 };
+        double      _refresh{ 0.0 };
+        double      _bias{ 0.0 };
+        bool        _locked{ false };
+
+        double      _currentPts{ -1.0 };
+        double      _lastQueuedPts{ -1.0 };
+        int         _heldFor{ 0 };
+
+        double      _phases[kPhaseSamples];
+        size_t      _phaseCount{ 0 };
+        size_t      _phaseHead{ 0 };
+    };
+}
@@ -0,0 +1,214 @@
+//
+//  AX-MediaPlayerProbe.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerProbe.h"
+#include "AX-MediaPlayerQuickTime.h"
+#include "AX-MediaPlayerRawVideoFile.h"
+#include "AX-MediaPlayerHap.h"
+
+#include <cstring>
+#include <algorithm>
+
+using namespace AX::Video;
+using namespace AX::Video::QuickTime;
+
+namespace
+{
+    static inline uint16_t ReadLE16 ( const uint8_t * p ) { return static_cast<uint16_t> ( p[0] | ( p[1] << 8 ) ); }
+    static inline uint32_t ReadLE32 ( const uint8_t * p ) { return p[0] | ( p[1] << 8 ) | ( p[2] << 16 ) | ( static_cast<uint32_t> ( p[3] ) << 24 ); }
+
+    // Version 0 headers have 32 bit times, version 1 64 bit ones
+    static bool ReadTimes ( const Atom & atom, uint32_t & timescale, uint64_t & duration )
+    {
+        const bool v1 = atom.end - atom.data >= 1 && atom.data[0] == 1;
+        if ( atom.end - atom.data < ( v1 ? 32 : 20 ) ) return false;
+
+        timescale = ReadBE32 ( atom.data + ( v1 ? 20 : 12 ) );
+        duration = v1 ? ReadBE64 ( atom.data + 24 ) : ReadBE32 ( atom.data + 16 );
+        return timescale > 0;
+    }
+
+    static void ProbeTrack ( const uint8_t * begin, const uint8_t * end, MediaInfo & info )
+    {
+        Atom mdia, mdhd, hdlr, minf, stbl, stsd;
+        if ( !FindAtom ( begin, end, FourCC ( 'm', 'd', 'i', 'a' ), mdia ) ) return;
+        if ( !FindAtom ( mdia.data, mdia.end, FourCC ( 'h', 'd', 'l', 'r' ), hdlr ) || hdlr.end - hdlr.data < 12 ) return;
+
+        const uint32_t handler = ReadBE32 ( hdlr.data + 8 );
+        const bool video = handler == FourCC ( 'v', 'i', 'd', 'e' );
+        const bool audio = handler == FourCC ( 's', 'o', 'u', 'n' );
+
+        // Only the first of each kind, the same tracks the engines pick by default
+        if ( ( !video && !audio ) || ( video && info.hasVideo ) || ( audio && info.hasAudio ) ) return;
+
+        uint32_t timescale = 0;
+        uint64_t duration = 0;
+        if ( !FindAtom ( mdia.data, mdia.end, FourCC ( 'm', 'd', 'h', 'd' ), mdhd ) || !ReadTimes ( mdhd, timescale, duration ) ) return;
+        if ( !FindAtom ( mdia.data, mdia.end, FourCC ( 'm', 'i', 'n', 'f' ), minf ) ) return;
+        if ( !FindAtom ( minf.data, minf.end, FourCC ( 's', 't', 'b', 'l' ), stbl ) ) return;
+        if ( !FindAtom ( stbl.data, stbl.end, FourCC ( 's', 't', 's', 'd' ), stsd ) || stsd.end - stsd.data < 8 + 36 ) return;
+
+        // Version / flags, entry count, then the first sample description
+        const uint8_t * description = stsd.data + 8;
+        const double seconds = duration / static_cast<double> ( timescale );
+        info.duration = std::max ( info.duration, seconds );
+
+        if ( video )
+        {
+            info.hasVideo = 1;
+            info.videoCodec = ReadBE32 ( description + 4 );
+            info.width = ReadBE16 ( description + 32 );
+            info.height = ReadBE16 ( description + 34 );
+
+            Atom stsz;
+            if ( FindAtom ( stbl.data, stbl.end, FourCC ( 's', 't', 's', 'z' ), stsz ) && stsz.end - stsz.data >= 12 )
+            {
+                info.frameCount = ReadBE32 ( stsz.data + 8 );
+                if ( seconds > 0.0 ) info.frameRate = info.frameCount / seconds;
+            }
+        }
+        else
+        {
+            // Sound descriptions put the channel count and a 16.16 rate at the same place in
+            // every version, v2 moves the real rate elsewhere but the track timescale matches it
+            info.hasAudio = 1;
+            info.audioCodec = ReadBE32 ( description + 4 );
+            info.audioChannels = ReadBE16 ( description + 24 );
+
+            const uint16_t version = ReadBE16 ( description + 16 );
+            const uint32_t rate = ReadBE32 ( description + 32 ) >> 16;
+            info.audioSampleRate = version < 2 && rate > 0 ? rate : timescale;
+        }
+    }
+
+    static bool ProbeQuickTime ( const uint8_t * begin, const uint8_t * end, MediaInfo & info )
+    {
+        // Top level atoms are skipped over, not read, so a moov after the media data costs the same
+        Atom moov;
+        if ( !FindAtom ( begin, end, FourCC ( 'm', 'o', 'o', 'v' ), moov ) ) return false;
+
+        Atom mvhd;
+        uint32_t timescale = 0;
+        uint64_t duration = 0;
+        if ( FindAtom ( moov.data, moov.end, FourCC ( 'm', 'v', 'h', 'd' ), mvhd ) && ReadTimes ( mvhd, timescale, duration ) )
+        {
+            info.duration = duration / static_cast<double> ( timescale );
+        }
+
+        const uint8_t * p = moov.data;
+        Atom trak;
+        while ( NextAtom ( p, moov.end, trak ) )
+        {
+            if ( trak.type == FourCC ( 't', 'r', 'a', 'k' ) ) ProbeTrack ( trak.data, trak.end, info );
+        }
+
+        info.container = MediaInfo::Container::QuickTime;
+        return info.hasVideo || info.hasAudio;
+    }
+
+    static bool ProbeWave ( const uint8_t * begin, const uint8_t * end, MediaInfo & info )
+    {
+        uint32_t byteRate = 0;
+        uint64_t dataBytes = 0;
+
+        const uint8_t * p = begin + 12;
+        while ( end - p >= 8 )
+        {
+            const uint32_t id = ReadBE32 ( p );
+            const uint64_t size = ReadLE32 ( p + 4 );
+            const uint8_t * data = p + 8;
+
+            if ( id == FourCC ( 'f', 'm', 't', ' ' ) && size >= 16 && end - data >= 16 )
+            {
+                info.audioCodec = ReadLE16 ( data );
+                info.audioChannels = ReadLE16 ( data + 2 );
+                info.audioSampleRate = ReadLE32 ( data + 4 );
+                byteRate = ReadLE32 ( data + 8 );
+            }
+            else if ( id == FourCC ( 'd', 'a', 't', 'a' ) )
+            {
+                // Streamed wavs can leave the size unset, the data runs to the end then
+                dataBytes = std::min<uint64_t> ( size == 0 || size == 0xFFFFFFFF ? UINT64_MAX : size, static_cast<uint64_t> ( end - data ) );
+                break;
+            }
+
+            // Chunks are padded to an even size
+            const uint64_t advance = 8 + size + ( size & 1 );
+            if ( advance > static_cast<uint64_t> ( end - p ) ) break;
+            p += advance;
+        }
+
+        if ( info.audioChannels == 0 || byteRate == 0 ) return false;
+
+        info.container = MediaInfo::Container::Wave;
+        info.hasAudio = 1;
+        info.duration = dataBytes / static_cast<double> ( byteRate );
+        return true;
+    }
+
+    static bool ProbeY4M ( const std::filesystem::path & path, MediaInfo & info )
+    {
+        // Frame offsets are computed from the stream header when the frames are all alike,
+        // so this still only reads the header in the usual case
+        auto video = RawVideoFile::Open ( path );
+        if ( !video ) return false;
+
+        switch ( video->GetPixelFormat ( ) )
+        {
+            case RawVideoFile::PixelFormat::BGRA: info.videoCodec = FourCC ( 'B', 'G', 'R', 'A' ); break;
+            case RawVideoFile::PixelFormat::NV12: info.videoCodec = FourCC ( 'N', 'V', '1', '2' ); break;
+            case RawVideoFile::PixelFormat::I420: info.videoCodec = FourCC ( 'I', '4', '2', '0' ); break;
+        }
+
+        info.container = MediaInfo::Container::Y4M;
+        info.hasVideo = 1;
+        info.width = video->GetWidth ( );
+        info.height = video->GetHeight ( );
+        info.frameRate = video->GetFrameRate ( );
+        info.frameCount = video->GetFrameCount ( );
+        info.duration = video->GetDurationInSeconds ( );
+        return true;
+    }
+}
+
+namespace AX::Video
+{
+    MediaInfo ProbeMedia ( const std::filesystem::path & path )
+    {
+        auto file = MappedFile::Open ( path );
+        if ( !file || file->Size ( ) < 12 ) return { };
+
+        const uint8_t * begin = file->Data ( );
+        const uint8_t * end = begin + file->Size ( );
+
+        MediaInfo info;
+        bool valid = false;
+
+        if ( std::memcmp ( begin, "YUV4MPEG2", 9 ) == 0 )
+        {
+            file = nullptr;
+            valid = ProbeY4M ( path, info );
+        }
+        else if ( std::memcmp ( begin, "RIFF", 4 ) == 0 && std::memcmp ( begin + 8, "WAVE", 4 ) == 0 )
+        {
+            valid = ProbeWave ( begin, end, info );
+        }
+        else
+        {
+            // QuickTime has no magic, but every file starts with an atom of a handful of types
+            const uint32_t type = ReadBE32 ( begin + 4 );
+            if ( type == FourCC ( 'f', 't', 'y', 'p' ) || type == FourCC ( 'm', 'o', 'o', 'v' ) || type == FourCC ( 'm', 'd', 'a', 't' )
+              || type == FourCC ( 'w', 'i', 'd', 'e' ) || type == FourCC ( 'f', 'r', 'e', 'e' ) || type == FourCC ( 's', 'k', 'i', 'p' ) )
+            {
+                valid = ProbeQuickTime ( begin, end, info );
+            }
+        }
+
+        return valid ? info : MediaInfo ( );
+    }
+}
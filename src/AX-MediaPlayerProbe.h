@@ -0,0 +1,50 @@
+//
+//  AX-MediaPlayerProbe.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+namespace AX::Video
+{
+    // What a file is, read straight out of its container header. Plain data
+    // with fixed size fields so it can be written to and mapped back from a MediaLibrary cache.
+    struct MediaInfo
+    {
+        enum class Container : uint32_t
+        {
+            Unknown,
+            QuickTime,  // .mov, .mp4, .m4v, .m4a (anything ISO BMFF)
+            Y4M,
+            Wave,
+        };
+
+        Container   container{ Container::Unknown };
+        uint32_t    videoCodec{ 0 };        // FourCC of the video sample description, i.e 'avc1', 'hvc1', 'Hap1', 'I420' for Y4M
+        uint32_t    audioCodec{ 0 };        // FourCC of the audio sample description, or the format tag of a wav
+        int32_t     width{ 0 };
+        int32_t     height{ 0 };
+        uint32_t    audioChannels{ 0 };
+        double      audioSampleRate{ 0.0 };
+        double      frameRate{ 0.0 };       // Average over the track
+        double      duration{ 0.0 };
+        int64_t     frameCount{ 0 };
+        uint8_t     hasVideo{ 0 };
+        uint8_t     hasAudio{ 0 };
+        uint8_t     reserved[6]{ };
+
+        explicit operator bool ( ) const { return container != Container::Unknown; }
+    };
+
+    // Reads only the container header (the moov atom, the Y4M stream header or
+    // the wav chunks) in place over a MappedFile, so it touches a few pages no matter how big
+    // the file is and never spins up a decoder. An invalid MediaInfo when the container isn't
+    // one of the above or the header is damaged. No dependency on cinder, like MappedFile.
+    MediaInfo ProbeMedia ( const std::filesystem::path & path );
+}
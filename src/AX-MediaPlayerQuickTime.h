@@ -0,0 +1,67 @@
+//
+//  AX-MediaPlayerQuickTime.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace AX::Video::QuickTime
+{
+    // Just enough of the QuickTime / ISO BMFF atom structure to walk a movie's
+    // header in place (over a MappedFile), shared by HapFile and the metadata probe.
+
+    inline uint16_t ReadBE16 ( const uint8_t * p ) { return static_cast<uint16_t> ( ( p[0] << 8 ) | p[1] ); }
+    inline uint32_t ReadBE32 ( const uint8_t * p ) { return ( static_cast<uint32_t> ( p[0] ) << 24 ) | ( p[1] << 16 ) | ( p[2] << 8 ) | p[3]; }
+    inline uint64_t ReadBE64 ( const uint8_t * p ) { return ( static_cast<uint64_t> ( ReadBE32 ( p ) ) << 32 ) | ReadBE32 ( p + 4 ); }
+
+    // Atoms, with the 64 bit and "to the end" sizes
+    struct Atom
+    {
+        const uint8_t * data;
+        const uint8_t * end;
+        uint32_t        type;
+    };
+
+    inline bool NextAtom ( const uint8_t *& p, const uint8_t * end, Atom & atom )
+    {
+        if ( end - p < 8 ) return false;
+
+        uint64_t size = ReadBE32 ( p );
+        atom.type = ReadBE32 ( p + 4 );
+        size_t header = 8;
+
+        if ( size == 1 )
+        {
+            if ( end - p < 16 ) return false;
+            size = ReadBE64 ( p + 8 );
+            header = 16;
+        }
+        else if ( size == 0 )
+        {
+            size = static_cast<uint64_t> ( end - p );
+        }
+
+        if ( size < header || size > static_cast<uint64_t> ( end - p ) ) return false;
+
+        atom.data = p + header;
+        atom.end = p + size;
+        p = atom.end;
+        return true;
+    }
+
+    inline bool FindAtom ( const uint8_t * begin, const uint8_t * end, uint32_t type, Atom & atom )
+    {
+        while ( NextAtom ( begin, end, atom ) )
+        {
+            if ( atom.type == type ) return true;
+        }
+
+        return false;
+    }
+}
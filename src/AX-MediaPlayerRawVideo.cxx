@@ -0,0 +1,370 @@
+//
+//  AX-MediaPlayerRawVideo.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerRawVideo.h"
+#include "cinder/app/App.h"
+#include "cinder/gl/gl.h"
+#include "cinder/Log.h"
+
+#include <cmath>
+#include <algorithm>
+
+using namespace ci;
+
+namespace
+{
+    using PixelFormat = AX::Video::RawVideoFile::PixelFormat;
+
+    static const char * kVertexShader = R"(
+        #version 150
+        uniform mat4 ciModelViewProjection;
+        in vec4 ciPosition;
+        in vec2 ciTexCoord0;
+        out vec2 vTexCoord;
+
+        void main ( )
+        {
+            vTexCoord = ciTexCoord0;
+            gl_Position = ciModelViewProjection * ciPosition;
+        }
+    )";
+
+    // BT.709, which is what anything HD and up has been converted with
+    static const char * kFragmentShader = R"(
+        #version 150
+        uniform sampler2D uY;
+        uniform sampler2D uU;
+        uniform sampler2D uV;
+        uniform bool uInterleaved;
+        uniform bool uFullRange;
+        in vec2 vTexCoord;
+        out vec4 oColor;
+
+        void main ( )
+        {
+            float y = texture ( uY, vTexCoord ).r;
+            vec2 uv = uInterleaved ? texture ( uU, vTexCoord ).rg : vec2 ( texture ( uU, vTexCoord ).r, texture ( uV, vTexCoord ).r );
+
+            if ( !uFullRange )
+            {
+                y = ( y - 16.0 / 255.0 ) * ( 255.0 / 219.0 );
+                uv = ( uv - 128.0 / 255.0 ) * ( 255.0 / 224.0 );
+            }
+            else
+            {
+                uv = uv - 128.0 / 255.0;
+            }
+
+            vec3 rgb = vec3 ( y + 1.5748 * uv.y, y - 0.1873 * uv.x - 0.4681 * uv.y, y + 1.8556 * uv.x );
+            oColor = vec4 ( clamp ( rgb, 0.0, 1.0 ), 1.0 );
+        }
+    )";
+
+    class RawFrameLease : public AX::Video::MediaPlayer::FrameLease
+    {
+    public:
+
+        RawFrameLease ( const gl::TextureRef & texture )
+            : _texture ( texture )
+        { }
+
+        gl::TextureRef ToTexture ( ) const override { return _texture; }
+
+    protected:
+
+        bool IsValid ( ) const override { return _texture != nullptr; }
+
+        gl::TextureRef _texture;
+    };
+
+    static inline uint8_t Saturate ( float value )
+    {
+        return static_cast<uint8_t> ( std::clamp ( value, 0.0f, 255.0f ) + 0.5f );
+    }
+}
+
+namespace AX::Video
+{
+    RawVideoPlayerRef RawVideoPlayer::Create ( const ci::fs::path & path, const Options & options )
+    {
+        auto file = RawVideoFile::Open ( path, options.GetFile ( ) );
+        if ( !file )
+        {
+            CI_LOG_E ( "Couldn't open " << path << " as Y4M (4:2:0, 8 bit) or as raw frames with the given options" );
+            return nullptr;
+        }
+
+        return RawVideoPlayerRef ( new RawVideoPlayer ( file, options ) );
+    }
+
+    RawVideoPlayer::RawVideoPlayer ( const RawVideoFileRef & file, const Options & options )
+        : _options ( options )
+        , _file ( file )
+    {
+        SetFrame ( 0 );
+        Anchor ( );
+
+        if ( auto app = app::App::get ( ) )
+        {
+            _updateConnection = app->getSignalUpdate ( ).connect ( [this] { Update ( ); } );
+        }
+    }
+
+    void RawVideoPlayer::Play ( )
+    {
+        if ( _complete && !_loop ) SetFrame ( 0 );
+
+        _complete = false;
+        _playing = true;
+        Anchor ( );
+    }
+
+    void RawVideoPlayer::Pause ( )
+    {
+        _playing = false;
+    }
+
+    void RawVideoPlayer::TogglePlayback ( )
+    {
+        if ( _playing ) Pause ( ); else Play ( );
+    }
+
+    void RawVideoPlayer::SeekToFrame ( int64_t index )
+    {
+        _complete = false;
+        SetFrame ( std::clamp<int64_t> ( index, 0, GetFrameCount ( ) - 1 ) );
+        Anchor ( );
+    }
+
+    void RawVideoPlayer::SeekToSeconds ( double seconds )
+    {
+        SeekToFrame ( _file->FrameIndexAt ( seconds ) );
+    }
+
+    void RawVideoPlayer::FrameStep ( int delta )
+    {
+        _playing = false;
+        SeekToFrame ( _index + delta );
+    }
+
+    void RawVideoPlayer::Anchor ( )
+    {
+        _anchorTime = Clock::now ( );
+        _anchorIndex = _index;
+    }
+
+    bool RawVideoPlayer::Update ( )
+    {
+        if ( !_playing ) return false;
+
+        // Counted from the last seek / play in whole frames, so there's no drift
+        // to accumulate and a late update skips straight to the frame that should be showing.
+        const double elapsed = std::chrono::duration<double> ( Clock::now ( ) - _anchorTime ).count ( );
+        int64_t target = _anchorIndex + static_cast<int64_t> ( std::floor ( elapsed * GetFrameRate ( ) + 1e-6 ) );
+
+        const int64_t count = GetFrameCount ( );
+        if ( target >= count )
+        {
+            if ( _loop )
+            {
+                target %= count;
+            }
+            else
+            {
+                SetFrame ( count - 1 );
+                _playing = false;
+                _complete = true;
+                OnComplete.emit ( );
+                return true;
+            }
+        }
+
+        if ( target == _index ) return false;
+
+        // Playing never goes backwards by itself, so that's the wrap
+        const bool looped = _loop && target < _index;
+        SetFrame ( target );
+        if ( looped ) OnLoop.emit ( );
+        return true;
+    }
+
+    void RawVideoPlayer::SetFrame ( int64_t index )
+    {
+        const int64_t count = GetFrameCount ( );
+        const int64_t ahead = std::max<int64_t> ( 0, _options.GetReadAheadFrames ( ) );
+
+        // The resident window is this frame and the `ahead` after it. Only the
+        // difference between the old and new windows is advised, so normal playback costs one
+        // frame paged in and one dropped per frame.
+        const int64_t oldFirst = _index, oldLast = _prefetchedUntil;
+        const int64_t newFirst = index, newLast = std::min ( index + ahead, count - 1 );
+        const bool overlap = oldLast >= oldFirst && newFirst <= oldLast && newLast >= oldFirst;
+
+        if ( !overlap )
+        {
+            if ( oldLast >= oldFirst ) _file->Evict ( oldFirst, oldLast - oldFirst + 1 );
+            _file->Prefetch ( newFirst, newLast - newFirst + 1 );
+        }
+        else
+        {
+            if ( oldFirst < newFirst ) _file->Evict ( oldFirst, newFirst - oldFirst );
+            if ( oldLast > newLast ) _file->Evict ( newLast + 1, oldLast - newLast );
+            if ( newFirst < oldFirst ) _file->Prefetch ( newFirst, oldFirst - newFirst );
+            if ( newLast > oldLast ) _file->Prefetch ( oldLast + 1, newLast - oldLast );
+        }
+
+        // The start of the file is needed again straight after the end
+        if ( _loop && index + ahead >= count ) _file->Prefetch ( 0, index + ahead - count + 1 );
+
+        _prefetchedUntil = newLast;
+        _hasNewFrame = _hasNewFrame || index != _index;
+        _index = index;
+    }
+
+    const Surface8uRef & RawVideoPlayer::GetSurface ( ) const
+    {
+        _hasNewFrame = false;
+        if ( _surfaceIndex == _index && _surface ) return _surface;
+
+        auto frame = GetFrame ( );
+        const int32_t width = _file->GetWidth ( );
+        const int32_t height = _file->GetHeight ( );
+
+        if ( _file->GetPixelFormat ( ) == PixelFormat::BGRA )
+        {
+            // Borrows the mapping, the file outlives the surface as long as this player does
+            auto & plane = frame.planes[0];
+            _surface = std::make_shared<Surface8u> ( const_cast<uint8_t *> ( plane.data ), width, height, plane.rowBytes, SurfaceChannelOrder::BGRA );
+        }
+        else
+        {
+            if ( !_surface || _surface->getSize ( ) != ivec2 ( width, height ) )
+            {
+                _surface = Surface8u::create ( width, height, false, SurfaceChannelOrder::BGRX );
+            }
+
+            const bool interleaved = _file->GetPixelFormat ( ) == PixelFormat::NV12;
+            const bool fullRange = _file->IsFullRange ( );
+            const float lumaScale = fullRange ? 1.0f : 255.0f / 219.0f;
+            const float lumaOffset = fullRange ? 0.0f : 16.0f;
+            const float chromaScale = fullRange ? 1.0f : 255.0f / 224.0f;
+
+            auto & luma = frame.planes[0];
+            auto & first = frame.planes[1];
+            auto & second = frame.planes[interleaved ? 1 : 2];
+
+            for ( int32_t y = 0; y < height; y++ )
+            {
+                const uint8_t * yRow = luma.data + static_cast<size_t> ( y ) * luma.rowBytes;
+                const uint8_t * uRow = first.data + static_cast<size_t> ( y / 2 ) * first.rowBytes;
+                const uint8_t * vRow = second.data + static_cast<size_t> ( y / 2 ) * second.rowBytes;
+                uint8_t * dst = _surface->getData ( ivec2 ( 0, y ) );
+
+                for ( int32_t x = 0; x < width; x++ )
+                {
+                    const int32_t cx = x / 2;
+                    const float Y = ( yRow[x] - lumaOffset ) * lumaScale;
+                    const float U = ( ( interleaved ? uRow[cx * 2 + 0] : uRow[cx] ) - 128.0f ) * chromaScale;
+                    const float V = ( ( interleaved ? vRow[cx * 2 + 1] : vRow[cx] ) - 128.0f ) * chromaScale;
+
+                    dst[x * 4 + 0] = Saturate ( Y + 1.8556f * U );
+                    dst[x * 4 + 1] = Saturate ( Y - 0.1873f * U - 0.4681f * V );
+                    dst[x * 4 + 2] = Saturate ( Y + 1.5748f * V );
+                    dst[x * 4 + 3] = 255;
+                }
+            }
+        }
+
+        _surfaceIndex = _index;
+        return _surface;
+    }
+
+    void RawVideoPlayer::UploadPlanes ( const RawVideoFile::Frame & frame ) const
+    {
+        const bool interleaved = _file->GetPixelFormat ( ) == PixelFormat::NV12;
+
+        if ( !_convert )
+        {
+            _convert = gl::GlslProg::create ( gl::GlslProg::Format ( ).vertex ( kVertexShader ).fragment ( kFragmentShader ) );
+            _convert->uniform ( "uY", 0 );
+            _convert->uniform ( "uU", 1 );
+            _convert->uniform ( "uV", 2 );
+            _convert->uniform ( "uInterleaved", interleaved );
+            _convert->uniform ( "uFullRange", _file->IsFullRange ( ) );
+        }
+
+        // Straight from the mapping, no staging copy
+        glPixelStorei ( GL_UNPACK_ALIGNMENT, 1 );
+        for ( int32_t i = 0; i < frame.planeCount; i++ )
+        {
+            auto & plane = frame.planes[i];
+            const bool rg = interleaved && i == 1;
+
+            if ( !_planes[i] )
+            {
+                auto fmt = gl::Texture::Format ( ).internalFormat ( rg ? GL_RG8 : GL_R8 ).minFilter ( GL_LINEAR ).magFilter ( GL_LINEAR ).wrap ( GL_CLAMP_TO_EDGE );
+                _planes[i] = gl::Texture::create ( plane.width, plane.height, fmt );
+            }
+
+            gl::ScopedTextureBind scopedTexture ( _planes[i] );
+            glTexSubImage2D ( GL_TEXTURE_2D, 0, 0, 0, plane.width, plane.height, rg ? GL_RG : GL_RED, GL_UNSIGNED_BYTE, plane.data );
+        }
+        glPixelStorei ( GL_UNPACK_ALIGNMENT, 4 );
+
+        const ivec2 size = GetSize ( );
+        if ( !_fbo )
+        {
+            _fbo = gl::Fbo::create ( size.x, size.y, gl::Fbo::Format ( ).colorTexture ( gl::Texture::Format ( ).internalFormat ( GL_RGBA8 ) ).disableDepth ( ) );
+        }
+
+        gl::ScopedFramebuffer scopedFbo ( _fbo );
+        gl::ScopedViewport scopedViewport ( ivec2 ( 0 ), size );
+        gl::ScopedMatrices scopedMatrices;
+        gl::ScopedBlend scopedBlend ( false );
+        gl::ScopedGlslProg scopedProg ( _convert );
+        gl::ScopedTextureBind y ( _planes[0], 0 );
+        gl::ScopedTextureBind u ( _planes[1], 1 );
+        gl::ScopedTextureBind v ( _planes[interleaved ? 1 : 2], 2 );
+
+        gl::setMatricesWindow ( size );
+        gl::drawSolidRect ( Rectf ( vec2 ( 0 ), size ), vec2 ( 0, 0 ), vec2 ( 1, 1 ) );
+    }
+
+    MediaPlayer::FrameLeaseRef RawVideoPlayer::GetTexture ( ) const
+    {
+        _hasNewFrame = false;
+
+        auto frame = GetFrame ( );
+        if ( !frame ) return nullptr;
+
+        const bool bgra = _file->GetPixelFormat ( ) == PixelFormat::BGRA;
+        if ( _textureIndex != _index )
+        {
+            if ( bgra )
+            {
+                if ( !_streaming ) _streaming = StreamingTexture::Create ( _options.GetUpload ( ) );
+
+                auto & plane = frame.planes[0];
+                _streaming->Upload ( Surface8u ( const_cast<uint8_t *> ( plane.data ), plane.width, plane.height, plane.rowBytes, SurfaceChannelOrder::BGRA ) );
+            }
+            else
+            {
+                UploadPlanes ( frame );
+            }
+
+            _textureIndex = _index;
+        }
+
+        return std::make_unique<RawFrameLease> ( bgra ? _streaming->GetTexture ( ) : _fbo->getColorTexture ( ) );
+    }
+
+    RawVideoPlayer::~RawVideoPlayer ( )
+    {
+        _updateConnection.disconnect ( );
+    }
+}
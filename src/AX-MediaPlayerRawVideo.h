@@ -0,0 +1,127 @@
+//
+//  AX-MediaPlayerRawVideo.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include "AX-MediaPlayer.h"
+#include "AX-MediaPlayerRawVideoFile.h"
+#include "cinder/gl/GlslProg.h"
+#include "cinder/gl/Fbo.h"
+
+#include <chrono>
+
+namespace AX::Video
+{
+    using RawVideoPlayerRef = std::shared_ptr<class RawVideoPlayer>;
+
+    // Plays pre-converted uncompressed content (see RawVideoFile) without going
+    // anywhere near the platform codecs, for installations where decoding can't be allowed
+    // to be the bottleneck. Portable, it only needs cinder and a GL context for textures.
+    //
+    // The clock is a frame counter rather than a position, so the frame shown for a given
+    // time, FrameStep ( ) and every seek are exact. The next ReadAheadFrames frames are kept
+    // paged in ahead of the playhead and the ones behind it dropped, so the cost of a frame
+    // is one upload from memory that's already resident. BGRA frames are uploaded straight
+    // from the mapping, YUV planes are uploaded as they are and converted on the GPU.
+    class RawVideoPlayer
+    {
+    public:
+
+        struct Options
+        {
+            Options & File ( const RawVideoFile::Options & options ) { _file = options; return *this; }
+            Options & ReadAheadFrames ( int64_t frames ) { _readAheadFrames = frames; return *this; }
+            Options & Upload ( const StreamingTexture::Options & options ) { _upload = options; return *this; }
+
+            const RawVideoFile::Options & GetFile ( ) const { return _file; }
+            int64_t GetReadAheadFrames ( ) const { return _readAheadFrames; }
+            const StreamingTexture::Options & GetUpload ( ) const { return _upload; }
+
+            Options ( ) { };
+
+        protected:
+
+            RawVideoFile::Options       _file;
+            int64_t                     _readAheadFrames{ 4 };
+            StreamingTexture::Options   _upload;
+        };
+
+        using EventSignal = MediaPlayer::EventSignal;
+
+        static RawVideoPlayerRef Create ( const ci::fs::path & path, const Options & options = Options ( ) );
+
+        ~RawVideoPlayer ( );
+
+        void    Play ( );
+        void    Pause ( );
+        void    TogglePlayback ( );
+        bool    IsPlaying ( ) const { return _playing; }
+        bool    IsComplete ( ) const { return _complete; }
+
+        void    SetLoop ( bool loop ) { _loop = loop; }
+        bool    IsLooping ( ) const { return _loop; }
+
+        void    SeekToFrame ( int64_t index );
+        void    SeekToSeconds ( double seconds );
+        void    FrameStep ( int delta );
+
+        inline  int64_t GetFrameIndex ( ) const { return _index; }
+        inline  int64_t GetFrameCount ( ) const { return _file->GetFrameCount ( ); }
+        inline  double  GetFrameRate ( ) const { return _file->GetFrameRate ( ); }
+        inline  double  GetPositionInSeconds ( ) const { return _index / _file->GetFrameRate ( ); }
+        inline  double  GetDurationInSeconds ( ) const { return _file->GetDurationInSeconds ( ); }
+        inline  ci::ivec2 GetSize ( ) const { return { _file->GetWidth ( ), _file->GetHeight ( ) }; }
+        inline  const RawVideoFileRef & GetFile ( ) const { return _file; }
+
+        // Advances the clock, called automatically from the app's update signal
+        bool    Update ( );
+
+        bool    CheckNewFrame ( ) const { return _hasNewFrame; }
+
+        // The frame as it sits in the mapping
+        RawVideoFile::Frame GetFrame ( ) const { return _file->GetFrame ( _index ); }
+
+        // BGRA files borrow the mapping, YUV is converted on the CPU (slow, prefer GetTexture ( ))
+        const ci::Surface8uRef & GetSurface ( ) const;
+        MediaPlayer::FrameLeaseRef GetTexture ( ) const;
+
+        EventSignal OnComplete;
+        EventSignal OnLoop;         // Each time playback wraps back to the start
+
+    protected:
+
+        using Clock = std::chrono::steady_clock;
+
+        RawVideoPlayer ( const RawVideoFileRef & file, const Options & options );
+
+        void    SetFrame ( int64_t index );
+        void    Anchor ( );
+        void    UploadPlanes ( const RawVideoFile::Frame & frame ) const;
+
+        Options                 _options;
+        RawVideoFileRef         _file;
+        ci::signals::Connection _updateConnection;
+
+        int64_t                 _index{ 0 };
+        int64_t                 _prefetchedUntil{ -1 };
+        bool                    _playing{ false };
+        bool                    _complete{ false };
+        bool                    _loop{ false };
+        Clock::time_point       _anchorTime;
+        int64_t                 _anchorIndex{ 0 };
+        mutable bool            _hasNewFrame{ true };
+
+        mutable ci::Surface8uRef    _surface;
+        mutable int64_t             _surfaceIndex{ -1 };
+        mutable StreamingTextureRef _streaming;
+        mutable ci::gl::TextureRef  _planes[3];
+        mutable ci::gl::FboRef      _fbo;
+        mutable ci::gl::GlslProgRef _convert;
+        mutable int64_t             _textureIndex{ -1 };
+    };
+}
@@ -0,0 +1,255 @@
+//
+//  AX-MediaPlayerRawVideoFile.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerRawVideoFile.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <algorithm>
+
+namespace
+{
+    static constexpr char     kY4MMagic[] = "YUV4MPEG2";
+    static constexpr char     kY4MFrame[] = "FRAME";
+    static constexpr uint64_t kMaxHeaderLine = 4096;
+
+    // Length of the line starting at `offset` including the '\n', 0 if there isn't one in reach
+    static uint64_t LineLength ( const uint8_t * data, uint64_t size, uint64_t offset )
+    {
+        if ( offset >= size ) return 0;
+
+        const uint64_t reach = std::min ( kMaxHeaderLine, size - offset );
+        auto end = static_cast<const uint8_t *> ( std::memchr ( data + offset, '\n', static_cast<size_t> ( reach ) ) );
+        return end ? static_cast<uint64_t> ( end - ( data + offset ) ) + 1 : 0;
+    }
+
+    static bool StartsWith ( const uint8_t * data, uint64_t size, uint64_t offset, const char * token )
+    {
+        const size_t length = std::strlen ( token );
+        return offset + length <= size && std::memcmp ( data + offset, token, length ) == 0;
+    }
+}
+
+namespace AX::Video
+{
+    RawVideoFileRef RawVideoFile::Open ( const std::filesystem::path & path, const Options & options )
+    {
+        auto file = MappedFile::Open ( path );
+        if ( !file ) return nullptr;
+
+        RawVideoFileRef video{ new RawVideoFile ( ) };
+        video->_file = file;
+
+        bool isY4M = StartsWith ( file->Data ( ), file->Size ( ), 0, kY4MMagic );
+        if ( !( isY4M ? video->ParseY4M ( ) : video->ParseRaw ( options ) ) ) return nullptr;
+        if ( video->GetFrameCount ( ) == 0 ) return nullptr;
+
+        // Frames are tens of megabytes, the kernel's fault-around readahead is
+        // both too small to help and wasted after a seek. Prefetch ( ) does it deliberately.
+        file->Advise ( 0, file->Size ( ), MappedFile::Advice::Random );
+        return video;
+    }
+
+    uint64_t RawVideoFile::ComputeFrameBytes ( ) const
+    {
+        const uint64_t luma = static_cast<uint64_t> ( _width ) * _height;
+        const uint64_t chroma = static_cast<uint64_t> ( ( _width + 1 ) / 2 ) * ( ( _height + 1 ) / 2 );
+
+        switch ( _format )
+        {
+            case PixelFormat::BGRA: return luma * 4;
+            case PixelFormat::NV12:
+            case PixelFormat::I420: return luma + chroma * 2;
+        }
+
+        return 0;
+    }
+
+    bool RawVideoFile::ParseRaw ( const Options & options )
+    {
+        _format     = options.GetFormat ( );
+        _width      = options.GetWidth ( );
+        _height     = options.GetHeight ( );
+        _frameRate  = options.GetFrameRate ( );
+        _fullRange  = options.IsFullRange ( );
+
+        if ( _width <= 0 || _height <= 0 || _frameRate <= 0.0 ) return false;
+
+        _frameBytes = ComputeFrameBytes ( );
+        _firstOffset = options.GetHeaderBytes ( );
+        _stride = _frameBytes;
+
+        // A partial frame at the end is ignored
+        const uint64_t size = _file->Size ( );
+        _frameCount = size > _firstOffset ? ( size - _firstOffset ) / _stride : 0;
+        return true;
+    }
+
+    bool RawVideoFile::ParseY4M ( )
+    {
+        const uint8_t * data = _file->Data ( );
+        const uint64_t size = _file->Size ( );
+
+        const uint64_t headerLength = LineLength ( data, size, 0 );
+        if ( headerLength == 0 ) return false;
+
+        std::string colorSpace = "420jpeg";
+        std::istringstream tokens ( std::string ( reinterpret_cast<const char *> ( data ), static_cast<size_t> ( headerLength - 1 ) ) );
+        std::string token;
+        tokens >> token; // YUV4MPEG2
+
+        while ( tokens >> token )
+        {
+            const std::string value = token.substr ( 1 );
+            switch ( token[0] )
+            {
+                case 'W': _width = std::atoi ( value.c_str ( ) ); break;
+                case 'H': _height = std::atoi ( value.c_str ( ) ); break;
+                case 'C': colorSpace = value; break;
+                case 'X': if ( value == "COLORRANGE=FULL" ) _fullRange = true; break;
+                case 'F':
+                {
+                    int numerator = 0, denominator = 0;
+                    if ( std::sscanf ( value.c_str ( ), "%d:%d", &numerator, &denominator ) == 2 && numerator > 0 && denominator > 0 )
+                    {
+                        _frameRate = numerator / static_cast<double> ( denominator );
+                    }
+                    break;
+                }
+                default: break; // Interlacing, aspect ratio and comments don't change the layout
+            }
+        }
+
+        // 444, 422, mono and high bit depth would need their own planes and shaders
+        if ( colorSpace != "420jpeg" && colorSpace != "420paldv" && colorSpace != "420mpeg2" && colorSpace != "420" ) return false;
+        if ( _width <= 0 || _height <= 0 ) return false;
+
+        _format = PixelFormat::I420;
+        _frameBytes = ComputeFrameBytes ( );
+
+        // Every frame has its own "FRAME[ params]\n" header. Nearly every writer
+        // leaves the params empty so the stride is constant, which is checked at the last frame
+        // rather than walking the whole file. Anything else gets a full index.
+        const uint64_t first = headerLength;
+        const uint64_t frameHeader = LineLength ( data, size, first );
+        if ( frameHeader == 0 || !StartsWith ( data, size, first, kY4MFrame ) ) return false;
+
+        _stride = frameHeader + _frameBytes;
+        _firstOffset = first + frameHeader;
+        _frameCount = ( size - first ) / _stride;
+
+        if ( _frameCount > 0 && ( size - first ) % _stride == 0 )
+        {
+            const uint64_t last = first + ( _frameCount - 1 ) * _stride;
+            bool constant = StartsWith ( data, size, last, kY4MFrame ) && LineLength ( data, size, last ) == frameHeader;
+            if ( constant ) return true;
+        }
+
+        return IndexY4MFrames ( first );
+    }
+
+    bool RawVideoFile::IndexY4MFrames ( uint64_t offset )
+    {
+        const uint8_t * data = _file->Data ( );
+        const uint64_t size = _file->Size ( );
+
+        _offsets.clear ( );
+        while ( StartsWith ( data, size, offset, kY4MFrame ) )
+        {
+            const uint64_t header = LineLength ( data, size, offset );
+            if ( header == 0 || offset + header + _frameBytes > size ) break;
+
+            _offsets.push_back ( offset + header );
+            offset += header + _frameBytes;
+        }
+
+        return !_offsets.empty ( );
+    }
+
+    uint64_t RawVideoFile::FrameOffset ( int64_t index ) const
+    {
+        if ( !_offsets.empty ( ) ) return _offsets[static_cast<size_t> ( index )];
+        return _firstOffset + static_cast<uint64_t> ( index ) * _stride;
+    }
+
+    int64_t RawVideoFile::FrameIndexAt ( double seconds ) const
+    {
+        // A millionth of a frame of slack so N / fps lands on frame N and not N - 1
+        const int64_t index = static_cast<int64_t> ( std::floor ( seconds * _frameRate + 1e-6 ) );
+        return std::clamp<int64_t> ( index, 0, GetFrameCount ( ) - 1 );
+    }
+
+    RawVideoFile::Frame RawVideoFile::GetFrame ( int64_t index ) const
+    {
+        Frame frame;
+        if ( index < 0 || index >= GetFrameCount ( ) ) return frame;
+
+        const uint8_t * data = _file->Data ( ) + FrameOffset ( index );
+        const int32_t chromaWidth = ( _width + 1 ) / 2;
+        const int32_t chromaHeight = ( _height + 1 ) / 2;
+
+        frame.index = index;
+        frame.pts = index / _frameRate;
+
+        switch ( _format )
+        {
+            case PixelFormat::BGRA:
+            {
+                frame.planes[0] = { data, _width, _height, _width * 4 };
+                frame.planeCount = 1;
+                break;
+            }
+
+            case PixelFormat::NV12:
+            {
+                frame.planes[0] = { data, _width, _height, _width };
+                frame.planes[1] = { data + static_cast<size_t> ( _width ) * _height, chromaWidth, chromaHeight, chromaWidth * 2 };
+                frame.planeCount = 2;
+                break;
+            }
+
+            case PixelFormat::I420:
+            {
+                const size_t luma = static_cast<size_t> ( _width ) * _height;
+                const size_t chroma = static_cast<size_t> ( chromaWidth ) * chromaHeight;
+                frame.planes[0] = { data, _width, _height, _width };
+                frame.planes[1] = { data + luma, chromaWidth, chromaHeight, chromaWidth };
+                frame.planes[2] = { data + luma + chroma, chromaWidth, chromaHeight, chromaWidth };
+                frame.planeCount = 3;
+                break;
+            }
+        }
+
+        return frame;
+    }
+
+    void RawVideoFile::Prefetch ( int64_t first, int64_t count ) const
+    {
+        first = std::max<int64_t> ( 0, first );
+        count = std::min<int64_t> ( count, GetFrameCount ( ) - first );
+
+        for ( int64_t i = 0; i < count; i++ )
+        {
+            _file->Advise ( FrameOffset ( first + i ), _frameBytes, MappedFile::Advice::WillNeed );
+        }
+    }
+
+    void RawVideoFile::Evict ( int64_t first, int64_t count ) const
+    {
+        first = std::max<int64_t> ( 0, first );
+        count = std::min<int64_t> ( count, GetFrameCount ( ) - first );
+
+        for ( int64_t i = 0; i < count; i++ )
+        {
+            _file->Advise ( FrameOffset ( first + i ), _frameBytes, MappedFile::Advice::DontNeed );
+        }
+    }
+}
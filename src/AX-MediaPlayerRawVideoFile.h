@@ -0,0 +1,129 @@
+//
+//  AX-MediaPlayerRawVideoFile.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include "AX-MediaPlayerMappedFile.h"
+
+#include <vector>
+#include <string>
+
+namespace AX::Video
+{
+    using RawVideoFileRef = std::shared_ptr<class RawVideoFile>;
+
+    // Uncompressed frames straight out of a memory mapped file, either a
+    // YUV4MPEG2 (.y4m) stream or a headerless sequence of fixed size BGRA / NV12 frames.
+    // Every frame is a fixed offset into the mapping so seeking and stepping are exact and
+    // cost the same wherever they land, and frames are views of the mapping (no copies).
+    // Residency is managed explicitly with Prefetch ( ) / Evict ( ) rather than leaving it to
+    // the kernel's readahead heuristics. Like MappedFile, no dependency on cinder.
+    class RawVideoFile
+    {
+    public:
+
+        enum class PixelFormat
+        {
+            BGRA,   // 4 bytes per pixel
+            NV12,   // Y plane then interleaved half resolution UV
+            I420,   // Y, U, V planes, U and V half resolution (Y4M's 420 variants)
+        };
+
+        // Describes headerless files, Y4M files describe themselves and ignore these
+        struct Options
+        {
+            Options & Format ( PixelFormat format ) { _format = format; return *this; }
+            Options & Size ( int32_t width, int32_t height ) { _width = width; _height = height; return *this; }
+            Options & FrameRate ( double fps ) { _frameRate = fps; return *this; }
+            Options & HeaderBytes ( uint64_t bytes ) { _headerBytes = bytes; return *this; }
+            Options & FullRange ( bool fullRange ) { _fullRange = fullRange; return *this; }
+
+            PixelFormat GetFormat ( ) const { return _format; }
+            int32_t     GetWidth ( ) const { return _width; }
+            int32_t     GetHeight ( ) const { return _height; }
+            double      GetFrameRate ( ) const { return _frameRate; }
+            uint64_t    GetHeaderBytes ( ) const { return _headerBytes; }
+            bool        IsFullRange ( ) const { return _fullRange; }
+
+            Options ( ) { };
+
+        protected:
+
+            PixelFormat _format{ PixelFormat::BGRA };
+            int32_t     _width{ 0 };
+            int32_t     _height{ 0 };
+            double      _frameRate{ 30.0 };
+            uint64_t    _headerBytes{ 0 };      // Skipped before the first frame
+            bool        _fullRange{ false };    // YUV only, otherwise video (16 - 235) levels
+        };
+
+        struct Plane
+        {
+            const uint8_t * data{ nullptr };
+            int32_t         width{ 0 };         // In samples, i.e half the luma width for chroma
+            int32_t         height{ 0 };
+            int32_t         rowBytes{ 0 };
+        };
+
+        struct Frame
+        {
+            Plane           planes[3];
+            int32_t         planeCount{ 0 };
+            int64_t         index{ -1 };
+            double          pts{ 0.0 };
+
+            explicit operator bool ( ) const { return planeCount > 0; }
+        };
+
+        static RawVideoFileRef Open ( const std::filesystem::path & path, const Options & options = Options ( ) );
+
+        inline PixelFormat GetPixelFormat ( ) const { return _format; }
+        inline int32_t  GetWidth ( ) const { return _width; }
+        inline int32_t  GetHeight ( ) const { return _height; }
+        inline double   GetFrameRate ( ) const { return _frameRate; }
+        inline int64_t  GetFrameCount ( ) const { return static_cast<int64_t> ( _offsets.empty ( ) ? _frameCount : _offsets.size ( ) ); }
+        inline double   GetDurationInSeconds ( ) const { return GetFrameCount ( ) / _frameRate; }
+        inline uint64_t GetFrameBytes ( ) const { return _frameBytes; }
+        inline bool     IsFullRange ( ) const { return _fullRange; }
+        inline const MappedFileRef & GetFile ( ) const { return _file; }
+
+        // Nearest frame at or before `seconds`
+        int64_t FrameIndexAt ( double seconds ) const;
+
+        // An invalid frame when out of range
+        Frame   GetFrame ( int64_t index ) const;
+
+        // Ask the OS to page in / drop `count` frames from `first`, asynchronously
+        void    Prefetch ( int64_t first, int64_t count ) const;
+        void    Evict ( int64_t first, int64_t count ) const;
+
+    protected:
+
+        RawVideoFile ( ) { };
+
+        bool    ParseY4M ( );
+        bool    ParseRaw ( const Options & options );
+        bool    IndexY4MFrames ( uint64_t first );
+        uint64_t FrameOffset ( int64_t index ) const;
+        uint64_t ComputeFrameBytes ( ) const;
+
+        MappedFileRef           _file;
+        PixelFormat             _format{ PixelFormat::BGRA };
+        int32_t                 _width{ 0 };
+        int32_t                 _height{ 0 };
+        double                  _frameRate{ 30.0 };
+        bool                    _fullRange{ false };
+        uint64_t                _frameBytes{ 0 };
+
+        // Fixed stride frames are computed, Y4M files with per frame parameters are indexed
+        uint64_t                _firstOffset{ 0 };
+        uint64_t                _stride{ 0 };
+        uint64_t                _frameCount{ 0 };
+        std::vector<uint64_t>   _offsets;
+    };
+}
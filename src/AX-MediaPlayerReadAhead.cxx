@@ -0,0 +1,582 @@
+//
+//  AX-MediaPlayerReadAhead.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerReadAhead.h"
+
+#include <deque>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/stat.h>
+#endif
+
+// Only when the build links liburing and says so, having the header around isn't enough
+#if defined( __linux__ ) && defined( AX_MEDIAPLAYER_IO_URING ) && AX_MEDIAPLAYER_IO_URING
+    #include <liburing.h>
+    #define AX_MEDIAPLAYER_HAS_IO_URING
+#endif
+
+namespace
+{
+#ifdef _WIN32
+    int64_t ReadAt ( void * file, uint64_t offset, uint8_t * destination, size_t length )
+    {
+        size_t total = 0;
+        while ( total < length )
+        {
+            OVERLAPPED overlapped{ };
+            overlapped.Offset = static_cast<DWORD> ( ( offset + total ) & 0xFFFFFFFF );
+            overlapped.OffsetHigh = static_cast<DWORD> ( ( offset + total ) >> 32 );
+
+            DWORD count = 0;
+            DWORD request = static_cast<DWORD> ( std::min<size_t> ( length - total, 1u << 30 ) );
+            if ( !ReadFile ( static_cast<HANDLE> ( file ), destination + total, request, &count, &overlapped ) )
+            {
+                if ( GetLastError ( ) == ERROR_HANDLE_EOF ) break;
+                return -1;
+            }
+
+            if ( count == 0 ) break;
+            total += count;
+        }
+
+        return static_cast<int64_t> ( total );
+    }
+#else
+    int64_t ReadAt ( int fd, uint64_t offset, uint8_t * destination, size_t length )
+    {
+        size_t total = 0;
+        while ( total < length )
+        {
+            ssize_t count = pread ( fd, destination + total, length - total, static_cast<off_t> ( offset + total ) );
+            if ( count < 0 )
+            {
+                if ( errno == EINTR ) continue;
+                return -1;
+            }
+
+            if ( count == 0 ) break;
+            total += static_cast<size_t> ( count );
+        }
+
+        return static_cast<int64_t> ( total );
+    }
+
+    void Advise ( int fd, uint64_t offset, uint64_t length, int advice )
+    {
+    #ifdef POSIX_FADV_NORMAL
+        posix_fadvise ( fd, static_cast<off_t> ( offset ), static_cast<off_t> ( length ), advice );
+    #endif
+    }
+#endif
+}
+
+namespace AX::Video
+{
+    struct ReadAheadByteSource::Block
+    {
+        uint64_t                index{ 0 };
+        uint64_t                offset{ 0 };
+        size_t                  length{ 0 };
+        size_t                  size{ 0 };
+        std::vector<uint8_t>    data;
+        bool                    ready{ false };
+        bool                    failed{ false };
+        int                     pins{ 0 };
+    };
+
+    class ReadAheadByteSource::Backend
+    {
+    public:
+
+        using Completion = std::function<void ( Block *, int64_t )>;
+
+        Backend ( Completion completion ) : _completion ( std::move ( completion ) ) { }
+        virtual ~Backend ( ) { };
+
+        // Reads block->length bytes at block->offset into block->data and
+        // calls the completion from a backend thread when it lands
+        virtual void Submit ( Block * block ) = 0;
+
+    protected:
+
+        Completion _completion;
+    };
+
+    namespace
+    {
+        class ThreadPoolBackend : public ReadAheadByteSource::Backend
+        {
+        public:
+
+#ifdef _WIN32
+            using Handle = void *;
+#else
+            using Handle = int;
+#endif
+
+            ThreadPoolBackend ( Handle file, int threads, Completion completion )
+                : Backend ( std::move ( completion ) )
+                , _file ( file )
+            {
+                for ( int i = 0; i < std::max ( 1, threads ); i++ )
+                {
+                    _threads.emplace_back ( [=] { Run ( ); } );
+                }
+            }
+
+            void Submit ( ReadAheadByteSource::Block * block ) override
+            {
+                {
+                    std::unique_lock<std::mutex> lk ( _mutex );
+                    _queue.push_back ( block );
+                }
+                _wake.notify_one ( );
+            }
+
+            ~ThreadPoolBackend ( )
+            {
+                {
+                    std::unique_lock<std::mutex> lk ( _mutex );
+                    _running = false;
+                }
+                _wake.notify_all ( );
+
+                for ( auto & thread : _threads ) thread.join ( );
+            }
+
+        protected:
+
+            void Run ( )
+            {
+                while ( true )
+                {
+                    ReadAheadByteSource::Block * block = nullptr;
+                    {
+                        std::unique_lock<std::mutex> lk ( _mutex );
+                        _wake.wait ( lk, [&] { return !_running || !_queue.empty ( ); } );
+                        if ( !_running ) return;
+
+                        block = _queue.front ( );
+                        _queue.pop_front ( );
+                    }
+
+                    _completion ( block, ReadAt ( _file, block->offset, block->data.data ( ), block->length ) );
+                }
+            }
+
+            Handle                                      _file;
+            std::mutex                                  _mutex;
+            std::condition_variable                     _wake;
+            std::deque<ReadAheadByteSource::Block *>    _queue;
+            std::vector<std::thread>                    _threads;
+            bool                                        _running{ true };
+        };
+
+#ifdef AX_MEDIAPLAYER_HAS_IO_URING
+        class IOUringBackend : public ReadAheadByteSource::Backend
+        {
+        public:
+
+            static std::unique_ptr<Backend> Create ( int fd, int queueDepth, Completion completion )
+            {
+                std::unique_ptr<IOUringBackend> backend{ new IOUringBackend ( fd, std::move ( completion ) ) };
+                if ( io_uring_queue_init ( static_cast<unsigned> ( queueDepth + 16 ), &backend->_ring, 0 ) < 0 ) return nullptr;
+
+                backend->_initialized = true;
+                backend->_thread = std::thread ( [ptr = backend.get ( )] { ptr->Run ( ); } );
+                return backend;
+            }
+
+            void Submit ( ReadAheadByteSource::Block * block ) override
+            {
+                std::unique_lock<std::mutex> lk ( _submitMutex );
+                _inFlight++;
+
+                io_uring_sqe * sqe = io_uring_get_sqe ( &_ring );
+                while ( !sqe )
+                {
+                    // Submission slots are recycled as soon as the kernel consumes them
+                    io_uring_submit ( &_ring );
+                    sqe = io_uring_get_sqe ( &_ring );
+                }
+
+                io_uring_prep_read ( sqe, _fd, block->data.data ( ), static_cast<unsigned> ( block->length ), block->offset );
+                io_uring_sqe_set_data ( sqe, block );
+                io_uring_submit ( &_ring );
+            }
+
+            ~IOUringBackend ( )
+            {
+                if ( !_initialized ) return;
+
+                {
+                    // Wake the completion thread with a no-op so it can drain and exit
+                    std::unique_lock<std::mutex> lk ( _submitMutex );
+                    _stopping = true;
+
+                    io_uring_sqe * sqe = io_uring_get_sqe ( &_ring );
+                    while ( !sqe )
+                    {
+                        io_uring_submit ( &_ring );
+                        sqe = io_uring_get_sqe ( &_ring );
+                    }
+
+                    io_uring_prep_nop ( sqe );
+                    io_uring_sqe_set_data ( sqe, nullptr );
+                    io_uring_submit ( &_ring );
+                }
+
+                _thread.join ( );
+                io_uring_queue_exit ( &_ring );
+            }
+
+        protected:
+
+            IOUringBackend ( int fd, Completion completion )
+                : Backend ( std::move ( completion ) )
+                , _fd ( fd )
+            { }
+
+            void Run ( )
+            {
+                while ( true )
+                {
+                    io_uring_cqe * cqe = nullptr;
+                    int error = io_uring_wait_cqe ( &_ring, &cqe );
+                    if ( error == -EINTR ) continue;
+                    if ( error < 0 ) return;
+
+                    auto block = static_cast<ReadAheadByteSource::Block *> ( io_uring_cqe_get_data ( cqe ) );
+                    int64_t result = cqe->res;
+                    io_uring_cqe_seen ( &_ring, cqe );
+
+                    if ( block )
+                    {
+                        // A short read mid file is legal, finish it off synchronously
+                        if ( result >= 0 && static_cast<size_t> ( result ) < block->length )
+                        {
+                            int64_t rest = ReadAt ( _fd, block->offset + result, block->data.data ( ) + result, block->length - static_cast<size_t> ( result ) );
+                            result = rest < 0 ? rest : result + rest;
+                        }
+
+                        _completion ( block, result );
+                        _inFlight--;
+                    }
+
+                    if ( _stopping && _inFlight.load ( ) == 0 ) return;
+                }
+            }
+
+            int                     _fd{ -1 };
+            io_uring                _ring{ };
+            bool                    _initialized{ false };
+            std::mutex              _submitMutex;
+            std::thread             _thread;
+            std::atomic_bool        _stopping{ false };
+            std::atomic_int         _inFlight{ 0 };
+        };
+#endif
+    }
+
+    ReadAheadByteSourceRef ReadAheadByteSource::Create ( const std::filesystem::path & path, const Options & options )
+    {
+        ReadAheadByteSourceRef source{ new ReadAheadByteSource ( path, options ) };
+        if ( !source->Open ( ) ) return nullptr;
+        return source;
+    }
+
+    ReadAheadByteSource::ReadAheadByteSource ( const std::filesystem::path & path, const Options & options )
+        : ByteSource ( path.filename ( ).string ( ), path.string ( ) )
+        , _path ( path )
+        , _options ( options )
+    {
+        if ( _options.GetBlockSize ( ) < 64 * 1024 ) _options.BlockSize ( 64 * 1024 );
+        if ( _options.GetQueueDepth ( ) < 1 ) _options.QueueDepth ( 1 );
+    }
+
+    bool ReadAheadByteSource::Open ( )
+    {
+        auto completion = [this] ( Block * block, int64_t result ) { OnBlockComplete ( block, result ); };
+
+#ifdef _WIN32
+        HANDLE file = CreateFileW ( _path.wstring ( ).c_str ( ), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+        if ( file == INVALID_HANDLE_VALUE ) return false;
+        _file = file;
+
+        LARGE_INTEGER size{ };
+        if ( !GetFileSizeEx ( file, &size ) ) return false;
+        _size = static_cast<uint64_t> ( size.QuadPart );
+
+        _backend = std::make_unique<ThreadPoolBackend> ( _file, _options.GetThreads ( ), completion );
+#else
+        _fd = open ( _path.c_str ( ), O_RDONLY | O_CLOEXEC );
+        if ( _fd < 0 ) return false;
+
+        struct stat info{ };
+        if ( fstat ( _fd, &info ) != 0 ) return false;
+        _size = static_cast<uint64_t> ( info.st_size );
+
+    #ifdef POSIX_FADV_SEQUENTIAL
+        Advise ( _fd, 0, 0, POSIX_FADV_SEQUENTIAL );
+    #endif
+
+    #ifdef AX_MEDIAPLAYER_HAS_IO_URING
+        if ( _options.IsIOUringEnabled ( ) )
+        {
+            _backend = IOUringBackend::Create ( _fd, _options.GetQueueDepth ( ), completion );
+            _stats.ioUring = _backend != nullptr;
+        }
+    #endif
+
+        // Either io_uring is unavailable or the kernel refused to give us a ring
+        if ( !_backend )
+        {
+            _backend = std::make_unique<ThreadPoolBackend> ( _fd, _options.GetThreads ( ), completion );
+        }
+#endif
+
+        return _size > 0;
+    }
+
+    void ReadAheadByteSource::SetDurationHint ( float seconds )
+    {
+        if ( seconds > 0.0f )
+        {
+            _bytesPerSecond.store ( static_cast<uint64_t> ( _size / seconds ) );
+        }
+    }
+
+    uint64_t ReadAheadByteSource::WindowInBlocks ( ) const
+    {
+        double bytes = _options.GetWindowMegabytes ( ) * 1024.0 * 1024.0;
+        bytes = std::max ( bytes, _options.GetWindowSeconds ( ) * static_cast<double> ( _bytesPerSecond.load ( ) ) );
+
+        uint64_t blocks = static_cast<uint64_t> ( bytes / _options.GetBlockSize ( ) );
+        return std::max<uint64_t> ( blocks, 2 );
+    }
+
+    ReadAheadByteSource::Block & ReadAheadByteSource::RequestBlock ( uint64_t index )
+    {
+        std::unique_ptr<Block> block;
+        if ( !_freeBlocks.empty ( ) )
+        {
+            block = std::move ( _freeBlocks.back ( ) );
+            _freeBlocks.pop_back ( );
+        }
+        else
+        {
+            block = std::make_unique<Block> ( );
+            block->data.resize ( _options.GetBlockSize ( ) );
+        }
+
+        block->index = index;
+        block->offset = index * _options.GetBlockSize ( );
+        block->length = static_cast<size_t> ( std::min<uint64_t> ( _options.GetBlockSize ( ), _size - block->offset ) );
+        block->size = 0;
+        block->ready = false;
+        block->failed = false;
+        block->pins = 0;
+
+        if ( _inFlight++ == 0 ) _busySince = Clock::now ( );
+
+        auto & result = *block;
+        _blocks[index] = std::move ( block );
+        _backend->Submit ( &result );
+
+        return result;
+    }
+
+    void ReadAheadByteSource::Prefetch ( uint64_t fromIndex )
+    {
+        uint64_t blockSize = _options.GetBlockSize ( );
+        uint64_t lastIndex = ( _size - 1 ) / blockSize;
+        uint64_t endIndex = std::min ( lastIndex, fromIndex + WindowInBlocks ( ) );
+
+        uint64_t firstRequested = 0;
+        uint64_t lastRequested = 0;
+
+        for ( uint64_t index = fromIndex + 1; index <= endIndex; index++ )
+        {
+            if ( _inFlight >= static_cast<size_t> ( _options.GetQueueDepth ( ) ) ) break;
+            if ( _blocks.count ( index ) ) continue;
+
+            RequestBlock ( index );
+            if ( firstRequested == 0 ) firstRequested = index;
+            lastRequested = index;
+        }
+
+#ifndef _WIN32
+    #ifdef POSIX_FADV_WILLNEED
+        if ( firstRequested != 0 )
+        {
+            // Let the kernel start on the range too, it may merge the requests better than we can
+            Advise ( _fd, firstRequested * blockSize, ( lastRequested - firstRequested + 1 ) * blockSize, POSIX_FADV_WILLNEED );
+        }
+    #endif
+#endif
+    }
+
+    void ReadAheadByteSource::Evict ( uint64_t currentIndex )
+    {
+        uint64_t window = WindowInBlocks ( );
+
+        // Demuxers often read audio and video from two different places
+        // in the file, so blocks outside the window are only dropped once we're over
+        // budget (farthest from the read head first) rather than as soon as the head moves
+        size_t budget = static_cast<size_t> ( window * 2 + 2 );
+
+        std::vector<std::pair<uint64_t, uint64_t>> candidates;
+        for ( auto & [index, block] : _blocks )
+        {
+            if ( !block->ready || block->pins > 0 ) continue;
+
+            bool inWindow = index + 1 >= currentIndex && index <= currentIndex + window;
+            if ( block->failed )
+            {
+                candidates.push_back ( { UINT64_MAX, index } );
+            }
+            else if ( !inWindow )
+            {
+                candidates.push_back ( { index < currentIndex ? currentIndex - index : index - currentIndex, index } );
+            }
+        }
+
+        std::sort ( candidates.begin ( ), candidates.end ( ), std::greater<> ( ) );
+
+        for ( auto & [distance, index] : candidates )
+        {
+            auto it = _blocks.find ( index );
+            auto & block = *it->second;
+            if ( !block.failed && _blocks.size ( ) <= budget ) break;
+
+#ifndef _WIN32
+    #ifdef POSIX_FADV_DONTNEED
+            // We've got our own copy, don't let a 400Mbit master push everything else out of the page cache
+            if ( index < currentIndex ) Advise ( _fd, block.offset, block.length, POSIX_FADV_DONTNEED );
+    #endif
+#endif
+
+            if ( _freeBlocks.size ( ) < window ) _freeBlocks.push_back ( std::move ( it->second ) );
+            _blocks.erase ( it );
+        }
+    }
+
+    void ReadAheadByteSource::OnBlockComplete ( Block * block, int64_t result )
+    {
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            block->failed = result < 0;
+            block->size = result < 0 ? 0 : static_cast<size_t> ( result );
+            block->ready = true;
+
+            _stats.bytesFetched += block->size;
+            if ( --_inFlight == 0 )
+            {
+                _busySeconds += std::chrono::duration<double> ( Clock::now ( ) - _busySince ).count ( );
+            }
+        }
+
+        _blockReady.notify_all ( );
+    }
+
+    size_t ReadAheadByteSource::Read ( uint64_t offset, void * destination, size_t length )
+    {
+        if ( offset >= _size || length == 0 ) return 0;
+        length = static_cast<size_t> ( std::min<uint64_t> ( length, _size - offset ) );
+
+        auto output = static_cast<uint8_t *> ( destination );
+        uint64_t blockSize = _options.GetBlockSize ( );
+        uint64_t index = offset / blockSize;
+        size_t total = 0;
+
+        std::unique_lock<std::mutex> lk ( _mutex );
+        while ( total < length )
+        {
+            uint64_t position = offset + total;
+            index = position / blockSize;
+
+            auto it = _blocks.find ( index );
+            Block & block = it != _blocks.end ( ) ? *it->second : RequestBlock ( index );
+
+            if ( block.ready )
+            {
+                _stats.cacheHits++;
+            }
+            else
+            {
+                // Get the rest of the window moving before we sit and wait
+                Prefetch ( index );
+
+                auto start = Clock::now ( );
+                block.pins++;
+                _blockReady.wait ( lk, [&] { return block.ready; } );
+                block.pins--;
+
+                double waited = std::chrono::duration<double> ( Clock::now ( ) - start ).count ( );
+                _stats.stalls++;
+                _stats.stallSeconds += waited;
+                _stats.longestStallSeconds = std::max ( _stats.longestStallSeconds, waited );
+            }
+
+            if ( block.failed ) break;
+
+            size_t within = static_cast<size_t> ( position - block.offset );
+            if ( within >= block.size ) break;
+
+            size_t count = std::min ( length - total, block.size - within );
+            std::memcpy ( output + total, block.data.data ( ) + within, count );
+            total += count;
+        }
+
+        _stats.bytesRequested += total;
+
+        Prefetch ( index );
+        Evict ( index );
+
+        return total;
+    }
+
+    ReadAheadByteSource::Stats ReadAheadByteSource::GetStats ( ) const
+    {
+        std::unique_lock<std::mutex> lk ( _mutex );
+
+        Stats stats = _stats;
+        stats.blocksInFlight = _inFlight;
+        stats.blocksResident = _blocks.size ( ) - _inFlight;
+
+        double busy = _busySeconds;
+        if ( _inFlight > 0 ) busy += std::chrono::duration<double> ( Clock::now ( ) - _busySince ).count ( );
+        if ( busy > 0.0 ) stats.throughputMBps = ( stats.bytesFetched / ( 1024.0 * 1024.0 ) ) / busy;
+
+        return stats;
+    }
+
+    ReadAheadByteSource::~ReadAheadByteSource ( )
+    {
+        // Make sure nothing is still writing into a block before they're freed
+        _backend = nullptr;
+
+#ifdef _WIN32
+        if ( _file ) CloseHandle ( static_cast<HANDLE> ( _file ) );
+#else
+        if ( _fd >= 0 ) close ( _fd );
+#endif
+    }
+}
@@ -0,0 +1,126 @@
+//
+//  AX-MediaPlayerReadAhead.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include "AX-MediaPlayerByteSource.h"
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <filesystem>
+#include <unordered_map>
+#include <condition_variable>
+
+namespace AX::Video
+{
+    using ReadAheadByteSourceRef = std::shared_ptr<class ReadAheadByteSource>;
+
+    // Keeps a window of a local file in flight ahead of wherever the
+    // decoder is currently reading so high bitrate masters on slow or network storage
+    // don't stall the engine. The file is split into fixed size blocks, reads that hit
+    // a block that hasn't landed yet block the caller and are counted as stalls.
+    class ReadAheadByteSource : public ByteSource
+    {
+    public:
+
+        struct Options
+        {
+            Options & WindowMegabytes ( float megabytes ) { _windowMegabytes = megabytes; return *this; }
+            Options & WindowSeconds ( float seconds ) { _windowSeconds = seconds; return *this; }
+            Options & BlockSize ( size_t bytes ) { _blockSize = bytes; return *this; }
+            Options & Threads ( int threads ) { _threads = threads; return *this; }
+            Options & QueueDepth ( int depth ) { _queueDepth = depth; return *this; }
+            // Linux only, and only in builds that define AX_MEDIAPLAYER_IO_URING=1 and link liburing
+            Options & UseIOUring ( bool enabled ) { _useIOUring = enabled; return *this; }
+
+            float   GetWindowMegabytes ( ) const { return _windowMegabytes; }
+            float   GetWindowSeconds ( ) const { return _windowSeconds; }
+            size_t  GetBlockSize ( ) const { return _blockSize; }
+            int     GetThreads ( ) const { return _threads; }
+            int     GetQueueDepth ( ) const { return _queueDepth; }
+            bool    IsIOUringEnabled ( ) const { return _useIOUring; }
+
+            Options ( ) { };
+
+        protected:
+
+            float   _windowMegabytes{ 64.0f };
+            float   _windowSeconds{ 2.0f };
+            size_t  _blockSize{ 1 << 20 };
+            int     _threads{ 4 };
+            int     _queueDepth{ 32 };
+            bool    _useIOUring{ true };
+        };
+
+        struct Stats
+        {
+            uint64_t    bytesRequested{ 0 };    // Handed to the decoder
+            uint64_t    bytesFetched{ 0 };      // Read from disk
+            uint64_t    cacheHits{ 0 };         // Blocks that were resident when asked for
+            uint64_t    stalls{ 0 };            // Reads that had to wait on the disk
+            double      stallSeconds{ 0.0 };
+            double      longestStallSeconds{ 0.0 };
+            double      throughputMBps{ 0.0 };  // Disk throughput while requests were in flight
+            size_t      blocksInFlight{ 0 };
+            size_t      blocksResident{ 0 };
+            bool        ioUring{ false };       // Reads go through io_uring rather than the thread pool
+        };
+
+        static ReadAheadByteSourceRef Create ( const std::filesystem::path & path, const Options & options = Options ( ) );
+
+        uint64_t    Size ( ) const override { return _size; }
+        size_t      Read ( uint64_t offset, void * destination, size_t length ) override;
+
+        // The seconds based window needs to know roughly how many bytes a second of media is
+        void        SetDurationHint ( float seconds );
+        Stats       GetStats ( ) const;
+
+        inline const Options & GetOptions ( ) const { return _options; }
+
+        ~ReadAheadByteSource ( );
+
+        class Backend;
+        struct Block;
+
+    protected:
+
+        ReadAheadByteSource ( const std::filesystem::path & path, const Options & options );
+        bool        Open ( );
+
+        Block &     RequestBlock ( uint64_t index );
+        void        Prefetch ( uint64_t fromIndex );
+        void        Evict ( uint64_t currentIndex );
+        void        OnBlockComplete ( Block * block, int64_t result );
+        uint64_t    WindowInBlocks ( ) const;
+
+        using Clock = std::chrono::steady_clock;
+
+        std::filesystem::path                               _path;
+        Options                                             _options;
+        uint64_t                                            _size{ 0 };
+        std::atomic<uint64_t>                               _bytesPerSecond{ 0 };
+        std::unique_ptr<Backend>                            _backend;
+
+        mutable std::mutex                                  _mutex;
+        std::condition_variable                             _blockReady;
+        std::unordered_map<uint64_t, std::unique_ptr<Block>> _blocks;
+        std::vector<std::unique_ptr<Block>>                 _freeBlocks;
+        size_t                                              _inFlight{ 0 };
+        Clock::time_point                                   _busySince;
+        double                                              _busySeconds{ 0.0 };
+        Stats                                               _stats;
+
+#ifdef _WIN32
+        void *                                              _file{ nullptr };
+#else
+        int                                                 _fd{ -1 };
+#endif
+    };
+}
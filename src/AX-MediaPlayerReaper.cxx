@@ -0,0 +1,166 @@
+//
+//  AX-MediaPlayerReaper.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerReaper.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <algorithm>
+
+namespace AX::Video
+{
+    Reaper & Reaper::Shared ( )
+    {
+        static Reaper reaper;
+        return reaper;
+    }
+
+    void Reaper::Retire ( Shutdown shutdown, Task release )
+    {
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            _stats.retired++;
+            _stats.pending++;
+        }
+
+        _strand.Post ( [this, shutdown = std::move ( shutdown ), release = std::move ( release )] ( ) mutable
+        {
+            // Released once `done` has been called and the shutdown's own captures
+            // are gone too, whichever comes last, so anything shared with `release` is always
+            // last let go of on the GL thread
+            struct Retirement
+            {
+                std::chrono::steady_clock::time_point   start{ std::chrono::steady_clock::now ( ) };
+                std::atomic_bool                        done{ false };
+                std::atomic_int                         remaining{ 2 };
+                double                                  seconds{ 0.0 };
+                Task                                    release;
+            };
+
+            auto retirement = std::make_shared<Retirement> ( );
+            retirement->release = std::move ( release );
+
+            auto settle = [this, retirement]
+            {
+                if ( retirement->remaining.fetch_sub ( 1 ) == 1 ) Finish ( retirement->seconds, std::move ( retirement->release ) );
+            };
+
+            auto done = [retirement, settle]
+            {
+                if ( retirement->done.exchange ( true ) ) return;
+
+                retirement->seconds = std::chrono::duration<double> ( std::chrono::steady_clock::now ( ) - retirement->start ).count ( );
+                settle ( );
+            };
+
+            try
+            {
+                if ( shutdown ) shutdown ( done ); else done ( );
+            }
+            catch ( const std::exception & e )
+            {
+                // Whatever it was waiting on may never call back, don't leave the release stranded
+                std::cout << "Error: " << e.what ( ) << std::endl;
+                done ( );
+            }
+
+            shutdown = nullptr;
+            settle ( );
+        } );
+    }
+
+    void Reaper::Finish ( double seconds, Task release )
+    {
+        Task wake;
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            _released.push_back ( release ? std::move ( release ) : Task ( [] { } ) );
+            _stats.worstShutdownSeconds = std::max ( _stats.worstShutdownSeconds, seconds );
+            _stats.totalShutdownSeconds += seconds;
+            wake = _waker;
+
+            // Under the lock, or a waiter could see it released and be gone before this returns
+            _changed.notify_all ( );
+        }
+
+        if ( wake ) wake ( );
+    }
+
+    size_t Reaper::DrainGLThread ( )
+    {
+        std::deque<Task> released;
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            released.swap ( _released );
+        }
+
+        for ( auto & release : released )
+        {
+            try
+            {
+                release ( );
+            }
+            catch ( const std::exception & e )
+            {
+                std::cout << "Error: " << e.what ( ) << std::endl;
+            }
+
+            release = nullptr;
+        }
+
+        if ( !released.empty ( ) )
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            _stats.pending -= released.size ( );
+            _stats.completed += released.size ( );
+            _changed.notify_all ( );
+        }
+
+        return released.size ( );
+    }
+
+    void Reaper::SetWaker ( Task wake )
+    {
+        std::unique_lock<std::mutex> lk ( _mutex );
+        _waker = std::move ( wake );
+    }
+
+    void Reaper::WaitForPending ( bool isGLThread )
+    {
+        while ( true )
+        {
+            if ( isGLThread ) DrainGLThread ( );
+
+            std::unique_lock<std::mutex> lk ( _mutex );
+            if ( _stats.pending == 0 ) return;
+
+            // The GL thread is the one that has to pick up what's just been shut down
+            if ( isGLThread )
+            {
+                _changed.wait ( lk, [&] { return _stats.pending == 0 || !_released.empty ( ); } );
+            }
+            else
+            {
+                _changed.wait ( lk, [&] { return _stats.pending == 0; } );
+            }
+        }
+    }
+
+    uint64_t Reaper::GetPending ( ) const
+    {
+        std::unique_lock<std::mutex> lk ( _mutex );
+        return _stats.pending;
+    }
+
+    Reaper::Stats Reaper::GetStats ( ) const
+    {
+        std::unique_lock<std::mutex> lk ( _mutex );
+        return _stats;
+    }
+}
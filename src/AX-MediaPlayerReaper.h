@@ -0,0 +1,75 @@
+//
+//  AX-MediaPlayerReaper.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include "AX-MediaPlayerExecutor.h"
+
+#include <mutex>
+#include <deque>
+#include <cstdint>
+#include <functional>
+#include <condition_variable>
+
+namespace AX::Video
+{
+    // Takes the slow part of tearing something down off the thread that let go
+    // of it. Each retirement is a `shutdown` that's started in the background, one at a time on
+    // a Background strand, and a `release` that runs on the GL thread (whenever DrainGLThread ( )
+    // is next called there) once the shutdown has called the `done` it was handed. Shutdowns
+    // that wait on other work should finish from that work's completion rather than blocking
+    // the worker they were started on. The waker is told each time there's something to drain.
+    // No dependency on cinder, like MappedFile.
+    class Reaper
+    {
+    public:
+
+        using Task = std::function<void ( )>;
+        using Shutdown = std::function<void ( Task done )>;
+
+        struct Stats
+        {
+            uint64_t    retired{ 0 };
+            uint64_t    completed{ 0 };         // Released on the GL thread
+            uint64_t    pending{ 0 };           // Retired but not released yet
+            double      worstShutdownSeconds{ 0.0 };
+            double      totalShutdownSeconds{ 0.0 };
+        };
+
+        static Reaper & Shared ( );
+
+        // `done` can be called from any thread, only the first call counts
+        void        Retire ( Shutdown shutdown, Task release );
+
+        // Runs whatever has finished shutting down, call on the GL thread. Returns how many.
+        size_t      DrainGLThread ( );
+
+        // Called from whichever thread a shutdown finished on
+        void        SetWaker ( Task wake );
+
+        // Blocks until everything retired so far has been released. On the GL thread it drains
+        // as it goes, from anywhere else the GL thread has to be draining in the meantime.
+        void        WaitForPending ( bool isGLThread );
+
+        uint64_t    GetPending ( ) const;
+        Stats       GetStats ( ) const;
+
+    protected:
+
+        Reaper ( ) { };
+
+        void        Finish ( double seconds, Task release );
+
+        Executor::Strand        _strand{ Executor::Priority::Background };
+        mutable std::mutex      _mutex;
+        std::condition_variable _changed;
+        std::deque<Task>        _released;      // Shut down, waiting for the GL thread
+        Task                    _waker;
+        Stats                   _stats;
+    };
+}
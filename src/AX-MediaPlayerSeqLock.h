@@ -0,0 +1,100 @@
+//
+//  AX-MediaPlayerSeqLock.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace AX::Video
+{
+    // A value that's written now and then and read constantly, from any thread.
+    // Readers never block or write anything, they copy the value out and retry on the rare
+    // occasion a write landed in the middle. Stored as atomic words rather than a plain T
+    // so the racing copy is well defined. Writers take a mutex between themselves.
+    template <typename T>
+    class SeqLock
+    {
+        static_assert ( std::is_trivially_copyable_v<T>, "SeqLock values are copied word by word" );
+
+    public:
+
+        SeqLock ( const T & value = T ( ) ) { Write ( value ); }
+
+        SeqLock ( const SeqLock & ) = delete;
+        SeqLock & operator= ( const SeqLock & ) = delete;
+
+        T Load ( ) const
+        {
+            uint64_t words[kWords];
+            while ( true )
+            {
+                const uint64_t before = _sequence.load ( std::memory_order_acquire );
+                if ( before & 1 )
+                {
+                    std::this_thread::yield ( );
+                    continue;
+                }
+
+                for ( size_t i = 0; i < kWords; i++ ) words[i] = _words[i].load ( std::memory_order_relaxed );
+
+                std::atomic_thread_fence ( std::memory_order_acquire );
+                if ( _sequence.load ( std::memory_order_relaxed ) == before ) break;
+            }
+
+            T value;
+            std::memcpy ( &value, words, sizeof ( T ) );
+            return value;
+        }
+
+        void Store ( const T & value )
+        {
+            std::unique_lock<std::mutex> lk ( _writer );
+            Write ( value );
+        }
+
+        // Read, change and write back as one, against other writers
+        template <typename Function>
+        void Modify ( Function && function )
+        {
+            std::unique_lock<std::mutex> lk ( _writer );
+            T value = Load ( );
+            function ( value );
+            Write ( value );
+        }
+
+        // Number of writes so far
+        uint64_t GetVersion ( ) const { return _sequence.load ( std::memory_order_acquire ) / 2; }
+
+    protected:
+
+        static constexpr size_t kWords = ( sizeof ( T ) + sizeof ( uint64_t ) - 1 ) / sizeof ( uint64_t );
+
+        void Write ( const T & value )
+        {
+            uint64_t words[kWords]{ };
+            std::memcpy ( words, &value, sizeof ( T ) );
+
+            const uint64_t sequence = _sequence.load ( std::memory_order_relaxed );
+            _sequence.store ( sequence + 1, std::memory_order_relaxed );
+            std::atomic_thread_fence ( std::memory_order_release );
+
+            for ( size_t i = 0; i < kWords; i++ ) _words[i].store ( words[i], std::memory_order_relaxed );
+
+            _sequence.store ( sequence + 2, std::memory_order_release );
+        }
+
+        std::atomic<uint64_t>   _sequence{ 0 };
+        std::atomic<uint64_t>   _words[kWords]{ };
+        std::mutex              _writer;
+    };
+}
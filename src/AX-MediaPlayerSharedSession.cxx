@@ -0,0 +1,303 @@
+//
+//  AX-MediaPlayerSharedSession.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerSharedSession.h"
+#include "cinder/app/App.h"
+
+#include <sstream>
+#include <algorithm>
+
+using namespace ci;
+
+namespace
+{
+    class SharedFrameLease : public AX::Video::MediaPlayer::FrameLease
+    {
+    public:
+
+        SharedFrameLease ( const std::shared_ptr<AX::Video::MediaPlayer::FrameLease> & lease )
+            : _lease ( lease )
+        { }
+
+        gl::TextureRef ToTexture ( ) const override { return _lease->ToTexture ( ); }
+
+    protected:
+
+        bool IsValid ( ) const override { return _lease && *_lease; }
+
+        std::shared_ptr<AX::Video::MediaPlayer::FrameLease> _lease;
+    };
+}
+
+namespace AX::Video
+{
+    std::mutex SharedSession::kMutex;
+    std::map<std::string, std::weak_ptr<SharedSession>> SharedSession::kSessions;
+
+    std::string SharedSession::MakeKey ( const ci::DataSourceRef & source, const MediaPlayer::Format & format )
+    {
+        if ( !source ) return { };
+
+        std::ostringstream key;
+        if ( source->isFilePath ( ) )
+        {
+            std::error_code error;
+            auto path = fs::weakly_canonical ( source->getFilePath ( ), error );
+            key << "file:" << ( error ? source->getFilePath ( ) : path ).generic_string ( );
+        }
+        else if ( source->isUrl ( ) )
+        {
+            key << "url:" << source->getUrl ( ).str ( );
+        }
+        else
+        {
+            return { };
+        }
+
+        // Anything that changes what gets decoded or how it's delivered splits
+        // the session, including the options of whichever of those features are switched on.
+        key << '|' << format.IsAudioEnabled ( )
+            << format.IsAudioOnly ( )
+            << format.IsHardwareAccelerated ( )
+            << format.IsReadAheadEnabled ( )
+            << format.IsHttpCacheEnabled ( )
+            << format.GetBufferPolicy ( ).IsEnabled ( )
+            << format.IsAudioTapEnabled ( )
+            << format.IsFrameDroppingEnabled ( )
+            << format.IsBackgroundTransferEnabled ( )
+            << format.IsPresentationSyncEnabled ( )
+            << format.IsStreamingUploadEnabled ( )
+            << format.IsSeamlessLoopEnabled ( )
+            << '|' << format.AudioDeviceID ( )
+            << '|' << format.AudioTapChannels ( );
+
+        if ( format.IsFrameDroppingEnabled ( ) )
+        {
+            const auto & options = format.FrameDroppingOptions ( );
+            key << "|drop:" << options.IsSkippingSuperseded ( )
+                << ',' << options.GetMaxConsecutiveSkips ( )
+                << ',' << static_cast<int> ( options.GetDegrade ( ) )
+                << ',' << options.GetOverloadFraction ( )
+                << ',' << options.GetDegradeAfterSeconds ( )
+                << ',' << options.GetRecoverAfterSeconds ( );
+        }
+
+        if ( format.IsPresentationSyncEnabled ( ) )
+        {
+            const auto & options = format.PresentationOptions ( );
+            key << "|sync:" << options.GetQueueDepth ( )
+                << ',' << options.GetLatencyRefreshes ( )
+                << ',' << options.GetRefreshRate ( )
+                << ',' << options.GetHistogramRangeMs ( );
+        }
+
+        if ( format.IsStreamingUploadEnabled ( ) )
+        {
+            const auto & options = format.StreamingUploadOptions ( );
+            key << "|upload:" << options.GetRingSize ( ) << ',' << options.IsPersistent ( );
+        }
+
+        if ( format.IsSeamlessLoopEnabled ( ) )
+        {
+            const auto & options = format.SeamlessLoopOptions ( );
+            key << "|loop:" << options.GetPrerollSeconds ( ) << ',' << options.GetMaxPrerollFrames ( );
+        }
+
+        return key.str ( );
+    }
+
+    SharedSessionRef SharedSession::Attach ( const std::string & key, const Factory & factory )
+    {
+        {
+            std::unique_lock<std::mutex> lk ( kMutex );
+
+            auto it = kSessions.find ( key );
+            if ( it != kSessions.end ( ) )
+            {
+                if ( auto session = it->second.lock ( ) ) return session;
+            }
+        }
+
+        // Opening the decoder can take a while (http, read ahead, device setup), so it's done
+        // without holding up every other Attach. Two players racing for the same key both open
+        // one, the first to get back in wins and the other decoder is let go on the way out.
+        auto decoder = factory ( );
+        if ( !decoder ) return nullptr;
+
+        std::unique_lock<std::mutex> lk ( kMutex );
+
+        auto it = kSessions.find ( key );
+        if ( it != kSessions.end ( ) )
+        {
+            if ( auto session = it->second.lock ( ) ) return session;
+        }
+
+        auto session = SharedSessionRef ( new SharedSession ( key, decoder ) );
+        kSessions[key] = session;
+        return session;
+    }
+
+    size_t SharedSession::GetSessionCount ( )
+    {
+        std::unique_lock<std::mutex> lk ( kMutex );
+
+        size_t count = 0;
+        for ( auto & session : kSessions )
+        {
+            if ( !session.second.expired ( ) ) count++;
+        }
+
+        return count;
+    }
+
+    SharedSession::SharedSession ( const std::string & key, const MediaPlayerRef & decoder )
+        : _key ( key )
+        , _decoder ( decoder )
+    {
+        // Connected after the decoder's own update, so a frame it just swapped in is seen the same frame
+        _updateConnection = app::App::get ( )->getSignalUpdate ( ).connect ( [this] { Update ( ); } );
+    }
+
+    void SharedSession::Update ( )
+    {
+        // Nobody's drawing it, so leave the frame where it is rather than copying it out
+        if ( !IsAnyVisible ( ) ) return;
+        if ( !_decoder->CheckNewFrame ( ) ) return;
+
+        // Takes the frame on behalf of every attached player, which also clears the decoder's flag
+        _surface = _decoder->GetSurface ( );
+        _lease.reset ( );
+        _serial++;
+    }
+
+    MediaPlayer::FrameLeaseRef SharedSession::GetTexture ( )
+    {
+        auto lease = _lease.lock ( );
+        if ( !lease || _leaseSerial != _serial )
+        {
+            lease = std::shared_ptr<MediaPlayer::FrameLease> ( _decoder->GetTexture ( ) );
+            if ( !lease ) return nullptr;
+
+            _lease = lease;
+            _leaseSerial = _serial;
+        }
+
+        return std::make_unique<SharedFrameLease> ( lease );
+    }
+
+    void SharedSession::Join ( const MediaPlayer * player )
+    {
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            _listeners[player] = Listener ( );
+        }
+
+        Mix ( );
+    }
+
+    void SharedSession::Leave ( const MediaPlayer * player )
+    {
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            _listeners.erase ( player );
+        }
+
+        Mix ( );
+    }
+
+    void SharedSession::SetVolume ( const MediaPlayer * player, float volume )
+    {
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            _listeners[player].volume = volume;
+        }
+
+        Mix ( );
+    }
+
+    float SharedSession::GetVolume ( const MediaPlayer * player ) const
+    {
+        std::unique_lock<std::mutex> lk ( _mutex );
+        auto it = _listeners.find ( player );
+        return it != _listeners.end ( ) ? it->second.volume : 1.0f;
+    }
+
+    void SharedSession::SetMuted ( const MediaPlayer * player, bool muted )
+    {
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            _listeners[player].muted = muted;
+        }
+
+        Mix ( );
+    }
+
+    bool SharedSession::IsMuted ( const MediaPlayer * player ) const
+    {
+        std::unique_lock<std::mutex> lk ( _mutex );
+        auto it = _listeners.find ( player );
+        return it != _listeners.end ( ) && it->second.muted;
+    }
+
+    void SharedSession::SetVisible ( const MediaPlayer * player, bool visible )
+    {
+        std::unique_lock<std::mutex> lk ( _mutex );
+        _listeners[player].visible = visible;
+    }
+
+    bool SharedSession::IsVisible ( const MediaPlayer * player ) const
+    {
+        std::unique_lock<std::mutex> lk ( _mutex );
+        auto it = _listeners.find ( player );
+        return it == _listeners.end ( ) || it->second.visible;
+    }
+
+    bool SharedSession::IsAnyVisible ( ) const
+    {
+        std::unique_lock<std::mutex> lk ( _mutex );
+        for ( auto & listener : _listeners )
+        {
+            if ( listener.second.visible ) return true;
+        }
+
+        return false;
+    }
+
+    void SharedSession::Mix ( )
+    {
+        float volume = 0.0f;
+        bool audible = false;
+
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            for ( auto & listener : _listeners )
+            {
+                if ( listener.second.muted ) continue;
+                volume = std::max ( volume, listener.second.volume );
+                audible = true;
+            }
+        }
+
+        // There's one stream, so it plays as loud as the loudest player that wants to hear it
+        if ( audible ) _decoder->SetVolume ( volume );
+        _decoder->SetMuted ( !audible );
+    }
+
+    SharedSession::~SharedSession ( )
+    {
+        _updateConnection.disconnect ( );
+
+        {
+            std::unique_lock<std::mutex> lk ( kMutex );
+            auto it = kSessions.find ( _key );
+            if ( it != kSessions.end ( ) && it->second.expired ( ) ) kSessions.erase ( it );
+        }
+
+        _decoder = nullptr;
+    }
+}
@@ -0,0 +1,91 @@
+//
+//  AX-MediaPlayerSharedSession.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include "AX-MediaPlayer.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <functional>
+
+namespace AX::Video
+{
+    using SharedSessionRef = std::shared_ptr<class SharedSession>;
+
+    // One decoding player that any number of MediaPlayers created with
+    // Format::SharedSession ( true ) from the same source and format attach to, so the same
+    // attract loop on a dozen screens is opened, decoded and transferred once. The decoder
+    // is never handed out, it lives exactly as long as the last player attached to it.
+    //
+    // Transport (play / pause / seek / rate / loop points) is shared since there's only one
+    // stream, so a Pause ( ) on any attached player pauses all of them. Volume, mute and
+    // visibility are per player: the stream plays at the loudest unmuted player's volume
+    // (muted when all of them are), and frames are only taken while at least one of them is
+    // visible. Each attached player keeps its own signals and its own idea of whether it has
+    // seen the current frame, and leases taken in the same frame share one underlying lease.
+    class SharedSession
+    {
+    public:
+
+        using Factory = std::function<MediaPlayerRef ( )>;
+
+        // Empty key if this source can't be shared (i.e raw byte sources)
+        static std::string      MakeKey ( const ci::DataSourceRef & source, const MediaPlayer::Format & format );
+        static SharedSessionRef Attach ( const std::string & key, const Factory & factory );
+        static size_t           GetSessionCount ( );
+
+        ~SharedSession ( );
+
+        const MediaPlayerRef &  GetDecoder ( ) const { return _decoder; }
+        uint64_t                GetFrameSerial ( ) const { return _serial; }
+
+        const ci::Surface8uRef & GetSurface ( ) const { return _surface; }
+        MediaPlayer::FrameLeaseRef GetTexture ( );
+
+        void                    Join ( const MediaPlayer * player );
+        void                    Leave ( const MediaPlayer * player );
+
+        void                    SetVolume ( const MediaPlayer * player, float volume );
+        float                   GetVolume ( const MediaPlayer * player ) const;
+        void                    SetMuted ( const MediaPlayer * player, bool muted );
+        bool                    IsMuted ( const MediaPlayer * player ) const;
+        void                    SetVisible ( const MediaPlayer * player, bool visible );
+        bool                    IsVisible ( const MediaPlayer * player ) const;
+
+    protected:
+
+        SharedSession ( const std::string & key, const MediaPlayerRef & decoder );
+        void                    Update ( );
+        void                    Mix ( );
+        bool                    IsAnyVisible ( ) const;
+
+        struct Listener
+        {
+            float               volume{ 1.0f };
+            bool                muted{ false };
+            bool                visible{ true };
+        };
+
+        static std::mutex                               kMutex;
+        static std::map<std::string, std::weak_ptr<SharedSession>> kSessions;
+
+        std::string             _key;
+        MediaPlayerRef          _decoder;
+        ci::signals::Connection _updateConnection;
+        uint64_t                _serial{ 0 };
+        ci::Surface8uRef        _surface;
+
+        mutable std::mutex      _mutex;
+        std::map<const MediaPlayer *, Listener> _listeners;
+
+        std::weak_ptr<MediaPlayer::FrameLease> _lease;
+        uint64_t                _leaseSerial{ 0 };
+    };
+}
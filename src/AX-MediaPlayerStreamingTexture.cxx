@@ -0,0 +1,195 @@
+//
+//  AX-MediaPlayerStreamingTexture.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerStreamingTexture.h"
+#include "cinder/gl/gl.h"
+#include "cinder/Log.h"
+
+#include <cstring>
+#include <algorithm>
+
+using namespace ci;
+
+namespace
+{
+    // Long enough for any sane frame, short enough that a lost context doesn't hang the app
+    static constexpr GLuint64 kFenceTimeoutNs = 100'000'000;
+
+    static GLenum ToGLFormat ( const SurfaceChannelOrder & order )
+    {
+        switch ( order.getCode ( ) )
+        {
+            case SurfaceChannelOrder::BGRA:
+            case SurfaceChannelOrder::BGRX: return GL_BGRA;
+            case SurfaceChannelOrder::RGBA:
+            case SurfaceChannelOrder::RGBX: return GL_RGBA;
+            case SurfaceChannelOrder::BGR:  return GL_BGR;
+            case SurfaceChannelOrder::RGB:  return GL_RGB;
+            default:                        return 0;
+        }
+    }
+
+    static bool SupportsBufferStorage ( )
+    {
+        auto version = gl::getVersion ( );
+        return version.first > 4 || ( version.first == 4 && version.second >= 4 ) || gl::isExtensionAvailable ( "GL_ARB_buffer_storage" );
+    }
+}
+
+namespace AX::Video
+{
+    StreamingTextureRef StreamingTexture::Create ( const Options & options )
+    {
+        return StreamingTextureRef ( new StreamingTexture ( options ) );
+    }
+
+    StreamingTexture::StreamingTexture ( const Options & options )
+        : _options ( options )
+    { }
+
+    bool StreamingTexture::Allocate ( const ivec2 & size, GLenum format, size_t pixelInc )
+    {
+        Release ( );
+
+        _size = size;
+        _format = format;
+        _pixelInc = pixelInc;
+        _bufferSize = static_cast<size_t> ( size.x ) * size.y * pixelInc;
+        _stats.persistent = _options.IsPersistent ( ) && SupportsBufferStorage ( );
+        _stats.reallocations++;
+
+        auto fmt = gl::Texture::Format ( ).internalFormat ( pixelInc == 4 ? GL_RGBA8 : GL_RGB8 ).loadTopDown ( );
+        _texture = gl::Texture::create ( size.x, size.y, fmt );
+        _texture->setTopDown ( true );
+
+        _buffers.resize ( std::max<size_t> ( 2, _options.GetRingSize ( ) ) );
+        for ( auto & buffer : _buffers )
+        {
+            glGenBuffers ( 1, &buffer.id );
+            gl::ScopedBuffer scopedBuffer ( GL_PIXEL_UNPACK_BUFFER, buffer.id );
+
+            if ( _stats.persistent )
+            {
+                const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+                glBufferStorage ( GL_PIXEL_UNPACK_BUFFER, _bufferSize, nullptr, flags );
+                buffer.mapped = static_cast<uint8_t *> ( glMapBufferRange ( GL_PIXEL_UNPACK_BUFFER, 0, _bufferSize, flags ) );
+
+                if ( !buffer.mapped )
+                {
+                    CI_LOG_W ( "Persistent mapping failed, falling back to mapping per frame" );
+                    _options.Persistent ( false );
+                    return Allocate ( size, format, pixelInc );
+                }
+            }
+            else
+            {
+                glBufferData ( GL_PIXEL_UNPACK_BUFFER, _bufferSize, nullptr, GL_STREAM_DRAW );
+            }
+        }
+
+        _head = 0;
+        return true;
+    }
+
+    void StreamingTexture::Release ( )
+    {
+        for ( auto & buffer : _buffers )
+        {
+            if ( buffer.fence ) glDeleteSync ( buffer.fence );
+            if ( buffer.mapped )
+            {
+                gl::ScopedBuffer scopedBuffer ( GL_PIXEL_UNPACK_BUFFER, buffer.id );
+                glUnmapBuffer ( GL_PIXEL_UNPACK_BUFFER );
+            }
+
+            glDeleteBuffers ( 1, &buffer.id );
+        }
+
+        _buffers.clear ( );
+        _texture = nullptr;
+    }
+
+    const gl::TextureRef & StreamingTexture::Upload ( const Surface8u & surface )
+    {
+        const GLenum format = ToGLFormat ( surface.getChannelOrder ( ) );
+        const size_t pixelInc = surface.getPixelInc ( );
+
+        if ( format == 0 )
+        {
+            // Nothing GL can unpack directly, let cinder convert it
+            _texture = gl::Texture::create ( surface, gl::Texture::Format ( ).loadTopDown ( ) );
+            return _texture;
+        }
+
+        if ( !_texture || surface.getSize ( ) != _size || format != _format || pixelInc != _pixelInc )
+        {
+            Allocate ( surface.getSize ( ), format, pixelInc );
+        }
+
+        auto & buffer = _buffers[_head];
+        _head = ( _head + 1 ) % _buffers.size ( );
+
+        // With a ring of three the GPU has had two frames to finish with this one,
+        // so waiting here is rare and means the upload itself is the bottleneck.
+        if ( buffer.fence )
+        {
+            if ( glClientWaitSync ( buffer.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0 ) == GL_TIMEOUT_EXPIRED )
+            {
+                _stats.fenceWaits++;
+                glClientWaitSync ( buffer.fence, GL_SYNC_FLUSH_COMMANDS_BIT, kFenceTimeoutNs );
+            }
+
+            glDeleteSync ( buffer.fence );
+            buffer.fence = nullptr;
+        }
+
+        gl::ScopedBuffer scopedBuffer ( GL_PIXEL_UNPACK_BUFFER, buffer.id );
+
+        uint8_t * dst = buffer.mapped;
+        if ( !dst )
+        {
+            // Already fenced, so there's no need for the driver to synchronize the map
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+            dst = static_cast<uint8_t *> ( glMapBufferRange ( GL_PIXEL_UNPACK_BUFFER, 0, _bufferSize, flags ) );
+            if ( !dst ) return _texture;
+        }
+
+        const size_t rowBytes = static_cast<size_t> ( _size.x ) * pixelInc;
+        if ( surface.getRowBytes ( ) == rowBytes )
+        {
+            std::memcpy ( dst, surface.getData ( ), _bufferSize );
+        }
+        else
+        {
+            for ( int y = 0; y < _size.y; y++ )
+            {
+                std::memcpy ( dst + y * rowBytes, surface.getData ( ivec2 ( 0, y ) ), rowBytes );
+            }
+        }
+
+        if ( !buffer.mapped ) glUnmapBuffer ( GL_PIXEL_UNPACK_BUFFER );
+
+        {
+            gl::ScopedTextureBind scopedTexture ( _texture );
+            glPixelStorei ( GL_UNPACK_ALIGNMENT, 1 );
+            glTexSubImage2D ( GL_TEXTURE_2D, 0, 0, 0, _size.x, _size.y, format, GL_UNSIGNED_BYTE, nullptr );
+            glPixelStorei ( GL_UNPACK_ALIGNMENT, 4 );
+        }
+
+        buffer.fence = glFenceSync ( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+
+        _stats.uploads++;
+        _stats.bytes += _bufferSize;
+        return _texture;
+    }
+
+    StreamingTexture::~StreamingTexture ( )
+    {
+        Release ( );
+    }
+}
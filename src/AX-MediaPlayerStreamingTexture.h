@@ -0,0 +1,91 @@
+//
+//  AX-MediaPlayerStreamingTexture.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include "cinder/Surface.h"
+#include "cinder/gl/Texture.h"
+
+#include <vector>
+
+namespace AX::Video
+{
+    using StreamingTextureRef = std::unique_ptr<class StreamingTexture>;
+
+    // One texture that CPU frames are streamed into for the lifetime of a
+    // player, instead of a gl::Texture::create ( ) and a synchronous upload per frame.
+    // Frames are copied into a ring of pixel unpack buffers and the texture is updated from
+    // the buffer, so the copy to the GPU overlaps with rendering. Each buffer is fenced and
+    // only rewritten once the GPU has finished with it. With GL 4.4 / ARB_buffer_storage the
+    // buffers stay persistently mapped, otherwise they're mapped unsynchronized per frame
+    // (i.e macOS' 4.1 core profile). Needs a current GL context, nothing vendor specific.
+    class StreamingTexture
+    {
+    public:
+
+        struct Options
+        {
+            Options & RingSize ( size_t buffers ) { _ringSize = buffers; return *this; }
+            Options & Persistent ( bool persistent ) { _persistent = persistent; return *this; }
+
+            size_t  GetRingSize ( ) const { return _ringSize; }
+            bool    IsPersistent ( ) const { return _persistent; }
+
+            Options ( ) { };
+
+        protected:
+
+            size_t  _ringSize{ 3 };
+            bool    _persistent{ true };    // Used when the context supports it
+        };
+
+        struct Stats
+        {
+            uint64_t    uploads{ 0 };
+            uint64_t    bytes{ 0 };
+            uint64_t    fenceWaits{ 0 };    // Uploads that found their buffer still in use by the GPU
+            uint64_t    reallocations{ 0 };
+            bool        persistent{ false };
+        };
+
+        static StreamingTextureRef Create ( const Options & options = Options ( ) );
+
+        ~StreamingTexture ( );
+
+        // Copies `surface` into the next buffer and updates the texture from it
+        const ci::gl::TextureRef & Upload ( const ci::Surface8u & surface );
+
+        inline const ci::gl::TextureRef & GetTexture ( ) const { return _texture; }
+        inline const Stats & GetStats ( ) const { return _stats; }
+
+    protected:
+
+        struct Buffer
+        {
+            GLuint      id{ 0 };
+            uint8_t *   mapped{ nullptr };
+            GLsync      fence{ nullptr };
+        };
+
+        StreamingTexture ( const Options & options );
+
+        bool        Allocate ( const ci::ivec2 & size, GLenum format, size_t pixelInc );
+        void        Release ( );
+
+        Options             _options;
+        Stats               _stats;
+        ci::gl::TextureRef  _texture;
+        std::vector<Buffer> _buffers;
+        size_t              _head{ 0 };
+
+        ci::ivec2           _size{ 0 };
+        GLenum              _format{ 0 };
+        size_t              _pixelInc{ 0 };
+        size_t              _bufferSize{ 0 };
+    };
+}
@@ -0,0 +1,40 @@
+//
+//  AX-MediaPlayerVideoDecoder.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include <memory>
+#include <cstdint>
+#include <filesystem>
+
+namespace AX::Video
+{
+    // Pulls every decoded video frame out of a file, in order, as fast as the
+    // platform decoder can go. No clock, no frames dropped, nothing rendered. Frames come out
+    // as 32 bit BGRA (alpha undefined, treat as opaque). Single threaded like AudioDecoder.
+    class VideoDecoder
+    {
+    public:
+
+        // Implemented per platform, nullptr if the file has no decodable video
+        static std::unique_ptr<VideoDecoder> Create ( const std::filesystem::path & path );
+
+        virtual ~VideoDecoder ( ) { };
+
+        virtual int32_t GetWidth ( ) const = 0;
+        virtual int32_t GetHeight ( ) const = 0;
+        virtual double  GetFrameRate ( ) const = 0;
+        virtual double  GetDurationInSeconds ( ) const = 0;
+
+        // Lands on or before the requested time, use the timestamps Decode ( ) reports
+        virtual bool    Seek ( double seconds ) = 0;
+
+        // Writes the next frame into `dst` (GetHeight ( ) rows of `rowBytes`), false at the end of the stream
+        virtual bool    Decode ( uint8_t * dst, size_t rowBytes, double & pts ) = 0;
+    };
+}
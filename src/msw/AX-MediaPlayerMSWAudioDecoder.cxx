@@ -0,0 +1,137 @@
+//
+//  AX-MediaPlayerMSWAudioDecoder.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerAudioDecoder.h"
+#include "AX-MediaPlayerMSWImpl.h"
+
+#include <mfapi.h>
+#include <mfreadwrite.h>
+#include <propvarutil.h>
+
+#pragma comment(lib, "mfreadwrite.lib")
+#pragma comment(lib, "propsys.lib")
+
+namespace AX::Video
+{
+    namespace
+    {
+        class MSWAudioDecoder : public AudioDecoder
+        {
+        public:
+
+            MSWAudioDecoder ( )
+            {
+                // Peaks are usually computed on worker threads with no player
+                // alive, so each decoder holds its own COM apartment and MF reference. Both
+                // are reference counted by the OS and pair up in the destructor.
+                _comInitialized = SUCCEEDED ( CoInitializeEx ( nullptr, COINIT_MULTITHREADED ) );
+                _mfInitialized = SUCCEEDED ( MFStartup ( MF_VERSION, MFSTARTUP_LITE ) );
+            }
+
+            ~MSWAudioDecoder ( )
+            {
+                _reader = nullptr;
+                if ( _mfInitialized ) MFShutdown ( );
+                if ( _comInitialized ) CoUninitialize ( );
+            }
+
+            bool Open ( const std::filesystem::path & path )
+            {
+                if ( !_mfInitialized ) return false;
+
+                if ( FAILED ( MFCreateSourceReaderFromURL ( path.wstring ( ).c_str ( ), nullptr, _reader.GetAddressOf ( ) ) ) ) return false;
+
+                const DWORD stream = static_cast<DWORD> ( MF_SOURCE_READER_FIRST_AUDIO_STREAM );
+                _reader->SetStreamSelection ( static_cast<DWORD> ( MF_SOURCE_READER_ALL_STREAMS ), FALSE );
+                if ( FAILED ( _reader->SetStreamSelection ( stream, TRUE ) ) ) return false;
+
+                ComPtr<IMFMediaType> type;
+                MFCreateMediaType ( type.GetAddressOf ( ) );
+                type->SetGUID ( MF_MT_MAJOR_TYPE, MFMediaType_Audio );
+                type->SetGUID ( MF_MT_SUBTYPE, MFAudioFormat_Float );
+                if ( FAILED ( _reader->SetCurrentMediaType ( stream, nullptr, type.Get ( ) ) ) ) return false;
+
+                ComPtr<IMFMediaType> current;
+                if ( FAILED ( _reader->GetCurrentMediaType ( stream, current.GetAddressOf ( ) ) ) ) return false;
+
+                _channels = MFGetAttributeUINT32 ( current.Get ( ), MF_MT_AUDIO_NUM_CHANNELS, 0 );
+                _sampleRate = MFGetAttributeUINT32 ( current.Get ( ), MF_MT_AUDIO_SAMPLES_PER_SECOND, 0 );
+
+                PROPVARIANT duration;
+                PropVariantInit ( &duration );
+                if ( SUCCEEDED ( _reader->GetPresentationAttribute ( static_cast<DWORD> ( MF_SOURCE_READER_MEDIASOURCE ), MF_PD_DURATION, &duration ) ) )
+                {
+                    _duration = duration.uhVal.QuadPart / 10000000.0;
+                }
+                PropVariantClear ( &duration );
+
+                return _channels > 0 && _sampleRate > 0.0 && _duration > 0.0;
+            }
+
+            size_t GetChannels ( ) const override { return _channels; }
+            double GetSampleRate ( ) const override { return _sampleRate; }
+            double GetDurationInSeconds ( ) const override { return _duration; }
+
+            bool Seek ( double seconds ) override
+            {
+                PROPVARIANT position;
+                InitPropVariantFromInt64 ( static_cast<LONGLONG> ( seconds * 10000000.0 ), &position );
+                HRESULT hr = _reader->SetCurrentPosition ( GUID_NULL, position );
+                PropVariantClear ( &position );
+
+                return SUCCEEDED ( hr );
+            }
+
+            bool Decode ( std::vector<float> & interleaved, double & startSeconds ) override
+            {
+                const DWORD stream = static_cast<DWORD> ( MF_SOURCE_READER_FIRST_AUDIO_STREAM );
+
+                while ( true )
+                {
+                    DWORD flags = 0;
+                    LONGLONG timestamp = 0;
+                    ComPtr<IMFSample> sample;
+                    if ( FAILED ( _reader->ReadSample ( stream, 0, nullptr, &flags, &timestamp, sample.GetAddressOf ( ) ) ) ) return false;
+                    if ( flags & MF_SOURCE_READERF_ENDOFSTREAM ) return false;
+                    if ( !sample ) continue;
+
+                    ComPtr<IMFMediaBuffer> buffer;
+                    if ( FAILED ( sample->ConvertToContiguousBuffer ( buffer.GetAddressOf ( ) ) ) ) return false;
+
+                    BYTE * data = nullptr;
+                    DWORD length = 0;
+                    if ( FAILED ( buffer->Lock ( &data, nullptr, &length ) ) ) return false;
+
+                    const float * samples = reinterpret_cast<const float *> ( data );
+                    interleaved.assign ( samples, samples + ( length / ( sizeof ( float ) * _channels ) ) * _channels );
+                    buffer->Unlock ( );
+
+                    startSeconds = timestamp / 10000000.0;
+                    return true;
+                }
+            }
+
+        protected:
+
+            ComPtr<IMFSourceReader>     _reader;
+            bool                        _comInitialized{ false };
+            bool                        _mfInitialized{ false };
+            size_t                      _channels{ 0 };
+            double                      _sampleRate{ 0.0 };
+            double                      _duration{ 0.0 };
+        };
+    }
+
+    std::unique_ptr<AudioDecoder> AudioDecoder::Create ( const std::filesystem::path & path )
+    {
+        auto decoder = std::make_unique<MSWAudioDecoder> ( );
+        if ( !decoder->Open ( path ) ) return nullptr;
+
+        return decoder;
+    }
+}
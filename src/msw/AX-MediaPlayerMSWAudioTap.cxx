@@ -0,0 +1,313 @@
+//
+//  AX-MediaPlayerMSWAudioTap.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerMSWAudioTap.h"
+#include "AX-MediaPlayerMSWByteStream.h"
+
+#include "cinder/Log.h"
+
+#include <mfapi.h>
+#include <mferror.h>
+#include <propvarutil.h>
+#include <algorithm>
+#include <cmath>
+
+#pragma comment(lib, "propsys.lib")
+
+namespace AX::Video
+{
+    AudioTap::AudioTap ( const MediaPlayer::AudioNodeRef & node, const ci::DataSourceRef & source, const ByteSourceRef & byteSource )
+        : _node ( node )
+        , _source ( source )
+        , _byteSource ( byteSource )
+    {
+        _thread = std::thread ( [=] { Run ( ); } );
+    }
+
+    void AudioTap::Seek ( float seconds )
+    {
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            _pendingSeek = std::max ( 0.0, static_cast<double> ( seconds ) );
+        }
+
+        _wake.notify_all ( );
+    }
+
+    void AudioTap::Sync ( float engineSeconds, bool playing, float rate )
+    {
+        _node->SetActive ( playing );
+        _node->SetPlaybackRate ( rate );
+
+        if ( !playing || _sampleRate <= 0.0 ) return;
+
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            if ( _pendingSeek >= 0.0 ) return;
+        }
+
+        auto now = std::chrono::steady_clock::now ( );
+        if ( std::abs ( GetDrift ( engineSeconds ) ) > kResyncThresholdSeconds && now - _lastResync > std::chrono::milliseconds ( 500 ) )
+        {
+            _lastResync = now;
+            Seek ( engineSeconds );
+        }
+    }
+
+    void AudioTap::Follow ( float engineSeconds )
+    {
+        if ( _sampleRate > 0.0 && std::abs ( GetDrift ( engineSeconds ) ) <= kResyncThresholdSeconds ) return;
+        Seek ( engineSeconds );
+    }
+
+    void AudioTap::SetLoop ( double in, double out )
+    {
+        std::unique_lock<std::mutex> lk ( _mutex );
+        _loopIn = in;
+        _loopOut = out > in ? out : 0.0;
+    }
+
+    double AudioTap::GetDrift ( double engineSeconds )
+    {
+        // What's coming out of the node right now, minus whatever is still queued in the ring
+        double drift = _decodedUntil.load ( ) - _node->GetBufferedFrames ( ) / _sampleRate - engineSeconds;
+
+        // Across a wrap one of them is still before the out point and the other past the in point
+        std::unique_lock<std::mutex> lk ( _mutex );
+        if ( _loopOut > _loopIn ) drift = std::remainder ( drift, _loopOut - _loopIn );
+        return drift;
+    }
+
+    void AudioTap::Run ( )
+    {
+        CoInitializeEx ( nullptr, COINIT_MULTITHREADED );
+
+        if ( Open ( ) )
+        {
+            Decode ( );
+        }
+
+        _reader = nullptr;
+        CoUninitialize ( );
+    }
+
+    bool AudioTap::Open ( )
+    {
+        ComPtr<IMFAttributes> attributes;
+        MFCreateAttributes ( attributes.GetAddressOf ( ), 1 );
+
+        HRESULT hr = E_FAIL;
+        if ( _byteSource )
+        {
+            auto stream = ByteSourceStream::Create ( _byteSource );
+            hr = MFCreateSourceReaderFromByteStream ( stream.Get ( ), attributes.Get ( ), _reader.GetAddressOf ( ) );
+        }
+        else if ( _source )
+        {
+            std::wstring path;
+            if ( _source->isUrl ( ) )
+            {
+                auto str = _source->getUrl ( ).str ( );
+                path = { str.begin ( ), str.end ( ) };
+            }
+            else
+            {
+                path = _source->getFilePath ( ).wstring ( );
+            }
+
+            hr = MFCreateSourceReaderFromURL ( path.c_str ( ), attributes.Get ( ), _reader.GetAddressOf ( ) );
+        }
+
+        if ( FAILED ( hr ) )
+        {
+            CI_LOG_E ( "Unable to create audio tap reader" );
+            return false;
+        }
+
+        const DWORD stream = static_cast<DWORD> ( MF_SOURCE_READER_FIRST_AUDIO_STREAM );
+        _reader->SetStreamSelection ( static_cast<DWORD> ( MF_SOURCE_READER_ALL_STREAMS ), FALSE );
+        if ( FAILED ( _reader->SetStreamSelection ( stream, TRUE ) ) ) return false;
+
+        ComPtr<IMFMediaType> native;
+        if ( FAILED ( _reader->GetNativeMediaType ( stream, 0, native.GetAddressOf ( ) ) ) ) return false;
+
+        UINT32 sampleRate = MFGetAttributeUINT32 ( native.Get ( ), MF_MT_AUDIO_SAMPLES_PER_SECOND, 48000 );
+        UINT32 channels = static_cast<UINT32> ( _node->getNumChannels ( ) );
+
+        // Ask the reader to do the up/down mix to the node's layout, but keep the
+        // native rate since the node resamples anyway and this avoids doing it twice.
+        auto setFormat = [&] ( UINT32 channelCount )
+        {
+            ComPtr<IMFMediaType> type;
+            MFCreateMediaType ( type.GetAddressOf ( ) );
+            type->SetGUID ( MF_MT_MAJOR_TYPE, MFMediaType_Audio );
+            type->SetGUID ( MF_MT_SUBTYPE, MFAudioFormat_Float );
+            type->SetUINT32 ( MF_MT_AUDIO_SAMPLES_PER_SECOND, sampleRate );
+            type->SetUINT32 ( MF_MT_AUDIO_BITS_PER_SAMPLE, 32 );
+            if ( channelCount > 0 )
+            {
+                type->SetUINT32 ( MF_MT_AUDIO_NUM_CHANNELS, channelCount );
+                type->SetUINT32 ( MF_MT_AUDIO_BLOCK_ALIGNMENT, channelCount * 4 );
+                type->SetUINT32 ( MF_MT_AUDIO_AVG_BYTES_PER_SECOND, channelCount * 4 * sampleRate );
+            }
+
+            return SUCCEEDED ( _reader->SetCurrentMediaType ( stream, nullptr, type.Get ( ) ) );
+        };
+
+        if ( !setFormat ( channels ) && !setFormat ( 0 ) )
+        {
+            CI_LOG_E ( "Audio tap can't decode to float PCM" );
+            return false;
+        }
+
+        ComPtr<IMFMediaType> current;
+        if ( FAILED ( _reader->GetCurrentMediaType ( stream, current.GetAddressOf ( ) ) ) ) return false;
+
+        _channels = MFGetAttributeUINT32 ( current.Get ( ), MF_MT_AUDIO_NUM_CHANNELS, channels );
+        _sampleRate = MFGetAttributeUINT32 ( current.Get ( ), MF_MT_AUDIO_SAMPLES_PER_SECOND, sampleRate );
+        _node->SetSourceFormat ( _channels, _sampleRate );
+
+        return true;
+    }
+
+    void AudioTap::ApplySeek ( double seconds )
+    {
+        Reposition ( seconds );
+        _node->Flush ( );
+    }
+
+    void AudioTap::Reposition ( double seconds )
+    {
+        PROPVARIANT position;
+        InitPropVariantFromInt64 ( static_cast<LONGLONG> ( seconds * 10000000.0 ), &position );
+        _reader->SetCurrentPosition ( GUID_NULL, position );
+        PropVariantClear ( &position );
+
+        // The reader lands on the packet before the target, trim up to the exact time
+        _discardBefore = seconds;
+        _decodedUntil.store ( seconds );
+        _ended = false;
+    }
+
+    void AudioTap::Decode ( )
+    {
+        const DWORD stream = static_cast<DWORD> ( MF_SOURCE_READER_FIRST_AUDIO_STREAM );
+
+        while ( true )
+        {
+            {
+                std::unique_lock<std::mutex> lk ( _mutex );
+                _wake.wait ( lk, [&] { return !_running || _pendingSeek >= 0.0 || !_ended; } );
+                if ( !_running ) return;
+
+                if ( _pendingSeek >= 0.0 )
+                {
+                    double target = _pendingSeek;
+                    _pendingSeek = -1.0;
+                    lk.unlock ( );
+
+                    ApplySeek ( target );
+                }
+            }
+
+            DWORD flags = 0;
+            LONGLONG timestamp = 0;
+            ComPtr<IMFSample> sample;
+            double loopIn = 0.0, loopOut = 0.0;
+            {
+                std::unique_lock<std::mutex> lk ( _mutex );
+                loopIn = _loopIn;
+                loopOut = _loopOut;
+            }
+
+            HRESULT hr = _reader->ReadSample ( stream, 0, nullptr, &flags, &timestamp, sample.GetAddressOf ( ) );
+            if ( FAILED ( hr ) || ( flags & MF_SOURCE_READERF_ENDOFSTREAM ) )
+            {
+                // Loop out point at (or past) the end of the clip
+                if ( SUCCEEDED ( hr ) && loopOut > loopIn )
+                {
+                    Reposition ( loopIn );
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lk ( _mutex );
+                _ended = true;
+                continue;
+            }
+
+            if ( !sample ) continue;
+
+            ComPtr<IMFMediaBuffer> buffer;
+            if ( FAILED ( sample->ConvertToContiguousBuffer ( buffer.GetAddressOf ( ) ) ) ) continue;
+
+            BYTE * data = nullptr;
+            DWORD length = 0;
+            if ( FAILED ( buffer->Lock ( &data, nullptr, &length ) ) ) continue;
+
+            const float * frames = reinterpret_cast<const float *> ( data );
+            size_t count = length / ( sizeof ( float ) * _channels );
+            double start = timestamp / 10000000.0;
+
+            if ( _discardBefore > start )
+            {
+                size_t skip = std::min ( count, static_cast<size_t> ( ( _discardBefore - start ) * _sampleRate ) );
+                frames += skip * _channels;
+                count -= skip;
+                start += skip / _sampleRate;
+            }
+            _discardBefore = -1.0;
+
+            // Only up to the out point, the rest of the ring is filled from the in point
+            bool wrap = false;
+            if ( loopOut > loopIn && start + count / _sampleRate >= loopOut )
+            {
+                count = start < loopOut ? std::min ( count, static_cast<size_t> ( ( loopOut - start ) * _sampleRate ) ) : 0;
+                wrap = true;
+            }
+
+            size_t pushed = 0;
+            while ( pushed < count )
+            {
+                pushed += _node->Push ( frames + pushed * _channels, count - pushed );
+                _decodedUntil.store ( start + pushed / _sampleRate );
+
+                if ( pushed < count )
+                {
+                    // Ring is full (or waiting on a flush), which is what paces decoding to playback.
+                    // Nothing is dropped by waiting, so it isn't counted as an overflow.
+                    std::unique_lock<std::mutex> lk ( _mutex );
+                    _wake.wait_for ( lk, std::chrono::milliseconds ( 5 ) );
+                    if ( !_running || _pendingSeek >= 0.0 ) break;
+                }
+            }
+
+            buffer->Unlock ( );
+
+            if ( wrap && pushed == count )
+            {
+                std::unique_lock<std::mutex> lk ( _mutex );
+                if ( _pendingSeek < 0.0 && _running )
+                {
+                    lk.unlock ( );
+                    Reposition ( loopIn );
+                }
+            }
+        }
+    }
+
+    AudioTap::~AudioTap ( )
+    {
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            _running = false;
+        }
+
+        _wake.notify_all ( );
+        if ( _thread.joinable ( ) ) _thread.join ( );
+    }
+}
@@ -0,0 +1,75 @@
+//
+//  AX-MediaPlayerMSWAudioTap.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include "AX-MediaPlayerMSWImpl.h"
+#include "AX-MediaPlayerAudioNode.h"
+
+#include <mfreadwrite.h>
+#include <chrono>
+#include <thread>
+#include <condition_variable>
+
+#pragma comment(lib, "mfreadwrite.lib")
+
+namespace AX::Video
+{
+    // The media engine has no way to hand out decoded audio, so when a
+    // player is tapped the engine is force muted and the audio track is decoded by a
+    // second, audio only source reader on its own thread. It's throttled by the node's
+    // ring so it only ever runs a ring's worth ahead, and resyncs to the engine's clock
+    // whenever they drift apart (seeks, loops, rate changes). Loops the player makes itself
+    // are wrapped here too, straight from the out point to the in point with no gap.
+    class AudioTap
+    {
+    public:
+
+        AudioTap ( const MediaPlayer::AudioNodeRef & node, const ci::DataSourceRef & source, const ByteSourceRef & byteSource );
+        ~AudioTap ( );
+
+        void    Seek ( float seconds );
+        void    Sync ( float engineSeconds, bool playing, float rate );
+
+        // Seeks unless the audio is already there, i.e after a wrap the tap has made itself
+        void    Follow ( float engineSeconds );
+
+        // Decoding goes back to `in` on reaching `out`, both zero for never
+        void    SetLoop ( double in, double out );
+
+    protected:
+
+        void    Run ( );
+        bool    Open ( );
+        void    Decode ( );
+        void    ApplySeek ( double seconds );
+        void    Reposition ( double seconds );
+        double  GetDrift ( double engineSeconds );
+
+        static constexpr double kResyncThresholdSeconds = 0.12;
+
+        MediaPlayer::AudioNodeRef   _node;
+        ci::DataSourceRef           _source;
+        ByteSourceRef               _byteSource;
+        ComPtr<IMFSourceReader>     _reader;
+        size_t                      _channels{ 0 };
+        std::atomic<double>         _sampleRate{ 0.0 };
+        double                      _discardBefore{ -1.0 };
+
+        std::thread                 _thread;
+        std::mutex                  _mutex;
+        std::condition_variable     _wake;
+        bool                        _running{ true };
+        double                      _pendingSeek{ -1.0 };
+        double                      _loopIn{ 0.0 };
+        double                      _loopOut{ 0.0 };
+        bool                        _ended{ false };
+        std::atomic<double>         _decodedUntil{ 0.0 };
+        std::chrono::steady_clock::time_point _lastResync;
+    };
+}
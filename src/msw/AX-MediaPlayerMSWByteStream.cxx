@@ -0,0 +1,228 @@
+//
+//  AX-MediaPlayerMSWByteStream.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerMSWByteStream.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Carries the result of a BeginRead ( ) through to EndRead ( )
+    class ReadOperation : public IUnknown
+    {
+    public:
+
+        HRESULT STDMETHODCALLTYPE QueryInterface ( REFIID riid, LPVOID * ppvObj ) override
+        {
+            if ( !ppvObj ) return E_INVALIDARG;
+
+            *ppvObj = nullptr;
+            if ( riid == IID_IUnknown )
+            {
+                *ppvObj = static_cast<IUnknown *> ( this );
+                AddRef ( );
+                return S_OK;
+            }
+            return E_NOINTERFACE;
+        }
+
+        ULONG STDMETHODCALLTYPE AddRef ( ) override
+        {
+            return InterlockedIncrement ( &_refCount );
+        }
+
+        ULONG STDMETHODCALLTYPE Release ( ) override
+        {
+            ULONG count = InterlockedDecrement ( &_refCount );
+            if ( count == 0 )
+            {
+                delete this;
+            }
+            return count;
+        }
+
+        ULONG _bytesRead{ 0 };
+
+    protected:
+
+        ULONG _refCount{ 0 };
+    };
+}
+
+namespace AX::Video
+{
+    ComPtr<IMFByteStream> ByteSourceStream::Create ( const ByteSourceRef & source )
+    {
+        if ( !source ) return nullptr;
+        return ComPtr<IMFByteStream> ( new ByteSourceStream ( source ) );
+    }
+
+    ByteSourceStream::ByteSourceStream ( const ByteSourceRef & source )
+        : _source ( source )
+    { }
+
+    HRESULT ByteSourceStream::GetCapabilities ( DWORD * capabilities )
+    {
+        if ( !capabilities ) return E_POINTER;
+        *capabilities = MFBYTESTREAM_IS_READABLE | MFBYTESTREAM_IS_SEEKABLE;
+        return S_OK;
+    }
+
+    HRESULT ByteSourceStream::GetLength ( QWORD * length )
+    {
+        if ( !length ) return E_POINTER;
+        *length = _source->Size ( );
+        return S_OK;
+    }
+
+    HRESULT ByteSourceStream::SetLength ( QWORD length )
+    {
+        return E_NOTIMPL;
+    }
+
+    HRESULT ByteSourceStream::GetCurrentPosition ( QWORD * position )
+    {
+        if ( !position ) return E_POINTER;
+        *position = _position.load ( );
+        return S_OK;
+    }
+
+    HRESULT ByteSourceStream::SetCurrentPosition ( QWORD position )
+    {
+        if ( position > _source->Size ( ) ) return E_INVALIDARG;
+        _position.store ( position );
+        return S_OK;
+    }
+
+    HRESULT ByteSourceStream::IsEndOfStream ( BOOL * endOfStream )
+    {
+        if ( !endOfStream ) return E_POINTER;
+        *endOfStream = _position.load ( ) >= _source->Size ( );
+        return S_OK;
+    }
+
+    HRESULT ByteSourceStream::Read ( BYTE * buffer, ULONG length, ULONG * bytesRead )
+    {
+        if ( !buffer || !bytesRead ) return E_POINTER;
+
+        QWORD position = _position.load ( );
+        *bytesRead = static_cast<ULONG> ( _source->Read ( position, buffer, length ) );
+        _position.store ( position + *bytesRead );
+
+        return S_OK;
+    }
+
+    HRESULT ByteSourceStream::BeginRead ( BYTE * buffer, ULONG length, IMFAsyncCallback * callback, IUnknown * state )
+    {
+        if ( !buffer || !callback ) return E_POINTER;
+
+        ComPtr<ReadOperation> operation{ new ReadOperation ( ) };
+        ComPtr<IMFAsyncResult> result;
+
+        HRESULT hr = MFCreateAsyncResult ( operation.Get ( ), callback, state, result.GetAddressOf ( ) );
+        if ( FAILED ( hr ) ) return hr;
+
+        // Advance the position up front so back to back BeginRead ( )
+        // calls without a Seek ( ) in between continue on from each other
+        QWORD position = _position.load ( );
+        QWORD size = _source->Size ( );
+        _position.store ( std::min<QWORD> ( position + length, size ) );
+
+        // A read can block on the network for as long as the source's timeout, so it goes on
+        // the I/O pool (also in the MTA) and never ties up a worker the players need
+        ByteSourceRef source = _source;
+        Executor::Io ( ).Submit ( Executor::Priority::Decode, [=]
+        {
+            operation->_bytesRead = static_cast<ULONG> ( source->Read ( position, buffer, length ) );
+            result->SetStatus ( S_OK );
+            MFInvokeCallback ( result.Get ( ) );
+        } );
+
+        return S_OK;
+    }
+
+    HRESULT ByteSourceStream::EndRead ( IMFAsyncResult * result, ULONG * bytesRead )
+    {
+        if ( !result || !bytesRead ) return E_POINTER;
+
+        ComPtr<IUnknown> object;
+        HRESULT hr = result->GetObject ( object.GetAddressOf ( ) );
+        if ( FAILED ( hr ) ) return hr;
+
+        *bytesRead = static_cast<ReadOperation *> ( object.Get ( ) )->_bytesRead;
+        return result->GetStatus ( );
+    }
+
+    HRESULT ByteSourceStream::Write ( const BYTE * buffer, ULONG length, ULONG * bytesWritten )
+    {
+        return E_NOTIMPL;
+    }
+
+    HRESULT ByteSourceStream::BeginWrite ( const BYTE * buffer, ULONG length, IMFAsyncCallback * callback, IUnknown * state )
+    {
+        return E_NOTIMPL;
+    }
+
+    HRESULT ByteSourceStream::EndWrite ( IMFAsyncResult * result, ULONG * bytesWritten )
+    {
+        return E_NOTIMPL;
+    }
+
+    HRESULT ByteSourceStream::Seek ( MFBYTESTREAM_SEEK_ORIGIN origin, LONGLONG offset, DWORD flags, QWORD * position )
+    {
+        LONGLONG base = origin == msoCurrent ? static_cast<LONGLONG> ( _position.load ( ) ) : 0;
+        LONGLONG target = base + offset;
+
+        if ( target < 0 || static_cast<QWORD> ( target ) > _source->Size ( ) ) return E_INVALIDARG;
+
+        _position.store ( static_cast<QWORD> ( target ) );
+        if ( position ) *position = static_cast<QWORD> ( target );
+
+        return S_OK;
+    }
+
+    HRESULT ByteSourceStream::Flush ( )
+    {
+        return S_OK;
+    }
+
+    HRESULT ByteSourceStream::Close ( )
+    {
+        return S_OK;
+    }
+
+    HRESULT ByteSourceStream::QueryInterface ( REFIID riid, LPVOID * ppvObj )
+    {
+        if ( !ppvObj ) return E_INVALIDARG;
+
+        *ppvObj = nullptr;
+        if ( riid == __uuidof( IMFByteStream ) || riid == IID_IUnknown )
+        {
+            *ppvObj = static_cast<IMFByteStream *> ( this );
+            AddRef ( );
+            return S_OK;
+        }
+
+        return E_NOINTERFACE;
+    }
+
+    ULONG ByteSourceStream::AddRef ( )
+    {
+        return InterlockedIncrement ( &_refCount );
+    }
+
+    ULONG ByteSourceStream::Release ( )
+    {
+        ULONG count = InterlockedDecrement ( &_refCount );
+        if ( count == 0 )
+        {
+            delete this;
+        }
+        return count;
+    }
+}
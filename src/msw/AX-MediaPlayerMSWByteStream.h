@@ -0,0 +1,55 @@
+//
+//  AX-MediaPlayerMSWByteStream.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include "AX-MediaPlayerMSWImpl.h"
+#include "AX-MediaPlayerByteSource.h"
+
+#include <atomic>
+
+namespace AX::Video
+{
+    // Adapts a ByteSource to an IMFByteStream so the media engine
+    // can pull from it via IMFMediaEngineEx::SetSourceFromByteStream ( ... )
+    class ByteSourceStream : public IMFByteStream
+    {
+    public:
+
+        static ComPtr<IMFByteStream> Create ( const ByteSourceRef & source );
+
+        HRESULT STDMETHODCALLTYPE GetCapabilities ( DWORD * capabilities ) override;
+        HRESULT STDMETHODCALLTYPE GetLength ( QWORD * length ) override;
+        HRESULT STDMETHODCALLTYPE SetLength ( QWORD length ) override;
+        HRESULT STDMETHODCALLTYPE GetCurrentPosition ( QWORD * position ) override;
+        HRESULT STDMETHODCALLTYPE SetCurrentPosition ( QWORD position ) override;
+        HRESULT STDMETHODCALLTYPE IsEndOfStream ( BOOL * endOfStream ) override;
+        HRESULT STDMETHODCALLTYPE Read ( BYTE * buffer, ULONG length, ULONG * bytesRead ) override;
+        HRESULT STDMETHODCALLTYPE BeginRead ( BYTE * buffer, ULONG length, IMFAsyncCallback * callback, IUnknown * state ) override;
+        HRESULT STDMETHODCALLTYPE EndRead ( IMFAsyncResult * result, ULONG * bytesRead ) override;
+        HRESULT STDMETHODCALLTYPE Write ( const BYTE * buffer, ULONG length, ULONG * bytesWritten ) override;
+        HRESULT STDMETHODCALLTYPE BeginWrite ( const BYTE * buffer, ULONG length, IMFAsyncCallback * callback, IUnknown * state ) override;
+        HRESULT STDMETHODCALLTYPE EndWrite ( IMFAsyncResult * result, ULONG * bytesWritten ) override;
+        HRESULT STDMETHODCALLTYPE Seek ( MFBYTESTREAM_SEEK_ORIGIN origin, LONGLONG offset, DWORD flags, QWORD * position ) override;
+        HRESULT STDMETHODCALLTYPE Flush ( ) override;
+        HRESULT STDMETHODCALLTYPE Close ( ) override;
+
+        HRESULT STDMETHODCALLTYPE QueryInterface ( REFIID riid, LPVOID * ppvObj ) override;
+        ULONG STDMETHODCALLTYPE AddRef ( ) override;
+        ULONG STDMETHODCALLTYPE Release ( ) override;
+
+    protected:
+
+        ByteSourceStream ( const ByteSourceRef & source );
+        virtual ~ByteSourceStream ( ) = default;
+
+        ByteSourceRef           _source;
+        std::atomic<QWORD>      _position{ 0 };
+        ULONG                   _refCount{ 0 };
+    };
+}
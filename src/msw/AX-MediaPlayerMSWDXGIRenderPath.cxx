@@ -213,12 +213,16 @@ namespace AX::Video
 
         if ( SUCCEEDED ( context.Device()->CreateTexture2D ( &desc, nullptr, _dxTexture.GetAddressOf ( ) ) ) )
         {
+            LiveObjects::Add ( LiveObjects::Kind::SharedTextures );
+
             gl::Texture::Format fmt;
             fmt.internalFormat ( GL_RGBA ).loadTopDown ( );
             
             _glTexture = gl::Texture::create ( size.x, size.y, fmt );
             _shareHandle = wglDXRegisterObjectNV ( context.Handle(), _dxTexture.Get(), _glTexture->getId(), GL_TEXTURE_2D, WGL_ACCESS_READ_ONLY_NV );
             _isValid = _shareHandle != nullptr;
+
+            if ( _isValid ) LiveObjects::Add ( LiveObjects::Kind::InteropObjects );
         }
     }
 
@@ -250,8 +254,11 @@ namespace AX::Video
                 if ( IsLocked() ) wglDXUnlockObjectsNV ( InteropContext::Get().Handle(), 1, &_shareHandle );
                 wglDXUnregisterObjectNV ( InteropContext::Get().Handle(), _shareHandle );
                 _shareHandle = nullptr;
+                LiveObjects::Remove ( LiveObjects::Kind::InteropObjects );
             }
         }
+
+        if ( _dxTexture ) LiveObjects::Remove ( LiveObjects::Kind::SharedTextures );
     }
 
     DXGIRenderPath::DXGIRenderPath ( MediaPlayer::Impl & owner, const ci::DataSourceRef & source )
@@ -275,18 +282,27 @@ namespace AX::Video
 
     bool DXGIRenderPath::InitializeRenderTarget ( const ci::ivec2 & size )
     {
-        if ( !_sharedTexture || size != _size )
+        if ( _sharedTextures.empty ( ) || size != _size || _sharedTextures.size ( ) != _slots.GetCount ( ) )
         {
             _size = size;
-            _sharedTexture = InteropContext::Get ( ).CreateSharedTexture ( size );
+            _sharedTextures.clear ( );
+            for ( size_t i = 0; i < _slots.GetCount ( ); i++ )
+            {
+                auto texture = InteropContext::Get ( ).CreateSharedTexture ( size );
+                if ( !texture ) break;
+                _sharedTextures.push_back ( std::move ( texture ) );
+            }
+
+            if ( _sharedTextures.size ( ) != _slots.GetCount ( ) ) _sharedTextures.clear ( );
+            _slots.Reset ( _slots.GetCount ( ) );
         }
 
-        return ( _sharedTexture != nullptr );
+        return !_sharedTextures.empty ( );
     }
 
-    bool DXGIRenderPath::ProcessFrame ( )
+    bool DXGIRenderPath::ProcessFrame ( double pts )
     {
-        if ( _sharedTexture )
+        if ( !_sharedTextures.empty ( ) )
         {
             auto & engine = _owner._mediaEngine;
 
@@ -294,10 +310,11 @@ namespace AX::Video
             RECT dstRect{ 0, 0, _size.x, _size.y };
             MFARGB black{ 0, 0, 0, 0 };
 
-            bool ok = SUCCEEDED ( engine->TransferVideoFrame ( _sharedTexture->DXTextureHandle(), &srcRect, &dstRect, &black ) );
+            // Only ever the write slot, the GL side only locks the read slot
+            bool ok = SUCCEEDED ( engine->TransferVideoFrame ( _sharedTextures[_slots.GetWriteSlot ( )]->DXTextureHandle(), &srcRect, &dstRect, &black ) );
             if ( ok )
             {
-                _owner._hasNewFrame.store ( true );
+                _slots.Publish ( pts );
             }
 
             return ok;
@@ -308,11 +325,12 @@ namespace AX::Video
 
     MediaPlayer::FrameLeaseRef DXGIRenderPath::GetFrameLease ( ) const
     {
-        return std::make_unique<DXGIRenderPathFrameLease> ( _sharedTexture );
+        if ( _sharedTextures.empty ( ) ) return std::make_unique<DXGIRenderPathFrameLease> ( nullptr );
+        return std::make_unique<DXGIRenderPathFrameLease> ( _sharedTextures[_slots.GetReadSlot ( )] );
     }
 
     DXGIRenderPath::~DXGIRenderPath ( )
     {
-        _sharedTexture = nullptr;
+        _sharedTextures.clear ( );
     }
 }
\ No newline at end of file
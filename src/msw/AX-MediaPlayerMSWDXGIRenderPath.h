@@ -11,6 +11,7 @@
 #include "AX-MediaPlayerMSWImpl.h"
 #include "cinder/gl/gl.h"
 #include <d3d11.h>
+#include <vector>
 
 namespace AX::Video
 {
@@ -27,11 +28,11 @@ namespace AX::Video
         
         bool Initialize             ( IMFAttributes & attributes ) override;
         bool InitializeRenderTarget ( const ci::ivec2 & size ) override;
-        bool ProcessFrame           ( ) override;
+        bool ProcessFrame           ( double pts ) override;
         MediaPlayer::FrameLeaseRef GetFrameLease ( ) const override;
     
     protected:
 
-        SharedTextureRef _sharedTexture{ nullptr };
+        std::vector<SharedTextureRef> _sharedTextures;
     };
 }
\ No newline at end of file
@@ -9,19 +9,27 @@
 #include "AX-MediaPlayerMSWImpl.h"
 #include "AX-MediaPlayerMSWWICRenderPath.h"
 #include "AX-MediaPlayerMSWDXGIRenderPath.h"
+#include "AX-MediaPlayerMSWByteStream.h"
+#include "AX-MediaPlayerMSWAudioTap.h"
+#include "AX-MediaPlayerMSWTransferThread.h"
 
 #include "cinder/app/App.h"
 #include "cinder/DataSource.h"
 #include "cinder/Log.h"
 #include "cinder/audio/Device.h"
 #include <string>
+#include <chrono>
 #include <unordered_map>
 #include <mutex>
-#include <condition_variable>
+#include <algorithm>
+#include <cmath>
 
 #include <mfapi.h>
 #include <mferror.h>
 #include <mfmediaengine.h>
+#include <dwmapi.h>
+
+#pragma comment(lib, "dwmapi.lib")
 
 using namespace ci;
 
@@ -30,107 +38,44 @@ namespace
     static std::atomic_int kNumMediaFoundationInstances = 0;
     static std::atomic_bool kIsMFInitialized = false;
 
-    static void OnMediaPlayerCreated ( )
+    // The count and the startup / shutdown it guards have to move together. With
+    // just the atomic, a player created while the last one is being destroyed could see the
+    // count go 0 -> 1, start MF, and then have the other thread's shutdown mark it uninitialized.
+    static std::mutex kMediaFoundationMutex;
+
+    static void StartMediaFoundation ( )
     {
-        if ( kNumMediaFoundationInstances++ == 0 )
-        {
-            kIsMFInitialized = SUCCEEDED ( MFStartup ( MF_VERSION ) );
-        }
+        kIsMFInitialized = SUCCEEDED ( MFStartup ( MF_VERSION ) );
+        if ( kIsMFInitialized ) AX::Video::LiveObjects::Add ( AX::Video::LiveObjects::Kind::MediaFoundation );
     }
 
-    static void OnMediaPlayerDestroyed ( )
+    static void StopMediaFoundation ( )
     {
-        if ( --kNumMediaFoundationInstances == 0 )
+        if ( kIsMFInitialized )
         {
             MFShutdown ( );
-            kIsMFInitialized = false;
+            AX::Video::LiveObjects::Remove ( AX::Video::LiveObjects::Kind::MediaFoundation );
         }
+
+        kIsMFInitialized = false;
     }
 
-    class MFCallbackBase : public IMFAsyncCallback
+    static void OnMediaPlayerCreated ( )
     {
-    public:
-        MFCallbackBase ( DWORD flags = 0, DWORD queue = MFASYNC_CALLBACK_QUEUE_MULTITHREADED ) : m_flags ( flags ), m_queue ( queue ) {}
-        virtual ~MFCallbackBase ( ) = default;
-
-        DWORD GetQueue ( ) const { return m_queue; }
-        DWORD GetFlags ( ) const { return m_flags; }
-
-        IFACEMETHODIMP GetParameters ( _Out_ DWORD * flags, _Out_ DWORD * queue )
-        {
-            *flags = m_flags;
-            *queue = m_queue;
-            return S_OK;
-        }
-
-        HRESULT STDMETHODCALLTYPE QueryInterface ( REFIID riid, LPVOID * ppvObj )
-        {
-            if ( !ppvObj ) return E_INVALIDARG;
-            
-            *ppvObj = NULL;
-            if ( riid == IID_IMFAsyncCallback )
-            {                
-                *ppvObj = (LPVOID)this;
-                AddRef ( );
-                return NOERROR;
-            }
-            return E_NOINTERFACE;
-        }
-
-        ULONG STDMETHODCALLTYPE AddRef ( )
-        {
-            InterlockedIncrement ( &m_refCount );
-            return m_refCount;
-        }
-
-        ULONG STDMETHODCALLTYPE Release( )
+        std::unique_lock<std::mutex> lk ( kMediaFoundationMutex );
+        if ( kNumMediaFoundationInstances++ == 0 )
         {
-            ULONG count = InterlockedDecrement ( &m_refCount );
-            if ( 0 == m_refCount )
-            {
-                delete this;
-            }
-            return count;
+            StartMediaFoundation ( );
         }
+    }
 
-    private:
-        DWORD m_flags = 0;
-        DWORD m_queue = 0;
-        ULONG m_refCount = 0;
-    };
-
-    class MFWorkItem : public MFCallbackBase
+    static void OnMediaPlayerDestroyed ( )
     {
-    public:
-        MFWorkItem ( std::function<void ( )> callback, DWORD flags = 0, DWORD queue = MFASYNC_CALLBACK_QUEUE_MULTITHREADED ) : MFCallbackBase ( flags, queue )
-        {
-            m_callback = callback;
-        }
-
-        IFACEMETHODIMP Invoke ( _In_opt_ IMFAsyncResult * /*result*/ ) noexcept override
-            try
-        {
-            m_callback ( );
-            Release ( );
-            return S_OK;
-        }
-        catch ( const std::exception & e )
+        std::unique_lock<std::mutex> lk ( kMediaFoundationMutex );
+        if ( --kNumMediaFoundationInstances == 0 )
         {
-            std::cout << "Error: " << e.what ( ) << std::endl;
-            return E_ABORT;
+            StopMediaFoundation ( );
         }
-
-    private:
-        std::function<void ( )> m_callback;
-    };
-
-    inline void MFPutWorkItem ( std::function<void ( )> callback )
-    {
-        ComPtr<MFWorkItem> workItem{ new MFWorkItem ( callback ) };
-        workItem->AddRef ( );
-
-        // @note(andrew): ::Release()'d when ::Invoked()
-        MFPutWorkItem2 ( workItem->GetQueue ( ), 0, workItem.Get ( ), nullptr );
     }
 
     std::string MFEventToString ( MF_MEDIA_ENGINE_EVENT event )
@@ -234,28 +179,20 @@ namespace AX::Video
 
         if ( apartmentType == APTTYPE_MTA )
         {
-            // Already in the MTA thread, just run the code
-            // @note(andrew): Do I need to do some co-init stuff here?
+            // Already in the MTA thread (which includes every Executor worker), just run the code
             callback ( );
         }
         else
         {
-            std::condition_variable wait;
-            std::mutex lock;
-            std::atomic_bool isDone{ false };
-
-            MFPutWorkItem ( [&] ( )
-            {
-                callback ( );
-                isDone.store ( true );
-                wait.notify_one ( );
-            } );
-
-            std::unique_lock lk{ lock };
-            wait.wait ( lk, [&] { return isDone.load ( ); } );
+            Executor::Shared ( ).Async ( Executor::Priority::Present, std::move ( callback ) ).get ( );
         }
     }
 
+    void RunAsyncInMTAThread ( std::function<void ( )> callback, Executor::Priority priority )
+    {
+        Executor::Shared ( ).Submit ( priority, std::move ( callback ) );
+    }
+
     void RunSynchronousInMainThread ( std::function<void ( )> callback )
     {
         app::App::get ( )->dispatchSync ( [&] { callback ( ); } );
@@ -263,26 +200,33 @@ namespace AX::Video
 
     void MediaPlayer::Impl::StaticInitialize ( )
     {
+        std::unique_lock<std::mutex> lk ( kMediaFoundationMutex );
         if ( !kIsMFInitialized )
         {
-            kIsMFInitialized = SUCCEEDED (MFStartup (MF_VERSION));
+            StartMediaFoundation ( );
         }
     }
 
     void MediaPlayer::Impl::StaticShutdown ( )
     {
-        if ( kIsMFInitialized ) MFShutdown ( );
-        kIsMFInitialized = false;
+        std::unique_lock<std::mutex> lk ( kMediaFoundationMutex );
+        StopMediaFoundation ( );
     }
 
-    MediaPlayer::Impl::Impl ( MediaPlayer & owner, const DataSourceRef & source, const Format& format )
+    MediaPlayer::Impl::Impl ( MediaPlayer & owner, const DataSourceRef & source, const Format& format, const ByteSourceRef & byteSource, MemoryBudget::AccountRef memory )
         : _owner ( owner )
         , _source ( source )
+        , _byteSource ( byteSource )
         , _format( format )
     {
+        // What Create ( ) reserved at admission, the render target's real size replaces it
+        if ( memory ) _memory = std::move ( memory );
+
         if ( _format.IsAutoInitialized() ) OnMediaPlayerCreated ();
         if ( !kIsMFInitialized )
         {
+            // The destructor won't run, so give back the reference it would have
+            if ( _format.IsAutoInitialized() ) OnMediaPlayerDestroyed ( );
             throw std::runtime_error ("MediaFoundation not initialized! Set MediaPlayer::Format::AutoInitialize or call MediaPlayer::StaticInitialize() to manually manage lifetime!");
             return;
         }
@@ -297,7 +241,8 @@ namespace AX::Video
 
             DWORD flags = MF_MEDIA_ENGINE_REAL_TIME_MODE;
 
-            if ( !_format.IsAudioEnabled() )
+            // When tapped the audio goes through the node, not the engine's own renderer
+            if ( !_format.IsAudioEnabled() || _owner.GetAudioNode ( ) )
             {
                 flags |= MF_MEDIA_ENGINE_FORCEMUTE;
             }
@@ -307,7 +252,20 @@ namespace AX::Video
                 flags |= MF_MEDIA_ENGINE_AUDIOONLY;
             }
 
-            if ( _format.IsHardwareAccelerated() )
+            _needsUpdate = !_format.IsAudioOnly ( ) || _owner.GetAudioNode ( );
+
+            if ( _format.IsFrameDroppingEnabled ( ) && !_format.IsAudioOnly ( ) )
+            {
+                _frameScheduler = std::make_unique<FrameScheduler> ( _format.FrameDroppingOptions ( ) );
+            }
+
+            // Audio only players never get a render path, so there's no
+            // DXGI device manager, no video decoder and nothing to do per frame.
+            if ( _format.IsAudioOnly() )
+            {
+                _renderPath = nullptr;
+            }
+            else if ( _format.IsHardwareAccelerated() )
             {
                 _renderPath = std::make_unique<DXGIRenderPath> ( *this, source );
             }
@@ -328,25 +286,63 @@ namespace AX::Video
                 attributes->SetString ( MF_AUDIO_RENDERER_ATTRIBUTE_ENDPOINT_ID, wideDeviceId.c_str ( ) );
             }
 
-            _renderPath->Initialize ( *attributes.Get() );
+            if ( _renderPath ) _renderPath->Initialize ( *attributes.Get() );
 
             if ( SUCCEEDED ( factory->CreateInstance ( flags, attributes.Get ( ), _mediaEngine.GetAddressOf ( ) ) ) )
             {
-                std::wstring actualPath;
-                if ( _source->isUrl ( ) )
+                LiveObjects::Add ( LiveObjects::Kind::Engines );
+                _mediaEngine->QueryInterface ( _mediaEngineEx.GetAddressOf ( ) );
+
+                if ( _owner.GetAudioNode ( ) )
                 {
-                    auto str = _source->getUrl ( ).str ( );
-                    actualPath = { str.begin ( ), str.end ( ) };
+                    _audioTap = std::make_unique<AudioTap> ( _owner.GetAudioNode ( ), _source, _byteSource );
                 }
-                else
+
+                if ( _renderPath && _format.IsPresentationSyncEnabled ( ) )
                 {
-                    actualPath = _source->getFilePath ( ).wstring ( );
+                    _presentation = std::make_unique<PresentationScheduler> ( _format.PresentationOptions ( ) );
                 }
-                
-                _mediaEngine->SetSource ( SafeBSTR{ actualPath } );
-                _mediaEngine->Load ( );
 
-                _mediaEngine->QueryInterface ( _mediaEngineEx.GetAddressOf ( ) );
+                // Nothing is transferred until there's metadata, so it's safe to start polling now
+                if ( _renderPath && ( _format.IsBackgroundTransferEnabled ( ) || _presentation ) )
+                {
+                    // A queue needs at least 4 slots to stay a queue, see FrameSlots
+                    _slotCount = _presentation ? std::max<size_t> ( 4, _format.PresentationOptions ( ).GetQueueDepth ( ) ) : 3;
+                    _minSlotCount = _presentation ? 4 : 3;
+                    _renderPath->SetSlotCount ( _slotCount );
+                    _transferThread = TransferThread::Shared ( );
+                    _transferThread->Add ( this );
+                }
+
+                if ( _byteSource )
+                {
+                    // The url is only used as a hint for the container
+                    // type so the entry name (with its extension) is all that's needed
+                    auto name = _byteSource->Name ( ).empty ( ) ? std::string ( "stream" ) : _byteSource->Name ( );
+                    std::wstring wideName{ name.begin ( ), name.end ( ) };
+
+                    auto stream = ByteSourceStream::Create ( _byteSource );
+                    if ( !_mediaEngineEx || FAILED ( _mediaEngineEx->SetSourceFromByteStream ( stream.Get ( ), SafeBSTR{ wideName } ) ) )
+                    {
+                        CI_LOG_E ( "Unable to set byte stream source " << name );
+                    }
+                }
+                else
+                {
+                    std::wstring actualPath;
+                    if ( _source->isUrl ( ) )
+                    {
+                        auto str = _source->getUrl ( ).str ( );
+                        actualPath = { str.begin ( ), str.end ( ) };
+                    }
+                    else
+                    {
+                        actualPath = _source->getFilePath ( ).wstring ( );
+                    }
+                    
+                    _mediaEngine->SetSource ( SafeBSTR{ actualPath } );
+                    _mediaEngine->Load ( );
+                }
             }
         }
     }
@@ -356,12 +352,27 @@ namespace AX::Video
 
     HRESULT MediaPlayer::Impl::EventNotify ( DWORD event, DWORD_PTR param1, DWORD param2 )
     {
+        // Still shutting down in the background, nobody is listening anymore
+        if ( _detached.load ( ) ) return S_OK;
+
         {
             // @note(andrew): Make sure all signals are emitted on the main thread
             std::unique_lock<std::mutex> lk( _eventMutex );
             _eventQueue.push( Event{ event, param1, param2 } );
         }
 
+        // Players that aren't polled every frame get their events pushed to the main thread instead
+        if ( !NeedsUpdate ( ) && !_eventsScheduled.exchange ( true ) )
+        {
+            std::weak_ptr<void> alive = _alive;
+            app::App::get ( )->dispatchAsync ( [this, alive]
+            {
+                if ( alive.expired ( ) ) return;
+                _eventsScheduled.store ( false );
+                UpdateEvents ( );
+            } );
+        }
+
         return S_OK;
     }
 
@@ -380,10 +391,10 @@ namespace AX::Video
                 _duration = static_cast< float > ( _mediaEngine->GetDuration() );
 
                 DWORD w, h;
-                if( SUCCEEDED( _mediaEngine->GetNativeVideoSize( &w, &h ) ) )
+                if( _renderPath && SUCCEEDED( _mediaEngine->GetNativeVideoSize( &w, &h ) ) )
                 {
                     _size = ivec2( w, h );
-                    _renderPath->InitializeRenderTarget( _size );
+                    ResizeRenderTarget( _size );
                 }
 
                 _hasMetadata = true;
@@ -392,15 +403,16 @@ namespace AX::Video
                 break;
             }
 
+            // Not when it's a seamless loop parking the engine while it seeks back, see LoopScheduler
             case MF_MEDIA_ENGINE_EVENT_PLAY:
             {
-                _owner.OnPlay.emit();
+                if ( !_owner.IsBridgingLoop ( ) ) _owner.OnPlay.emit();
                 break;
             }
 
             case MF_MEDIA_ENGINE_EVENT_PAUSE:
             {
-                _owner.OnPause.emit();
+                if ( !_owner.IsBridgingLoop ( ) ) _owner.OnPause.emit();
                 break;
             }
             case MF_MEDIA_ENGINE_EVENT_ENDED:
@@ -412,29 +424,20 @@ namespace AX::Video
             case MF_MEDIA_ENGINE_EVENT_SEEKING:
             {
                 _owner.OnSeekStart.emit();
-                _timeInSecondsAtStartOfSeek = _owner.GetPositionInSeconds ( );
                 break;
             }
 
             case MF_MEDIA_ENGINE_EVENT_SEEKED:
             {
+                // A seamless wrap lands where the tap already is, having looped by itself
+                if ( _audioTap ) _audioTap->Follow ( static_cast<float> ( _mediaEngine->GetCurrentTime ( ) ) );
+                if ( _frameScheduler ) _frameScheduler->Reset ( );
+                if ( _presentation ) _presentation->Reset ( );
                 _owner.OnSeekEnd.emit();
-                if ( _owner.IsLooping ( ) )
-                {
-                    // @NOTE(andrew): Since the complete event is not fired on looping videos,
-                    // the best metric I was able to rely on was an EVENT_SEEKING with current time 0
-                    // followed by an EVENT_SEEKED, also at time 0. My crude hack is to try and keep
-                    // track of the current time when these are fired and if they're both zero 
-                    // (or close to it) then to assume a loop has taken place. Not perfect, but 
-                    // since the MFMediaEngine follows the HTML5 video spec, you can take it up
-                    // with the brains trust at the W3C ;)
-
-                    auto now = _owner.GetPositionInSeconds ( );
-                    if ( now < 0.05f && ( ( now - _timeInSecondsAtStartOfSeek ) < 0.01f ) )
-                    {
-                        _owner.OnComplete.emit ( );
-                    }
-                }
+
+                // A loop is a seek as far as the engine (and the HTML5 spec it follows)
+                // is concerned, there's no event for it. MediaPlayer::OnLoop comes from the frame
+                // timestamps wrapping instead, see LoopScheduler.
                 break;
             }
 
@@ -461,6 +464,8 @@ namespace AX::Video
 
     void MediaPlayer::Impl::UpdateEvents ( )
     {
+        if ( _detached.load ( ) ) return;
+
         Event evt;
         bool hasEvent = false;
         do
@@ -480,6 +485,72 @@ namespace AX::Video
                 ProcessEvent( evt.eventId, evt.param1, evt.param2 );
             }
         } while( hasEvent );
+
+        PublishState ( );
+    }
+
+    // The one place the engine is asked how it's doing, once per tick (or after
+    // each batch of events for players that aren't ticked), only ever from the main thread.
+    // Everything else reads the snapshot,
+    // which is a copy out of a SeqLock and never a call into the engine.
+    void MediaPlayer::Impl::PublishState ( ) const
+    {
+        if ( !_mediaEngine ) return;
+
+        const double position = _mediaEngine->GetCurrentTime ( );
+        double bufferedStart = 0.0, bufferedEnd = 0.0;
+
+        ComPtr<IMFMediaTimeRange> ranges;
+        if ( SUCCEEDED ( _mediaEngine->GetBuffered ( ranges.GetAddressOf ( ) ) ) )
+        {
+            for ( DWORD i = 0; i < ranges->GetLength ( ); i++ )
+            {
+                double start = 0.0, end = 0.0;
+                if ( SUCCEEDED ( ranges->GetStart ( i, &start ) ) && SUCCEEDED ( ranges->GetEnd ( i, &end ) ) && position >= start && position <= end )
+                {
+                    bufferedStart = start;
+                    bufferedEnd = end;
+                    break;
+                }
+            }
+        }
+
+        const bool paused = _mediaEngine->IsPaused ( );
+        const bool seeking = _mediaEngine->IsSeeking ( );
+        const bool complete = _mediaEngine->IsEnded ( );
+        const bool hasAudio = _mediaEngine->HasAudio ( );
+        const bool hasVideo = _mediaEngine->HasVideo ( );
+        const float rate = static_cast<float> ( _mediaEngine->GetPlaybackRate ( ) );
+        const double framePts = _renderPath ? _renderPath->GetFramePts ( ) : -1.0;
+
+        // Volume, mute and loop are left as the setters wrote them
+        _state.Modify ( [&] ( MediaPlayer::State & state )
+        {
+            state.version++;
+            state.position = position;
+            state.duration = _duration;
+            state.rate = rate;
+            state.bufferedStart = bufferedStart;
+            state.bufferedEnd = bufferedEnd;
+            state.framePts = framePts;
+            state.framesPresented = _framesPresented;
+            state.width = _size.x;
+            state.height = _size.y;
+            state.ready = _hasMetadata;
+            state.paused = paused;
+            state.seeking = seeking;
+            state.complete = complete;
+            state.hasAudio = hasAudio;
+            state.hasVideo = hasVideo;
+        } );
+    }
+
+    MediaPlayer::State MediaPlayer::Impl::GetState ( ) const
+    {
+        // Never publishes, not even for players that aren't polled. Those still
+        // get a steady stream of TIMEUPDATE events while they play (as well as PLAY, PAUSE,
+        // SEEKED etc), and each batch is published from the main thread by UpdateEvents ( ).
+        return _state.Load ( );
     }
 
     HRESULT STDMETHODCALLTYPE MediaPlayer::Impl::QueryInterface ( REFIID riid, LPVOID * ppvObj )
@@ -504,11 +575,14 @@ namespace AX::Video
     ULONG STDMETHODCALLTYPE MediaPlayer::Impl::AddRef ( ) { return 0;  }
     ULONG STDMETHODCALLTYPE MediaPlayer::Impl::Release ( ) { return 0; }
     
+    // Control calls never wait on the engine, they're queued (with a reference
+    // to the engine of their own) and applied in order in the MTA. Settings the engine can't
+    // change by itself (volume, mute, loop) answer with what was last asked for.
     void MediaPlayer::Impl::Play ( )
     {
         if ( _mediaEngine )
         {
-            _mediaEngine->Play ( );
+            _commands.Push ( CommandQueue::Kind::Playback, [engine = _mediaEngine] { engine->Play ( ); } );
         }
     }
 
@@ -516,19 +590,19 @@ namespace AX::Video
     {
         if ( _mediaEngine )
         {
-            _mediaEngine->Pause ( );
+            _commands.Push ( CommandQueue::Kind::Playback, [engine = _mediaEngine] { engine->Pause ( ); } );
         }
     }
 
     void MediaPlayer::Impl::TogglePlayback ( )
     {
-        if ( IsPaused ( ) )
-        {
-            Play ( );
-        }
-        else
+        // Decided when it's applied, against whatever the queued commands ahead of it did
+        if ( _mediaEngine )
         {
-            Pause ( );
+            _commands.Push ( CommandQueue::Kind::Ordered, [engine = _mediaEngine]
+            {
+                if ( engine->IsPaused ( ) ) engine->Play ( ); else engine->Pause ( );
+            } );
         }
     }
 
@@ -538,7 +612,8 @@ namespace AX::Video
         {
             if ( IsPlaybackRateSupported ( rate ) )
             {
-                return SUCCEEDED ( _mediaEngine->SetPlaybackRate ( static_cast<double> ( rate ) ) );
+                _commands.Push ( CommandQueue::Kind::Rate, [engine = _mediaEngine, rate] { engine->SetPlaybackRate ( static_cast<double> ( rate ) ); } );
+                return true;
             }
         }
 
@@ -549,7 +624,7 @@ namespace AX::Video
     {
         if ( _mediaEngine )
         {
-            return static_cast<float> ( _mediaEngine->GetPlaybackRate ( ) );
+            return GetState ( ).rate;
         }
 
         return 1.0f;
@@ -569,71 +644,87 @@ namespace AX::Video
     {
         if ( _mediaEngine )
         {
-            RunSynchronousInMTAThread ( [&] { _mediaEngine->SetMuted ( mute ); } );
+            _state.Modify ( [mute] ( MediaPlayer::State & state ) { state.muted = mute; } );
+            _commands.Push ( CommandQueue::Kind::Muted, [engine = _mediaEngine, mute] { engine->SetMuted ( mute ); } );
         }
     }
 
     bool MediaPlayer::Impl::IsMuted ( ) const
     {
-        if ( _mediaEngine )
-        {
-            return static_cast<bool> ( _mediaEngine->GetMuted ( ) );
-        }
-
-        return false;
+        return _mediaEngine ? _state.Load ( ).muted : false;
     }
 
     void MediaPlayer::Impl::SetVolume ( float volume )
     {
         if ( _mediaEngine )
         {
-            RunSynchronousInMTAThread ( [&] { _mediaEngine->SetVolume ( volume ); } );
+            _state.Modify ( [volume] ( MediaPlayer::State & state ) { state.volume = volume; } );
+            _commands.Push ( CommandQueue::Kind::Volume, [engine = _mediaEngine, volume] { engine->SetVolume ( volume ); } );
         }
     }
 
     float MediaPlayer::Impl::GetVolume ( ) const
     {
-        if ( _mediaEngine )
-        {
-            return static_cast<float> ( _mediaEngine->GetVolume ( ) );
-        }
-
-        return 1.0f;
+        return _mediaEngine ? _state.Load ( ).volume : 1.0f;
     }
 
     void MediaPlayer::Impl::SetLoop ( bool loop )
     {
         if ( _mediaEngine )
         {
-            _mediaEngine->SetLoop ( static_cast<BOOL> ( loop ) );
+            _state.Modify ( [loop] ( MediaPlayer::State & state ) { state.looping = loop; } );
+            _commands.Push ( CommandQueue::Kind::Loop, [engine = _mediaEngine, loop] { engine->SetLoop ( static_cast<BOOL> ( loop ) ); } );
         }
     }
 
     bool MediaPlayer::Impl::IsLooping ( ) const
     {
-        if ( _mediaEngine )
-        {
-            return static_cast<bool> ( _mediaEngine->GetLoop ( ) );
-        }
+        return _mediaEngine ? _state.Load ( ).looping : false;
+    }
 
-        return false;
+    void MediaPlayer::Impl::SetAudioLoop ( double in, double out )
+    {
+        if ( _audioTap ) _audioTap->SetLoop ( in, out );
     }
 
     float MediaPlayer::Impl::GetPositionInSeconds ( ) const
     {
         if ( !_mediaEngine ) return -1.0f;
-        return static_cast<float> ( _mediaEngine->GetCurrentTime ( ) );
+        return static_cast<float> ( GetState ( ).position );
+    }
+
+    MediaPlayer::TimeRanges MediaPlayer::Impl::GetBufferedRanges ( ) const
+    {
+        MediaPlayer::TimeRanges result;
+
+        ComPtr<IMFMediaTimeRange> ranges;
+        if ( _mediaEngine && SUCCEEDED ( _mediaEngine->GetBuffered ( ranges.GetAddressOf ( ) ) ) )
+        {
+            for ( DWORD i = 0; i < ranges->GetLength ( ); i++ )
+            {
+                double start = 0.0, end = 0.0;
+                if ( SUCCEEDED ( ranges->GetStart ( i, &start ) ) && SUCCEEDED ( ranges->GetEnd ( i, &end ) ) )
+                {
+                    result.push_back ( { static_cast<float> ( start ), static_cast<float> ( end ) } );
+                }
+            }
+        }
+
+        return result;
     }
 
     void MediaPlayer::Impl::SeekToSeconds ( float seconds, bool approximate )
     {
         if ( _mediaEngineEx )
         {
-            _mediaEngineEx->SetCurrentTimeEx ( seconds, approximate ? MF_MEDIA_ENGINE_SEEK_MODE_APPROXIMATE : MF_MEDIA_ENGINE_SEEK_MODE_NORMAL );
+            _commands.Push ( CommandQueue::Kind::Seek, [engine = _mediaEngineEx, seconds, approximate]
+            {
+                engine->SetCurrentTimeEx ( seconds, approximate ? MF_MEDIA_ENGINE_SEEK_MODE_APPROXIMATE : MF_MEDIA_ENGINE_SEEK_MODE_NORMAL );
+            } );
         }
         else if ( _mediaEngine )
         {
-            _mediaEngine->SetCurrentTime ( static_cast<double> ( seconds ) );
+            _commands.Push ( CommandQueue::Kind::Seek, [engine = _mediaEngine, seconds] { engine->SetCurrentTime ( static_cast<double> ( seconds ) ); } );
         }
     }
 
@@ -647,9 +738,10 @@ namespace AX::Video
 
     void MediaPlayer::Impl::FrameStep ( int delta )
     {
+        // Every step counts, so these are never collapsed
         if ( _mediaEngineEx )
         {
-            _mediaEngineEx->FrameStep ( delta > 0 ? true : false );
+            _commands.Push ( CommandQueue::Kind::Ordered, [engine = _mediaEngineEx, delta] { engine->FrameStep ( delta > 0 ? true : false ); } );
         }
     }
 
@@ -657,7 +749,7 @@ namespace AX::Video
     {
         if ( _mediaEngine )
         {
-            return _mediaEngine->IsEnded ( );
+            return GetState ( ).complete;
         }
         else
         {
@@ -669,7 +761,7 @@ namespace AX::Video
     {
         if ( _mediaEngine )
         {
-            return _mediaEngine->IsPaused ( );
+            return GetState ( ).paused;
         }
 
         return false;
@@ -684,7 +776,7 @@ namespace AX::Video
     {
         if ( _mediaEngine )
         {
-            return _mediaEngine->IsSeeking ( );
+            return GetState ( ).seeking;
         }
 
         return false;
@@ -699,7 +791,7 @@ namespace AX::Video
     {
         if ( _mediaEngine )
         {
-            return _mediaEngine->HasAudio ( );
+            return GetState ( ).hasAudio;
         }
 
         return false;
@@ -709,7 +801,7 @@ namespace AX::Video
     {
         if ( _mediaEngine )
         {
-            return _mediaEngine->HasVideo ( );
+            return GetState ( ).hasVideo;
         }
 
         return false;
@@ -717,23 +809,179 @@ namespace AX::Video
 
     bool MediaPlayer::Impl::Update ( )
     {
-        if ( _mediaEngine && HasVideo ( ) )
+        if ( _renderPath && _mediaEngine && HasVideo ( ) )
         {
-            LONGLONG time;
-            if ( SUCCEEDED ( _mediaEngine->OnVideoStreamTick ( &time ) ) )
+            // With a transfer thread the frame is already converted, all that's left is the swap
+            if ( !_transferThread ) TransferFrame ( );
+
+            if ( SwapFrame ( ) )
             {
-                if ( _renderPath->ProcessFrame ( ) )
+                _hasNewFrame.store ( true );
+                _framesPresented++;
+
+                if ( _surface && _sinks.HasSinks ( FrameSink::Thread::Main ) )
                 {
-                    _hasNewFrame.store ( true );
+                    _sinks.Dispatch ( { _surface->getData ( ), _surface->getSize ( ), _surface->getRowBytes ( ), _surface->getChannelOrder ( ), _renderPath->GetFramePts ( ) }, FrameSink::Thread::Main );
                 }
             }
+
+            // Follow the scheduler in and out of HalfSize and the memory budget in and out of
+            // Shrink / Downscale, TransferVideoFrame scales to whatever the target is
+            float scale = 1.0f;
+            if ( _frameScheduler )
+            {
+                std::unique_lock<std::mutex> lk ( _schedulerMutex );
+                scale = _frameScheduler->GetOutputScale ( );
+            }
+
+            const auto pressure = MemoryBudget::Shared ( ).GetPressure ( );
+            if ( pressure >= MemoryBudget::Pressure::Downscale ) scale = std::min ( scale, 0.5f );
+            const size_t slots = pressure >= MemoryBudget::Pressure::Shrink ? _minSlotCount : _slotCount;
+
+            ivec2 target = ivec2 ( vec2 ( _size ) * scale );
+            if ( target.x > 0 && target.y > 0 && ( target != _renderPath->GetSize ( ) || slots != _renderPath->GetSlotCount ( ) ) ) ResizeRenderTarget ( target, slots );
         }
 
         UpdateEvents ( );
+
+        if ( _audioTap )
+        {
+            _audioTap->Sync ( GetPositionInSeconds ( ), !IsPaused ( ) && !IsSeeking ( ) && !IsComplete ( ), GetPlaybackRate ( ) );
+        }
         
         return false;
     }
 
+    bool MediaPlayer::Impl::ShouldPresent ( double pts )
+    {
+        if ( !_frameScheduler ) return true;
+
+        double now = std::chrono::duration<double> ( std::chrono::steady_clock::now ( ).time_since_epoch ( ) ).count ( );
+        double clock = _mediaEngine->GetCurrentTime ( );
+        float rate = IsPaused ( ) ? 0.0f : GetPlaybackRate ( );
+
+        std::unique_lock<std::mutex> lk ( _schedulerMutex );
+        return _frameScheduler->Evaluate ( pts, clock, rate, now ) == FrameScheduler::Decision::Present;
+    }
+
+    // Warning: On the transfer thread when there is one, no GL activity here
+    void MediaPlayer::Impl::TransferFrame ( )
+    {
+        if ( _detached.load ( ) ) return;
+
+        std::unique_lock<std::mutex> lk ( _transferMutex );
+        if ( !_renderPath || !_hasMetadata ) return;
+
+        // S_FALSE means nothing new since the last tick, so there's nothing to transfer
+        LONGLONG time;
+        if ( _mediaEngine->OnVideoStreamTick ( &time ) == S_OK && ShouldPresent ( time / 10000000.0 ) )
+        {
+            _renderPath->ProcessFrame ( time / 10000000.0 );
+        }
+    }
+
+    bool MediaPlayer::Impl::IsTransferActive ( ) const
+    {
+        const auto state = _state.Load ( );
+        return state.hasVideo && !state.paused;
+    }
+
+    // Warning: On the poller, which never polls a player while its transfer is in flight
+    // and stops polling it before Shutdown ( ) lets go of the engine
+    bool MediaPlayer::Impl::PollFrame ( double & pts )
+    {
+        if ( _detached.load ( ) || !_hasMetadata ) return false;
+
+        LONGLONG time;
+        if ( _mediaEngine->OnVideoStreamTick ( &time ) != S_OK || time == _polledTime ) return false;
+
+        _polledTime = time;
+        pts = time / 10000000.0;
+        return true;
+    }
+
+    // Warning: On the transfer thread, no GL activity here
+    void MediaPlayer::Impl::TransferFrame ( double pts )
+    {
+        if ( _detached.load ( ) ) return;
+
+        std::unique_lock<std::mutex> lk ( _transferMutex );
+        if ( !_renderPath || !_hasMetadata ) return;
+
+        if ( ShouldPresent ( pts ) ) _renderPath->ProcessFrame ( pts );
+    }
+
+    bool MediaPlayer::Impl::SwapFrame ( )
+    {
+        double target = _presentationTarget;
+        _presentationTarget = -1.0;
+
+        float rate = IsPaused ( ) ? 0.0f : GetPlaybackRate ( );
+        if ( !_presentation || rate <= 0.0f )
+        {
+            // Paused, stepping or reversing, just show whatever came out last
+            if ( _presentation ) _presentation->Reset ( );
+            return _renderPath->SwapFrame ( );
+        }
+
+        double secondsUntil = 0.0;
+        double interval = 0.0;
+        PredictRefresh ( secondsUntil, interval );
+        if ( target >= 0.0 ) secondsUntil = target;
+
+        double queued[FrameSlots::kMaxSlots];
+        size_t count = _renderPath->GetQueuedFrames ( queued, FrameSlots::kMaxSlots );
+        double displayMedia = _mediaEngine->GetCurrentTime ( ) + secondsUntil * rate;
+
+        int pick = _presentation->Select ( queued, count, displayMedia, interval * rate );
+        return pick >= 0 && _renderPath->SwapFrame ( queued[pick] );
+    }
+
+    void MediaPlayer::Impl::PredictRefresh ( double & secondsUntil, double & interval ) const
+    {
+        float hz = _format.PresentationOptions ( ).GetRefreshRate ( );
+        interval = hz > 0.0f ? 1.0 / hz : 1.0 / 60.0;
+        secondsUntil = interval;
+
+        LARGE_INTEGER frequency, now;
+        DWM_TIMING_INFO timing{ };
+        timing.cbSize = sizeof ( timing );
+
+        if ( QueryPerformanceFrequency ( &frequency ) && QueryPerformanceCounter ( &now ) && SUCCEEDED ( DwmGetCompositionTimingInfo ( nullptr, &timing ) ) && timing.qpcRefreshPeriod > 0 )
+        {
+            // The compositor knows the phase of the last vblank, project that forwards to the next one
+            const double period = static_cast<double> ( timing.qpcRefreshPeriod );
+            const double sinceVBlank = static_cast<double> ( now.QuadPart ) - static_cast<double> ( timing.qpcVBlank );
+            const double next = std::ceil ( sinceVBlank / period ) * period - sinceVBlank;
+
+            if ( hz <= 0.0f ) interval = period / frequency.QuadPart;
+            secondsUntil = next / frequency.QuadPart;
+        }
+    }
+
+    void MediaPlayer::Impl::ResizeRenderTarget ( const ivec2 & size, size_t slots )
+    {
+        // Rare (metadata, degrading), so the transfer thread can wait while every slot is reallocated
+        std::unique_lock<std::mutex> lk ( _transferMutex );
+        if ( slots > 0 && slots != _renderPath->GetSlotCount ( ) )
+        {
+            _renderPath->SetSlotCount ( slots );
+            if ( _presentation ) _presentation->Reset ( );
+        }
+
+        const bool allocated = _renderPath->InitializeRenderTarget ( size );
+
+        // Every slot is a full BGRA frame, on the GPU or in a surface
+        const auto & actual = _renderPath->GetSize ( );
+        _memory->Set ( allocated ? static_cast<uint64_t> ( actual.x ) * actual.y * 4 * _renderPath->GetSlotCount ( ) : 0 );
+    }
+
+    FrameScheduler::Stats MediaPlayer::Impl::GetFrameStats ( ) const
+    {
+        std::unique_lock<std::mutex> lk ( _schedulerMutex );
+        return _frameScheduler ? _frameScheduler->GetStats ( ) : FrameScheduler::Stats ( );
+    }
+
     const Surface8uRef & MediaPlayer::Impl::GetSurface ( ) const
     {
         _hasNewFrame.store ( false );
@@ -743,29 +991,71 @@ namespace AX::Video
     MediaPlayer::FrameLeaseRef MediaPlayer::Impl::GetTexture ( ) const
     {
         _hasNewFrame.store ( false );
-        return _renderPath->GetFrameLease ( );
+        return _renderPath ? _renderPath->GetFrameLease ( ) : nullptr;
     }
 
-    MediaPlayer::Impl::~Impl ( )
+    void MediaPlayer::Impl::Shutdown ( std::function<void ( )> done )
     {
-        _renderPath = nullptr;
+        if ( _isShutdown )
+        {
+            if ( done ) done ( );
+            return;
+        }
+
+        _isShutdown = true;
+        _audioTap = nullptr;
         _hasNewFrame.store ( false );
-        
-        // @todo(andrew): Do I need to ::Shutdown through the Ex interface
-        // or since it's likely just an upcasted IMFMediaEngine will the
-        // original interface suffice?
-        _mediaEngineEx = nullptr;
-        
-        if ( _mediaEngine )
+
+        // Nothing in here waits, it's usually on a worker and what it would be
+        // waiting for could be queued behind it. A transfer still in flight finishes first (it
+        // uses the engine), then the engine is shut down behind any control calls still queued
+        // (which hold their own reference) and `done` runs on the worker that applied that.
+        auto closeEngine = [this, done = std::move ( done )] ( ) mutable
         {
-            RunSynchronousInMTAThread ( [&]
+            // @todo(andrew): Do I need to ::Shutdown through the Ex interface
+            // or since it's likely just an upcasted IMFMediaEngine will the
+            // original interface suffice?
+            _mediaEngineEx = nullptr;
+
+            if ( _mediaEngine )
             {
-                _mediaEngine->Shutdown ( );
+                _commands.Push ( CommandQueue::Kind::Ordered, [engine = _mediaEngine] { engine->Shutdown ( ); } );
+                _mediaEngine = nullptr;
+                LiveObjects::Remove ( LiveObjects::Kind::Engines );
+            }
+
+            _commands.Push ( CommandQueue::Kind::Ordered, [autoInitialized = _format.IsAutoInitialized ( ), done = std::move ( done )]
+            {
+                if ( autoInitialized ) OnMediaPlayerDestroyed ( );
+                if ( done ) done ( );
             } );
+        };
+
+        // Holds on to the transfer thread until it's done with this player
+        if ( auto transferThread = std::move ( _transferThread ) )
+        {
+            transferThread->Remove ( this, [transferThread, closeEngine = std::move ( closeEngine )] ( ) mutable { closeEngine ( ); } );
+        }
+        else
+        {
+            closeEngine ( );
+        }
+    }
 
-            _mediaEngine = nullptr;
+    MediaPlayer::Impl::~Impl ( )
+    {
+        // Already done in the background unless something other than MediaPlayer owned this, in
+        // which case it's being let go of on the GL thread and can wait for it
+        Detach ( );
+        if ( !_isShutdown )
+        {
+            std::promise<void> finished;
+            Shutdown ( [&finished] { finished.set_value ( ); } );
+            finished.get_future ( ).wait ( );
         }
 
-        if ( _format.IsAutoInitialized() ) OnMediaPlayerDestroyed ( );
+        _renderPath = nullptr;
+        _surface = nullptr;
+        _memory->Set ( 0 );
     }
-}
\ No newline at end of file
+}
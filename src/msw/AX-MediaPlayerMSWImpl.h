@@ -36,12 +36,22 @@ using namespace Microsoft::WRL;
 #endif
 
 #include "AX-MediaPlayer.h"
+#include "AX-MediaPlayerFrameSlots.h"
+#include "AX-MediaPlayerCommandQueue.h"
+#include "AX-MediaPlayerSeqLock.h"
+#include "AX-MediaPlayerMemoryBudget.h"
+#include "AX-MediaPlayerExecutor.h"
+#include "AX-MediaPlayerFrameSink.h"
 
 namespace AX::Video
 {
     void RunSynchronousInMTAThread  ( std::function<void ( )> callback );
+    void RunAsyncInMTAThread        ( std::function<void ( )> callback, Executor::Priority priority = Executor::Priority::Background );
     void RunSynchronousInMainThread ( std::function<void ( )> callback );
 
+    class AudioTap;
+    class TransferThread;
+
     class MediaPlayer::Impl : public IMFMediaEngineNotify
     {
     public:
@@ -58,28 +68,48 @@ namespace AX::Video
             
             virtual bool Initialize ( IMFAttributes & attributes ) { return true; }
             virtual bool InitializeRenderTarget ( const ci::ivec2 & size ) = 0;
-            virtual bool ProcessFrame ( ) = 0;
             virtual MediaPlayer::FrameLeaseRef GetFrameLease ( ) const { return nullptr; }
+            virtual StreamingTexture::Stats GetUploadStats ( ) const { return { }; }
             inline const ci::ivec2 & GetSize ( ) const { return _size; };
 
+            // ProcessFrame ( ) transfers into the write slot and publishes it,
+            // possibly on the transfer thread. SwapFrame ( ) is always on the main thread and
+            // makes the newest (or with a queue, the chosen) published frame the one leases
+            // and surfaces are taken from.
+            virtual bool ProcessFrame ( double pts ) = 0;
+            bool SwapFrame ( ) { return _slots.Swap ( ) && OnFrameSwapped ( ); }
+            bool SwapFrame ( double pts ) { return _slots.SwapTo ( pts ) && OnFrameSwapped ( ); }
+            size_t GetQueuedFrames ( double * pts, size_t max ) const { return _slots.GetQueued ( pts, max ); }
+            double GetFramePts ( ) const { return _slots.GetReadPts ( ); }
+            size_t GetSlotCount ( ) const { return _slots.GetCount ( ); }
+
+            // Needs to happen before InitializeRenderTarget ( ), 3 when a transfer thread is used
+            // and more when frames are queued for the presentation scheduler
+            void SetSlotCount ( size_t count ) { _slots.Reset ( count ); }
 
         protected:
+            virtual bool OnFrameSwapped ( ) { return true; }
+
             ci::DataSourceRef   _source;
             MediaPlayer::Impl & _owner;
             ci::ivec2           _size;
+            FrameSlots          _slots;
         };
 
         using RenderPathRef = std::unique_ptr<RenderPath>;
         friend class RenderPath;
         friend class DXGIRenderPath;
         friend class WICRenderPath;
+        friend class TransferThread;
 
         static void StaticInitialize ( );
         static void StaticShutdown ( );
+        static bool CanStreamByteSources ( ) { return true; }
 
-        Impl    ( MediaPlayer & owner, const ci::DataSourceRef & source, const Format& format );
+        Impl    ( MediaPlayer & owner, const ci::DataSourceRef & source, const Format& format, const ByteSourceRef & byteSource = nullptr, MemoryBudget::AccountRef memory = nullptr );
 
         bool    Update ( );
+        bool    NeedsUpdate ( ) const { return _needsUpdate; }
 
         bool    IsComplete ( ) const;
         bool    IsPlaying ( ) const;
@@ -107,6 +137,9 @@ namespace AX::Video
         void    SetLoop ( bool loop );
         bool    IsLooping ( ) const;
 
+        // Section the audio tap wraps by itself when the player makes the loops, both zero for none
+        void    SetAudioLoop ( double in, double out );
+
         const   ci::ivec2 & GetSize ( ) const { return _size; }
 
         void    SeekToSeconds ( float seconds, bool approximate );
@@ -114,8 +147,16 @@ namespace AX::Video
 
         float   GetPositionInSeconds ( ) const;
         float   GetDurationInSeconds ( ) const { return _duration; }
+        MediaPlayer::TimeRanges GetBufferedRanges ( ) const;
+        FrameScheduler::Stats GetFrameStats ( ) const;
+        void    SetPresentationTarget ( double secondsFromNow ) { _presentationTarget = secondsFromNow; }
+        PresentationScheduler::Stats GetPresentationStats ( ) const { return _presentation ? _presentation->GetStats ( ) : PresentationScheduler::Stats ( ); }
+        StreamingTexture::Stats GetUploadStats ( ) const { return _renderPath ? _renderPath->GetUploadStats ( ) : StreamingTexture::Stats ( ); }
+        FrameSinkList & GetFrameSinks ( ) { return _sinks; }
 
         void    FrameStep ( int delta );
+        std::future<void> FlushCommands ( ) { return _commands.Flush ( ); }
+        MediaPlayer::State GetState ( ) const;
 
         bool    CheckNewFrame ( ) const { return _hasNewFrame.load ( ); }
         const   ci::Surface8uRef & GetSurface ( ) const;
@@ -126,31 +167,69 @@ namespace AX::Video
         ULONG STDMETHODCALLTYPE AddRef ( ) override;
         ULONG STDMETHODCALLTYPE Release ( ) override;
 
+        // Teardown is in three parts so the slow ones can happen somewhere other
+        // than the thread that let go of the player, see MediaPlayer::~MediaPlayer. Detach ( )
+        // is immediate and stops every signal and transfer, Shutdown ( ) starts closing the engine
+        // from any thread without blocking it and calls `done` once it's closed, and the
+        // destructor frees what's left (GL included) on the GL thread.
+        void Detach ( ) { _detached.store ( true ); }
+        void Shutdown ( std::function<void ( )> done );
+
         void UpdateEvents ( );
+        bool ShouldPresent ( double pts );
+        void TransferFrame ( );
+
+        // For the transfer thread's poller, which only hands a player to the
+        // Executor once PollFrame ( ) has found a frame it hasn't seen (then TransferFrame ( pts )
+        // converts it). Paused players only get new frames from seeks and steps, so the poller
+        // looks at them less often, see IsTransferActive ( ).
+        bool IsTransferActive ( ) const;
+        bool PollFrame ( double & pts );
+        void TransferFrame ( double pts );
+        void ResizeRenderTarget ( const ci::ivec2 & size, size_t slots = 0 );
+        bool SwapFrame ( );
+        void PredictRefresh ( double & secondsUntil, double & interval ) const;
 
         ~Impl ( );
 
 
     protected:
         void ProcessEvent ( DWORD evt, DWORD_PTR param1, DWORD param2 );
+        void PublishState ( ) const;
 
         MediaPlayer &               _owner;
         ci::DataSourceRef           _source;
+        ByteSourceRef               _byteSource;
         ci::ivec2                   _size;
         MediaPlayer::Format         _format;
         float                       _duration{ 0.0f };
-        bool                        _hasMetadata{ false };
+        std::atomic_bool            _hasMetadata{ false };
+        bool                        _needsUpdate{ true };
         ci::Surface8uRef            _surface{ nullptr };
         RenderPathRef               _renderPath;
+        std::unique_ptr<AudioTap>   _audioTap;
+        std::unique_ptr<FrameScheduler> _frameScheduler;
+        mutable std::mutex          _schedulerMutex;
+        std::shared_ptr<TransferThread> _transferThread;
+        std::unique_ptr<PresentationScheduler> _presentation;
+        FrameSinkList               _sinks;
+        double                      _presentationTarget{ -1.0 };
+        std::mutex                  _transferMutex;     // Held for each transfer and while the render target changes
+        LONGLONG                    _polledTime{ -1 };  // Last frame the poller handed on, only touched there
         ComPtr<IMFMediaEngine>      _mediaEngine{ nullptr };
         ComPtr<IMFMediaEngineEx>    _mediaEngineEx{ nullptr };
+        CommandQueue                _commands{ Executor::Priority::Present };   // Control calls, applied in order in the MTA
+        mutable SeqLock<MediaPlayer::State> _state;     // What the getters answer with, see PublishState ( )
+        uint64_t                    _framesPresented{ 0 };
+        MemoryBudget::AccountRef    _memory{ MemoryBudget::Shared ( ).OpenAccount ( ) };
+        size_t                      _slotCount{ 1 };    // What the format asked for
+        size_t                      _minSlotCount{ 1 }; // What it can get by with under memory pressure
         mutable std::atomic_bool    _hasNewFrame{ false };
         std::mutex                  _eventMutex;
-
-        // This is to try and determine if a loop has occurred
-        // since there's no loop event and it's indistinguishable 
-        // from a regular user loop
-        float                       _timeInSecondsAtStartOfSeek{ 0.0f }; 
+        std::atomic_bool            _eventsScheduled{ false };
+        std::shared_ptr<void>       _alive{ std::make_shared<int> ( 0 ) };
+        std::atomic_bool            _detached{ false }; // The MediaPlayer is gone, _owner can't be touched
+        bool                        _isShutdown{ false };
 
         struct Event
         {
@@ -0,0 +1,151 @@
+//
+//  AX-MediaPlayerMSWTransferThread.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerMSWTransferThread.h"
+
+#include <objbase.h>
+#include <timeapi.h>
+#include <algorithm>
+
+#pragma comment(lib, "winmm.lib")
+
+namespace AX::Video
+{
+    std::shared_ptr<TransferThread> TransferThread::Shared ( )
+    {
+        // Lives only as long as some player is using it
+        static std::mutex kMutex;
+        static std::weak_ptr<TransferThread> kShared;
+
+        std::unique_lock<std::mutex> lk ( kMutex );
+        auto thread = kShared.lock ( );
+        if ( !thread )
+        {
+            thread = std::shared_ptr<TransferThread> ( new TransferThread ( ) );
+            kShared = thread;
+        }
+
+        return thread;
+    }
+
+    TransferThread::TransferThread ( )
+    {
+        _thread = std::thread ( [=] { Run ( ); } );
+    }
+
+    void TransferThread::Add ( MediaPlayer::Impl * player )
+    {
+        std::unique_lock<std::mutex> lk ( _mutex );
+        _players.push_back ( player );
+    }
+
+    void TransferThread::Remove ( MediaPlayer::Impl * player, std::function<void ( )> removed )
+    {
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            _players.erase ( std::remove ( _players.begin ( ), _players.end ( ), player ), _players.end ( ) );
+
+            // Not waited on here, the caller is likely a worker itself and the
+            // transfer could be queued behind it
+            if ( _inFlight.count ( player ) > 0 )
+            {
+                _removed[player] = std::move ( removed );
+                return;
+            }
+        }
+
+        if ( removed ) removed ( );
+    }
+
+    void TransferThread::Run ( )
+    {
+        // The engines are polled from here, like everything else that talks to them it's in the MTA
+        CoInitializeEx ( nullptr, COINIT_MULTITHREADED );
+
+        auto & executor = Executor::Shared ( );
+        bool active = false;
+        size_t polls = 0;
+
+        std::unique_lock<std::mutex> lk ( _mutex );
+        while ( _running )
+        {
+            const bool sweep = !active || ++polls % kPausedPollEvery == 0;
+            bool playing = false;
+
+            for ( auto player : _players )
+            {
+                // Still busy with the last one, it'll pick up whatever's new next poll
+                if ( _inFlight.count ( player ) > 0 )
+                {
+                    playing = true;
+                    continue;
+                }
+
+                const bool isActive = player->IsTransferActive ( );
+                playing = playing || isActive;
+                if ( !isActive && !sweep ) continue;
+
+                // Only a frame the engine hasn't handed over before is worth a task
+                double pts = 0.0;
+                if ( !player->PollFrame ( pts ) ) continue;
+
+                _inFlight.insert ( player );
+                executor.Submit ( Executor::Priority::Present, [this, player, pts]
+                {
+                    player->TransferFrame ( pts );
+
+                    std::function<void ( )> removed;
+                    {
+                        std::unique_lock<std::mutex> lk ( _mutex );
+                        _inFlight.erase ( player );
+
+                        auto it = _removed.find ( player );
+                        if ( it != _removed.end ( ) )
+                        {
+                            removed = std::move ( it->second );
+                            _removed.erase ( it );
+                        }
+
+                        _idle.notify_all ( );
+                    }
+
+                    // Last, it can be what lets go of this thread
+                    if ( removed ) removed ( );
+                } );
+            }
+
+            // Without this a 2ms wait is really a 15.6ms one, but it raises the
+            // timer resolution for the whole system, so it's only held while something plays
+            if ( playing != active )
+            {
+                if ( playing ) timeBeginPeriod ( 1 ); else timeEndPeriod ( 1 );
+                active = playing;
+            }
+
+            _wake.wait_for ( lk, active ? kPollInterval : kIdlePollInterval, [&] { return !_running; } );
+        }
+
+        if ( active ) timeEndPeriod ( 1 );
+        CoUninitialize ( );
+    }
+
+    TransferThread::~TransferThread ( )
+    {
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            _running = false;
+        }
+
+        _wake.notify_all ( );
+        if ( _thread.joinable ( ) ) _thread.join ( );
+
+        // Every player has been removed by now, but don't leave a transfer pointing at this
+        std::unique_lock<std::mutex> lk ( _mutex );
+        _idle.wait ( lk, [&] { return _inFlight.empty ( ); } );
+    }
+}
@@ -0,0 +1,64 @@
+//
+//  AX-MediaPlayerMSWTransferThread.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include "AX-MediaPlayerMSWImpl.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <condition_variable>
+
+namespace AX::Video
+{
+    // Polls the engines for new frames and hands each player's TransferVideoFrame
+    // and any CPU conversion to the shared Executor, as soon as a frame is available rather than
+    // whenever the app next gets around to updating. One poller services every player, and since
+    // the transfers themselves run in parallel a slow player doesn't hold the others up. The
+    // engine is asked here first, so a task is only submitted for a frame that's actually new.
+    class TransferThread
+    {
+    public:
+
+        static std::shared_ptr<TransferThread> Shared ( );
+
+        ~TransferThread ( );
+
+        void    Add ( MediaPlayer::Impl * player );
+
+        // Never waits, `removed` runs once no transfer for `player` is in flight: straight away on
+        // the caller if there isn't one, otherwise on the worker that finishes it
+        void    Remove ( MediaPlayer::Impl * player, std::function<void ( )> removed );
+
+    protected:
+
+        TransferThread ( );
+        void    Run ( );
+
+        // The engine has no per frame callback, so poll at a fraction of even a 120hz frame while
+        // anything is playing. With everything paused the default timer resolution will do.
+        static constexpr auto kPollInterval = std::chrono::milliseconds ( 2 );
+        static constexpr auto kIdlePollInterval = std::chrono::milliseconds ( 16 );
+
+        // Paused players are looked at once every this many polls
+        static constexpr size_t kPausedPollEvery = 8;
+
+        std::vector<MediaPlayer::Impl *> _players;
+        std::unordered_set<MediaPlayer::Impl *> _inFlight;  // Submitted and not finished, never queued twice
+        std::unordered_map<MediaPlayer::Impl *, std::function<void ( )>> _removed;   // Waiting on one of those
+        std::mutex                  _mutex;
+        std::condition_variable     _wake;
+        std::condition_variable     _idle;
+        bool                        _running{ true };
+        std::thread                 _thread;
+    };
+}
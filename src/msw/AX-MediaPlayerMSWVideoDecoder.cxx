@@ -0,0 +1,172 @@
+//
+//  AX-MediaPlayerMSWVideoDecoder.cxx
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerVideoDecoder.h"
+#include "AX-MediaPlayerMSWImpl.h"
+
+#include <mfapi.h>
+#include <mfreadwrite.h>
+#include <propvarutil.h>
+#include <algorithm>
+#include <cstring>
+
+#pragma comment(lib, "mfreadwrite.lib")
+#pragma comment(lib, "propsys.lib")
+
+namespace AX::Video
+{
+    namespace
+    {
+        class MSWVideoDecoder : public VideoDecoder
+        {
+        public:
+
+            MSWVideoDecoder ( )
+            {
+                // Same deal as MSWAudioDecoder, usable with no player alive and from any thread
+                _comInitialized = SUCCEEDED ( CoInitializeEx ( nullptr, COINIT_MULTITHREADED ) );
+                _mfInitialized = SUCCEEDED ( MFStartup ( MF_VERSION, MFSTARTUP_LITE ) );
+            }
+
+            ~MSWVideoDecoder ( )
+            {
+                _reader = nullptr;
+                if ( _mfInitialized ) MFShutdown ( );
+                if ( _comInitialized ) CoUninitialize ( );
+            }
+
+            bool Open ( const std::filesystem::path & path )
+            {
+                if ( !_mfInitialized ) return false;
+
+                // Video processing lets the reader do the YUV -> RGB32 conversion
+                // itself, so whatever the decoder outputs (NV12, P010 ...) comes out as BGRA.
+                ComPtr<IMFAttributes> attributes;
+                MFCreateAttributes ( attributes.GetAddressOf ( ), 1 );
+                attributes->SetUINT32 ( MF_SOURCE_READER_ENABLE_VIDEO_PROCESSING, TRUE );
+
+                if ( FAILED ( MFCreateSourceReaderFromURL ( path.wstring ( ).c_str ( ), attributes.Get ( ), _reader.GetAddressOf ( ) ) ) ) return false;
+
+                const DWORD stream = static_cast<DWORD> ( MF_SOURCE_READER_FIRST_VIDEO_STREAM );
+                _reader->SetStreamSelection ( static_cast<DWORD> ( MF_SOURCE_READER_ALL_STREAMS ), FALSE );
+                if ( FAILED ( _reader->SetStreamSelection ( stream, TRUE ) ) ) return false;
+
+                ComPtr<IMFMediaType> type;
+                MFCreateMediaType ( type.GetAddressOf ( ) );
+                type->SetGUID ( MF_MT_MAJOR_TYPE, MFMediaType_Video );
+                type->SetGUID ( MF_MT_SUBTYPE, MFVideoFormat_RGB32 );
+                if ( FAILED ( _reader->SetCurrentMediaType ( stream, nullptr, type.Get ( ) ) ) ) return false;
+
+                ComPtr<IMFMediaType> current;
+                if ( FAILED ( _reader->GetCurrentMediaType ( stream, current.GetAddressOf ( ) ) ) ) return false;
+
+                UINT32 width = 0, height = 0;
+                MFGetAttributeSize ( current.Get ( ), MF_MT_FRAME_SIZE, &width, &height );
+                _width = static_cast<int32_t> ( width );
+                _height = static_cast<int32_t> ( height );
+
+                UINT32 numerator = 0, denominator = 0;
+                if ( SUCCEEDED ( MFGetAttributeRatio ( current.Get ( ), MF_MT_FRAME_RATE, &numerator, &denominator ) ) && denominator > 0 )
+                {
+                    _frameRate = numerator / static_cast<double> ( denominator );
+                }
+
+                // RGB32 defaults to bottom up unless the type says otherwise
+                _stride = static_cast<LONG> ( MFGetAttributeUINT32 ( current.Get ( ), MF_MT_DEFAULT_STRIDE, static_cast<UINT32> ( -static_cast<LONG> ( width * 4 ) ) ) );
+
+                PROPVARIANT duration;
+                PropVariantInit ( &duration );
+                if ( SUCCEEDED ( _reader->GetPresentationAttribute ( static_cast<DWORD> ( MF_SOURCE_READER_MEDIASOURCE ), MF_PD_DURATION, &duration ) ) )
+                {
+                    _duration = duration.uhVal.QuadPart / 10000000.0;
+                }
+                PropVariantClear ( &duration );
+
+                return _width > 0 && _height > 0;
+            }
+
+            int32_t GetWidth ( ) const override { return _width; }
+            int32_t GetHeight ( ) const override { return _height; }
+            double  GetFrameRate ( ) const override { return _frameRate; }
+            double  GetDurationInSeconds ( ) const override { return _duration; }
+
+            bool Seek ( double seconds ) override
+            {
+                PROPVARIANT position;
+                InitPropVariantFromInt64 ( static_cast<LONGLONG> ( seconds * 10000000.0 ), &position );
+                HRESULT hr = _reader->SetCurrentPosition ( GUID_NULL, position );
+                PropVariantClear ( &position );
+
+                return SUCCEEDED ( hr );
+            }
+
+            bool Decode ( uint8_t * dst, size_t rowBytes, double & pts ) override
+            {
+                const DWORD stream = static_cast<DWORD> ( MF_SOURCE_READER_FIRST_VIDEO_STREAM );
+
+                while ( true )
+                {
+                    DWORD flags = 0;
+                    LONGLONG timestamp = 0;
+                    ComPtr<IMFSample> sample;
+                    if ( FAILED ( _reader->ReadSample ( stream, 0, nullptr, &flags, &timestamp, sample.GetAddressOf ( ) ) ) ) return false;
+                    if ( flags & MF_SOURCE_READERF_ENDOFSTREAM ) return false;
+                    if ( !sample ) continue;
+
+                    ComPtr<IMFMediaBuffer> buffer;
+                    if ( FAILED ( sample->ConvertToContiguousBuffer ( buffer.GetAddressOf ( ) ) ) ) return false;
+
+                    BYTE * data = nullptr;
+                    LONG pitch = 0;
+                    ComPtr<IMF2DBuffer> buffer2D;
+                    bool locked2D = SUCCEEDED ( buffer.As ( &buffer2D ) ) && SUCCEEDED ( buffer2D->Lock2D ( &data, &pitch ) );
+
+                    if ( !locked2D )
+                    {
+                        DWORD length = 0;
+                        if ( FAILED ( buffer->Lock ( &data, nullptr, &length ) ) ) return false;
+
+                        // A negative stride means bottom up, start at the last row and walk backwards
+                        pitch = _stride;
+                        if ( pitch < 0 ) data += static_cast<size_t> ( -pitch ) * ( _height - 1 );
+                    }
+
+                    const size_t bytes = std::min ( rowBytes, static_cast<size_t> ( _width ) * 4 );
+                    for ( int32_t y = 0; y < _height; y++ )
+                    {
+                        std::memcpy ( dst + y * rowBytes, data + static_cast<ptrdiff_t> ( y ) * pitch, bytes );
+                    }
+
+                    if ( locked2D ) buffer2D->Unlock2D ( ); else buffer->Unlock ( );
+
+                    pts = timestamp / 10000000.0;
+                    return true;
+                }
+            }
+
+        protected:
+
+            ComPtr<IMFSourceReader>     _reader;
+            bool                        _comInitialized{ false };
+            bool                        _mfInitialized{ false };
+            int32_t                     _width{ 0 };
+            int32_t                     _height{ 0 };
+            LONG                        _stride{ 0 };
+            double                      _frameRate{ 0.0 };
+            double                      _duration{ 0.0 };
+        };
+    }
+
+    std::unique_ptr<VideoDecoder> VideoDecoder::Create ( const std::filesystem::path & path )
+    {
+        auto decoder = std::make_unique<MSWVideoDecoder> ( );
+        if ( !decoder->Open ( path ) ) return nullptr;
+
+        return decoder;
+    }
+}
@@ -24,6 +24,10 @@ namespace AX::Video
             }
         }
 
+        WICRenderPathFrameLease ( const gl::TextureRef & texture )
+            : _texture ( texture )
+        { }
+
         inline bool    IsValid ( ) const override { return ToTexture ( ) != nullptr; }
         gl::TextureRef ToTexture ( ) const override { return _texture; };
 
@@ -44,13 +48,22 @@ namespace AX::Video
     bool WICRenderPath::InitializeRenderTarget ( const ci::ivec2 & size )
     {
         if ( !_wicFactory ) return false;
-        if ( !_wicBitmap || size != _size )
+        if ( !_wicBitmap || size != _size || _surfaces.size ( ) != _slots.GetCount ( ) )
         {
             _size = size;
 
             if ( _wicFactory )
             {
-                _owner._surface = Surface8u::create ( size.x, size.y, true, SurfaceChannelOrder::BGRA );
+                LiveObjects::Remove ( LiveObjects::Kind::Surfaces, static_cast<int64_t> ( _surfaces.size ( ) ) );
+                _surfaces.clear ( );
+                for ( size_t i = 0; i < _slots.GetCount ( ); i++ )
+                {
+                    _surfaces.push_back ( Surface8u::create ( size.x, size.y, true, SurfaceChannelOrder::BGRA ) );
+                }
+                LiveObjects::Add ( LiveObjects::Kind::Surfaces, static_cast<int64_t> ( _surfaces.size ( ) ) );
+
+                _slots.Reset ( _slots.GetCount ( ) );
+                _owner._surface = _surfaces[_slots.GetReadSlot ( )];
                 return SUCCEEDED ( _wicFactory->CreateBitmap ( size.x, size.y, GUID_WICPixelFormat32bppBGRA, WICBitmapCacheOnDemand, _wicBitmap.GetAddressOf ( ) ) );
             }
             else
@@ -62,7 +75,7 @@ namespace AX::Video
         return ( _wicBitmap != nullptr );
     }
 
-    bool WICRenderPath::ProcessFrame ( )
+    bool WICRenderPath::ProcessFrame ( double pts )
     {
         auto& engine = _owner._mediaEngine;
         if ( _wicBitmap )
@@ -88,10 +101,15 @@ namespace AX::Video
 
                         if ( SUCCEEDED ( lockedData->GetDataPointer ( &bufferSize, &data ) ) )
                         {
+                            // Straight from the locked bitmap, before anything else touches it
+                            _owner._sinks.Dispatch ( { data, _size, static_cast<int32_t> ( stride ), SurfaceChannelOrder::BGRA, pts }, FrameSink::Thread::Producer );
+
                             Surface8u surface ( data, _size.x, _size.y, stride, SurfaceChannelOrder::BGRA );
-                            assert ( _owner._surface->getSize ( ) == surface.getSize ( ) );
+                            auto & target = _surfaces[_slots.GetWriteSlot ( )];
+                            assert ( target->getSize ( ) == surface.getSize ( ) );
 
-                            _owner._surface->copyFrom ( surface, surface.getBounds ( ) );
+                            target->copyFrom ( surface, surface.getBounds ( ) );
+                            _slots.Publish ( pts );
                             return true;
                         }
                     }
@@ -102,8 +120,40 @@ namespace AX::Video
         return false;
     }
 
+    bool WICRenderPath::OnFrameSwapped ( )
+    {
+        _owner._surface = _surfaces[_slots.GetReadSlot ( )];
+        _swappedFrame++;
+        return true;
+    }
+
     MediaPlayer::FrameLeaseRef WICRenderPath::GetFrameLease ( ) const
     {
-        return std::make_unique<WICRenderPathFrameLease> ( _owner._surface );
+        auto & format = _owner._format;
+        if ( !format.IsStreamingUploadEnabled ( ) || !_owner._surface )
+        {
+            return std::make_unique<WICRenderPathFrameLease> ( _owner._surface );
+        }
+
+        // The lease is a view of the player's one texture, so it shows whatever
+        // the latest upload was rather than being a snapshot of the frame it was taken on.
+        if ( !_streaming ) _streaming = StreamingTexture::Create ( format.StreamingUploadOptions ( ) );
+        if ( _uploadedFrame != _swappedFrame || !_streaming->GetTexture ( ) )
+        {
+            _streaming->Upload ( *_owner._surface );
+            _uploadedFrame = _swappedFrame;
+        }
+
+        return std::make_unique<WICRenderPathFrameLease> ( _streaming->GetTexture ( ) );
+    }
+
+    StreamingTexture::Stats WICRenderPath::GetUploadStats ( ) const
+    {
+        return _streaming ? _streaming->GetStats ( ) : StreamingTexture::Stats ( );
+    }
+
+    WICRenderPath::~WICRenderPath ( )
+    {
+        LiveObjects::Remove ( LiveObjects::Kind::Surfaces, static_cast<int64_t> ( _surfaces.size ( ) ) );
     }
 }
\ No newline at end of file
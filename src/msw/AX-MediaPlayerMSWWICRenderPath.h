@@ -9,6 +9,7 @@
 #pragma once
 
 #include "AX-MediaPlayerMSWImpl.h"
+#include <vector>
 
 namespace AX::Video
 {
@@ -17,14 +18,24 @@ namespace AX::Video
     public:
 
         WICRenderPath ( MediaPlayer::Impl & owner, const ci::DataSourceRef & source );
+        ~WICRenderPath ( );
         
-        bool ProcessFrame ( ) override;
+        bool ProcessFrame ( double pts ) override;
         bool InitializeRenderTarget ( const ci::ivec2 & size ) override;
         MediaPlayer::FrameLeaseRef GetFrameLease ( ) const override;
+        StreamingTexture::Stats GetUploadStats ( ) const override;
     
     protected:
 
+        bool OnFrameSwapped ( ) override;
+
         ComPtr<IWICBitmap> _wicBitmap{ nullptr };
         ComPtr<IWICImagingFactory> _wicFactory{ nullptr };
+        std::vector<ci::Surface8uRef> _surfaces;
+
+        // Created on the first GetFrameLease ( ), which is always on the main thread with a context
+        mutable StreamingTextureRef _streaming;
+        mutable uint64_t    _uploadedFrame{ 0 };
+        uint64_t            _swappedFrame{ 1 };
     };
 }
\ No newline at end of file
@@ -0,0 +1,151 @@
+//
+//  AX-MediaPlayerOSXAudioDecoder.mm
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerAudioDecoder.h"
+#include <AVFoundation/AVFoundation.h>
+#include <algorithm>
+
+namespace AX::Video
+{
+    namespace
+    {
+        class OSXAudioDecoder : public AudioDecoder
+        {
+        public:
+
+            ~OSXAudioDecoder ( )
+            {
+                Close ( );
+                [_track release];
+                [_asset release];
+            }
+
+            bool Open ( const std::filesystem::path & path )
+            {
+                @autoreleasepool
+                {
+                    NSURL * url = [NSURL fileURLWithPath:[NSString stringWithUTF8String:path.c_str()]];
+                    _asset = [[AVURLAsset alloc] initWithURL:url options:@{ AVURLAssetPreferPreciseDurationAndTimingKey : @YES }];
+                    _track = [[[_asset tracksWithMediaType:AVMediaTypeAudio] firstObject] retain];
+                    if ( !_track ) return false;
+
+                    for ( id description in [_track formatDescriptions] )
+                    {
+                        auto asbd = CMAudioFormatDescriptionGetStreamBasicDescription ( (__bridge CMAudioFormatDescriptionRef)description );
+                        if ( asbd )
+                        {
+                            _channels = asbd->mChannelsPerFrame;
+                            _sampleRate = asbd->mSampleRate;
+                            break;
+                        }
+                    }
+
+                    _duration = CMTimeGetSeconds ( [_asset duration] );
+                }
+
+                return _channels > 0 && _sampleRate > 0.0 && _duration > 0.0 && Start ( kCMTimeZero );
+            }
+
+            size_t GetChannels ( ) const override { return _channels; }
+            double GetSampleRate ( ) const override { return _sampleRate; }
+            double GetDurationInSeconds ( ) const override { return _duration; }
+
+            bool Seek ( double seconds ) override
+            {
+                // An asset reader can't be repositioned once started, so a
+                // seek is a fresh reader over the remaining time range
+                Close ( );
+                return Start ( CMTimeMakeWithSeconds ( seconds, static_cast<int32_t> ( _sampleRate ) ) );
+            }
+
+            bool Decode ( std::vector<float> & interleaved, double & startSeconds ) override
+            {
+                if ( !_output ) return false;
+
+                @autoreleasepool
+                {
+                    while ( true )
+                    {
+                        CMSampleBufferRef sample = [_output copyNextSampleBuffer];
+                        if ( !sample ) return false;
+
+                        CMItemCount frames = CMSampleBufferGetNumSamples ( sample );
+                        CMBlockBufferRef block = CMSampleBufferGetDataBuffer ( sample );
+                        if ( frames == 0 || !block )
+                        {
+                            CFRelease ( sample );
+                            continue;
+                        }
+
+                        interleaved.resize ( static_cast<size_t> ( frames ) * _channels );
+                        size_t bytes = std::min ( interleaved.size ( ) * sizeof ( float ), CMBlockBufferGetDataLength ( block ) );
+                        CMBlockBufferCopyDataBytes ( block, 0, bytes, interleaved.data ( ) );
+                        interleaved.resize ( bytes / ( sizeof ( float ) * _channels ) * _channels );
+
+                        startSeconds = CMTimeGetSeconds ( CMSampleBufferGetPresentationTimeStamp ( sample ) );
+                        CFRelease ( sample );
+                        return true;
+                    }
+                }
+            }
+
+        protected:
+
+            bool Start ( CMTime from )
+            {
+                @autoreleasepool
+                {
+                    NSError * error = nil;
+                    _reader = [[AVAssetReader alloc] initWithAsset:_asset error:&error];
+                    if ( !_reader ) return false;
+
+                    NSDictionary * settings = @{
+                        AVFormatIDKey : @( kAudioFormatLinearPCM ),
+                        AVLinearPCMBitDepthKey : @32,
+                        AVLinearPCMIsFloatKey : @YES,
+                        AVLinearPCMIsBigEndianKey : @NO,
+                        AVLinearPCMIsNonInterleaved : @NO,
+                    };
+
+                    _output = [[AVAssetReaderTrackOutput alloc] initWithTrack:_track outputSettings:settings];
+                    _output.alwaysCopiesSampleData = NO;
+                    if ( ![_reader canAddOutput:_output] ) return false;
+                    [_reader addOutput:_output];
+
+                    _reader.timeRange = CMTimeRangeMake ( from, kCMTimePositiveInfinity );
+                    return [_reader startReading];
+                }
+            }
+
+            void Close ( )
+            {
+                [_reader cancelReading];
+                [_output release];
+                [_reader release];
+                _output = nil;
+                _reader = nil;
+            }
+
+            AVURLAsset *                _asset{ nil };
+            AVAssetTrack *              _track{ nil };
+            AVAssetReader *             _reader{ nil };
+            AVAssetReaderTrackOutput *  _output{ nil };
+            size_t                      _channels{ 0 };
+            double                      _sampleRate{ 0.0 };
+            double                      _duration{ 0.0 };
+        };
+    }
+
+    std::unique_ptr<AudioDecoder> AudioDecoder::Create ( const std::filesystem::path & path )
+    {
+        auto decoder = std::make_unique<OSXAudioDecoder> ( );
+        if ( !decoder->Open ( path ) ) return nullptr;
+
+        return decoder;
+    }
+}
@@ -0,0 +1,36 @@
+//
+//  AX-MediaPlayerOSXAudioTap.h
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#pragma once
+
+#include "AX-MediaPlayerOSXImpl.h"
+#include "AX-MediaPlayerAudioNode.h"
+
+namespace AX::Video
+{
+    // Installs an MTAudioProcessingTap on the player item's audio mix. The
+    // tap copies each decoded buffer into the node's ring and then silences it, so AVPlayer
+    // keeps driving decode and timing but nothing it renders is audible.
+    class AudioTap
+    {
+    public:
+
+        AudioTap ( const MediaPlayer::AudioNodeRef & node );
+        ~AudioTap ( );
+
+        bool    Attach ( const std::shared_ptr<ci::qtime::MovieBase> & player );
+        void    Seek ( );
+        void    SetActive ( bool active );
+
+    protected:
+
+        MediaPlayer::AudioNodeRef       _node;
+        std::weak_ptr<ci::qtime::MovieBase> _player;
+        bool                            _attached{ false };
+    };
+}
@@ -0,0 +1,144 @@
+//
+//  AX-MediaPlayerOSXAudioTap.mm
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerOSXAudioTap.h"
+#include <AVFoundation/AVFoundation.h>
+#include <MediaToolbox/MediaToolbox.h>
+#include <vector>
+#include <cstring>
+
+using namespace ci;
+
+namespace
+{
+    struct TapContext
+    {
+        std::weak_ptr<AX::Video::MediaPlayer::AudioNode> node;
+        std::vector<const float *>  planar;
+        bool                        interleaved{ false };
+        bool                        isFloat{ false };
+        size_t                      channels{ 0 };
+    };
+
+    void TapInit ( MTAudioProcessingTapRef tap, void * clientInfo, void ** tapStorageOut )
+    {
+        *tapStorageOut = clientInfo;
+    }
+
+    void TapFinalize ( MTAudioProcessingTapRef tap )
+    {
+        delete static_cast<TapContext *> ( MTAudioProcessingTapGetStorage ( tap ) );
+    }
+
+    void TapPrepare ( MTAudioProcessingTapRef tap, CMItemCount maxFrames, const AudioStreamBasicDescription * format )
+    {
+        auto context = static_cast<TapContext *> ( MTAudioProcessingTapGetStorage ( tap ) );
+        context->channels = format->mChannelsPerFrame;
+        context->interleaved = !( format->mFormatFlags & kAudioFormatFlagIsNonInterleaved );
+        context->isFloat = ( format->mFormatFlags & kAudioFormatFlagIsFloat ) && format->mBitsPerChannel == 32;
+        context->planar.resize ( context->channels );
+
+        if ( auto node = context->node.lock ( ) )
+        {
+            node->SetSourceFormat ( context->channels, format->mSampleRate );
+        }
+    }
+
+    void TapUnprepare ( MTAudioProcessingTapRef tap ) { }
+
+    void TapProcess ( MTAudioProcessingTapRef tap, CMItemCount numberFrames, MTAudioProcessingTapFlags flags, AudioBufferList * bufferList, CMItemCount * numberFramesOut, MTAudioProcessingTapFlags * flagsOut )
+    {
+        if ( MTAudioProcessingTapGetSourceAudio ( tap, numberFrames, bufferList, flagsOut, nullptr, numberFramesOut ) != noErr ) return;
+
+        auto context = static_cast<TapContext *> ( MTAudioProcessingTapGetStorage ( tap ) );
+        auto node = context->node.lock ( );
+
+        if ( node && context->isFloat )
+        {
+            // AVPlayer's render thread can't be held up, whatever doesn't fit is lost
+            size_t frames = static_cast<size_t> ( *numberFramesOut );
+            if ( context->interleaved )
+            {
+                node->Drop ( frames - node->Push ( static_cast<const float *> ( bufferList->mBuffers[0].mData ), frames ) );
+            }
+            else if ( bufferList->mNumberBuffers >= context->channels )
+            {
+                for ( size_t c = 0; c < context->channels; c++ ) context->planar[c] = static_cast<const float *> ( bufferList->mBuffers[c].mData );
+                node->Drop ( frames - node->Push ( context->planar.data ( ), frames ) );
+            }
+        }
+
+        // The node is the only output, AVPlayer's own renderer only ever sees silence
+        for ( UInt32 i = 0; i < bufferList->mNumberBuffers; i++ )
+        {
+            std::memset ( bufferList->mBuffers[i].mData, 0, bufferList->mBuffers[i].mDataByteSize );
+        }
+    }
+}
+
+namespace AX::Video
+{
+    AudioTap::AudioTap ( const MediaPlayer::AudioNodeRef & node )
+        : _node ( node )
+    { }
+
+    bool AudioTap::Attach ( const std::shared_ptr<qtime::MovieBase> & player )
+    {
+        if ( _attached || !player ) return _attached;
+
+        AVPlayerItem * item = [player->getPlayerHandle() currentItem];
+        AVAssetTrack * track = [[[item asset] tracksWithMediaType:AVMediaTypeAudio] firstObject];
+        if ( !track ) return false;
+
+        MTAudioProcessingTapCallbacks callbacks;
+        callbacks.version = kMTAudioProcessingTapCallbacksVersion_0;
+        callbacks.clientInfo = new TapContext{ _node };
+        callbacks.init = TapInit;
+        callbacks.finalize = TapFinalize;
+        callbacks.prepare = TapPrepare;
+        callbacks.unprepare = TapUnprepare;
+        callbacks.process = TapProcess;
+
+        MTAudioProcessingTapRef tap = nullptr;
+        if ( MTAudioProcessingTapCreate ( kCFAllocatorDefault, &callbacks, kMTAudioProcessingTapCreationFlag_PostEffects, &tap ) != noErr )
+        {
+            delete static_cast<TapContext *> ( callbacks.clientInfo );
+            return false;
+        }
+
+        AVMutableAudioMixInputParameters * parameters = [AVMutableAudioMixInputParameters audioMixInputParametersWithTrack:track];
+        parameters.audioTapProcessor = tap;
+        CFRelease ( tap );
+
+        AVMutableAudioMix * mix = [AVMutableAudioMix audioMix];
+        mix.inputParameters = @[parameters];
+        item.audioMix = mix;
+
+        _player = player;
+        _attached = true;
+        return true;
+    }
+
+    void AudioTap::Seek ( )
+    {
+        _node->Flush ( );
+    }
+
+    void AudioTap::SetActive ( bool active )
+    {
+        _node->SetActive ( active );
+    }
+
+    AudioTap::~AudioTap ( )
+    {
+        if ( auto player = _player.lock ( ) )
+        {
+            [[player->getPlayerHandle() currentItem] setAudioMix:nil];
+        }
+    }
+}
@@ -20,20 +20,31 @@
 #endif
 
 #include "AX-MediaPlayer.h"
+#include "AX-MediaPlayerSeqLock.h"
+#include "AX-MediaPlayerMemoryBudget.h"
+#include "AX-MediaPlayerFrameSink.h"
 
 namespace AX::Video
 {
+    class AudioTap;
+
     class MediaPlayer::Impl
     {
     public:
         
         static void StaticInitialize ( );
         static void StaticShutdown ( );
+
+        // qtime can only open paths and urls so byte sources are spilled to disk first
+        static bool CanStreamByteSources ( ) { return false; }
         
-        Impl    ( MediaPlayer & owner, const ci::DataSourceRef & source, const Format& format );
+        Impl    ( MediaPlayer & owner, const ci::DataSourceRef & source, const Format& format, const ByteSourceRef & byteSource = nullptr, MemoryBudget::AccountRef memory = nullptr );
 
         bool    Update ( );
 
+        // Audio only players only need polling to report buffering on remote urls
+        bool    NeedsUpdate ( ) const { return !_format.IsAudioOnly() || ( _source && _source->isUrl() ); }
+
         bool    IsComplete ( ) const;
         bool    IsPlaying ( ) const;
         bool    IsPaused ( ) const;
@@ -60,6 +71,9 @@ namespace AX::Video
         void    SetLoop ( bool loop );
         bool    IsLooping ( ) const;
 
+        // The tap here sits on the player's own audio, which follows the seek
+        void    SetAudioLoop ( double, double ) { }
+
         const   ci::ivec2 & GetSize ( ) const { return _size; }
 
         void    SeekToSeconds ( float seconds, bool approximate );
@@ -67,14 +81,36 @@ namespace AX::Video
         
         void    FrameStep ( int delta );
 
+        // Control calls are synchronous here
+        std::future<void> FlushCommands ( );
+        MediaPlayer::State GetState ( ) const;
+
         float   GetPositionInSeconds ( ) const;
         float   GetDurationInSeconds ( ) const { return _duration; }
+        MediaPlayer::TimeRanges GetBufferedRanges ( ) const;
+        FrameScheduler::Stats GetFrameStats ( ) const { return _frameScheduler ? _frameScheduler->GetStats ( ) : FrameScheduler::Stats ( ); }
+
+        // AVPlayerItemVideoOutput already picks frames against the display's host time
+        void    SetPresentationTarget ( double secondsFromNow ) { }
+        PresentationScheduler::Stats GetPresentationStats ( ) const { return { }; }
+        FrameSinkList & GetFrameSinks ( ) { return _sinks; }
+        StreamingTexture::Stats GetUploadStats ( ) const { return _streamingTexture ? _streamingTexture->GetStats ( ) : StreamingTexture::Stats ( ); }
 
         bool    CheckNewFrame ( ) const { return _hasNewFrame.load ( ); }
         const   ci::Surface8uRef & GetSurface ( ) const;
         MediaPlayer::FrameLeaseRef GetTexture ( ) const;
+
+        // See the Windows Impl. Everything here belongs to qtime's movie or its AVPlayerItem, which
+        // want the main thread, so Shutdown ( ) is done straight away and it's all freed in the destructor.
+        void    Detach ( ) { _detached.store ( true ); }
+        void    Shutdown ( std::function<void ( )> done );
+
+        ~Impl ( );
         
     protected:
+
+        bool    ShouldPresent ( );
+        void    PublishState ( ) const;
         
         using QtimePlayerRef        = std::shared_ptr<ci::qtime::MovieBase>;
         
@@ -84,6 +120,9 @@ namespace AX::Video
         MediaPlayer::Format         _format;
         float                       _duration{ 0.0f };
         ci::Surface8uRef            _surface{ nullptr };
+        mutable StreamingTextureRef _streamingTexture;
+        FrameSinkList               _sinks;
+        mutable ci::Surface8uRef    _uploadedSurface;
         mutable std::atomic_bool    _hasNewFrame{ false };
         QtimePlayerRef              _player;
         bool                        _isPlaying{false};
@@ -91,6 +130,13 @@ namespace AX::Video
         float                       _volume{1.0f};
         bool                        _loop{false};
         bool                        _wasBuffering{false};
+        std::unique_ptr<AudioTap>   _audioTap;
+        std::unique_ptr<FrameScheduler> _frameScheduler;
+        mutable SeqLock<MediaPlayer::State> _state;     // What the getters answer with, see PublishState ( )
+        uint64_t                    _framesPresented{ 0 };
+        MemoryBudget::AccountRef    _memory{ MemoryBudget::Shared ( ).OpenAccount ( ) };
+        std::atomic_bool            _detached{ false }; // The MediaPlayer is gone, _owner can't be touched
+        void *                      _timeObserver{ nullptr };   // AVPlayer periodic observer for players that aren't polled
         
     };
 }
@@ -7,13 +7,22 @@
 //
 
 #include "AX-MediaPlayerOSXImpl.h"
+#include "AX-MediaPlayerOSXAudioTap.h"
 #include "cinder/app/App.h"
 #include <AVFoundation/AVFoundation.h>
+#include <fstream>
+#include <atomic>
+#include <chrono>
+#include <unistd.h>
+#include <cmath>
 
 using namespace ci;
 
 namespace
 {
+    // How often a player that isn't polled publishes its state while it plays
+    constexpr double kUnpolledPublishSeconds = 1.0 / 30.0;
+
     class StaticFrameLease : public AX::Video::MediaPlayer::FrameLease
     {
     public:
@@ -26,6 +35,77 @@ namespace
         gl::TextureRef  _texture;
         bool IsValid ( ) const override { return _texture != nullptr; };
     };
+
+    // A movie that never allocates a visual context, so audio only
+    // players have no video output, no frame copies and nothing to poll per frame.
+    class AudioMovie : public qtime::MovieBase
+    {
+    public:
+
+        static std::shared_ptr<AudioMovie> create ( const Url & url ) { return std::shared_ptr<AudioMovie> ( new AudioMovie ( url ) ); }
+        static std::shared_ptr<AudioMovie> create ( const fs::path & path ) { return std::shared_ptr<AudioMovie> ( new AudioMovie ( path ) ); }
+
+    protected:
+
+        AudioMovie ( const Url & url ) : MovieBase ( ) { MovieBase::initFromUrl ( url ); }
+        AudioMovie ( const fs::path & path ) : MovieBase ( ) { MovieBase::initFromPath ( path ); }
+
+        void allocateVisualContext ( ) override { }
+        void deallocateVisualContext ( ) override { }
+        void newFrame ( CVImageBufferRef cvImage ) override { }
+        void releaseFrame ( ) override { }
+    };
+
+    // qtime only plays from a path or url and doesn't expose the
+    // AVAssetResourceLoader, so byte sources are spilled to a cached temp file once.
+    // It's keyed by where the bytes come from (for bundles the bundle path and entry
+    // offset) and written under a name of its own first, so another player only ever
+    // finds a complete copy.
+    fs::path MaterializeByteSource ( const AX::Video::ByteSourceRef & source )
+    {
+        static std::atomic<uint64_t> kPartCounter{ 0 };
+
+        auto name = fs::path ( source->Name ( ) );
+        auto directory = fs::temp_directory_path ( ) / "AX-MediaPlayer";
+        auto path = directory / ( std::to_string ( std::hash<std::string>{ } ( source->Key ( ) ) ) + "-" + std::to_string ( source->Size ( ) ) + name.extension ( ).string ( ) );
+
+        std::error_code ec;
+        if ( fs::exists ( path, ec ) && fs::file_size ( path, ec ) == source->Size ( ) ) return path;
+
+        fs::create_directories ( directory, ec );
+
+        auto part = path;
+        part += "." + std::to_string ( getpid ( ) ) + "-" + std::to_string ( kPartCounter++ ) + ".part";
+
+        uint64_t offset = 0;
+        {
+            std::ofstream file ( part, std::ios::binary | std::ios::trunc );
+
+            std::vector<char> buffer ( 1 << 20 );
+            while ( file && offset < source->Size ( ) )
+            {
+                size_t count = source->Read ( offset, buffer.data ( ), buffer.size ( ) );
+                if ( count == 0 ) break;
+
+                file.write ( buffer.data ( ), count );
+                offset += count;
+            }
+
+            file.close ( );
+            if ( !file ) offset = 0;
+        }
+
+        // Whoever renames last wins, every copy is the same bytes
+        const bool written = offset == source->Size ( );
+        if ( written ) fs::rename ( part, path, ec );
+        if ( !written || ec )
+        {
+            fs::remove ( part, ec );
+            throw std::runtime_error ( "Couldn't write a temporary copy of " + source->Name ( ) );
+        }
+
+        return path;
+    }
 }
 
 namespace AX::Video
@@ -33,30 +113,47 @@ namespace AX::Video
     void MediaPlayer::Impl::StaticInitialize ( ) { }
     void MediaPlayer::Impl::StaticShutdown ( ) { }
     
-    MediaPlayer::Impl::Impl ( MediaPlayer & owner, const DataSourceRef & source, const Format& format )
+    MediaPlayer::Impl::Impl ( MediaPlayer & owner, const DataSourceRef & source, const Format& format, const ByteSourceRef & byteSource, MemoryBudget::AccountRef memory )
         : _owner ( owner )
         , _source ( source )
         , _format( format )
     {
+        // What Create ( ) reserved at admission, the real output size replaces it once it's ready
+        if ( memory ) _memory = std::move ( memory );
+
         try
         {
-            if ( format.IsHardwareAccelerated() )
+            if ( byteSource )
+            {
+                _source = DataSourcePath::create ( MaterializeByteSource ( byteSource ) );
+            }
+            
+            if ( format.IsAudioOnly() )
+            {
+                if ( _source->isUrl() )
+                {
+                    _player = AudioMovie::create ( _source->getUrl() );
+                }else
+                {
+                    _player = AudioMovie::create ( _source->getFilePath() );
+                }
+            }else if ( format.IsHardwareAccelerated() )
             {
-                if ( source->isUrl() )
+                if ( _source->isUrl() )
                 {
-                    _player = qtime::MovieGl::create( source->getUrl() );
+                    _player = qtime::MovieGl::create( _source->getUrl() );
                 }else
                 {
-                    _player = qtime::MovieGl::create ( source->getFilePath() );
+                    _player = qtime::MovieGl::create ( _source->getFilePath() );
                 }
             }else
             {
-                if ( source->isUrl() )
+                if ( _source->isUrl() )
                 {
-                    _player = qtime::MovieSurface::create( source->getUrl() );
+                    _player = qtime::MovieSurface::create( _source->getUrl() );
                 }else
                 {
-                    _player = qtime::MovieSurface::create ( source->getFilePath() );
+                    _player = qtime::MovieSurface::create ( _source->getFilePath() );
                 }
             }
             
@@ -65,20 +162,71 @@ namespace AX::Video
                 SetMuted( true );
             }
             
+            if ( _player && _owner.GetAudioNode ( ) )
+            {
+                _audioTap = std::make_unique<AudioTap> ( _owner.GetAudioNode ( ) );
+            }
+
+            if ( _player && _format.IsFrameDroppingEnabled ( ) && !_format.IsAudioOnly ( ) )
+            {
+                // qtime owns the output size, so the only way down from here is fewer frames
+                auto options = _format.FrameDroppingOptions ( );
+                if ( options.GetDegrade ( ) == FrameScheduler::Degrade::HalfSize ) options.DegradeTo ( FrameScheduler::Degrade::HalfRate );
+                _frameScheduler = std::make_unique<FrameScheduler> ( options );
+            }
+            
             if ( _player )
             {
+                LiveObjects::Add ( LiveObjects::Kind::Engines );
                 _duration = _player->getDuration();
                 _size = _player->getSize();
                 
                 _player->getReadySignal().connect( [=]
                 {
+                    if ( _detached.load ( ) ) return;
+
                     _duration = _player->getDuration();
                     _size = _player->getSize();
+                    
+                    if ( _format.IsAudioOnly() )
+                    {
+                        // Without this AVPlayer keeps decoding video nobody will ever see
+                        for ( AVPlayerItemTrack * track in [[_player->getPlayerHandle() currentItem] tracks] )
+                        {
+                            if ( [track.assetTrack.mediaType isEqualToString:AVMediaTypeVideo] ) track.enabled = NO;
+                        }
+                        _size = ivec2 ( 0 );
+                    }
+                    
+                    // qtime decides its own output size and buffering, so under memory
+                    // pressure there's nothing to shrink here, it's only counted towards the budget
+                    _memory->Set ( static_cast<uint64_t> ( _size.x ) * _size.y * 4 );
+
+                    // The audio track isn't known until the asset is ready
+                    if ( _audioTap ) _audioTap->Attach ( _player );
+
+                    // Nothing ticks a player that isn't polled, so AVPlayer calls back on the
+                    // main queue while it plays (and whenever it starts, stops or jumps) to keep the snapshot
+                    // moving. The AVPlayer only exists once the asset is ready.
+                    if ( !NeedsUpdate ( ) && !_timeObserver )
+                    {
+                        id observer = [_player->getPlayerHandle() addPeriodicTimeObserverForInterval:CMTimeMakeWithSeconds ( kUnpolledPublishSeconds, NSEC_PER_SEC ) queue:dispatch_get_main_queue() usingBlock:^( CMTime time )
+                        {
+                            if ( !_detached.load ( ) ) PublishState ( );
+                        }];
+                        _timeObserver = (void *)CFBridgingRetain ( observer );
+                    }
+
+                    PublishState ( );
                     _owner.OnReady.emit();
                 } );
                 _player->getEndedSignal().connect( [=]
                 {
+                    if ( _detached.load ( ) ) return;
+
                     _isPlaying = false;
+                    if ( _audioTap ) _audioTap->SetActive ( false );
+                    PublishState ( );
                     _owner.OnComplete.emit();
                 } );
             }
@@ -99,6 +247,7 @@ namespace AX::Video
         {
             _isPlaying = true;
             _player->play ( );
+            if ( _audioTap ) _audioTap->SetActive ( true );
         }
     }
 
@@ -108,6 +257,7 @@ namespace AX::Video
         {
             _isPlaying = false;
             _player->play ( true );
+            if ( _audioTap ) _audioTap->SetActive ( false );
         }
     }
 
@@ -181,6 +331,7 @@ namespace AX::Video
         if ( _player )
         {
             _player->setVolume( mute ? 0.0f : _volume );
+            _state.Modify ( [=] ( MediaPlayer::State & state ) { state.muted = mute; state.volume = mute ? 0.0f : _volume; } );
         }
     }
 
@@ -188,7 +339,7 @@ namespace AX::Video
     {
         if ( _player )
         {
-            return _player->getVolume() == 0.0f;
+            return GetState ( ).muted;
         }
 
         return false;
@@ -200,6 +351,7 @@ namespace AX::Video
         {
             _volume = volume;
             _player->setVolume( volume );
+            _state.Modify ( [volume] ( MediaPlayer::State & state ) { state.volume = volume; state.muted = volume == 0.0f; } );
         }
     }
 
@@ -207,7 +359,7 @@ namespace AX::Video
     {
         if ( _player )
         {
-            return _player->getVolume();
+            return GetState ( ).volume;
         }
 
         return 1.0f;
@@ -219,6 +371,7 @@ namespace AX::Video
         {
             _loop = loop;
             _player->setLoop ( loop );
+            _state.Modify ( [loop] ( MediaPlayer::State & state ) { state.looping = loop; } );
         }
     }
 
@@ -230,7 +383,23 @@ namespace AX::Video
     float MediaPlayer::Impl::GetPositionInSeconds ( ) const
     {
         if ( !_player ) return -1.0f;
-        return static_cast<float> ( _player->getCurrentTime() );
+        return static_cast<float> ( GetState ( ).position );
+    }
+
+    MediaPlayer::TimeRanges MediaPlayer::Impl::GetBufferedRanges ( ) const
+    {
+        MediaPlayer::TimeRanges result;
+        if ( !_player ) return result;
+
+        AVPlayerItem * item = [_player->getPlayerHandle() currentItem];
+        for ( NSValue * value in [item loadedTimeRanges] )
+        {
+            CMTimeRange range = [value CMTimeRangeValue];
+            float start = static_cast<float> ( CMTimeGetSeconds ( range.start ) );
+            result.push_back ( { start, start + static_cast<float> ( CMTimeGetSeconds ( range.duration ) ) } );
+        }
+
+        return result;
     }
 
     void MediaPlayer::Impl::SeekToSeconds ( float seconds, bool approximate )
@@ -239,6 +408,8 @@ namespace AX::Video
         {
             _owner.OnSeekStart.emit();
             _player->seekToTime( seconds );
+            if ( _audioTap ) _audioTap->Seek ( );
+            if ( _frameScheduler ) _frameScheduler->Reset ( );
             
             // @note(andrew): Unfortunately using the jumped signal isn't viable
             // as it gets called in a lot more cases than just seeking. Just firing
@@ -261,11 +432,18 @@ namespace AX::Video
         _player->seekToFrame( frame + delta );
     }
 
+    std::future<void> MediaPlayer::Impl::FlushCommands ( )
+    {
+        std::promise<void> done;
+        done.set_value ( );
+        return done.get_future ( );
+    }
+
     bool MediaPlayer::Impl::IsComplete ( ) const
     {
         if ( _player )
         {
-            return _player->isDone();
+            return GetState ( ).complete;
         }
         else
         {
@@ -292,7 +470,7 @@ namespace AX::Video
     {
         if ( _player )
         {
-            return _player->isPlayable();
+            return GetState ( ).ready;
         }
         return false;
     }
@@ -301,7 +479,7 @@ namespace AX::Video
     {
         if ( _player )
         {
-            return _player->hasAudio ( );
+            return GetState ( ).hasAudio;
         }
 
         return false;
@@ -309,9 +487,9 @@ namespace AX::Video
 
     bool MediaPlayer::Impl::HasVideo ( ) const
     {
-        if ( _player )
+        if ( _player && !_format.IsAudioOnly() )
         {
-            return _player->hasVisuals ( );
+            return GetState ( ).hasVideo;
         }
 
         return false;
@@ -321,12 +499,21 @@ namespace AX::Video
     {
         if ( _player )
         {
-            if ( _player->checkNewFrame() )
+            if ( !_format.IsAudioOnly() && _player->checkNewFrame() && ShouldPresent ( ) )
             {
                 _hasNewFrame.store( true );
+                _framesPresented++;
                 if ( !_format.IsHardwareAccelerated() )
                 {
                     _surface = std::static_pointer_cast<qtime::MovieSurface>( _player )->getSurface();
+
+                    // qtime converts on the main thread, so that's the producer thread here too
+                    if ( _surface )
+                    {
+                        FrameSink::Frame frame{ _surface->getData ( ), _surface->getSize ( ), _surface->getRowBytes ( ), _surface->getChannelOrder ( ), _player->getCurrentTime ( ) };
+                        _sinks.Dispatch ( frame, FrameSink::Thread::Producer );
+                        _sinks.Dispatch ( frame, FrameSink::Thread::Main );
+                    }
                 }
             }
             
@@ -351,9 +538,82 @@ namespace AX::Video
             }
         }
 
+        PublishState ( );
         return false;
     }
 
+    // qtime is asked once per tick (or by the time observer for players that
+    // aren't polled), always on the main thread, and the getters read the copy, so they're
+    // cheap and safe off the main thread. Intent (playing, rate, loop) is taken as last set.
+    void MediaPlayer::Impl::PublishState ( ) const
+    {
+        if ( !_player ) return;
+
+        const double position = _player->getCurrentTime ( );
+        double bufferedStart = 0.0, bufferedEnd = 0.0;
+
+        AVPlayerItem * item = [_player->getPlayerHandle() currentItem];
+        for ( NSValue * value in [item loadedTimeRanges] )
+        {
+            CMTimeRange range = [value CMTimeRangeValue];
+            double start = CMTimeGetSeconds ( range.start );
+            double end = start + CMTimeGetSeconds ( range.duration );
+            if ( position >= start && position <= end )
+            {
+                bufferedStart = start;
+                bufferedEnd = end;
+                break;
+            }
+        }
+
+        const float volume = _player->getVolume ( );
+        const bool complete = _player->isDone ( );
+        const bool ready = _player->isPlayable ( );
+        const bool hasAudio = _player->hasAudio ( );
+        const bool hasVideo = !_format.IsAudioOnly ( ) && _player->hasVisuals ( );
+
+        _state.Modify ( [&] ( MediaPlayer::State & state )
+        {
+            state.version++;
+            state.position = position;
+            state.duration = _duration;
+            state.rate = _playbackRate;
+            state.volume = volume;
+            state.bufferedStart = bufferedStart;
+            state.bufferedEnd = bufferedEnd;
+            state.framePts = _framesPresented > 0 ? position : -1.0;
+            state.framesPresented = _framesPresented;
+            state.width = _size.x;
+            state.height = _size.y;
+            state.ready = ready;
+            state.paused = !_isPlaying;
+            state.complete = complete;
+            state.hasAudio = hasAudio;
+            state.hasVideo = hasVideo;
+            state.muted = volume == 0.0f;
+            state.looping = _loop;
+        } );
+    }
+
+    MediaPlayer::State MediaPlayer::Impl::GetState ( ) const
+    {
+        return _state.Load ( );
+    }
+
+    bool MediaPlayer::Impl::ShouldPresent ( )
+    {
+        if ( !_frameScheduler ) return true;
+
+        // There's no per frame timestamp through qtime, so the frame is the one the clock is currently in.
+        // That never reads as superseded, but gaps still show up as missed frames and drive HalfRate.
+        double clock = _player->getCurrentTime ( );
+        double fps = _player->getFramerate ( );
+        double pts = fps > 0.0 ? std::floor ( clock * fps ) / fps : clock;
+        double now = std::chrono::duration<double> ( std::chrono::steady_clock::now ( ).time_since_epoch ( ) ).count ( );
+
+        return _frameScheduler->Evaluate ( pts, clock, IsPaused ( ) ? 0.0f : _playbackRate, now ) == FrameScheduler::Decision::Present;
+    }
+
     const Surface8uRef & MediaPlayer::Impl::GetSurface ( ) const
     {
         _hasNewFrame.store ( false );
@@ -362,7 +622,7 @@ namespace AX::Video
 
     MediaPlayer::FrameLeaseRef MediaPlayer::Impl::GetTexture ( ) const
     {
-        if ( _player )
+        if ( _player && !_format.IsAudioOnly() )
         {
             if ( _format.IsHardwareAccelerated() )
             {
@@ -373,9 +633,22 @@ namespace AX::Video
             {
                 _hasNewFrame.store ( false );
                 auto player = std::static_pointer_cast<qtime::MovieSurface>( _player );
-                if ( player && player->getSurface() )
+                auto surface = player ? player->getSurface() : nullptr;
+                if ( surface && _format.IsStreamingUploadEnabled ( ) )
+                {
+                    // MovieSurface hands out a new surface per frame, so a different one means a new frame
+                    if ( !_streamingTexture ) _streamingTexture = StreamingTexture::Create ( _format.StreamingUploadOptions ( ) );
+                    if ( surface != _uploadedSurface || !_streamingTexture->GetTexture ( ) )
+                    {
+                        _streamingTexture->Upload ( *surface );
+                        _uploadedSurface = surface;
+                    }
+
+                    return std::make_unique<StaticFrameLease>( _streamingTexture->GetTexture ( ) );
+                }
+                else if ( surface )
                 {
-                    auto texture = gl::Texture::create ( *player->getSurface(), gl::Texture::Format ( ).loadTopDown ( ) );
+                    auto texture = gl::Texture::create ( *surface, gl::Texture::Format ( ).loadTopDown ( ) );
                     return std::make_unique<StaticFrameLease>( texture );
                 }else
                 {
@@ -386,4 +659,29 @@ namespace AX::Video
         
         return nullptr;
     }
+
+    void MediaPlayer::Impl::Shutdown ( std::function<void ( )> done )
+    {
+        if ( done ) done ( );
+    }
+
+    MediaPlayer::Impl::~Impl ( )
+    {
+        Detach ( );
+        _audioTap = nullptr;
+        _memory->Set ( 0 );
+
+        if ( _timeObserver )
+        {
+            if ( _player ) [_player->getPlayerHandle() removeTimeObserver:(__bridge id)_timeObserver];
+            CFRelease ( _timeObserver );
+            _timeObserver = nullptr;
+        }
+
+        if ( _player )
+        {
+            _player = nullptr;
+            LiveObjects::Remove ( LiveObjects::Kind::Engines );
+        }
+    }
 }
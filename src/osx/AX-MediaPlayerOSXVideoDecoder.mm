@@ -0,0 +1,147 @@
+//
+//  AX-MediaPlayerOSXVideoDecoder.mm
+//  AX-MediaPlayer
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive (axinteractive.com.au)
+//
+
+#include "AX-MediaPlayerVideoDecoder.h"
+#include <AVFoundation/AVFoundation.h>
+#include <algorithm>
+#include <cstring>
+
+namespace AX::Video
+{
+    namespace
+    {
+        class OSXVideoDecoder : public VideoDecoder
+        {
+        public:
+
+            ~OSXVideoDecoder ( )
+            {
+                Close ( );
+                [_track release];
+                [_asset release];
+            }
+
+            bool Open ( const std::filesystem::path & path )
+            {
+                @autoreleasepool
+                {
+                    NSURL * url = [NSURL fileURLWithPath:[NSString stringWithUTF8String:path.c_str()]];
+                    _asset = [[AVURLAsset alloc] initWithURL:url options:@{ AVURLAssetPreferPreciseDurationAndTimingKey : @YES }];
+                    _track = [[[_asset tracksWithMediaType:AVMediaTypeVideo] firstObject] retain];
+                    if ( !_track ) return false;
+
+                    CGSize size = CGSizeApplyAffineTransform ( [_track naturalSize], CGAffineTransformIdentity );
+                    _width = static_cast<int32_t> ( size.width );
+                    _height = static_cast<int32_t> ( size.height );
+                    _frameRate = [_track nominalFrameRate];
+                    _duration = CMTimeGetSeconds ( [_asset duration] );
+                }
+
+                return _width > 0 && _height > 0 && Start ( kCMTimeZero );
+            }
+
+            int32_t GetWidth ( ) const override { return _width; }
+            int32_t GetHeight ( ) const override { return _height; }
+            double  GetFrameRate ( ) const override { return _frameRate; }
+            double  GetDurationInSeconds ( ) const override { return _duration; }
+
+            bool Seek ( double seconds ) override
+            {
+                // Same as OSXAudioDecoder, a fresh reader over the remaining time range
+                Close ( );
+                return Start ( CMTimeMakeWithSeconds ( seconds, 90000 ) );
+            }
+
+            bool Decode ( uint8_t * dst, size_t rowBytes, double & pts ) override
+            {
+                if ( !_output ) return false;
+
+                @autoreleasepool
+                {
+                    while ( true )
+                    {
+                        CMSampleBufferRef sample = [_output copyNextSampleBuffer];
+                        if ( !sample ) return false;
+
+                        CVImageBufferRef image = CMSampleBufferGetImageBuffer ( sample );
+                        if ( !image )
+                        {
+                            CFRelease ( sample );
+                            continue;
+                        }
+
+                        CVPixelBufferLockBaseAddress ( image, kCVPixelBufferLock_ReadOnly );
+                        const uint8_t * src = static_cast<const uint8_t *> ( CVPixelBufferGetBaseAddress ( image ) );
+                        const size_t srcRowBytes = CVPixelBufferGetBytesPerRow ( image );
+                        const size_t rows = std::min<size_t> ( _height, CVPixelBufferGetHeight ( image ) );
+                        const size_t bytes = std::min ( { rowBytes, srcRowBytes, static_cast<size_t> ( _width ) * 4 } );
+
+                        for ( size_t y = 0; y < rows; y++ )
+                        {
+                            std::memcpy ( dst + y * rowBytes, src + y * srcRowBytes, bytes );
+                        }
+
+                        CVPixelBufferUnlockBaseAddress ( image, kCVPixelBufferLock_ReadOnly );
+
+                        pts = CMTimeGetSeconds ( CMSampleBufferGetPresentationTimeStamp ( sample ) );
+                        CFRelease ( sample );
+                        return true;
+                    }
+                }
+            }
+
+        protected:
+
+            bool Start ( CMTime from )
+            {
+                @autoreleasepool
+                {
+                    NSError * error = nil;
+                    _reader = [[AVAssetReader alloc] initWithAsset:_asset error:&error];
+                    if ( !_reader ) return false;
+
+                    NSDictionary * settings = @{ (id)kCVPixelBufferPixelFormatTypeKey : @( kCVPixelFormatType_32BGRA ) };
+
+                    _output = [[AVAssetReaderTrackOutput alloc] initWithTrack:_track outputSettings:settings];
+                    _output.alwaysCopiesSampleData = NO;
+                    if ( ![_reader canAddOutput:_output] ) return false;
+                    [_reader addOutput:_output];
+
+                    _reader.timeRange = CMTimeRangeMake ( from, kCMTimePositiveInfinity );
+                    return [_reader startReading];
+                }
+            }
+
+            void Close ( )
+            {
+                [_reader cancelReading];
+                [_output release];
+                [_reader release];
+                _output = nil;
+                _reader = nil;
+            }
+
+            AVURLAsset *                _asset{ nil };
+            AVAssetTrack *              _track{ nil };
+            AVAssetReader *             _reader{ nil };
+            AVAssetReaderTrackOutput *  _output{ nil };
+            int32_t                     _width{ 0 };
+            int32_t                     _height{ 0 };
+            double                      _frameRate{ 0.0 };
+            double                      _duration{ 0.0 };
+        };
+    }
+
+    std::unique_ptr<VideoDecoder> VideoDecoder::Create ( const std::filesystem::path & path )
+    {
+        auto decoder = std::make_unique<OSXVideoDecoder> ( );
+        if ( !decoder->Open ( path ) ) return nullptr;
+
+        return decoder;
+    }
+}
@@ -0,0 +1,119 @@
+//
+//  BundlePacker.cxx
+//  BundlePacker
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive
+//
+
+#include "AX-MediaPlayerBundle.h"
+
+#include <charconv>
+#include <iostream>
+#include <algorithm>
+
+namespace fs = std::filesystem;
+using AX::Video::MediaBundle;
+
+static int PrintUsage ( )
+{
+    std::cout << "Usage:\n"
+              << "  BundlePacker -o <output.axb> [--align <bytes>] [--meta key=value ...] <file or directory> ...\n"
+              << "  BundlePacker --list <bundle.axb>\n\n"
+              << "Directories are packed recursively, entries are named by their path relative to the\n"
+              << "directory given on the command line and are played back with bundle://<name>\n";
+    return 1;
+}
+
+static int ListBundle ( const fs::path & path )
+{
+    auto bundle = MediaBundle::Open ( path );
+    if ( !bundle )
+    {
+        std::cerr << "Unable to open bundle " << path << std::endl;
+        return 1;
+    }
+
+    for ( auto & entry : bundle->Entries ( ) )
+    {
+        std::cout << entry.name << "\t" << entry.offset << "\t" << entry.length;
+        for ( auto & [key, value] : entry.metadata ) std::cout << "\t" << key << "=" << value;
+        std::cout << "\n";
+    }
+
+    return 0;
+}
+
+int main ( int argc, char ** argv )
+{
+    fs::path output;
+    uint32_t alignment = MediaBundle::kDefaultAlignment;
+    MediaBundle::Metadata metadata;
+    std::vector<MediaBundle::PackInput> inputs;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if ( arg == "--list" && hasValue )
+        {
+            return ListBundle ( argv[++i] );
+        }
+        else if ( arg == "-o" && hasValue )
+        {
+            output = argv[++i];
+        }
+        else if ( arg == "--align" && hasValue )
+        {
+            const std::string value = argv[++i];
+            auto [end, error] = std::from_chars ( value.data ( ), value.data ( ) + value.size ( ), alignment );
+            if ( error != std::errc ( ) || end != value.data ( ) + value.size ( ) )
+            {
+                std::cerr << "Invalid alignment: " << value << std::endl;
+                return PrintUsage ( );
+            }
+        }
+        else if ( arg == "--meta" && hasValue )
+        {
+            std::string pair = argv[++i];
+            auto split = pair.find ( '=' );
+            if ( split == std::string::npos ) return PrintUsage ( );
+            metadata[pair.substr ( 0, split )] = pair.substr ( split + 1 );
+        }
+        else if ( fs::is_directory ( arg ) )
+        {
+            std::vector<MediaBundle::PackInput> found;
+            for ( auto & item : fs::recursive_directory_iterator ( arg ) )
+            {
+                if ( !item.is_regular_file ( ) ) continue;
+                found.push_back ( { item.path ( ), fs::relative ( item.path ( ), arg ).generic_string ( ), metadata } );
+            }
+
+            // Keep the packing order stable between runs so bundles can be diffed
+            std::sort ( found.begin ( ), found.end ( ), [] ( auto & a, auto & b ) { return a.name < b.name; } );
+            inputs.insert ( inputs.end ( ), found.begin ( ), found.end ( ) );
+        }
+        else if ( fs::is_regular_file ( arg ) )
+        {
+            inputs.push_back ( { arg, fs::path ( arg ).filename ( ).string ( ), metadata } );
+        }
+        else
+        {
+            std::cerr << "Unknown argument or missing file: " << arg << std::endl;
+            return PrintUsage ( );
+        }
+    }
+
+    if ( output.empty ( ) || inputs.empty ( ) ) return PrintUsage ( );
+
+    std::string error;
+    if ( !MediaBundle::Pack ( output, inputs, alignment, &error ) )
+    {
+        std::cerr << "Packing failed: " << error << std::endl;
+        return 1;
+    }
+
+    std::cout << "Packed " << inputs.size ( ) << " entries into " << output.string ( ) << std::endl;
+    return 0;
+}
@@ -0,0 +1,420 @@
+//
+//  HttpHarness.cxx
+//  HttpHarness
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive
+//
+
+#include "AX-MediaPlayerHttpSource.h"
+
+#include <mutex>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    #pragma comment(lib, "ws2_32.lib")
+#else
+    #include <unistd.h>
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/select.h>
+    #include <sys/socket.h>
+#endif
+
+// Serves a generated file over plain http from a loopback server, once honouring Range
+// requests and once ignoring them like a dumb server would, and plays it through an
+// HttpByteSource the way a looping player does. Checks that every byte matches, that a
+// second pass (and a later run) doesn't download anything, that the cache replays with
+// the server gone, and that the cache stays under MaxCacheBytes by dropping the least
+// recently played segments.
+
+namespace fs = std::filesystem;
+using namespace AX::Video;
+
+namespace
+{
+#ifdef _WIN32
+    using SocketHandle = SOCKET;
+    static const SocketHandle kInvalidSocket = INVALID_SOCKET;
+    inline void CloseSocket ( SocketHandle socket ) { closesocket ( socket ); }
+#else
+    using SocketHandle = int;
+    static const SocketHandle kInvalidSocket = -1;
+    inline void CloseSocket ( SocketHandle socket ) { close ( socket ); }
+#endif
+
+#ifdef MSG_NOSIGNAL
+    static const int kSendFlags = MSG_NOSIGNAL;     // The size probe hangs up mid body
+#else
+    static const int kSendFlags = 0;
+#endif
+
+    struct Settings
+    {
+        uint64_t    megabytes{ 16 };
+        size_t      segmentKB{ 256 };
+        size_t      chunk{ 64 * 1024 };
+        int         seeks{ 6 };
+        fs::path    cache;
+    };
+
+    class Server
+    {
+    public:
+
+        Server ( const std::vector<uint8_t> & data, bool ranges )
+            : _data ( data )
+            , _ranges ( ranges )
+        { }
+
+        ~Server ( ) { Stop ( ); }
+
+        bool Start ( )
+        {
+#ifdef _WIN32
+            WSADATA data;
+            WSAStartup ( MAKEWORD ( 2, 2 ), &data );
+#endif
+            _listener = socket ( AF_INET, SOCK_STREAM, IPPROTO_TCP );
+            if ( _listener == kInvalidSocket ) return false;
+
+            sockaddr_in address{ };
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl ( INADDR_LOOPBACK );
+            address.sin_port = 0;
+
+            socklen_t length = sizeof ( address );
+            if ( bind ( _listener, reinterpret_cast<sockaddr *> ( &address ), sizeof ( address ) ) != 0 ) return false;
+            if ( listen ( _listener, 16 ) != 0 ) return false;
+            if ( getsockname ( _listener, reinterpret_cast<sockaddr *> ( &address ), &length ) != 0 ) return false;
+
+            _port = ntohs ( address.sin_port );
+            _running = true;
+            _acceptor = std::thread ( [this] { Accept ( ); } );
+            return true;
+        }
+
+        void Stop ( )
+        {
+            if ( !_running.exchange ( false ) ) return;
+
+            _acceptor.join ( );
+            CloseSocket ( _listener );
+
+            std::unique_lock<std::mutex> lk ( _mutex );
+            for ( auto & connection : _connections ) connection.join ( );
+            _connections.clear ( );
+        }
+
+        std::string GetUrl ( const std::string & name ) const { return "http://127.0.0.1:" + std::to_string ( _port ) + "/" + name; }
+        uint64_t    GetRequests ( ) const { return _requests.load ( ); }
+
+    protected:
+
+        void Accept ( )
+        {
+            while ( _running )
+            {
+                fd_set readable;
+                FD_ZERO ( &readable );
+                FD_SET ( _listener, &readable );
+
+                timeval timeout{ 0, 50000 };
+                if ( select ( static_cast<int> ( _listener + 1 ), &readable, nullptr, nullptr, &timeout ) <= 0 ) continue;
+
+                SocketHandle client = accept ( _listener, nullptr, nullptr );
+                if ( client == kInvalidSocket ) continue;
+
+                std::unique_lock<std::mutex> lk ( _mutex );
+                _connections.emplace_back ( [this, client] { Serve ( client ); CloseSocket ( client ); } );
+            }
+        }
+
+        bool Send ( SocketHandle client, const char * data, size_t length )
+        {
+            while ( length > 0 )
+            {
+                int sent = send ( client, data, static_cast<int> ( std::min<size_t> ( length, 1 << 20 ) ), kSendFlags );
+                if ( sent <= 0 ) return false;
+
+                data += sent;
+                length -= static_cast<size_t> ( sent );
+            }
+
+            return true;
+        }
+
+        void Serve ( SocketHandle client )
+        {
+            std::string request;
+            char buffer[4096];
+            while ( request.find ( "\r\n\r\n" ) == std::string::npos )
+            {
+                int count = recv ( client, buffer, sizeof ( buffer ), 0 );
+                if ( count <= 0 ) return;
+                request.append ( buffer, static_cast<size_t> ( count ) );
+            }
+
+            _requests++;
+
+            std::string lower = request;
+            std::transform ( lower.begin ( ), lower.end ( ), lower.begin ( ), [] ( unsigned char c ) { return static_cast<char> ( std::tolower ( c ) ); } );
+
+            uint64_t begin = 0, end = _data.size ( ) - 1;
+            bool ranged = false;
+
+            auto range = lower.find ( "\r\nrange: bytes=" );
+            if ( _ranges && range != std::string::npos )
+            {
+                unsigned long long first = 0, last = 0;
+                if ( std::sscanf ( lower.c_str ( ) + range + 15, "%llu-%llu", &first, &last ) == 2 && first <= last && first < _data.size ( ) )
+                {
+                    begin = first;
+                    end = std::min<uint64_t> ( last, _data.size ( ) - 1 );
+                    ranged = true;
+                }
+            }
+
+            std::string header = ranged ? "HTTP/1.1 206 Partial Content\r\n" : "HTTP/1.1 200 OK\r\n";
+            header += "Content-Length: " + std::to_string ( end - begin + 1 ) + "\r\n";
+            if ( ranged ) header += "Content-Range: bytes " + std::to_string ( begin ) + "-" + std::to_string ( end ) + "/" + std::to_string ( _data.size ( ) ) + "\r\n";
+            header += "Connection: close\r\n\r\n";
+
+            if ( !Send ( client, header.data ( ), header.size ( ) ) ) return;
+            Send ( client, reinterpret_cast<const char *> ( _data.data ( ) + begin ), static_cast<size_t> ( end - begin + 1 ) );
+        }
+
+        const std::vector<uint8_t> &    _data;
+        bool                            _ranges{ true };
+        SocketHandle                    _listener{ kInvalidSocket };
+        uint16_t                        _port{ 0 };
+        std::atomic_bool                _running{ false };
+        std::atomic<uint64_t>           _requests{ 0 };
+        std::thread                     _acceptor;
+        std::mutex                      _mutex;
+        std::vector<std::thread>        _connections;
+    };
+
+    std::vector<uint8_t> Generate ( uint64_t size )
+    {
+        std::vector<uint8_t> data ( static_cast<size_t> ( size ) );
+        std::mt19937 random ( 7 );
+        for ( auto & byte : data ) byte = static_cast<uint8_t> ( random ( ) );
+        return data;
+    }
+
+    // Reads the whole source like a player, sequentially with a few seeks, and counts wrong or missing bytes
+    uint64_t Play ( HttpByteSource & source, const std::vector<uint8_t> & expected, const Settings & settings, uint32_t seed )
+    {
+        if ( source.Size ( ) != expected.size ( ) ) return expected.size ( );
+
+        std::vector<uint8_t> buffer ( settings.chunk );
+        std::mt19937_64 random ( seed );
+
+        const uint64_t size = expected.size ( );
+        const uint64_t seekEvery = settings.seeks > 0 ? size / ( settings.seeks + 1 ) : size;
+        uint64_t offset = 0, sinceSeek = 0, played = 0, wrong = 0;
+
+        while ( played < size )
+        {
+            if ( offset >= size ) offset = 0;
+
+            const size_t length = static_cast<size_t> ( std::min<uint64_t> ( buffer.size ( ), size - offset ) );
+            const size_t read = source.Read ( offset, buffer.data ( ), length );
+
+            wrong += length - read;
+            if ( std::memcmp ( buffer.data ( ), expected.data ( ) + offset, read ) != 0 ) wrong += read;
+
+            played += length;
+            offset += length;
+            sinceSeek += length;
+
+            if ( sinceSeek >= seekEvery )
+            {
+                offset = random ( ) % size;
+                sinceSeek = 0;
+            }
+        }
+
+        // The seeks skip parts of it, so make sure all of it has been through once
+        for ( offset = 0; offset < size; offset += buffer.size ( ) )
+        {
+            const size_t length = static_cast<size_t> ( std::min<uint64_t> ( buffer.size ( ), size - offset ) );
+            const size_t read = source.Read ( offset, buffer.data ( ), length );
+
+            wrong += length - read;
+            if ( std::memcmp ( buffer.data ( ), expected.data ( ) + offset, read ) != 0 ) wrong += read;
+        }
+
+        return wrong;
+    }
+
+    uint64_t CacheBytes ( const fs::path & root )
+    {
+        uint64_t total = 0;
+        std::error_code ec;
+        for ( fs::recursive_directory_iterator it ( root, ec ), end; !ec && it != end; it.increment ( ec ) )
+        {
+            std::error_code error;
+            if ( it->path ( ).extension ( ) == ".seg" ) total += it->file_size ( error );
+        }
+
+        return total;
+    }
+
+    bool Check ( bool ok, const std::string & what )
+    {
+        std::cout << ( ok ? "  ok   " : "  FAIL " ) << what << std::endl;
+        return ok;
+    }
+
+    bool RunServer ( const std::vector<uint8_t> & data, const Settings & settings, bool ranges )
+    {
+        std::cout << ( ranges ? "Range requests" : "No range support" ) << std::endl;
+
+        const fs::path cache = settings.cache / ( ranges ? "ranges" : "whole" );
+        std::error_code ec;
+        fs::remove_all ( cache, ec );
+
+        auto options = HttpByteSource::Options ( )
+            .SegmentSize ( settings.segmentKB * 1024 )
+            .CacheDirectory ( cache )
+            .TimeoutSeconds ( 5.0f )
+            .MaxCacheBytes ( 0 );
+
+        Server server ( data, ranges );
+        if ( !Check ( server.Start ( ), "server started" ) ) return false;
+
+        const auto url = server.GetUrl ( "clip.mp4" );
+        bool ok = true;
+
+        {
+            auto source = HttpByteSource::Create ( url, options );
+            ok &= Check ( source && Play ( *source, data, settings, 1 ) == 0, "first pass matches" );
+            ok &= Check ( source && source->IsFullyCached ( ), "fully cached after the first pass" );
+
+            const uint64_t served = server.GetRequests ( );
+            const uint64_t requested = source ? source->GetStats ( ).requests : 0;
+
+            ok &= Check ( source && Play ( *source, data, settings, 2 ) == 0, "second pass matches" );
+            ok &= Check ( server.GetRequests ( ) == served && source && source->GetStats ( ).requests == requested,
+                          "second pass made no requests (" + std::to_string ( server.GetRequests ( ) - served ) + ")" );
+        }
+
+        {
+            // A later run of the app only asks how big the file is
+            const uint64_t served = server.GetRequests ( );
+            auto source = HttpByteSource::Create ( url, options );
+            ok &= Check ( source && Play ( *source, data, settings, 3 ) == 0, "reopened source matches" );
+            ok &= Check ( source && source->GetStats ( ).requests == 0 && server.GetRequests ( ) - served == 1,
+                          "reopened source only probed the size (" + std::to_string ( server.GetRequests ( ) - served ) + " requests)" );
+        }
+
+        server.Stop ( );
+
+        {
+            auto source = HttpByteSource::Create ( url, options );
+            ok &= Check ( source && Play ( *source, data, settings, 4 ) == 0, "offline replay matches" );
+            ok &= Check ( source && source->GetStats ( ).requests == 0, "offline replay made no requests" );
+        }
+
+        return ok;
+    }
+
+    bool RunEviction ( const std::vector<uint8_t> & data, const Settings & settings )
+    {
+        std::cout << "Eviction" << std::endl;
+
+        const fs::path cache = settings.cache / "evict";
+        std::error_code ec;
+        fs::remove_all ( cache, ec );
+
+        const uint64_t segment = settings.segmentKB * 1024;
+        const uint64_t limit = data.size ( ) / 2;
+
+        auto options = HttpByteSource::Options ( )
+            .SegmentSize ( segment )
+            .CacheDirectory ( cache )
+            .TimeoutSeconds ( 5.0f )
+            .MaxCacheBytes ( limit );
+
+        Server server ( data, true );
+        if ( !Check ( server.Start ( ), "server started" ) ) return false;
+
+        bool ok = true;
+        auto source = HttpByteSource::Create ( server.GetUrl ( "clip.mp4" ), options );
+        Settings sequential = settings;
+        sequential.seeks = 0;
+
+        ok &= Check ( source && Play ( *source, data, sequential, 5 ) == 0, "plays with a cache half its size" );
+
+        // Trimming is allowed to lag by an eighth of the limit (or a segment) plus what's being written
+        const uint64_t used = CacheBytes ( cache );
+        const uint64_t slack = std::max ( limit / 8, segment ) + segment * 4;
+        ok &= Check ( used <= limit + slack, "cache is " + std::to_string ( used ) + " bytes against a " + std::to_string ( limit ) + " limit" );
+
+        // Played start to end, so the end of the file is what should be left
+        const auto ranges = source ? source->GetCachedRanges ( ) : std::vector<HttpByteSource::Range> { };
+        ok &= Check ( !ranges.empty ( ) && ranges.back ( ).end == data.size ( ) && ranges.front ( ).begin > 0, "least recently played segments went first" );
+
+        ok &= Check ( source && Play ( *source, data, sequential, 6 ) == 0, "evicted segments are fetched again" );
+        return ok;
+    }
+
+    int PrintUsage ( )
+    {
+        std::cout << "Usage:\n"
+                  << "  HttpHarness [--size <MB>] [--segment <KB>] [--chunk <KB>] [--seeks <n>] [--cache <dir>]\n\n"
+                  << "Serves a generated file from a loopback http server, with and without range support, and\n"
+                  << "plays it through the http cache. Exits non zero if any check fails.\n";
+        return 1;
+    }
+}
+
+int main ( int argc, char ** argv )
+{
+    Settings settings;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if ( arg == "--size" && hasValue ) settings.megabytes = std::stoull ( argv[++i] );
+        else if ( arg == "--segment" && hasValue ) settings.segmentKB = std::stoul ( argv[++i] );
+        else if ( arg == "--chunk" && hasValue ) settings.chunk = std::stoul ( argv[++i] ) * 1024;
+        else if ( arg == "--seeks" && hasValue ) settings.seeks = std::stoi ( argv[++i] );
+        else if ( arg == "--cache" && hasValue ) settings.cache = argv[++i];
+        else
+        {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return PrintUsage ( );
+        }
+    }
+
+    if ( settings.megabytes == 0 || settings.chunk == 0 || settings.segmentKB < 64 ) return PrintUsage ( );
+    if ( settings.cache.empty ( ) ) settings.cache = fs::temp_directory_path ( ) / "AX-HttpHarness";
+
+    const auto data = Generate ( settings.megabytes * 1024 * 1024 );
+
+    bool ok = RunServer ( data, settings, true );
+    ok &= RunServer ( data, settings, false );
+    ok &= RunEviction ( data, settings );
+
+    std::error_code ec;
+    fs::remove_all ( settings.cache, ec );
+
+    return ok ? 0 : 1;
+}
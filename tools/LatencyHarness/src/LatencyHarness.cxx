@@ -0,0 +1,566 @@
+//
+//  LatencyHarness.cxx
+//  LatencyHarness
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive
+//
+
+#include "AX-MediaPlayerRawVideoFile.h"
+#include "AX-MediaPlayerFrameSlots.h"
+#include "AX-MediaPlayerPresentationScheduler.h"
+#include "AX-MediaPlayerCommandQueue.h"
+#include "AX-MediaPlayerExecutor.h"
+
+#include <cmath>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+
+// Plays a generated Y4M clip, with each frame's index drawn into the picture as
+// a barcode, through the same stages a Windows player's frames go through. A poller stands in
+// for OnVideoStreamTick and hands each new frame to the Executor to be converted into a
+// FrameSlots write slot (ProcessFrame), and a display loop ticking at the refresh rate swaps
+// it in (SwapFrame, optionally through the PresentationScheduler). The loop then reads the
+// barcode back out of whatever it would have drawn. MediaFoundation itself only exists on
+// Windows, so the clock and decoder are simulated, and everything from "the frame is due" to
+// "the frame is on screen" is the library's real code. No window, no GPU, runs anywhere.
+
+namespace fs = std::filesystem;
+using namespace AX::Video;
+
+namespace
+{
+    static constexpr int kIndexBits = 20;
+    static constexpr int kCheckBits = 4;
+    static constexpr int kBarcodeBits = kIndexBits + kCheckBits;
+
+    struct Settings
+    {
+        int         width{ 320 };
+        int         height{ 180 };
+        int         fps{ 30 };
+        double      refresh{ 60.0 };
+        double      seconds{ 10.0 };
+        int         seeks{ 20 };
+        double      seekInterval{ 0.5 };
+        bool        queued{ false };
+        size_t      queueDepth{ 6 };
+        float       rate{ 1.0f };
+        uint32_t    seed{ 1 };
+        double      maxP99Ms{ 0.0 };
+        fs::path    clip;
+        fs::path    output;
+    };
+
+    double Now ( )
+    {
+        return std::chrono::duration<double> ( std::chrono::steady_clock::now ( ).time_since_epoch ( ) ).count ( );
+    }
+
+    uint32_t CheckNibble ( uint32_t index )
+    {
+        return ( index * 7 + 3 ) & ( ( 1u << kCheckBits ) - 1 );
+    }
+
+    // Top quarter of the picture is the barcode, one block per bit, white for set
+    bool GenerateClip ( const fs::path & path, const Settings & settings, int frames )
+    {
+        std::ofstream file ( path, std::ios::binary | std::ios::trunc );
+        if ( !file ) return false;
+
+        const int w = settings.width, h = settings.height;
+        file << "YUV4MPEG2 W" << w << " H" << h << " F" << settings.fps << ":1 Ip A1:1 C420jpeg\n";
+
+        std::vector<uint8_t> luma ( static_cast<size_t> ( w ) * h );
+        std::vector<uint8_t> chroma ( static_cast<size_t> ( ( w + 1 ) / 2 ) * ( ( h + 1 ) / 2 ) * 2, 128 );
+
+        for ( int index = 0; index < frames; index++ )
+        {
+            const uint32_t code = static_cast<uint32_t> ( index ) | ( CheckNibble ( index ) << kIndexBits );
+            for ( int y = 0; y < h; y++ )
+            {
+                uint8_t * row = luma.data ( ) + static_cast<size_t> ( y ) * w;
+                for ( int x = 0; x < w; x++ )
+                {
+                    if ( y < h / 4 )
+                    {
+                        const int bit = x * kBarcodeBits / w;
+                        row[x] = ( code >> bit ) & 1 ? 235 : 16;
+                    }
+                    else
+                    {
+                        // Something moving underneath, so it looks like video to a human too
+                        row[x] = static_cast<uint8_t> ( 16 + ( ( x + y + index * 4 ) % 220 ) );
+                    }
+                }
+            }
+
+            file << "FRAME\n";
+            file.write ( reinterpret_cast<const char *> ( luma.data ( ) ), static_cast<std::streamsize> ( luma.size ( ) ) );
+            file.write ( reinterpret_cast<const char *> ( chroma.data ( ) ), static_cast<std::streamsize> ( chroma.size ( ) ) );
+        }
+
+        return static_cast<bool> ( file );
+    }
+
+    // -1 if the barcode doesn't check out, i.e a torn or stale buffer
+    int32_t ReadBarcode ( const uint8_t * bgra, int width, int height )
+    {
+        const int y = height / 8;
+        uint32_t code = 0;
+        for ( int bit = 0; bit < kBarcodeBits; bit++ )
+        {
+            const int x = ( 2 * bit + 1 ) * width / ( 2 * kBarcodeBits );
+            const uint8_t * pixel = bgra + ( static_cast<size_t> ( y ) * width + x ) * 4;
+            if ( pixel[1] > 128 ) code |= 1u << bit;
+        }
+
+        const uint32_t index = code & ( ( 1u << kIndexBits ) - 1 );
+        return ( code >> kIndexBits ) == CheckNibble ( index ) ? static_cast<int32_t> ( index ) : -1;
+    }
+
+    // BT.601 video range, what the Windows path's TransferVideoFrame does for us there
+    void ConvertToBGRA ( const RawVideoFile::Frame & frame, uint8_t * out )
+    {
+        const auto & Y = frame.planes[0];
+        const auto & U = frame.planes[1];
+        const auto & V = frame.planes[2];
+
+        for ( int y = 0; y < Y.height; y++ )
+        {
+            const uint8_t * yRow = Y.data + static_cast<size_t> ( y ) * Y.rowBytes;
+            const uint8_t * uRow = U.data + static_cast<size_t> ( y / 2 ) * U.rowBytes;
+            const uint8_t * vRow = V.data + static_cast<size_t> ( y / 2 ) * V.rowBytes;
+            uint8_t * o = out + static_cast<size_t> ( y ) * Y.width * 4;
+
+            for ( int x = 0; x < Y.width; x++, o += 4 )
+            {
+                const int c = yRow[x] - 16, d = uRow[x / 2] - 128, e = vRow[x / 2] - 128;
+                o[0] = static_cast<uint8_t> ( std::clamp ( ( 298 * c + 516 * d + 128 ) >> 8, 0, 255 ) );
+                o[1] = static_cast<uint8_t> ( std::clamp ( ( 298 * c - 100 * d - 208 * e + 128 ) >> 8, 0, 255 ) );
+                o[2] = static_cast<uint8_t> ( std::clamp ( ( 298 * c + 409 * e + 128 ) >> 8, 0, 255 ) );
+                o[3] = 255;
+            }
+        }
+    }
+
+    // Stand-in for the media engine's clock, controlled through a CommandQueue like a player is
+    class Engine
+    {
+    public:
+
+        Engine ( double duration ) : _duration ( duration ) { }
+
+        void Play ( ) { _commands.Push ( CommandQueue::Kind::Playback, [this] { Apply ( [&] { _playing = true; } ); } ); }
+        void Pause ( ) { _commands.Push ( CommandQueue::Kind::Playback, [this] { Apply ( [&] { _playing = false; } ); } ); }
+        void SetRate ( float rate ) { _commands.Push ( CommandQueue::Kind::Rate, [this, rate] { Apply ( [&] { _rate = rate; } ); } ); }
+        void Seek ( double seconds ) { _commands.Push ( CommandQueue::Kind::Seek, [this, seconds] { Apply ( [&] { _anchorMedia = seconds; _generation++; } ); } ); }
+        void Flush ( ) { _commands.Flush ( ).wait ( ); }
+
+        double GetMediaTime ( double wall ) const
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            return MediaAt ( wall );
+        }
+
+        // Wall time the clock reached (or will reach) `media`
+        double GetWallTime ( double media ) const
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            return _playing && _rate > 0.0f ? _anchorWall + ( media - _anchorMedia ) / _rate : _anchorWall;
+        }
+
+        uint64_t GetGeneration ( ) const
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            return _generation;
+        }
+
+    protected:
+
+        template <typename Function>
+        void Apply ( Function && change )
+        {
+            std::unique_lock<std::mutex> lk ( _mutex );
+            const double wall = Now ( );
+            _anchorMedia = MediaAt ( wall );
+            _anchorWall = wall;
+            change ( );
+        }
+
+        double MediaAt ( double wall ) const
+        {
+            const double media = _playing ? _anchorMedia + ( wall - _anchorWall ) * _rate : _anchorMedia;
+            return std::clamp ( media, 0.0, _duration );
+        }
+
+        mutable std::mutex  _mutex;
+        double              _duration;
+        double              _anchorWall{ Now ( ) };
+        double              _anchorMedia{ 0.0 };
+        float               _rate{ 1.0f };
+        bool                _playing{ false };
+        uint64_t            _generation{ 0 };
+        CommandQueue        _commands{ Executor::Priority::Present };
+    };
+
+    struct Distribution
+    {
+        std::vector<double> samples;
+
+        void Add ( double value ) { samples.push_back ( value ); }
+
+        double Percentile ( double p ) const
+        {
+            if ( samples.empty ( ) ) return 0.0;
+            std::vector<double> sorted = samples;
+            std::sort ( sorted.begin ( ), sorted.end ( ) );
+            return sorted[static_cast<size_t> ( std::min<double> ( sorted.size ( ) - 1, std::floor ( p * ( sorted.size ( ) - 1 ) + 0.5 ) ) )];
+        }
+
+        std::string ToJson ( double scale = 1000.0 ) const
+        {
+            double sum = 0.0, max = 0.0;
+            for ( double s : samples ) { sum += s; max = std::max ( max, s ); }
+
+            std::ostringstream json;
+            json << "{ \"count\": " << samples.size ( )
+                 << ", \"mean\": " << ( samples.empty ( ) ? 0.0 : sum / samples.size ( ) * scale )
+                 << ", \"p50\": " << Percentile ( 0.5 ) * scale
+                 << ", \"p90\": " << Percentile ( 0.9 ) * scale
+                 << ", \"p99\": " << Percentile ( 0.99 ) * scale
+                 << ", \"max\": " << max * scale << " }";
+            return json.str ( );
+        }
+    };
+
+    int PrintUsage ( )
+    {
+        std::cout << "Usage:\n"
+                  << "  LatencyHarness [--size <w>x<h>] [--fps <n>] [--refresh <hz>] [--seconds <s>] [--seeks <n>]\n"
+                  << "                 [--rate <r>] [--queued <depth>] [--seed <n>] [--clip <file.y4m>] [--out <report.json>]\n"
+                  << "                 [--max-p99-ms <ms>]\n\n"
+                  << "Generates (or reuses) a clip with the frame index encoded in each picture, plays it through\n"
+                  << "the frame hand off the players use and reports what was actually drawn on each refresh as JSON.\n"
+                  << "Exits non zero if a frame couldn't be read back, a seek never landed or p99 latency is over the limit.\n";
+        return 1;
+    }
+}
+
+int main ( int argc, char ** argv )
+{
+    Settings settings;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if ( arg == "--size" && hasValue )
+        {
+            if ( std::sscanf ( argv[++i], "%dx%d", &settings.width, &settings.height ) != 2 ) return PrintUsage ( );
+        }
+        else if ( arg == "--fps" && hasValue ) settings.fps = std::stoi ( argv[++i] );
+        else if ( arg == "--refresh" && hasValue ) settings.refresh = std::stod ( argv[++i] );
+        else if ( arg == "--seconds" && hasValue ) settings.seconds = std::stod ( argv[++i] );
+        else if ( arg == "--seeks" && hasValue ) settings.seeks = std::stoi ( argv[++i] );
+        else if ( arg == "--rate" && hasValue ) settings.rate = std::stof ( argv[++i] );
+        else if ( arg == "--queued" && hasValue ) { settings.queued = true; settings.queueDepth = std::stoul ( argv[++i] ); }
+        else if ( arg == "--seed" && hasValue ) settings.seed = static_cast<uint32_t> ( std::stoul ( argv[++i] ) );
+        else if ( arg == "--clip" && hasValue ) settings.clip = argv[++i];
+        else if ( arg == "--out" && hasValue ) settings.output = argv[++i];
+        else if ( arg == "--max-p99-ms" && hasValue ) settings.maxP99Ms = std::stod ( argv[++i] );
+        else
+        {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return PrintUsage ( );
+        }
+    }
+
+    if ( settings.width < kBarcodeBits * 2 || settings.height < 8 || settings.fps <= 0 || settings.refresh <= 0.0 || settings.rate <= 0.0f ) return PrintUsage ( );
+
+    // Long enough to never run off the end, seeks land in the first half
+    const double runSeconds = 0.5 + settings.seconds + settings.seeks * settings.seekInterval + 1.0;
+    const int frames = static_cast<int> ( std::ceil ( ( runSeconds * settings.rate + 2.0 ) * settings.fps ) ) * 2;
+
+    bool generated = false;
+    if ( settings.clip.empty ( ) )
+    {
+        settings.clip = fs::temp_directory_path ( ) / ( "AX-LatencyHarness-" + std::to_string ( settings.width ) + "x" + std::to_string ( settings.height ) + "-" + std::to_string ( settings.fps ) + "-" + std::to_string ( frames ) + ".y4m" );
+        if ( !fs::exists ( settings.clip ) )
+        {
+            if ( !GenerateClip ( settings.clip, settings, frames ) )
+            {
+                std::cerr << "Unable to write " << settings.clip << std::endl;
+                return 1;
+            }
+
+            generated = true;
+        }
+    }
+
+    auto video = RawVideoFile::Open ( settings.clip );
+    if ( !video || video->GetPixelFormat ( ) != RawVideoFile::PixelFormat::I420 )
+    {
+        std::cerr << "Unable to open " << settings.clip << " as 4:2:0 Y4M" << std::endl;
+        return 1;
+    }
+
+    const int width = video->GetWidth ( ), height = video->GetHeight ( );
+    const double fps = video->GetFrameRate ( );
+    const int64_t frameCount = video->GetFrameCount ( );
+    auto frameAt = [&] ( double media ) { return std::clamp<int64_t> ( static_cast<int64_t> ( std::floor ( media * fps + 1e-6 ) ), 0, frameCount - 1 ); };
+
+    // The frame hand off, exactly as a transfer-threaded (or PresentationSync) player sets it up
+    FrameSlots slots;
+    slots.Reset ( settings.queued ? std::max<size_t> ( 4, settings.queueDepth ) : 3 );
+
+    std::vector<std::vector<uint8_t>> buffers ( slots.GetCount ( ), std::vector<uint8_t> ( static_cast<size_t> ( width ) * height * 4 ) );
+    std::vector<double> publishedAt ( slots.GetCount ( ), 0.0 );
+    std::vector<double> dueAt ( slots.GetCount ( ), 0.0 );
+
+    PresentationScheduler presentation ( PresentationScheduler::Options ( ).QueueDepth ( settings.queueDepth ).RefreshRate ( static_cast<float> ( settings.refresh ) ) );
+
+    Engine engine ( frameCount / fps );
+    engine.SetRate ( settings.rate );
+    engine.Flush ( );
+
+    // OnVideoStreamTick, polled every millisecond like the transfer poller does, with each new
+    // frame converted on the Executor
+    std::atomic_bool running{ true };
+    std::atomic_bool inFlight{ false };
+    std::atomic<uint64_t> transfers{ 0 };
+
+    std::thread poller ( [&]
+    {
+        int64_t lastIndex = -1;
+        uint64_t lastGeneration = 0;
+
+        while ( running.load ( ) )
+        {
+            const int64_t index = frameAt ( engine.GetMediaTime ( Now ( ) ) );
+            const uint64_t generation = engine.GetGeneration ( );
+
+            if ( ( index != lastIndex || generation != lastGeneration ) && !inFlight.exchange ( true ) )
+            {
+                lastIndex = index;
+                lastGeneration = generation;
+
+                Executor::Shared ( ).Submit ( Executor::Priority::Present, [&, index]
+                {
+                    const size_t slot = slots.GetWriteSlot ( );
+                    ConvertToBGRA ( video->GetFrame ( index ), buffers[slot].data ( ) );
+
+                    const double pts = index / fps;
+                    dueAt[slot] = engine.GetWallTime ( pts );
+                    publishedAt[slot] = Now ( );
+                    slots.Publish ( pts );
+
+                    transfers++;
+                    inFlight.store ( false );
+                } );
+            }
+
+            std::this_thread::sleep_for ( std::chrono::milliseconds ( 1 ) );
+        }
+    } );
+
+    // The display, one iteration per refresh
+    Distribution dueToPublish, publishToDraw, dueToDraw, seekLatency;
+    std::vector<uint64_t> offsetHistogram ( 9, 0 );    // Expected minus shown, -4 .. +4 frames, ends collect the rest
+    uint64_t ticks = 0, framesShown = 0, dropped = 0, repeated = 0, unreadable = 0, seeksFailed = 0;
+    double playResponse = -1.0;
+
+    enum class Phase { Idle, Starting, Playing, Seeking, Done } phase = Phase::Idle;
+    const double interval = 1.0 / settings.refresh;
+    const int cadence = static_cast<int> ( std::ceil ( settings.refresh / ( fps * settings.rate ) - 1e-6 ) );
+
+    std::mt19937 random ( settings.seed );
+    std::uniform_real_distribution<double> seekTargets ( 1.0, std::max ( 1.5, frameCount / fps * 0.5 ) );
+
+    const double start = Now ( );
+    double phaseStart = start, commandAt = 0.0;
+    int64_t lastShown = -1, seekTarget = -1;
+    int heldFor = 0, seeksDone = 0;
+    uint64_t generation = 0;
+
+    for ( uint64_t refresh = 1; phase != Phase::Done; refresh++ )
+    {
+        std::this_thread::sleep_until ( std::chrono::steady_clock::time_point ( std::chrono::duration_cast<std::chrono::steady_clock::duration> ( std::chrono::duration<double> ( start + refresh * interval ) ) ) );
+        const double wall = Now ( );
+        ticks++;
+
+        if ( engine.GetGeneration ( ) != generation )
+        {
+            generation = engine.GetGeneration ( );
+            presentation.Reset ( );
+        }
+
+        bool swapped = false;
+        if ( settings.queued )
+        {
+            double queued[FrameSlots::kMaxSlots];
+            const size_t count = slots.GetQueued ( queued, FrameSlots::kMaxSlots );
+            const int pick = presentation.Select ( queued, count, engine.GetMediaTime ( wall + interval ), interval * settings.rate );
+            swapped = pick >= 0 && slots.SwapTo ( queued[pick] );
+        }
+        else
+        {
+            swapped = slots.Swap ( );
+        }
+
+        // "Draw", which for us is reading back what would have been drawn
+        const size_t slot = slots.GetReadSlot ( );
+        const int32_t shown = transfers.load ( ) > 0 ? ReadBarcode ( buffers[slot].data ( ), width, height ) : -1;
+        if ( transfers.load ( ) > 0 && shown < 0 ) unreadable++;
+
+        if ( swapped )
+        {
+            dueToPublish.Add ( std::max ( 0.0, publishedAt[slot] - dueAt[slot] ) );
+            publishToDraw.Add ( wall - publishedAt[slot] );
+            dueToDraw.Add ( std::max ( 0.0, wall - dueAt[slot] ) );
+        }
+
+        const bool steady = phase == Phase::Playing;
+        if ( shown >= 0 && shown != lastShown )
+        {
+            framesShown++;
+            if ( steady && lastShown >= 0 && shown > lastShown ) dropped += static_cast<uint64_t> ( shown - lastShown - 1 );
+            if ( steady && heldFor > cadence ) repeated += static_cast<uint64_t> ( heldFor - cadence );
+            heldFor = 1;
+        }
+        else
+        {
+            heldFor++;
+        }
+
+        if ( steady && shown >= 0 )
+        {
+            const int64_t offset = frameAt ( engine.GetMediaTime ( wall ) ) - shown;
+            offsetHistogram[static_cast<size_t> ( std::clamp<int64_t> ( offset, -4, 4 ) + 4 )]++;
+        }
+
+        switch ( phase )
+        {
+            case Phase::Idle:
+            {
+                // Let the first frame land, then measure how long Play takes to show motion
+                if ( shown >= 0 && wall - phaseStart > 0.5 )
+                {
+                    commandAt = Now ( );
+                    engine.Play ( );
+                    phase = Phase::Starting;
+                }
+                break;
+            }
+
+            case Phase::Starting:
+            {
+                if ( shown > lastShown && lastShown >= 0 )
+                {
+                    playResponse = wall - commandAt;
+                    phase = Phase::Playing;
+                    phaseStart = wall;
+                }
+                break;
+            }
+
+            case Phase::Playing:
+            {
+                const bool steadyDone = seeksDone == 0 ? wall - phaseStart >= settings.seconds : wall - phaseStart >= settings.seekInterval;
+                if ( !steadyDone ) break;
+
+                if ( seeksDone >= settings.seeks )
+                {
+                    phase = Phase::Done;
+                    break;
+                }
+
+                const double target = seekTargets ( random );
+                seekTarget = frameAt ( target );
+                commandAt = Now ( );
+                engine.Seek ( target );
+                phase = Phase::Seeking;
+                break;
+            }
+
+            case Phase::Seeking:
+            {
+                // Correct means the target frame, or one after it that the clock has since moved on to
+                const int64_t reach = seekTarget + static_cast<int64_t> ( std::ceil ( ( wall - commandAt ) * fps * settings.rate ) ) + 1;
+                if ( shown >= seekTarget && shown <= reach )
+                {
+                    seekLatency.Add ( wall - commandAt );
+                    seeksDone++;
+                    phase = Phase::Playing;
+                    phaseStart = wall;
+                }
+                else if ( wall - commandAt > 2.0 )
+                {
+                    seeksFailed++;
+                    seeksDone++;
+                    phase = Phase::Playing;
+                    phaseStart = wall;
+                }
+                break;
+            }
+
+            case Phase::Done: break;
+        }
+
+        if ( shown >= 0 ) lastShown = shown;
+    }
+
+    running.store ( false );
+    poller.join ( );
+    while ( inFlight.load ( ) ) std::this_thread::yield ( );
+    engine.Flush ( );
+
+    const double p99 = dueToDraw.Percentile ( 0.99 ) * 1000.0;
+    const bool ok = unreadable == 0 && seeksFailed == 0 && playResponse >= 0.0 && ( settings.maxP99Ms <= 0.0 || p99 <= settings.maxP99Ms );
+
+    std::ostringstream json;
+    json << "{\n"
+         << "  \"clip\": { \"path\": \"" << settings.clip.generic_string ( ) << "\", \"generated\": " << ( generated ? "true" : "false" )
+         << ", \"width\": " << width << ", \"height\": " << height << ", \"fps\": " << fps << ", \"frames\": " << frameCount << " },\n"
+         << "  \"config\": { \"refreshHz\": " << settings.refresh << ", \"rate\": " << settings.rate << ", \"mode\": \"" << ( settings.queued ? "queued" : "latest" )
+         << "\", \"slots\": " << slots.GetCount ( ) << ", \"executorThreads\": " << Executor::Shared ( ).GetThreadCount ( ) << " },\n"
+         << "  \"playResponseMs\": " << playResponse * 1000.0 << ",\n"
+         << "  \"latencyMs\": {\n"
+         << "    \"dueToPublish\": " << dueToPublish.ToJson ( ) << ",\n"
+         << "    \"publishToDraw\": " << publishToDraw.ToJson ( ) << ",\n"
+         << "    \"dueToDraw\": " << dueToDraw.ToJson ( ) << "\n"
+         << "  },\n"
+         << "  \"frames\": { \"refreshes\": " << ticks << ", \"transferred\": " << transfers.load ( ) << ", \"shown\": " << framesShown
+         << ", \"dropped\": " << dropped << ", \"repeated\": " << repeated << ", \"unreadable\": " << unreadable << " },\n"
+         << "  \"offsetFrames\": { \"range\": [-4, 4], \"histogram\": [";
+    for ( size_t i = 0; i < offsetHistogram.size ( ); i++ ) json << ( i ? ", " : "" ) << offsetHistogram[i];
+    json << "] },\n"
+         << "  \"seeks\": { \"count\": " << seeksDone << ", \"failed\": " << seeksFailed << ", \"toFirstCorrectFrameMs\": " << seekLatency.ToJson ( ) << " },\n"
+         << "  \"ok\": " << ( ok ? "true" : "false" ) << "\n"
+         << "}\n";
+
+    if ( settings.output.empty ( ) )
+    {
+        std::cout << json.str ( );
+    }
+    else
+    {
+        std::ofstream file ( settings.output, std::ios::trunc );
+        file << json.str ( );
+        if ( !file )
+        {
+            std::cerr << "Unable to write " << settings.output << std::endl;
+            return 1;
+        }
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,257 @@
+//
+//  ReadAheadHarness.cxx
+//  ReadAheadHarness
+//
+//  Created on 18/10/26.
+//  (c) 2026 AX Interactive
+//
+
+#include "AX-MediaPlayerReadAhead.h"
+
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+// Reads a generated file, where every 8 byte word holds its own offset, through a
+// ReadAheadByteSource the way a decoder would: mostly sequential at a steady bitrate with
+// the odd seek. Every byte handed back is checked. The first pass starts with the file
+// dropped from the page cache so the reads really go to the disk, the second is warm.
+// Run it under a bandwidth limit (see the CMake THROTTLE options) to see it on slow storage.
+
+namespace fs = std::filesystem;
+using namespace AX::Video;
+
+namespace
+{
+    struct Settings
+    {
+        uint64_t    megabytes{ 64 };
+        double      rateMBps{ 0.0 };        // 0 reads as fast as it can
+        size_t      chunk{ 64 * 1024 };
+        size_t      blockKB{ 1024 };
+        float       windowMB{ 16.0f };
+        int         seeks{ 8 };
+        bool        ioUring{ true };
+        bool        expectIOUring{ false };
+        uint64_t    maxStalls{ 0 };
+        bool        limitStalls{ false };
+        fs::path    file;
+    };
+
+    bool GenerateFile ( const fs::path & path, uint64_t size )
+    {
+        std::ofstream file ( path, std::ios::binary | std::ios::trunc );
+        if ( !file ) return false;
+
+        std::vector<uint64_t> words ( 1 << 17 );
+        for ( uint64_t offset = 0; offset < size; )
+        {
+            const uint64_t count = std::min<uint64_t> ( words.size ( ), ( size - offset ) / sizeof ( uint64_t ) );
+            for ( uint64_t i = 0; i < count; i++ ) words[i] = offset + i * sizeof ( uint64_t );
+
+            file.write ( reinterpret_cast<const char *> ( words.data ( ) ), static_cast<std::streamsize> ( count * sizeof ( uint64_t ) ) );
+            offset += count * sizeof ( uint64_t );
+        }
+
+        return static_cast<bool> ( file );
+    }
+
+    // Best effort, so the first pass can't be served out of memory
+    void DropFromCache ( const fs::path & path )
+    {
+#if !defined( _WIN32 ) && defined( POSIX_FADV_DONTNEED )
+        int fd = open ( path.c_str ( ), O_RDONLY | O_CLOEXEC );
+        if ( fd < 0 ) return;
+
+        fdatasync ( fd );
+        posix_fadvise ( fd, 0, 0, POSIX_FADV_DONTNEED );
+        close ( fd );
+#endif
+    }
+
+    bool Verify ( const uint8_t * data, uint64_t offset, size_t length )
+    {
+        for ( size_t i = 0; i < length; i++ )
+        {
+            const uint64_t position = offset + i;
+            const uint64_t word = position & ~uint64_t ( 7 );
+
+            uint8_t expected;
+            std::memcpy ( &expected, reinterpret_cast<const uint8_t *> ( &word ) + ( position - word ), 1 );
+            if ( data[i] != expected ) return false;
+        }
+
+        return true;
+    }
+
+    struct Pass
+    {
+        uint64_t    bytes{ 0 };
+        uint64_t    mismatches{ 0 };
+        uint64_t    shortReads{ 0 };
+        double      seconds{ 0.0 };
+        ReadAheadByteSource::Stats stats;
+    };
+
+    bool Run ( const Settings & settings, uint32_t seed, Pass & pass )
+    {
+        auto options = ReadAheadByteSource::Options ( )
+            .BlockSize ( settings.blockKB * 1024 )
+            .WindowMegabytes ( settings.windowMB )
+            .UseIOUring ( settings.ioUring );
+
+        auto source = ReadAheadByteSource::Create ( settings.file, options );
+        if ( !source ) return false;
+
+        const uint64_t size = source->Size ( );
+        std::vector<uint8_t> buffer ( settings.chunk );
+
+        std::mt19937_64 random ( seed );
+        const uint64_t seekEvery = settings.seeks > 0 ? size / ( settings.seeks + 1 ) : size;
+        uint64_t offset = 0, sinceSeek = 0;
+
+        using Clock = std::chrono::steady_clock;
+        const auto start = Clock::now ( );
+
+        while ( pass.bytes < size )
+        {
+            // Loops back to the start like a looping clip would
+            if ( offset >= size ) offset = 0;
+
+            // A decoder pulling at the clip's bitrate, rather than as fast as the disk allows
+            if ( settings.rateMBps > 0.0 )
+            {
+                const double due = pass.bytes / ( settings.rateMBps * 1024.0 * 1024.0 );
+                std::this_thread::sleep_until ( start + std::chrono::duration_cast<Clock::duration> ( std::chrono::duration<double> ( due ) ) );
+            }
+
+            const size_t length = static_cast<size_t> ( std::min<uint64_t> ( buffer.size ( ), size - offset ) );
+            const size_t read = source->Read ( offset, buffer.data ( ), length );
+
+            if ( read != length ) pass.shortReads++;
+            if ( !Verify ( buffer.data ( ), offset, read ) ) pass.mismatches++;
+
+            pass.bytes += read;
+            offset += length;
+            sinceSeek += length;
+
+            if ( sinceSeek >= seekEvery && offset < size )
+            {
+                offset = ( random ( ) % size ) & ~uint64_t ( 7 );
+                sinceSeek = 0;
+            }
+        }
+
+        pass.seconds = std::chrono::duration<double> ( Clock::now ( ) - start ).count ( );
+        pass.stats = source->GetStats ( );
+        return true;
+    }
+
+    void Print ( const char * name, const Pass & pass )
+    {
+        const auto & stats = pass.stats;
+        std::cout << name << ": " << ( pass.bytes / ( 1024.0 * 1024.0 ) ) << " MB in " << pass.seconds << "s"
+                  << ", " << ( stats.ioUring ? "io_uring" : "thread pool" )
+                  << ", disk " << stats.throughputMBps << " MB/s"
+                  << ", hits " << stats.cacheHits
+                  << ", stalls " << stats.stalls << " (" << stats.stallSeconds * 1000.0 << "ms, longest " << stats.longestStallSeconds * 1000.0 << "ms)"
+                  << ", mismatches " << pass.mismatches
+                  << ", short reads " << pass.shortReads << std::endl;
+    }
+
+    int PrintUsage ( )
+    {
+        std::cout << "Usage:\n"
+                  << "  ReadAheadHarness [--size <MB>] [--rate <MB/s>] [--chunk <KB>] [--block <KB>] [--window <MB>]\n"
+                  << "                   [--seeks <n>] [--no-uring] [--expect-uring] [--max-stalls <n>] [--file <path>]\n\n"
+                  << "Generates (or reuses) a file and reads it through the read ahead cache, cold then warm.\n"
+                  << "Exits non zero if any byte is wrong, a read comes back short, io_uring was expected but\n"
+                  << "not used or the cold pass stalled more than --max-stalls times.\n";
+        return 1;
+    }
+}
+
+int main ( int argc, char ** argv )
+{
+    Settings settings;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if ( arg == "--size" && hasValue ) settings.megabytes = std::stoull ( argv[++i] );
+        else if ( arg == "--rate" && hasValue ) settings.rateMBps = std::stod ( argv[++i] );
+        else if ( arg == "--chunk" && hasValue ) settings.chunk = std::stoul ( argv[++i] ) * 1024;
+        else if ( arg == "--block" && hasValue ) settings.blockKB = std::stoul ( argv[++i] );
+        else if ( arg == "--window" && hasValue ) settings.windowMB = std::stof ( argv[++i] );
+        else if ( arg == "--seeks" && hasValue ) settings.seeks = std::stoi ( argv[++i] );
+        else if ( arg == "--max-stalls" && hasValue ) { settings.limitStalls = true; settings.maxStalls = std::stoull ( argv[++i] ); }
+        else if ( arg == "--file" && hasValue ) settings.file = argv[++i];
+        else if ( arg == "--no-uring" ) settings.ioUring = false;
+        else if ( arg == "--expect-uring" ) settings.expectIOUring = true;
+        else
+        {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return PrintUsage ( );
+        }
+    }
+
+    if ( settings.megabytes == 0 || settings.chunk == 0 || settings.rateMBps < 0.0 ) return PrintUsage ( );
+
+    if ( settings.file.empty ( ) )
+    {
+        settings.file = fs::temp_directory_path ( ) / ( "AX-ReadAheadHarness-" + std::to_string ( settings.megabytes ) + "MB.bin" );
+        std::error_code error;
+        if ( fs::file_size ( settings.file, error ) != settings.megabytes * 1024 * 1024 )
+        {
+            if ( !GenerateFile ( settings.file, settings.megabytes * 1024 * 1024 ) )
+            {
+                std::cerr << "Unable to write " << settings.file << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    DropFromCache ( settings.file );
+
+    Pass cold, warm;
+    if ( !Run ( settings, 1, cold ) || !Run ( settings, 2, warm ) )
+    {
+        std::cerr << "Unable to open " << settings.file << std::endl;
+        return 1;
+    }
+
+    Print ( "cold", cold );
+    Print ( "warm", warm );
+
+    bool failed = false;
+    for ( auto * pass : { &cold, &warm } )
+    {
+        if ( pass->mismatches > 0 || pass->shortReads > 0 ) failed = true;
+    }
+
+    if ( settings.expectIOUring && !cold.stats.ioUring )
+    {
+        std::cerr << "Expected io_uring, got the thread pool" << std::endl;
+        failed = true;
+    }
+
+    if ( settings.limitStalls && cold.stats.stalls > settings.maxStalls )
+    {
+        std::cerr << "Cold pass stalled " << cold.stats.stalls << " times, limit is " << settings.maxStalls << std::endl;
+        failed = true;
+    }
+
+    return failed ? 1 : 0;
+}